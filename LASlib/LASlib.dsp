@@ -133,6 +133,10 @@ SOURCE=.\src\laskdtree.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\laspipeline.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=..\LASzip\src\lasquadtree.cpp
 # End Source File
 # Begin Source File
@@ -369,6 +373,10 @@ SOURCE=.\inc\laskdtree.hpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\inc\laspipeline.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=..\LASzip\src\laspoint.hpp
 # End Source File
 # Begin Source File
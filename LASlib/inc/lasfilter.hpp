@@ -24,6 +24,12 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- criteria describe themselves for fusion with get_fuse_mask()
+    18 October 2026 -- time the cost of the criteria in batches on a sample of points
+    18 October 2026 -- reorder stateless criteria by measured cost and rejection rate
+    18 October 2026 -- fuse runs of class, return and flag criteria into masks
+    18 October 2026 -- thinning with grid or time keeps used cells in sparse hashed tiles
+    18 October 2026 -- criteria can reject whole chunks from their min/max summaries
      9 June 2021 -- disallow use of '-keep_class' together with '-keep_extended_class'
      3 April 2021 -- new filter '-keep_profile p1_x p1_y p2_x p2_y width' 
      6 March 2018 -- changed '%g' to '%lf' for all sprintf() of F64 values
@@ -39,6 +45,51 @@
 #include "lasdefinitions.hpp"
 #include "laszip_decompress_selective_v3.hpp"
 
+class LASchunkSummary;
+
+// what a criterion drops by looking only at the classification, the return
+// number or the flags. a set bit means the point is dropped. the legacy
+// classification indexes a 33 bit mask (with 32 standing for a zero legacy
+// but a non-zero extended classification), the extended one a 256 bit mask,
+// the return number a 16 bit mask and the synthetic, keypoint, withheld and
+// overlap flags together a 16 bit mask.
+
+class LASfuseMask
+{
+public:
+  U64 drop_class;
+  U32 drop_extended_class[8];
+  U32 drop_return_mask;
+  U32 drop_flag_mask;
+  inline BOOL drops(const LASpoint* point) const
+  {
+    U32 c = point->classification | (((point->classification == 0) & (point->extended_classification != 0)) << 5);
+    U32 e = point->extended_classification;
+    U32 f = point->synthetic_flag | (point->keypoint_flag << 1) | (point->withheld_flag << 2) | (point->extended_classification_flags & 8);
+    return (((U32)(drop_class >> c) | (drop_extended_class[e >> 5] >> (e & 31)) | (drop_return_mask >> point->return_number) | (drop_flag_mask >> f)) & 1);
+  };
+  // drop all flag combinations with 'flag' set (or not set)
+  void drop_flag(U32 flag, BOOL set)
+  {
+    for (U32 i = 0; i < 16; i++) if (((i & flag) != 0) == (set != FALSE)) drop_flag_mask |= (1u << i);
+  };
+  void add(const LASfuseMask* other)
+  {
+    drop_class |= other->drop_class;
+    for (U32 i = 0; i < 8; i++) drop_extended_class[i] |= other->drop_extended_class[i];
+    drop_return_mask |= other->drop_return_mask;
+    drop_flag_mask |= other->drop_flag_mask;
+  };
+  void reset()
+  {
+    drop_class = 0;
+    for (U32 i = 0; i < 8; i++) drop_extended_class[i] = 0;
+    drop_return_mask = 0;
+    drop_flag_mask = 0;
+  };
+  LASfuseMask() { reset(); };
+};
+
 class LAScriterion
 {
 public:
@@ -46,6 +97,13 @@ public:
   virtual I32 get_command(CHAR* string) const = 0;
   virtual U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_CHANNEL_RETURNS_XY; };
   virtual BOOL filter(const LASpoint* point) = 0;
+  // TRUE only if filter() is certain to be TRUE for all points of the chunk
+  virtual BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return FALSE; };
+  // TRUE if filter() depends on the points that were seen before
+  virtual BOOL is_stateful() const { return FALSE; };
+  // TRUE if what filter() drops can be added to 'mask' so that runs of such
+  // criteria are evaluated with one lookup per attribute
+  virtual BOOL get_fuse_mask(LASfuseMask* mask) const { return FALSE; };
   virtual void reset(){};
   virtual ~LAScriterion(){};
 };
@@ -67,8 +125,12 @@ public:
   void addKeepScanDirectionChange();
 
   BOOL filter(const LASpoint* point);
+  BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point);
   void reset();
 
+  // verbose report of the points rejected by each criterion since the last one
+  void report_statistics();
+
   LASfilter();
   ~LASfilter();
 
@@ -78,7 +140,28 @@ private:
   U32 num_criteria;
   U32 alloc_criteria;
   LAScriterion** criteria;
-  I32* counters;
+  I64* counters;
+  // the criteria as they are evaluated with runs of simple ones fused
+  void compile();
+  void clean_stages();
+  U32 num_stages;
+  LAScriterion** stages;
+  U32* stage_criteria;
+  U32* stage_sizes;
+  U32 rejecting_criterion(U32 stage, const LASpoint* point) const;
+  // the stateless stages are measured on the first points and then reordered
+  BOOL filter_and_learn(const LASpoint* point);
+  void time_stages();
+  void reorder_stages();
+  F64 stage_rank(U32 i) const;
+  void swap_stages(U32 i, U32 j);
+  BOOL in_order;
+  U32 learn_count;
+  U32* stage_evaluated;
+  U32* stage_rejected;
+  F64* stage_costs;
+  LASpoint* learn_sample;
+  U32 learn_sampled;
 };
 
 #endif
@@ -0,0 +1,99 @@
+/*
+===============================================================================
+
+  FILE:  laspipeline.hpp
+
+  CONTENTS:
+
+    Drives the read -> process -> write loop of a tool as a pipeline. When it
+    is threaded the LASreader (decoding, filtering and transforming) and the
+    LASwriter (encoding) each run on their own thread and hand blocks of points
+    to the calling thread through bounded single-producer/single-consumer rings
+    so that decompression, the work of the tool and compression overlap. When
+    it is not threaded the same calls go directly to reader and writer.
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the LICENSE.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- exceptions of the stage threads reach the caller
+    18 October 2026 -- close() stops the read stage at the next point
+    18 October 2026 -- failed writes are reported by write_point() and close()
+    18 October 2026 -- stages sleep on a condition variable instead of spinning
+    18 October 2026 -- created to overlap LAZ decoding with LAZ encoding
+
+===============================================================================
+*/
+#ifndef LAS_PIPELINE_HPP
+#define LAS_PIPELINE_HPP
+
+#include "lasreader.hpp"
+#include "laswriter.hpp"
+
+#include <exception>
+#include <thread>
+
+class LASpointRing;
+class LASpointBlock;
+
+class LASLIB_DLL LASpipeline
+{
+public:
+  I64 p_cnt;   // reader count of the current point (as in LASreader)
+  I64 p_count; // number of points handed to the writer
+
+  // both 'lasreader' and 'laswriter' are optional. the points written must
+  // have the layout of 'layout' (or of the reader point when it is zero)
+  BOOL open(LASreader* lasreader, LASwriter* laswriter, BOOL update_inventory, BOOL threaded, const LASpoint* layout=0);
+  BOOL is_threaded() const { return threaded; };
+
+  // the next point read, filtered and transformed or zero at the end. it
+  // stays valid until the next call. an exception of the reader is rethrown
+  // here once the points read before it are consumed
+  LASpoint* read_point();
+
+  // queues the point for writing (and maybe for the inventory). FALSE once
+  // the writer has failed
+  BOOL write_point(const LASpoint* point);
+
+  // stops reading, waits until all queued points are written and joins the
+  // threads. only then the writer (and the reader) may be used again. FALSE
+  // if the writer failed or threw on any point or if the reader threw
+  BOOL close();
+
+  LASpipeline();
+  ~LASpipeline();
+
+private:
+  LASreader* lasreader;
+  LASwriter* laswriter;
+  BOOL update_inventory;
+  BOOL threaded;
+  LASpointRing* decoded;
+  LASpointRing* encoded;
+  std::thread* read_stage;
+  std::thread* write_stage;
+  LASpointBlock* read_block;
+  LASpointBlock* write_block;
+  U32 read_next;
+  BOOL write_failed;
+  std::exception_ptr read_exception;
+  std::exception_ptr write_exception;
+  void run_read_stage();
+  void run_write_stage();
+};
+
+#endif
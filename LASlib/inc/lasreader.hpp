@@ -25,6 +25,10 @@
 
     CHANGE HISTORY:
 
+        18 October 2026 -- report the filter statistics when the filtered points end
+        18 October 2026 -- readers of LAZ files may hand out compressed chunks for copying
+        18 October 2026 -- number of threads for decoding the layers of LAZ 1.4 chunks
+        18 October 2026 -- number of threads for parsing ASCII lines
         18 April 2023 -- adding support of COPC spatial index standard
         10 March 2022 -- added '-iptx_transform' option
         31 October 2019 -- adding kdtree of bounding boxes for large number of LAS/LAZ files
@@ -149,6 +153,16 @@ class LASLIB_DLL LASreader {
   };
 
   virtual BOOL seek(const I64 p_index) = 0;
+
+  // readers of LAZ files may hand out the next compressed chunk to be copied
+  // as it is. it is then either read point by point or skipped
+  virtual BOOL peek_chunk(const U8** bytes, U32* num_bytes, U32* num_points) {
+    return FALSE;
+  };
+  virtual BOOL skip_chunk() {
+    return FALSE;
+  };
+
   BOOL read_point() {
     return (this->*read_simple)();
   };
@@ -272,6 +286,10 @@ class LASLIB_DLL LASreadOpener {
   inline U32 get_io_ibuffer_size() const {
     return io_ibuffer_size;
   };
+  void set_layer_threads(const U32 layer_threads);
+  inline U32 get_layer_threads() const {
+    return layer_threads;
+  };
   U32 get_file_name_number() const;
   U32 get_file_name_current() const;
   const CHAR* get_file_name() const;
@@ -345,6 +363,7 @@ class LASLIB_DLL LASreadOpener {
   BOOL set_point_type(U8 point_type);
   void set_parse_string(const CHAR* parse_string);
   void set_skip_lines(const U32 number_of_lines);
+  void set_parse_threads(const I32 parse_threads);
   void set_populate_header(BOOL populate_header);
   void set_keep_lastiling(BOOL keep_lastiling);
   void set_keep_copc(BOOL keep_copc);
@@ -427,6 +446,7 @@ class LASLIB_DLL LASreadOpener {
   BOOL add_file_name(const CHAR* file_name, U32 ID, BOOL unique);
   BOOL add_file_name(const CHAR* file_name, U32 ID, I64 npoints, F64 min_x, F64 min_y, F64 max_x, F64 max_y, BOOL unique = FALSE);
   U32 io_ibuffer_size;
+  U32 layer_threads;
   const CHAR* file_name;
   BOOL merged;
   BOOL stored;
@@ -480,6 +500,7 @@ class LASLIB_DLL LASreadOpener {
   U8 point_type;
   CHAR* parse_string;
   U32 skip_lines;
+  I32 parse_threads;
   BOOL populate_header;
   BOOL keep_lastiling;
   BOOL keep_copc;
@@ -24,6 +24,9 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- inside_none() reads the entire raster again
+    18 October 2026 -- index of row offsets for seek() and for jumping to the rows inside '-inside'
+    18 October 2026 -- parse whole rows and convert only the rows inside '-inside'
     31 August 2019 -- add RasterLAZ during code sprint after FOSS4G 2019 in Bucharest 
     10 May 2019 -- checking for overflows in X, Y, Z 32 bit integers of fixed-point LAS
     06 December 2013 -- option to deal with European '-comma_not_dot' numbers
@@ -50,6 +53,11 @@ public:
 
   BOOL seek(const I64 p_index);
 
+  BOOL inside_none();
+  BOOL inside_tile(const F32 ll_x, const F32 ll_y, const F32 size);
+  BOOL inside_circle(const F64 center_x, const F64 center_y, const F64 radius);
+  BOOL inside_rectangle(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y);
+
   ByteStreamIn* get_stream() const;
   void close(BOOL close_stream=TRUE);
   BOOL reopen(const CHAR* file_name);
@@ -74,6 +82,14 @@ private:
   F64 xllcenter, yllcenter;
   F32 cellsize;
   F32 nodata;
+  F64* row_elevations;
+  I32 row_cells;
+  I32 row_first, row_last, col_first, col_last;
+  I64* row_offsets;
+  I64* row_points;
+  I64 line_start;
+  BOOL indexing;
+  BOOL seek_rows;
   I64 overflow_I32_x;
   I64 overflow_I32_y;
   I64 overflow_I32_z;
@@ -81,6 +97,10 @@ private:
   F64 orig_x_scale_factor, orig_y_scale_factor, orig_z_scale_factor;
 
   void clean();
+  I32 read_row(BOOL convert);
+  BOOL seek_row(const I32 r);
+  void start_window();
+  void set_window(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y);
   void populate_scale_and_offset();
   void populate_bounding_box();
 };
@@ -24,6 +24,9 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- inside_none() reads the entire raster again
+    18 October 2026 -- seek() to any point and read only the columns inside '-inside'
+    18 October 2026 -- read and convert whole rows and only the rows inside '-inside'
     31 August 2019 -- add RasterLAZ during code sprint after FOSS4G 2019 in Bucharest 
     10 May 2019 -- checking for overflows in X, Y, Z 32 bit integers of fixed-point LAS
      7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
@@ -51,6 +54,11 @@ public:
 
   BOOL seek(const I64 p_index);
 
+  BOOL inside_none();
+  BOOL inside_tile(const F32 ll_x, const F32 ll_y, const F32 size);
+  BOOL inside_circle(const F64 center_x, const F64 center_y, const F64 radius);
+  BOOL inside_rectangle(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y);
+
   ByteStreamIn* get_stream() const;
   void close(BOOL close_stream=TRUE);
   BOOL reopen(const CHAR* file_name);
@@ -71,6 +79,14 @@ private:
   F32 nodata;
   BOOL floatpixels;
   BOOL signedpixels;
+  BOOL bigendianpixels;
+  I32 cell_size;
+  U8* row_buffer;
+  F32* row_elevations;
+  I32 row_cells;
+  I32 row_first, row_last, col_first, col_last;
+  BOOL seek_cols;
+  I64* row_points;
   I64 overflow_I32_x;
   I64 overflow_I32_y;
   I64 overflow_I32_z;
@@ -80,6 +96,9 @@ private:
   void clean();
   BOOL read_hdr_file(const CHAR* file_name);
   BOOL read_blw_file(const CHAR* file_name);
+  I32 read_row();
+  BOOL start_window();
+  void set_window(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y);
   void populate_scale_and_offset();
   void populate_bounding_box();
 };
@@ -24,6 +24,9 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- inside_none() reads the entire raster again
+    18 October 2026 -- seek() to any point and read only the rows inside '-inside'
+    18 October 2026 -- read and convert whole columns and only the columns inside '-inside'
     31 August 2019 -- add RasterLAZ during code sprint after FOSS4G 2019 in Bucharest 
     10 May 2019 -- checking for overflows in X, Y, Z 32 bit integers of fixed-point LAS
     10 October 2013 -- created after returning from INTERGEO 2013 in Essen
@@ -49,6 +52,11 @@ public:
 
   BOOL seek(const I64 p_index);
 
+  BOOL inside_none();
+  BOOL inside_tile(const F32 ll_x, const F32 ll_y, const F32 size);
+  BOOL inside_circle(const F64 center_x, const F64 center_y, const F64 radius);
+  BOOL inside_rectangle(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y);
+
   ByteStreamIn* get_stream() const;
   void close(BOOL close_stream=TRUE);
   BOOL reopen(const CHAR* file_name);
@@ -68,6 +76,13 @@ private:
   F32 xdim, ydim;
   F32 nodata;
   I16 data_type;  // 2 = F32, 1 = I32, 0 = I16, 3 = F64
+  I32 cell_size;
+  U8* col_buffer;
+  F64* col_elevations;
+  I32 col_cells;
+  I32 row_first, row_last, col_first, col_last;
+  BOOL seek_rows;
+  I64* col_points;
   I64 overflow_I32_x;
   I64 overflow_I32_y;
   I64 overflow_I32_z;
@@ -75,6 +90,9 @@ private:
   F64 orig_x_scale_factor, orig_y_scale_factor, orig_z_scale_factor;
 
   void clean();
+  I32 read_col();
+  BOOL start_window();
+  void set_window(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y);
   void populate_scale_and_offset();
   void populate_bounding_box();
 };
@@ -24,6 +24,10 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- hands out entire compressed chunks for copying them as-is
+    18 October 2026 -- hands the number of layer threads of the opener to LASreadPoint
+    18 October 2026 -- open from a caller-owned memory buffer or a read callback
+    18 October 2026 -- skips chunks that the filter rejects based on chunk summaries
     9 November 2022 -- support of COPC VLR and EVLR
     13 June 2022 -- support unicode filenames
     10 July 2018 -- user must set seek-ability of istream (hard to determine) 
@@ -45,6 +49,7 @@
 
 #include "lasreader.hpp"
 #include "laszip_decompress_selective_v3.hpp"
+#include "bytestreamin_callback.hpp"
 
 #include <stdio.h>
 
@@ -56,6 +61,7 @@
 #endif
 
 class LASreadPoint;
+class LASstatistics;
 
 class LASLIB_DLL LASreaderLAS : public LASreader
 {
@@ -66,6 +72,10 @@ public:
   BOOL open(const char* file_name, I32 io_buffer_size=LAS_TOOLS_IO_IBUFFER_SIZE, BOOL peek_only=FALSE, U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL);
   BOOL open(FILE* file, BOOL peek_only=FALSE, U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL);
   BOOL open(std::istream& stream, BOOL peek_only=FALSE, U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL, BOOL seekable=TRUE);
+  // zero-copy over 'size' bytes of 'data' that must stay valid until close()
+  BOOL open(const U8* data, I64 size, BOOL peek_only=FALSE, U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL);
+  // fetches blocks of the 'size' bytes via 'callback' (e.g. HTTP range requests)
+  BOOL open(ByteStreamInReadCallback callback, void* user_data, I64 size, BOOL peek_only=FALSE, U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL);
   virtual BOOL open(ByteStreamIn* stream, BOOL peek_only=FALSE, U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL);
 
   I32 get_format() const;
@@ -75,11 +85,19 @@ public:
   ByteStreamIn* get_stream() const;
   void close(BOOL close_stream=TRUE);
 
+  // between two chunks of a LAZ file with new LAS 1.4 points the next chunk
+  // can be looked at and then either be read point by point or be skipped
+  BOOL peek_chunk(const U8** bytes, U32* num_bytes, U32* num_points);
+  BOOL skip_chunk();
+
   LASreaderLAS(LASreadOpener* opener);
   virtual ~LASreaderLAS();
 
 protected:
   virtual BOOL read_point_default();
+  // cleared by readers that change scale or offset of the points (which
+  // makes the chunk summaries and the compressed chunks of the file wrong)
+  BOOL use_chunk_summaries;
 
 private:
   FILE* file;
@@ -89,6 +107,14 @@ private:
   LASreadPoint* reader;
   BOOL checked_end;
   BOOL keep_copc;
+  // for skipping chunks whose summaries the filter rejects
+  LASstatistics* chunk_statistics;
+  I64* chunk_starts;
+  I64 next_chunk_start;
+  BOOL load_chunk_summaries();
+  void skip_rejected_chunks();
+  // for copying chunks
+  U32 peeked_points;
 };
 
 class LASreaderLASrescale : public virtual LASreaderLAS
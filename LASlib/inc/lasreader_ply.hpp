@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- read binary vertices in blocks with a precompiled layout
     9 May 2020 -- added silly 'obj_info' used by Cloud Compare
     4 September 2018 -- created after returning to Samara with locks changed
   
@@ -86,11 +87,27 @@ private:
   F64 attribute_no_datas[32];
   F64 orig_x_offset, orig_y_offset, orig_z_offset;
   F64 orig_x_scale_factor, orig_y_scale_factor, orig_z_scale_factor;
+  // binary vertex layout compiled once from the header
+  U32 number_properties;
+  U32 vertex_size;
+  U32 property_offsets[64];
+  CHAR property_fields[64];
+  CHAR property_types[64];
+  I32 property_attributes[64];
+  BOOL swap_bytes;
+  // block of binary vertices read with one fread and converted column by column
+  U8* vertex_block;
+  F64* vertex_values;
+  U32 block_size;
+  U32 block_count;
+  U32 block_next;
+  I64 block_vertices;
   BOOL parse_header();
   BOOL set_attribute(I32 index, F64 value);
   BOOL parse_attribute(const CHAR* l, I32 index);
   BOOL parse(const CHAR* parse_string);
-  F64 read_binary_value(CHAR type);
+  void compile_vertex_layout();
+  BOOL read_binary_block();
   BOOL read_binary_point();
   void populate_scale_and_offset();
   void populate_bounding_box();
@@ -24,6 +24,8 @@
 
   CHANGE HISTORY:
 
+   18 October 2026 -- coarsen the scale (or fail) when the points do not fit into 32 bit integers
+   18 October 2026 -- parse lines in batches on several threads with '-cores'
    10 March 2022 -- added '-iptx_transform' option
     7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
    22 July 2018 -- bug fix for parsing classfication to point type 6 (or higher)
@@ -56,10 +58,12 @@ public:
   void set_scale_scan_angle(F32 scale_scan_angle);
   void set_scale_factor(const F64* scale_factor);
   void set_offset(const F64* offset);
+  void set_threads(I32 threads);
   void add_attribute(I32 data_type, const CHAR* name, const CHAR* description = 0, F64 scale = 1.0, F64 offset = 0.0, F64 pre_scale = 1.0, F64 pre_offset = 0.0, F64 no_data = F64_MAX);
   virtual BOOL open(const CHAR* file_name, U8 point_type = 0, const CHAR* parse_string = 0, I32 skip_lines = 0, BOOL populate_header = FALSE);
   virtual BOOL open(FILE* file, const CHAR* file_name = 0, U8 point_type = 0, const CHAR* parse_string = 0, I32 skip_lines = 0, BOOL populate_header = FALSE);
   I32 get_format() const { return LAS_TOOLS_FORMAT_TXT; };
+  BOOL has_quantization_overflow() const { return quantization_overflow; };
 
   BOOL seek(const I64 p_index);
 
@@ -103,6 +107,23 @@ private:
   I32 attribute_starts[32];
   F64 orig_x_offset, orig_y_offset, orig_z_offset;
   F64 orig_x_scale_factor, orig_y_scale_factor, orig_z_scale_factor;
+  BOOL quantization_overflow;
+  // lines are read in batches and parsed by one parser per thread
+  I32 threads;
+  I32 batch_size;
+  I32 batch_capacity;
+  I32 batch_count;
+  I32 batch_next;
+  CHAR* batch_lines;
+  I32* batch_starts;
+  BOOL* batch_parsed;
+  LASpoint* batch_points;
+  LASreaderTXT** parsers;
+  BOOL init_batch();
+  BOOL read_batch();
+  void parse_batch(I32 parser, I32 begin, I32 end);
+  BOOL next_batch_point();
+  void clean_batch();
   BOOL parse_extended_flags(CHAR* parse_string);
   BOOL parse_column_description(CHAR** parse_string);
   BOOL parse_attribute(const CHAR* l, I32 index);
@@ -117,6 +138,7 @@ private:
   BOOL skip_pre();
   void skip_post();
   void populate_scale_and_offset();
+  BOOL fit_scale_and_offset();
   void populate_bounding_box();
   void clean();
 
@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- hands out the compressed chunks of LAZ files to be copied
      2 May 2023 -- adding support of COPC spatial index standard
      4 November 2019 -- add ID to files for subsets of merged '-faf' files
      5 September 2018 -- support for reading points from the PLY format
@@ -82,6 +83,11 @@ public:
 
   BOOL seek(const I64 p_index){ return FALSE; };
 
+  // the next compressed chunk of the merged LAZ files (continuing with the
+  // next file once one is done) if their points can be copied as they are
+  BOOL peek_chunk(const U8** bytes, U32* num_bytes, U32* num_points);
+  BOOL skip_chunk();
+
   ByteStreamIn* get_stream() const { return 0; };
   void close(BOOL close_stream=TRUE);
 
@@ -108,6 +114,8 @@ private:
   BOOL point_type_change;
   BOOL point_size_change;
   BOOL additional_attribute_change;
+  U32 laszip_file;
+  BOOL laszip_same;
   BOOL rescale;
   BOOL reoffset;
   F64* scale_factor;
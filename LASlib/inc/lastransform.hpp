@@ -24,6 +24,8 @@
 
 	CHANGE HISTORY:
 
+		18 October 2026 -- fuse runs of affine XYZ operations into one matrix
+		18 October 2026 -- which LAZ layers the operations change for recompressing only those
 		10 March 2022 -- added TransformMatrix operation
 		18 November 2021 -- new '-forceRGB' to use RGB values also in non-RGB point versions
 		15 June 2021 -- new '-clamp_RGB_to_8bit' transform useful to avoid 8 bit overflow
@@ -65,19 +67,35 @@ struct LASTransformMatrix {
 	F64 tr3;
 };
 
+#define LASTRANSFORM_X_COORDINATE 0x00000001
+#define LASTRANSFORM_Y_COORDINATE 0x00000002
+#define LASTRANSFORM_Z_COORDINATE 0x00000004
+#define LASTRANSFORM_INTENSITY    0x00000008
+#define LASTRANSFORM_RGB          0x00020000
+#define LASTRANSFORM_NIR          0x02000000
+
+#define LASTRANSFORM_XY_COORDINATE (LASTRANSFORM_X_COORDINATE | LASTRANSFORM_Y_COORDINATE)
+#define LASTRANSFORM_XYZ_COORDINATE (LASTRANSFORM_XY_COORDINATE | LASTRANSFORM_Z_COORDINATE)
+
 class LASoperation
 {
 public:
 	virtual const CHAR * name() const = 0;
 	virtual I32 get_command(CHAR* string) const = 0;
 	virtual U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_CHANNEL_RETURNS_XY; };
+	// the layers of new LAS 1.4 points that the operation may change (all unless known)
+	virtual U32 get_recompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_ALL; };
 	inline I64 get_overflow() const { return overflow; };
 	inline void zero_overflow() { overflow = 0; };
   inline void set_header(LASheader& header){ this->header = &header; };
   virtual F64* transform_coords_for_offset_adjustment(F64 x, F64 y, F64 z) = 0;
 	virtual void transform(LASpoint* point) = 0;
+	// TRUE if the operation maps x, y and z with the affine 'matrix' of three
+	// rows (x, y, z and translation) and only writes the 'coordinates' it sets
+	virtual BOOL get_affine(F64* matrix, U32* coordinates) const { return FALSE; };
 	virtual void reset() { overflow = 0; };
 	inline void set_offset_adjust(BOOL offset_adjust) { this->offset_adjust = offset_adjust; };
+	inline BOOL get_offset_adjust() const { return offset_adjust; };
   void set_origins(F64 orig_x_offset, F64 orig_y_offset, F64 orig_z_offset, F64 orig_x_scale_factor, F64 orig_y_scale_factor, F64 orig_z_scale_factor);
   void set_scale_factor(F64 scale_factor_x, F64 scale_factor_y, F64 scale_factor_z);
   void set_adjusted_offset(F64 adjusted_offset_x, F64 adjusted_offset_y, F64 adjusted_offset_z);
@@ -168,6 +186,13 @@ public:
       }
     }
 	};
+	inline BOOL get_affine(F64* matrix, U32* coordinates) const {
+		matrix[0] = r11; matrix[1] = r12; matrix[2] = r13; matrix[3] = tr1;
+		matrix[4] = r21; matrix[5] = r22; matrix[6] = r23; matrix[7] = tr2;
+		matrix[8] = r31; matrix[9] = r32; matrix[10] = r33; matrix[11] = tr3;
+		*coordinates = LASTRANSFORM_XYZ_COORDINATE;
+		return TRUE;
+	};
 	LASoperationTransformMatrix(F64 r11, F64 r12, F64 r13, F64 r21, F64 r22, F64 r23, F64 r31, F64 r32, F64 r33, F64 tr1, F64 tr2, F64 tr3)
 	{
 		this->r11 = r11; this->r12 = r12; this->r13 = r13;
@@ -227,16 +252,6 @@ class LASoperationMultiplyScaledIntensityRangeIntoRGB : public LASoperation
   F32 scale;
 };
 
-#define LASTRANSFORM_X_COORDINATE 0x00000001
-#define LASTRANSFORM_Y_COORDINATE 0x00000002
-#define LASTRANSFORM_Z_COORDINATE 0x00000004
-#define LASTRANSFORM_INTENSITY    0x00000008
-#define LASTRANSFORM_RGB          0x00020000
-#define LASTRANSFORM_NIR          0x02000000
-
-#define LASTRANSFORM_XY_COORDINATE (LASTRANSFORM_X_COORDINATE | LASTRANSFORM_Y_COORDINATE)
-#define LASTRANSFORM_XYZ_COORDINATE (LASTRANSFORM_XY_COORDINATE | LASTRANSFORM_Z_COORDINATE)
-
 class LAStransform
 {
 public:
@@ -251,6 +266,7 @@ public:
 	I32 unparse(CHAR* string) const;
 	inline BOOL active() const { return (num_operations != 0); };
 	U32 get_decompress_selective() const;
+	U32 get_recompress_selective() const;
 	inline BOOL filtered() const { return is_filtered; };
 
 	void setFilter(LASfilter* filter);
@@ -289,6 +305,12 @@ private:
 	U32 num_operations;
 	U32 alloc_operations;
 	LASoperation** operations;
+	// the operations as they are applied with runs of affine ones fused
+	void compile();
+	void clean_stages();
+	U32 num_stages;
+	LASoperation** stages;
+	U32* stage_sizes;
 	BOOL is_filtered;
 	LASfilter* filter;
 };
@@ -24,6 +24,12 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- LASstatistics warns on write failures and bounds the chunks it reads
+    18 October 2026 -- LAStileHash shared by the occupancy grid and the thinning filters
+    18 October 2026 -- LASstatistics builds chunk summaries only when a sidecar is written
+    18 October 2026 -- open addressing tile hash and cache of recent tiles in LASoccupancyGrid
+    18 October 2026 -- LASstatistics sidecar with per-chunk summaries
+    18 October 2026 -- sparse and mergeable tiles for the LASoccupancyGrid
     27 August 2017 -- added '-histo scanner_channel 1'
      1 June 2017 -- improved "fluff" detection
      3 May 2015 -- updated LASinventory to handle LAS 1.4 content 
@@ -36,6 +42,9 @@
 
 #include "lasdefinitions.hpp"
 
+class ByteStreamIn;
+class ByteStreamOut;
+
 class LASLIB_DLL LASinventory
 {
 public:
@@ -92,11 +101,83 @@ public:
   BOOL has_very_serious_fluff(U32 i) const { return (number_of_point_records && (number_of_point_records == xyz_fluff_1000[i])); };
   BOOL has_extremely_serious_fluff() const { return has_extremely_serious_fluff(0) || has_extremely_serious_fluff(1) || has_extremely_serious_fluff(2); };
   BOOL has_extremely_serious_fluff(U32 i) const { return (number_of_point_records && (number_of_point_records == xyz_fluff_10000[i])); };
+  BOOL read(ByteStreamIn* stream);
+  BOOL write(ByteStreamOut* stream) const;
   LASsummary();
 private:
   BOOL first;
 };
 
+// bounds of a consecutive run of points (e.g. one LAZ chunk) that allow
+// rejecting the entire run for a query without decompressing any point
+
+class LASLIB_DLL LASchunkSummary
+{
+public:
+  U32 number_of_points;
+  I32 min_X;
+  I32 max_X;
+  I32 min_Y;
+  I32 max_Y;
+  I32 min_Z;
+  I32 max_Z;
+  F64 min_gps_time;
+  F64 max_gps_time;
+  U16 min_intensity;
+  U16 max_intensity;
+  U16 return_numbers;    // bit r is set if there is a point with return number r
+  U8 classifications[32]; // bit c is set if there is a point with classification c
+  inline BOOL has_classification(U8 c) const { return (classifications[c >> 3] & (1 << (c & 7))) != 0; };
+  inline BOOL has_return_number(U8 r) const { return (return_numbers & (1 << (r & 15))) != 0; };
+  void reset();
+  void add(const LASpoint* point);
+  BOOL read(ByteStreamIn* stream);
+  BOOL write(ByteStreamOut* stream) const;
+  LASchunkSummary() { reset(); };
+};
+
+// everything lasinfo computes in its read pass plus the per-chunk summaries.
+// it is stored in a small '.stats' sidecar next to the LAS/LAZ file that is
+// keyed by the size and the modification time of that file so that it is
+// silently ignored once the file changes. the per-chunk summaries are only
+// built after an explicit init().
+
+class LASLIB_DLL LASstatistics
+{
+public:
+  LASsummary summary;
+  I64 number_of_first_returns;
+  I64 number_of_intermediate_returns;
+  I64 number_of_last_returns;
+  I64 number_of_single_returns;
+  I64 number_of_all_returns;
+  U32 chunk_size;
+  U32 number_of_chunks;
+  LASchunkSummary* chunks;
+  void init(const LASheader* header, U32 chunk_size=LASZIP_CHUNK_SIZE_DEFAULT); // before adding any point
+  void add(const LASpoint* point);
+  void chunk();
+  BOOL is_compatible(const LASheader* header) const;
+  BOOL read(ByteStreamIn* stream);
+  BOOL write(ByteStreamOut* stream) const;
+  BOOL read_chunks(ByteStreamIn* stream, I64 npoints);
+  BOOL write_chunks(ByteStreamOut* stream) const;
+  BOOL read(const CHAR* file_name);
+  BOOL write(const CHAR* file_name);
+  LASstatistics();
+  ~LASstatistics();
+private:
+  BOOL chunked;
+  U32 alloc_chunks;
+  U32 point_in_chunk;
+  U8 point_data_format;
+  U16 point_data_record_length;
+  F64 scale_factor[3];
+  F64 offset[3];
+  I64 file_size;
+  I64 file_time;
+};
+
 class LASLIB_DLL LASbin
 {
 public:
@@ -187,6 +268,32 @@ private:
   LASbin* return_map_bin_intensity;
 };
 
+// open addressing hash with linear probing from I64 keys to tiles of a fixed
+// number of 64 bit words. new tiles are zeroed and only reset() removes them.
+// it grows to keep at most half of its slots used.
+
+class LASLIB_DLL LAStileHash
+{
+public:
+  U32 number;
+  U32 capacity;
+  I64* keys;
+  U64** tiles;
+  U64* find(I64 key) const;
+  U64* get(I64 key); // allocates a missing tile
+  void reset();
+  LAStileHash(U32 words);
+  ~LAStileHash();
+private:
+  U32 words;
+  inline U32 slot(I64 key) const { return (U32)((((U64)key) * 0x9E3779B97F4A7C15ull) >> 32) & (capacity - 1); };
+  void grow();
+};
+
+// sparse occupancy grid made from tiles of 64 x 64 cells that are stored in a
+// hash by tile position. each thread can fill its own grid and the grids can be
+// combined with merge() afterwards.
+
 class LASLIB_DLL LASoccupancyGrid
 {
 public:
@@ -196,7 +303,10 @@ public:
   BOOL occupied(const LASpoint* point) const;
   BOOL occupied(I32 pos_x, I32 pos_y) const;
   BOOL active() const;
+  BOOL merge(const LASoccupancyGrid* other);
   U32 get_num_occupied() const { return num_occupied; };
+  U32 get_num_tiles() const;
+  U32 count_occupied() const;
   BOOL write_asc_grid(const CHAR* file_name) const;
 
   // read from file or write to file
@@ -208,22 +318,11 @@ public:
   I32 min_x, min_y, max_x, max_y;
 private:
   BOOL add_internal(I32 pos_x, I32 pos_y);
+  const U64* get_tile(I32 pos_x, I32 pos_y) const;
   F32 grid_spacing;
-  I32 anker;
-  I32* minus_ankers;
-  U32 minus_minus_size;
-  U32** minus_minus;
-  U16* minus_minus_sizes;
-  U32 minus_plus_size;
-  U32** minus_plus;
-  U16* minus_plus_sizes;
-  I32* plus_ankers;
-  U32 plus_minus_size;
-  U32** plus_minus;
-  U16* plus_minus_sizes;
-  U32 plus_plus_size;
-  U32** plus_plus;
-  U16* plus_plus_sizes;
+  LAStileHash* tiles;
+  I64 cache_keys[64];
+  U64* cache_tiles[64];
   U32 num_occupied;
 };
 
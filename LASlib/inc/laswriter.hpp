@@ -25,6 +25,8 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- adaptive chunking with '-chunk_gps_gap', '-chunk_cell' and '-chunk_bytes'
+    18 October 2026 -- get_decompress_selective() for what the output needs
     14 June 2023 -- add tell() to the writers to be able to write copc files
     7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
     17 August 2017 -- switch on "native LAS 1.4 extension". turns off with '-no_native'.
@@ -85,6 +87,11 @@ public:
   BOOL set_format(const CHAR* format);
   void set_force(BOOL force);
   void set_chunk_size(U32 chunk_size);
+  void set_statistics_sidecar(BOOL statistics_sidecar);
+  void set_chunk_summaries(BOOL chunk_summaries);
+  void set_chunk_gps_time_gap(F64 chunk_gps_time_gap);
+  void set_chunk_cell_size(F64 chunk_cell_size);
+  void set_chunk_target_bytes(U32 chunk_target_bytes);
   void make_numbered_file_name(const CHAR* file_name, I32 digits);
   void make_file_name(const CHAR* file_name, I32 file_number=-1);
   const CHAR* get_directory() const;
@@ -94,8 +101,13 @@ public:
   CHAR* get_file_name_base() const;
   U32 get_cut() const;
   BOOL get_native() const;
+  U32 get_chunk_size() const { return chunk_size; };
+  BOOL get_statistics_sidecar() const { return statistics_sidecar; };
+  BOOL get_chunk_summaries() const { return chunk_summaries; };
+  BOOL get_adaptive_chunking() const { return (chunk_gps_time_gap > 0.0) || (chunk_cell_size > 0.0) || chunk_target_bytes; };
   BOOL format_was_specified() const;
   I32 get_format() const;
+  U32 get_decompress_selective() const;
   const CHAR* get_format_name() const;
   void set_parse_string(const CHAR* parse_string);
   inline const CHAR* get_parse_string() const { return parse_string; };
@@ -129,6 +141,11 @@ private:
   BOOL force;
   BOOL native;
   U32 chunk_size;
+  BOOL statistics_sidecar;
+  BOOL chunk_summaries;
+  F64 chunk_gps_time_gap;
+  F64 chunk_cell_size;
+  U32 chunk_target_bytes;
   BOOL use_stdout;
   BOOL use_nil;
 };
@@ -27,6 +27,12 @@
     29 March 2017 -- read and write support "native LAS 1.4 extension" for LASzip
     23 October 2016 -- support writing Extended Variable Length Records (ELVRs)
     29 April 2016 -- added WARNINGs when rescale / reoffset overflows integers
+    18 October 2026 -- cell borders only cut chunks whose points are spatially coherent
+    18 October 2026 -- copies compressed chunks or their layers from another LAZ file
+    18 October 2026 -- adaptive chunking at GPS time gaps, cell borders or a byte size
+    18 October 2026 -- open to a write callback (e.g. a memory buffer of a server)
+    18 October 2026 -- optionally writes per-chunk summaries as an EVLR on close()
+    18 October 2026 -- optionally writes a LASstatistics sidecar on close()
     13 October 2014 -- changed default IO buffer size with setvbuf() to 262144
     5 November 2011 -- changed default IO buffer size with setvbuf() to 65536
     8 May 2011 -- added an option for variable chunking via chunk()
@@ -42,6 +48,7 @@
 #define LAS_WRITER_LAS_HPP
 
 #include "laswriter.hpp"
+#include "bytestreamout_callback.hpp"
 
 #include <stdio.h>
 
@@ -54,6 +61,7 @@
 
 class ByteStreamOut;
 class LASwritePoint;
+class LASstatistics;
 
 class LASLIB_DLL LASwriterLAS : public LASwriter
 {
@@ -61,16 +69,29 @@ public:
 
   BOOL refile(FILE* file);
   void set_delete_stream(BOOL delete_stream=TRUE) { this->delete_stream = delete_stream; };
+  void set_statistics_sidecar(BOOL statistics_sidecar=TRUE) { this->statistics_sidecar = statistics_sidecar; };
+  void set_chunk_summaries(BOOL chunk_summaries=TRUE) { this->chunk_summaries = chunk_summaries; };
+  // new LAS 1.4 points only: instead of every 'chunk_size' points a new chunk starts when the GPS
+  // time jumps by more than 'gps_time_gap', when the points leave the 'cell_size' grid cell where
+  // the chunk began or when it has compressed to 'target_bytes'. 'chunk_size' becomes the maximum
+  void set_adaptive_chunking(F64 gps_time_gap, F64 cell_size, U32 target_bytes) { chunk_gps_time_gap = gps_time_gap; chunk_cell_size = cell_size; chunk_target_bytes = target_bytes; };
 
   BOOL open(const LASheader* header, U32 compressor=LASZIP_COMPRESSOR_NONE, I32 requested_version=0, I32 chunk_size=50000);
   BOOL open(const char* file_name, const LASheader* header, U32 compressor=LASZIP_COMPRESSOR_NONE, I32 requested_version=0, I32 chunk_size=50000, I32 io_buffer_size=LAS_TOOLS_IO_OBUFFER_SIZE);
   BOOL open(FILE* file, const LASheader* header, U32 compressor=LASZIP_COMPRESSOR_NONE, I32 requested_version=0, I32 chunk_size=50000);
   BOOL open(std::ostream& ostream, const LASheader* header, U32 compressor=LASZIP_COMPRESSOR_NONE, I32 requested_version=0, I32 chunk_size=50000);
+  BOOL open(ByteStreamOutWriteCallback callback, void* user_data, const LASheader* header, U32 compressor=LASZIP_COMPRESSOR_NONE, I32 requested_version=0, I32 chunk_size=50000);
   BOOL open(ByteStreamOut* stream, const LASheader* header, U32 compressor=LASZIP_COMPRESSOR_NONE, I32 requested_version=0, I32 chunk_size=50000);
 
   BOOL write_point(const LASpoint* point);
   BOOL chunk();
 
+  // entire compressed chunks (or all but the 'compress_selective' layers of the next one)
+  // copied from a LAZ file with the same point format and LASzip items. see LASwritePoint
+  BOOL can_copy_chunks(const LASzip* laszip) const;
+  BOOL write_chunk(const U8* bytes, U32 num_bytes, U32 num_points);
+  BOOL copy_layers(const U8* bytes, U32 num_bytes, U32 compress_selective);
+
   BOOL update_header(const LASheader* header, BOOL use_inventory=FALSE, BOOL update_extra_bytes=FALSE);
   I64 close(BOOL update_npoints=TRUE);
   I64 tell();
@@ -90,6 +111,23 @@ private:
   I64 start_of_first_extended_variable_length_record;
   U32 number_of_extended_variable_length_records;
   const LASevlr* evlrs;
+  // for the optional statistics sidecar of files opened by name
+  BOOL statistics_sidecar;
+  CHAR* statistics_file_name;
+  LASstatistics* statistics;
+  // for the optional per-chunk summaries EVLR used for filter pushdown
+  BOOL chunk_summaries;
+  BOOL write_chunk_summaries();
+  // for adaptive chunking (active when 'chunk_max_points' is not zero)
+  F64 chunk_gps_time_gap;
+  F64 chunk_cell_size;
+  U32 chunk_target_bytes;
+  U32 chunk_max_points;
+  F64 chunk_last_gps_time;
+  I64 chunk_cell_x;
+  I64 chunk_cell_y;
+  U32 chunk_cell_strays;
+  BOOL starts_new_chunk(const LASpoint* point);
 };
 
 #endif
@@ -24,6 +24,7 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- report the point layers a parse string needs
      7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
     10 April 2011 -- created after a sunny weekend of biking to/from Buergel
 
@@ -49,6 +50,9 @@ public:
   BOOL open(const CHAR* file_name, const LASheader* header, const CHAR* parse_string=0, const CHAR* separator=0);
   BOOL open(FILE* file, const LASheader* header, const CHAR* parse_string=0, const CHAR* separator=0);
 
+  // the LAS 1.4 layers that must be decompressed to write this parse string
+  static U32 get_decompress_selective(const CHAR* parse_string, BOOL pts_or_ptx=FALSE);
+
   BOOL write_point(const LASpoint* point);
   BOOL chunk() { return FALSE; };
 
@@ -30,17 +30,21 @@
 */
 #include "lasfilter.hpp"
 #include "lasmessage.hpp"
+#include "lasutility.hpp"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 #include <iostream>
 
-#include <map>
-#include <set>
+#include <string.h>
+#include <chrono>
 
-typedef std::multimap<I64, F64> my_I64_F64_map;
-typedef std::set<I64> my_I64_set;
+// the number of points after which the criteria are reordered
+#define LAS_FILTER_LEARN_POINTS 10000
+// the number of learning points kept to time the criteria in batches
+#define LAS_FILTER_SAMPLE_POINTS 256
+#define LAS_FILTER_SAMPLE_ROUNDS 8
 
 // convert the first number in a input string to the out float
 // if the string ends with [d/D] or [p/P] the out value will be 
@@ -84,6 +88,20 @@ BOOL rangeValidate(const CHAR* argv, T* is1, T* is2, T min, T max)
   return TRUE;
 }
 
+// world bounds of the points summarized for one chunk. the integer bounds
+// are in the quantization of the file, which is also the one of the point.
+
+static inline F64 chunk_min_x(const LASchunkSummary* chunk, const LASpoint* point) { F64 a = point->quantizer->get_x(chunk->min_X); F64 b = point->quantizer->get_x(chunk->max_X); return (a < b ? a : b); }
+static inline F64 chunk_max_x(const LASchunkSummary* chunk, const LASpoint* point) { F64 a = point->quantizer->get_x(chunk->min_X); F64 b = point->quantizer->get_x(chunk->max_X); return (a < b ? b : a); }
+static inline F64 chunk_min_y(const LASchunkSummary* chunk, const LASpoint* point) { F64 a = point->quantizer->get_y(chunk->min_Y); F64 b = point->quantizer->get_y(chunk->max_Y); return (a < b ? a : b); }
+static inline F64 chunk_max_y(const LASchunkSummary* chunk, const LASpoint* point) { F64 a = point->quantizer->get_y(chunk->min_Y); F64 b = point->quantizer->get_y(chunk->max_Y); return (a < b ? b : a); }
+static inline F64 chunk_min_z(const LASchunkSummary* chunk, const LASpoint* point) { F64 a = point->quantizer->get_z(chunk->min_Z); F64 b = point->quantizer->get_z(chunk->max_Z); return (a < b ? a : b); }
+static inline F64 chunk_max_z(const LASchunkSummary* chunk, const LASpoint* point) { F64 a = point->quantizer->get_z(chunk->min_Z); F64 b = point->quantizer->get_z(chunk->max_Z); return (a < b ? b : a); }
+
+// the summarized Z is useless when the z coordinate is taken from an attribute
+
+static inline BOOL chunk_has_z(const LASpoint* point) { return (point->quantizer->z_from_attrib < 0); }
+
 class LAScriterionAnd : public LAScriterion
 {
 public:
@@ -91,6 +109,8 @@ public:
   inline I32 get_command(CHAR* string) const { int n = 0; n += one->get_command(&string[n]); n += two->get_command(&string[n]); n += sprintf(&string[n], "-%s ", name()); return n; };
   inline U32 get_decompress_selective() const { return (one->get_decompress_selective() | two->get_decompress_selective()); };
   inline BOOL filter(const LASpoint* point) { return one->filter(point) && two->filter(point); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return one->reject_chunk(chunk, point) && two->reject_chunk(chunk, point); };
+  inline BOOL is_stateful() const { return one->is_stateful() || two->is_stateful(); };
   LAScriterionAnd(LAScriterion* one, LAScriterion* two) { this->one = one; this->two = two; };
 private:
   LAScriterion* one;
@@ -104,6 +124,8 @@ public:
   inline I32 get_command(CHAR* string) const { int n = 0; n += one->get_command(&string[n]); n += two->get_command(&string[n]); n += sprintf(&string[n], "-%s ", name()); return n; };
   inline U32 get_decompress_selective() const { return (one->get_decompress_selective() | two->get_decompress_selective()); };
   inline BOOL filter(const LASpoint* point) { return one->filter(point) || two->filter(point); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return one->reject_chunk(chunk, point) || two->reject_chunk(chunk, point); };
+  inline BOOL is_stateful() const { return one->is_stateful() || two->is_stateful(); };
   LAScriterionOr(LAScriterion* one, LAScriterion* two) { this->one = one; this->two = two; };
 private:
   LAScriterion* one;
@@ -116,6 +138,7 @@ public:
   inline const CHAR* name() const { return "keep_tile"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %g %g %g ", name(), ll_x, ll_y, tile_size); };
   inline BOOL filter(const LASpoint* point) { return (!point->inside_tile(ll_x, ll_y, ur_x, ur_y)); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk_max_x(chunk, point) < ll_x) || (chunk_min_x(chunk, point) >= ur_x) || (chunk_max_y(chunk, point) < ll_y) || (chunk_min_y(chunk, point) >= ur_y); };
   LAScriterionKeepTile(F32 ll_x, F32 ll_y, F32 tile_size) { this->ll_x = ll_x; this->ll_y = ll_y; this->ur_x = ll_x + tile_size; this->ur_y = ll_y + tile_size; this->tile_size = tile_size; };
 private:
   F32 ll_x, ll_y, ur_x, ur_y, tile_size;
@@ -127,6 +150,16 @@ public:
   inline const CHAR* name() const { return "keep_circle"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf %lf ", name(), center_x, center_y, radius); };
   inline BOOL filter(const LASpoint* point) { return (!point->inside_circle(center_x, center_y, radius_squared)); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const
+  {
+    F64 nearest_x = chunk_min_x(chunk, point);
+    if (center_x > nearest_x) { nearest_x = chunk_max_x(chunk, point); if (center_x < nearest_x) nearest_x = center_x; }
+    F64 nearest_y = chunk_min_y(chunk, point);
+    if (center_y > nearest_y) { nearest_y = chunk_max_y(chunk, point); if (center_y < nearest_y) nearest_y = center_y; }
+    F64 dx = center_x - nearest_x;
+    F64 dy = center_y - nearest_y;
+    return ((dx * dx + dy * dy) >= radius_squared);
+  };
   LAScriterionKeepCircle(F64 x, F64 y, F64 radius) { this->center_x = x; this->center_y = y; this->radius = radius; this->radius_squared = radius * radius; };
 private:
   F64 center_x, center_y, radius, radius_squared;
@@ -139,6 +172,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf %lf %lf %lf %lf ", name(), min_x, min_y, min_z, max_x, max_y, max_z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_CHANNEL_RETURNS_XY | LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (!point->inside_box(min_x, min_y, min_z, max_x, max_y, max_z)); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk_max_x(chunk, point) < min_x) || (chunk_min_x(chunk, point) >= max_x) || (chunk_max_y(chunk, point) < min_y) || (chunk_min_y(chunk, point) >= max_y) || (chunk_has_z(point) && ((chunk_max_z(chunk, point) < min_z) || (chunk_min_z(chunk, point) >= max_z))); };
   LAScriterionKeepxyz(F64 min_x, F64 min_y, F64 min_z, F64 max_x, F64 max_y, F64 max_z) { this->min_x = min_x; this->min_y = min_y; this->min_z = min_z; this->max_x = max_x; this->max_y = max_y; this->max_z = max_z; };
 private:
   F64 min_x, min_y, min_z, max_x, max_y, max_z;
@@ -227,6 +261,7 @@ public:
   inline const CHAR* name() const { return "keep_xy"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf %lf %lf ", name(), below_x, below_y, above_x, above_y); };
   inline BOOL filter(const LASpoint* point) { return (!point->inside_rectangle(below_x, below_y, above_x, above_y)); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk_max_x(chunk, point) < below_x) || (chunk_min_x(chunk, point) >= above_x) || (chunk_max_y(chunk, point) < below_y) || (chunk_min_y(chunk, point) >= above_y); };
   LAScriterionKeepxy(F64 below_x, F64 below_y, F64 above_x, F64 above_y) { this->below_x = below_x; this->below_y = below_y; this->above_x = above_x; this->above_y = above_y; };
 private:
   F64 below_x, below_y, above_x, above_y;
@@ -249,6 +284,7 @@ public:
   inline const CHAR* name() const { return "keep_x"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_x, above_x); };
   inline BOOL filter(const LASpoint* point) { F64 x = point->get_x(); return (x < below_x) || (x >= above_x); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk_max_x(chunk, point) < below_x) || (chunk_min_x(chunk, point) >= above_x); };
   LAScriterionKeepx(F64 below_x, F64 above_x) { this->below_x = below_x; this->above_x = above_x; };
 private:
   F64 below_x, above_x;
@@ -271,6 +307,7 @@ public:
   inline const CHAR* name() const { return "keep_y"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_y, above_y); };
   inline BOOL filter(const LASpoint* point) { F64 y = point->get_y(); return (y < below_y) || (y >= above_y); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk_max_y(chunk, point) < below_y) || (chunk_min_y(chunk, point) >= above_y); };
   LAScriterionKeepy(F64 below_y, F64 above_y) { this->below_y = below_y; this->above_y = above_y; };
 private:
   F64 below_y, above_y;
@@ -294,6 +331,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_z, above_z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { F64 z = point->get_z(); return (z < below_z) || (z >= above_z); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return chunk_has_z(point) && ((chunk_max_z(chunk, point) < below_z) || (chunk_min_z(chunk, point) >= above_z)); };
   LAScriterionKeepz(F64 below_z, F64 above_z) { this->below_z = below_z; this->above_z = above_z; };
 private:
   F64 below_z, above_z;
@@ -317,6 +355,7 @@ public:
   inline const CHAR* name() const { return "drop_x_below"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), below_x); };
   inline BOOL filter(const LASpoint* point) { return (point->get_x() < below_x); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk_max_x(chunk, point) < below_x); };
   LAScriterionDropxBelow(F64 below_x) { this->below_x = below_x; };
 private:
   F64 below_x;
@@ -328,6 +367,7 @@ public:
   inline const CHAR* name() const { return "drop_x_above"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), above_x); };
   inline BOOL filter(const LASpoint* point) { return (point->get_x() >= above_x); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk_min_x(chunk, point) >= above_x); };
   LAScriterionDropxAbove(F64 above_x) { this->above_x = above_x; };
 private:
   F64 above_x;
@@ -339,6 +379,7 @@ public:
   inline const CHAR* name() const { return "drop_y_below"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), below_y); };
   inline BOOL filter(const LASpoint* point) { return (point->get_y() < below_y); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk_max_y(chunk, point) < below_y); };
   LAScriterionDropyBelow(F64 below_y) { this->below_y = below_y; };
 private:
   F64 below_y;
@@ -350,6 +391,7 @@ public:
   inline const CHAR* name() const { return "drop_y_above"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), above_y); };
   inline BOOL filter(const LASpoint* point) { return (point->get_y() >= above_y); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk_min_y(chunk, point) >= above_y); };
   LAScriterionDropyAbove(F64 above_y) { this->above_y = above_y; };
 private:
   F64 above_y;
@@ -362,6 +404,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), below_z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (point->get_z() < below_z); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return chunk_has_z(point) && (chunk_max_z(chunk, point) < below_z); };
   LAScriterionDropzBelow(F64 below_z) { this->below_z = below_z; };
 private:
   F64 below_z;
@@ -374,6 +417,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), above_z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (point->get_z() >= above_z); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return chunk_has_z(point) && (chunk_min_z(chunk, point) >= above_z); };
   LAScriterionDropzAbove(F64 above_z) { this->above_z = above_z; };
 private:
   F64 above_z;
@@ -385,6 +429,7 @@ public:
   inline const CHAR* name() const { return "keep_XY"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d %d %d ", name(), below_X, below_Y, above_X, above_Y); };
   inline BOOL filter(const LASpoint* point) { return (point->get_X() < below_X) || (point->get_Y() < below_Y) || (point->get_X() >= above_X) || (point->get_Y() >= above_Y); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk->max_X < below_X) || (chunk->max_Y < below_Y) || (chunk->min_X >= above_X) || (chunk->min_Y >= above_Y); };
   LAScriterionKeepXY(I32 below_X, I32 below_Y, I32 above_X, I32 above_Y) { this->below_X = below_X; this->below_Y = below_Y; this->above_X = above_X; this->above_Y = above_Y; };
 private:
   I32 below_X, below_Y, above_X, above_Y;
@@ -396,6 +441,7 @@ public:
   inline const CHAR* name() const { return "keep_X"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_X, above_X); };
   inline BOOL filter(const LASpoint* point) { return (point->get_X() < below_X) || (above_X <= point->get_X()); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk->max_X < below_X) || (above_X <= chunk->min_X); };
   LAScriterionKeepX(I32 below_X, I32 above_X) { this->below_X = below_X; this->above_X = above_X; };
 private:
   I32 below_X, above_X;
@@ -419,6 +465,7 @@ public:
   inline const CHAR* name() const { return "keep_Y"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_Y, above_Y); };
   inline BOOL filter(const LASpoint* point) { return (point->get_Y() < below_Y) || (above_Y <= point->get_Y()); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk->max_Y < below_Y) || (above_Y <= chunk->min_Y); };
   LAScriterionKeepY(I32 below_Y, I32 above_Y) { this->below_Y = below_Y; this->above_Y = above_Y; };
 private:
   I32 below_Y, above_Y;
@@ -443,6 +490,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_Z, above_Z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (point->get_Z() < below_Z) || (above_Z <= point->get_Z()); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return chunk_has_z(point) && ((chunk->max_Z < below_Z) || (above_Z <= chunk->min_Z)); };
   LAScriterionKeepZ(I32 below_Z, I32 above_Z) { this->below_Z = below_Z; this->above_Z = above_Z; };
 private:
   I32 below_Z, above_Z;
@@ -467,6 +515,7 @@ public:
   inline const CHAR* name() const { return "drop_X_below"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_X); };
   inline BOOL filter(const LASpoint* point) { return (point->get_X() < below_X); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk->max_X < below_X); };
   LAScriterionDropXBelow(I32 below_X) { this->below_X = below_X; };
 private:
   I32 below_X;
@@ -478,6 +527,7 @@ public:
   inline const CHAR* name() const { return "drop_X_above"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_X); };
   inline BOOL filter(const LASpoint* point) { return (point->get_X() >= above_X); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk->min_X >= above_X); };
   LAScriterionDropXAbove(I32 above_X) { this->above_X = above_X; };
 private:
   I32 above_X;
@@ -489,6 +539,7 @@ public:
   inline const CHAR* name() const { return "drop_Y_below"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_Y); };
   inline BOOL filter(const LASpoint* point) { return (point->get_Y() < below_Y); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk->max_Y < below_Y); };
   LAScriterionDropYBelow(I32 below_Y) { this->below_Y = below_Y; };
 private:
   I32 below_Y;
@@ -500,6 +551,7 @@ public:
   inline const CHAR* name() const { return "drop_Y_above"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_Y); };
   inline BOOL filter(const LASpoint* point) { return (point->get_Y() >= above_Y); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk->min_Y >= above_Y); };
   LAScriterionDropYAbove(I32 above_Y) { this->above_Y = above_Y; };
 private:
   I32 above_Y;
@@ -512,6 +564,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_Z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (point->get_Z() < below_Z); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return chunk_has_z(point) && (chunk->max_Z < below_Z); };
   LAScriterionDropZBelow(I32 below_Z) { this->below_Z = below_Z; };
 private:
   I32 below_Z;
@@ -524,6 +577,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_Z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (point->get_Z() >= above_Z); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return chunk_has_z(point) && (chunk->min_Z >= above_Z); };
   LAScriterionDropZAbove(I32 above_Z) { this->above_Z = above_Z; };
 private:
   I32 above_Z;
@@ -637,6 +691,7 @@ public:
     return n;
   };
   inline BOOL filter(const LASpoint* point) { return ((1 << point->get_return_number()) & drop_return_mask); };
+  inline BOOL get_fuse_mask(LASfuseMask* mask) const { mask->drop_return_mask |= drop_return_mask; return TRUE; };
   LAScriterionKeepReturns(U16 keep_return_mask) { drop_return_mask = ~keep_return_mask; };
   inline U16 get_keep_return_mask() const { return ~drop_return_mask; };
 private:
@@ -654,6 +709,7 @@ public:
     return n;
   };
   inline BOOL filter(const LASpoint* point) { return ((1 << point->get_return_number()) & drop_return_mask); };
+  inline BOOL get_fuse_mask(LASfuseMask* mask) const { mask->drop_return_mask |= drop_return_mask; return TRUE; };
   LAScriterionDropReturns(U16 drop_return_mask) { this->drop_return_mask = drop_return_mask; };
   inline U16 get_drop_return_mask() const { return drop_return_mask; };
 private:
@@ -702,6 +758,7 @@ public:
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_FLAGS; };
   inline BOOL filter(const LASpoint* point) { if (scan_direction_flag == point->scan_direction_flag) return TRUE; I32 s = scan_direction_flag; scan_direction_flag = point->scan_direction_flag; return s == -1; };
   void reset() { scan_direction_flag = -1; };
+  inline BOOL is_stateful() const { return TRUE; };
   LAScriterionKeepScanDirectionChange() { reset(); };
 private:
   I32 scan_direction_flag;
@@ -1153,6 +1210,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_intensity, above_intensity); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY; };
   inline BOOL filter(const LASpoint* point) { return (point->get_intensity() < below_intensity) || (point->get_intensity() > above_intensity); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk->max_intensity < below_intensity) || (chunk->min_intensity > above_intensity); };
   LAScriterionKeepIntensity(U16 below_intensity, U16 above_intensity) { this->below_intensity = below_intensity; this->above_intensity = above_intensity; };
 private:
   U16 below_intensity, above_intensity;
@@ -1165,6 +1223,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_intensity); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY; };
   inline BOOL filter(const LASpoint* point) { return (point->get_intensity() >= below_intensity); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk->min_intensity >= below_intensity); };
   LAScriterionKeepIntensityBelow(U16 below_intensity) { this->below_intensity = below_intensity; };
 private:
   U16 below_intensity;
@@ -1177,6 +1236,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_intensity); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY; };
   inline BOOL filter(const LASpoint* point) { return (point->get_intensity() <= above_intensity); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk->max_intensity <= above_intensity); };
   LAScriterionKeepIntensityAbove(U16 above_intensity) { this->above_intensity = above_intensity; };
 private:
   U16 above_intensity;
@@ -1189,6 +1249,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_intensity); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY; };
   inline BOOL filter(const LASpoint* point) { return (point->get_intensity() < below_intensity); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk->max_intensity < below_intensity); };
   LAScriterionDropIntensityBelow(I32 below_intensity) { this->below_intensity = below_intensity; };
 private:
   I32 below_intensity;
@@ -1201,6 +1262,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_intensity); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY; };
   inline BOOL filter(const LASpoint* point) { return (point->get_intensity() > above_intensity); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (chunk->min_intensity > above_intensity); };
   LAScriterionDropIntensityAbove(I32 above_intensity) { this->above_intensity = above_intensity; };
 private:
   I32 above_intensity;
@@ -1213,6 +1275,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_intensity, above_intensity); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY; };
   inline BOOL filter(const LASpoint* point) { return (below_intensity <= point->get_intensity()) && (point->get_intensity() <= above_intensity); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (below_intensity <= chunk->min_intensity) && (chunk->max_intensity <= above_intensity); };
   LAScriterionDropIntensityBetween(I32 below_intensity, I32 above_intensity) { this->below_intensity = below_intensity; this->above_intensity = above_intensity; };
 private:
   I32 below_intensity, above_intensity;
@@ -1248,6 +1311,18 @@ public:
       return ((1u << point->classification) & drop_classification_mask);
     }
   };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const
+  {
+    // classifications above 31 are never kept
+    for (U32 c = 0; c < 32; c++) if (chunk->has_classification(c) && !((1u << c) & drop_classification_mask)) return FALSE;
+    return TRUE;
+  };
+  inline BOOL get_fuse_mask(LASfuseMask* mask) const
+  {
+    // a zero legacy but non-zero extended classification is never kept
+    mask->drop_class |= ((U64)drop_classification_mask) | (((U64)1) << 32);
+    return TRUE;
+  };
   LAScriterionKeepClassifications(U32 keep_classification_mask) { drop_classification_mask = ~keep_classification_mask; };
   inline U32 get_keep_classification_mask() const { return ~drop_classification_mask; };
 private:
@@ -1283,6 +1358,13 @@ public:
       return ((1u << point->classification) & drop_classification_mask);
     }
   };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const
+  {
+    // classifications above 31 are never dropped
+    for (U32 c = 0; c < 256; c++) if (chunk->has_classification(c) && ((c > 31) || !((1u << c) & drop_classification_mask))) return FALSE;
+    return TRUE;
+  };
+  inline BOOL get_fuse_mask(LASfuseMask* mask) const { mask->drop_class |= drop_classification_mask; return TRUE; };
   LAScriterionDropClassifications(U32 drop_classification_mask) { this->drop_classification_mask = drop_classification_mask; };
   inline U32 get_drop_classification_mask() const { return drop_classification_mask; };
 private:
@@ -1296,6 +1378,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %u %u %u %u %u %u %u %u ", name(), drop_extended_classification_mask[7], drop_extended_classification_mask[6], drop_extended_classification_mask[5], drop_extended_classification_mask[4], drop_extended_classification_mask[3], drop_extended_classification_mask[2], drop_extended_classification_mask[1], drop_extended_classification_mask[0]); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION; };
   inline BOOL filter(const LASpoint* point) { return ((1 << (point->extended_classification - (32 * (point->extended_classification / 32)))) & drop_extended_classification_mask[point->extended_classification / 32]); };
+  inline BOOL get_fuse_mask(LASfuseMask* mask) const
+  {
+    for (I32 i = 0; i < 8; i++) mask->drop_extended_class[i] |= drop_extended_classification_mask[i];
+    return TRUE;
+  };
   LAScriterionDropExtendedClassifications(U32 drop_extended_classification_mask[8]) { for (I32 i = 0; i < 8; i++) this->drop_extended_classification_mask[i] = drop_extended_classification_mask[i]; };
 private:
   U32 drop_extended_classification_mask[8];
@@ -1308,6 +1395,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_FLAGS; };
   inline BOOL filter(const LASpoint* point) { return (point->get_synthetic_flag() == 1); };
+  inline BOOL get_fuse_mask(LASfuseMask* mask) const { mask->drop_flag(1, TRUE); return TRUE; };
 };
 
 class LAScriterionKeepSynthetic : public LAScriterion
@@ -1317,6 +1405,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_FLAGS; };
   inline BOOL filter(const LASpoint* point) { return (point->get_synthetic_flag() == 0); };
+  inline BOOL get_fuse_mask(LASfuseMask* mask) const { mask->drop_flag(1, FALSE); return TRUE; };
 };
 
 class LAScriterionDropKeypoint : public LAScriterion
@@ -1326,6 +1415,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_FLAGS; };
   inline BOOL filter(const LASpoint* point) { return (point->get_keypoint_flag() == 1); };
+  inline BOOL get_fuse_mask(LASfuseMask* mask) const { mask->drop_flag(2, TRUE); return TRUE; };
 };
 
 class LAScriterionKeepKeypoint : public LAScriterion
@@ -1335,6 +1425,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_FLAGS; };
   inline BOOL filter(const LASpoint* point) { return (point->get_keypoint_flag() == 0); };
+  inline BOOL get_fuse_mask(LASfuseMask* mask) const { mask->drop_flag(2, FALSE); return TRUE; };
 };
 
 class LAScriterionDropWithheld : public LAScriterion
@@ -1344,6 +1435,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_FLAGS; };
   inline BOOL filter(const LASpoint* point) { return (point->get_withheld_flag() == 1); };
+  inline BOOL get_fuse_mask(LASfuseMask* mask) const { mask->drop_flag(4, TRUE); return TRUE; };
 };
 
 class LAScriterionKeepWithheld : public LAScriterion
@@ -1353,6 +1445,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_FLAGS; };
   inline BOOL filter(const LASpoint* point) { return (point->get_withheld_flag() == 0); };
+  inline BOOL get_fuse_mask(LASfuseMask* mask) const { mask->drop_flag(4, FALSE); return TRUE; };
 };
 
 class LAScriterionDropOverlap : public LAScriterion
@@ -1362,6 +1455,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_FLAGS; };
   inline BOOL filter(const LASpoint* point) { return (point->get_extended_overlap_flag() == 1); };
+  inline BOOL get_fuse_mask(LASfuseMask* mask) const { mask->drop_flag(8, TRUE); return TRUE; };
 };
 
 class LAScriterionKeepOverlap : public LAScriterion
@@ -1371,6 +1465,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_FLAGS; };
   inline BOOL filter(const LASpoint* point) { return (point->get_extended_overlap_flag() == 0); };
+  inline BOOL get_fuse_mask(LASfuseMask* mask) const { mask->drop_flag(8, FALSE); return TRUE; };
 };
 
 class LAScriterionKeepUserData : public LAScriterion
@@ -1548,6 +1643,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_gpstime, above_gpstime); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME; };
   inline BOOL filter(const LASpoint* point) { return (point->have_gps_time && ((point->gps_time < below_gpstime) || (point->gps_time > above_gpstime))); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (point->have_gps_time && ((chunk->max_gps_time < below_gpstime) || (chunk->min_gps_time > above_gpstime))); };
   LAScriterionKeepGpsTime(F64 below_gpstime, F64 above_gpstime) { this->below_gpstime = below_gpstime; this->above_gpstime = above_gpstime; };
 private:
   F64 below_gpstime, above_gpstime;
@@ -1560,6 +1656,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), below_gpstime); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME; };
   inline BOOL filter(const LASpoint* point) { return (point->have_gps_time && (point->gps_time < below_gpstime)); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (point->have_gps_time && (chunk->max_gps_time < below_gpstime)); };
   LAScriterionDropGpsTimeBelow(F64 below_gpstime) { this->below_gpstime = below_gpstime; };
 private:
   F64 below_gpstime;
@@ -1572,6 +1669,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), above_gpstime); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME; };
   inline BOOL filter(const LASpoint* point) { return (point->have_gps_time && (point->gps_time > above_gpstime)); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (point->have_gps_time && (chunk->min_gps_time > above_gpstime)); };
   LAScriterionDropGpsTimeAbove(F64 above_gpstime) { this->above_gpstime = above_gpstime; };
 private:
   F64 above_gpstime;
@@ -1584,6 +1682,7 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_gpstime, above_gpstime); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME; };
   inline BOOL filter(const LASpoint* point) { return (point->have_gps_time && ((below_gpstime <= point->gps_time) && (point->gps_time <= above_gpstime))); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const { return (point->have_gps_time && ((below_gpstime <= chunk->min_gps_time) && (chunk->max_gps_time <= above_gpstime))); };
   LAScriterionDropGpsTimeBetween(F64 below_gpstime, F64 above_gpstime) { this->below_gpstime = below_gpstime; this->above_gpstime = above_gpstime; };
 private:
   F64 below_gpstime, above_gpstime;
@@ -1699,6 +1798,7 @@ public:
   inline const CHAR* name() const { return "keep_every_nth"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %u ", name(), every); };
   inline BOOL filter(const LASpoint* point) { if (counter == every) { counter = 1; return FALSE; } else { counter++; return TRUE; } };
+  inline BOOL is_stateful() const { return TRUE; };
   LAScriterionKeepEveryNth(U32 every) { this->every = every; counter = 1; };
 private:
   U32 counter;
@@ -1711,6 +1811,7 @@ public:
   inline const CHAR* name() const { return "drop_every_nth"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %u ", name(), every); };
   inline BOOL filter(const LASpoint* point) { if (counter == every) { counter = 1; return TRUE; } else { counter++; return FALSE; } };
+  inline BOOL is_stateful() const { return TRUE; };
   LAScriterionDropEveryNth(U32 every) { this->every = every; counter = 1; };
 private:
   U32 counter;
@@ -1729,6 +1830,7 @@ public:
     return ((F32)seed / (F32)RAND_MAX) > fraction;
   };
   void reset() { seed = requested_seed; };
+  inline BOOL is_stateful() const { return TRUE; };
   LAScriterionKeepRandomFraction(F32 fraction) { requested_seed = seed = 0; this->fraction = fraction; };
   LAScriterionKeepRandomFraction(U32 seed, F32 fraction) { requested_seed = this->seed = seed; this->fraction = fraction; };
 private:
@@ -1737,223 +1839,76 @@ private:
   F32 fraction;
 };
 
+// the occupied cells live in the sparse 64 x 64 tiles of a LASoccupancyGrid
+// so that memory grows with the covered area and not with its bounding box
+
 class LAScriterionThinWithGrid : public LAScriterion
 {
 public:
   inline const CHAR* name() const { return "thin_with_grid"; };
-  inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %g ", name(), (grid_spacing > 0 ? grid_spacing : -grid_spacing)); };
+  inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %g ", name(), grid_spacing); };
   inline BOOL filter(const LASpoint* point)
   {
-    if (grid_spacing < 0)
-    {
-      grid_spacing = -grid_spacing;
-      anker = I32_FLOOR(point->get_y() / grid_spacing);
-    }
-    I32 pos_x = I32_FLOOR(point->get_x() / grid_spacing);
-    I32 pos_y = I32_FLOOR(point->get_y() / grid_spacing) - anker;
-    BOOL no_x_anker = FALSE;
-    U32* array_size;
-    I32** ankers;
-    U32*** array;
-    U16** array_sizes;
-    if (pos_y < 0)
-    {
-      pos_y = -pos_y - 1;
-      ankers = &minus_ankers;
-      if ((U32)pos_y < minus_plus_size && minus_plus_sizes[pos_y])
-      {
-        pos_x -= minus_ankers[pos_y];
-        if (pos_x < 0)
-        {
-          pos_x = -pos_x - 1;
-          array_size = &minus_minus_size;
-          array = &minus_minus;
-          array_sizes = &minus_minus_sizes;
-        }
-        else
-        {
-          array_size = &minus_plus_size;
-          array = &minus_plus;
-          array_sizes = &minus_plus_sizes;
-        }
-      }
-      else
-      {
-        no_x_anker = TRUE;
-        array_size = &minus_plus_size;
-        array = &minus_plus;
-        array_sizes = &minus_plus_sizes;
-      }
-    }
-    else
-    {
-      ankers = &plus_ankers;
-      if ((U32)pos_y < plus_plus_size && plus_plus_sizes[pos_y])
-      {
-        pos_x -= plus_ankers[pos_y];
-        if (pos_x < 0)
-        {
-          pos_x = -pos_x - 1;
-          array_size = &plus_minus_size;
-          array = &plus_minus;
-          array_sizes = &plus_minus_sizes;
-        }
-        else
-        {
-          array_size = &plus_plus_size;
-          array = &plus_plus;
-          array_sizes = &plus_plus_sizes;
-        }
-      }
-      else
-      {
-        no_x_anker = TRUE;
-        array_size = &plus_plus_size;
-        array = &plus_plus;
-        array_sizes = &plus_plus_sizes;
-      }
-    }
-    // maybe grow banded grid in y direction
-    if ((U32)pos_y >= *array_size)
-    {
-      U32 array_size_new = ((pos_y / 1024) + 1) * 1024;
-      if (*array_size)
-      {
-        if (array == &minus_plus || array == &plus_plus) *ankers = (I32*)realloc_las(*ankers, array_size_new * sizeof(I32));
-        *array = (U32**)realloc_las(*array, array_size_new * sizeof(U32*));
-        *array_sizes = (U16*)realloc_las(*array_sizes, array_size_new * sizeof(U16));
-      }
-      else
-      {
-        if (array == &minus_plus || array == &plus_plus) *ankers = (I32*)malloc(array_size_new * sizeof(I32));
-        *array = (U32**)malloc(array_size_new * sizeof(U32*));
-        *array_sizes = (U16*)malloc(array_size_new * sizeof(U16));
-      }
-      for (U32 i = *array_size; i < array_size_new; i++)
-      {
-        if (array != nullptr && *array != nullptr) (*array)[i] = 0;
-        if (array_sizes != nullptr && *array_sizes != nullptr) (*array_sizes)[i] = 0;
-      }
-      *array_size = array_size_new;
-    }
-    // is this the first x anker for this y pos?
-    if (no_x_anker)
-    {
-      if (ankers != nullptr && *ankers != nullptr) (*ankers)[pos_y] = pos_x;
-      pos_x = 0;
-    }
-    // maybe grow banded grid in x direction
-    U32 pos_x_pos = pos_x / 32;
-    if (array_sizes != nullptr && *array_sizes != nullptr && pos_x_pos >= (*array_sizes)[pos_y])
-    {
-      U32 array_sizes_new = ((pos_x_pos / 256) + 1) * 256;
-      if ((*array_sizes)[pos_y])
-      {
-        (*array)[pos_y] = (U32*)realloc_las((*array)[pos_y], array_sizes_new * sizeof(U32));
-      }
-      else
-      {
-        if (array != nullptr && *array != nullptr) (*array)[pos_y] = (U32*)malloc(array_sizes_new * sizeof(U32));
-      }
-      for (U16 i = (*array_sizes)[pos_y]; i < array_sizes_new; i++)
-      {
-        if (array != nullptr && *array != nullptr && (*array)[pos_y] != nullptr) (*array)[pos_y][i] = 0;
-      }
-      (*array_sizes)[pos_y] = array_sizes_new;
-    }
-    U32 pos_x_bit = 1 << (pos_x % 32);
-    if (array != nullptr && *array != nullptr && (*array)[pos_y] != nullptr) {
-      if ((*array)[pos_y][pos_x_pos] & pos_x_bit) return TRUE;
-      (*array)[pos_y][pos_x_pos] |= pos_x_bit;
-    }
-    return FALSE;
-  }
+    return !grid.add(point);
+  };
   void reset()
   {
-#pragma warning(push)
-#pragma warning(disable : 6001)
-    if (grid_spacing > 0) grid_spacing = -grid_spacing;
-    if (minus_minus_size)
-    {
-      for (U32 i = 0; i < minus_minus_size; i++) if (minus_minus[i]) free(minus_minus[i]);
-      free(minus_minus);
-      minus_minus = 0;
-      free(minus_minus_sizes);
-      minus_minus_sizes = 0;
-      minus_minus_size = 0;
-    }
-    if (minus_plus_size)
-    {
-      free(minus_ankers);
-      minus_ankers = 0;
-      for (U32 i = 0; i < minus_plus_size; i++) if (minus_plus[i]) free(minus_plus[i]);
-      free(minus_plus);
-      minus_plus = 0;
-      free(minus_plus_sizes);
-      minus_plus_sizes = 0;
-      minus_plus_size = 0;
-    }
-    if (plus_minus_size)
-    {
-      for (U32 i = 0; i < plus_minus_size; i++) if (plus_minus[i]) free(plus_minus[i]);
-      free(plus_minus);
-      plus_minus = 0;
-      free(plus_minus_sizes);
-      plus_minus_sizes = 0;
-      plus_minus_size = 0;
-    }
-    if (plus_plus_size)
+    grid.reset();
+  };
+  inline BOOL is_stateful() const { return TRUE; };
+  LAScriterionThinWithGrid(F32 grid_spacing) : grid(grid_spacing)
+  {
+    this->grid_spacing = grid_spacing;
+  };
+private:
+  F32 grid_spacing;
+  LASoccupancyGrid grid;
+};
+
+// GPS time is (nearly) sorted so that consecutive points fall into the same
+// time bins. the bins already used are kept as bits in tiles of 512 bins that
+// are hashed by tile number and the most recent tile is remembered.
+
+#define LAS_TIME_TILE_BITS 9
+#define LAS_TIME_TILE_WORDS ((1 << LAS_TIME_TILE_BITS) / 64)
+
+class LAStimeBins
+{
+public:
+  // TRUE if the bin was not used before
+  inline BOOL add(I64 pos_t)
+  {
+    I64 key = (pos_t >> LAS_TIME_TILE_BITS);
+    if ((last_tile == 0) || (key != last_tile_key))
     {
-      free(plus_ankers);
-      plus_ankers = 0;
-      for (U32 i = 0; i < plus_plus_size; i++) if (plus_plus[i]) free(plus_plus[i]);
-      free(plus_plus);
-      plus_plus = 0;
-      free(plus_plus_sizes);
-      plus_plus_sizes = 0;
-      plus_plus_size = 0;
+      last_tile = tiles.get(key);
+      last_tile_key = key;
     }
-#pragma warning(pop)
+    U32 index = (U32)(pos_t & ((1 << LAS_TIME_TILE_BITS) - 1));
+    U64 bit = ((U64)1) << (index & 63);
+    if (last_tile[index >> 6] & bit) return FALSE;
+    last_tile[index >> 6] |= bit;
+    return TRUE;
   };
-  LAScriterionThinWithGrid(F32 grid_spacing)
+  void reset()
   {
-    this->grid_spacing = -grid_spacing;
-    minus_ankers = 0;
-    minus_minus_size = 0;
-    minus_minus = 0;
-    minus_minus_sizes = 0;
-    minus_plus_size = 0;
-    minus_plus = 0;
-    minus_plus_sizes = 0;
-    plus_ankers = 0;
-    plus_minus_size = 0;
-    plus_minus = 0;
-    plus_minus_sizes = 0;
-    plus_plus_size = 0;
-    plus_plus = 0;
-    plus_plus_sizes = 0;
-    anker = 0;
+    tiles.reset();
+    last_tile_key = 0;
+    last_tile = 0;
   };
-  ~LAScriterionThinWithGrid() { reset(); };
+  LAStimeBins() : tiles(LAS_TIME_TILE_WORDS) { last_tile_key = 0; last_tile = 0; };
 private:
-  F32 grid_spacing;
-  I32 anker;
-  I32* minus_ankers;
-  U32 minus_minus_size;
-  U32** minus_minus;
-  U16* minus_minus_sizes;
-  U32 minus_plus_size;
-  U32** minus_plus;
-  U16* minus_plus_sizes;
-  I32* plus_ankers;
-  U32 plus_minus_size;
-  U32** plus_minus;
-  U16* plus_minus_sizes;
-  U32 plus_plus_size;
-  U32** plus_plus;
-  U16* plus_plus_sizes;
+  LAStileHash tiles;
+  I64 last_tile_key;
+  U64* last_tile;
 };
 
+// the first GPS time of each pulse bin is kept in tiles of 64 bins that hold
+// one word with the bits of the used bins followed by the 64 GPS times
+
+#define LAS_PULSE_TILE_BITS 6
+#define LAS_PULSE_TILE_WORDS (1 + (1 << LAS_PULSE_TILE_BITS))
+
 class LAScriterionThinPulsesWithTime : public LAScriterion
 {
 public:
@@ -1962,34 +1917,45 @@ public:
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME; };
   inline BOOL filter(const LASpoint* point)
   {
-    I64 pos_t = I64_FLOOR(point->get_gps_time() / time_spacing);
-    my_I64_F64_map::iterator map_element = times.find(pos_t);
-    if (map_element == times.end())
+    F64 gps_time = point->get_gps_time();
+    I64 pos_t = I64_FLOOR(gps_time / time_spacing);
+    // the returns of one pulse follow each other
+    if (last_valid && (pos_t == last_pos_t))
     {
-      times.insert(my_I64_F64_map::value_type(pos_t, point->get_gps_time()));
-      return FALSE;
+      return (last_gps_time != gps_time);
     }
-    else if ((*map_element).second == point->get_gps_time())
+    U64* tile = times.get(pos_t >> LAS_PULSE_TILE_BITS);
+    U32 index = (U32)(pos_t & ((1 << LAS_PULSE_TILE_BITS) - 1));
+    U64 bit = ((U64)1) << index;
+    if ((tile[0] & bit) == 0)
     {
-      return FALSE;
-    }
-    else
-    {
-      return TRUE;
+      tile[0] |= bit;
+      memcpy(&tile[1 + index], &gps_time, sizeof(F64));
     }
+    last_valid = TRUE;
+    last_pos_t = pos_t;
+    memcpy(&last_gps_time, &tile[1 + index], sizeof(F64));
+    return (last_gps_time != gps_time);
   }
   void reset()
   {
-    times.clear();
+    times.reset();
+    last_valid = FALSE;
   };
-  LAScriterionThinPulsesWithTime(F64 time_spacing)
+  inline BOOL is_stateful() const { return TRUE; };
+  LAScriterionThinPulsesWithTime(F64 time_spacing) : times(LAS_PULSE_TILE_WORDS)
   {
     this->time_spacing = time_spacing;
+    last_valid = FALSE;
+    last_pos_t = 0;
+    last_gps_time = 0.0;
   };
-  ~LAScriterionThinPulsesWithTime() { reset(); };
 private:
   F64 time_spacing;
-  my_I64_F64_map times;
+  LAStileHash times;
+  BOOL last_valid;
+  I64 last_pos_t;
+  F64 last_gps_time;
 };
 
 class LAScriterionThinPointsWithTime : public LAScriterion
@@ -2000,35 +1966,89 @@ public:
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME; };
   inline BOOL filter(const LASpoint* point)
   {
-    I64 pos_t = I64_FLOOR(point->get_gps_time() / time_spacing);
-    my_I64_set::iterator map_element = times.find(pos_t);
-    if (map_element == times.end())
-    {
-      times.insert(my_I64_set::value_type(pos_t));
-      return FALSE;
-    }
-    else
-    {
-      return TRUE;
-    }
+    return !times.add(I64_FLOOR(point->get_gps_time() / time_spacing));
   }
   void reset()
   {
-    times.clear();
+    times.reset();
   };
+  inline BOOL is_stateful() const { return TRUE; };
   LAScriterionThinPointsWithTime(F64 time_spacing)
   {
     this->time_spacing = time_spacing;
   };
-  ~LAScriterionThinPointsWithTime() { reset(); };
 private:
   F64 time_spacing;
-  my_I64_set times;
+  LAStimeBins times;
+};
+
+// consecutive criteria that can describe themselves with a LASfuseMask are
+// fused into one table lookup per attribute. their own masks are kept to tell
+// which of them rejected a point.
+
+class LAScriterionFusedMask : public LAScriterion
+{
+public:
+  inline const CHAR* name() const { return "fused_mask"; };
+  inline I32 get_command(CHAR* string) const
+  {
+    I32 n = 0;
+    for (U32 i = 0; i < num_fused; i++) n += fused[i]->get_command(&string[n]);
+    return n;
+  };
+  inline U32 get_decompress_selective() const
+  {
+    U32 decompress_selective = LASZIP_DECOMPRESS_SELECTIVE_CHANNEL_RETURNS_XY;
+    for (U32 i = 0; i < num_fused; i++) decompress_selective |= fused[i]->get_decompress_selective();
+    return decompress_selective;
+  };
+  inline BOOL filter(const LASpoint* point) { return mask.drops(point); };
+  inline BOOL reject_chunk(const LASchunkSummary* chunk, const LASpoint* point) const
+  {
+    for (U32 i = 0; i < num_fused; i++) if (fused[i]->reject_chunk(chunk, point)) return TRUE;
+    return FALSE;
+  };
+  // the first of the fused criteria that drops the point
+  U32 rejected_by(const LASpoint* point) const
+  {
+    for (U32 i = 0; i < num_fused; i++) if (masks[i].drops(point)) return i;
+    return 0;
+  };
+  static BOOL can_fuse(const LAScriterion* criterion)
+  {
+    LASfuseMask unused;
+    return criterion->get_fuse_mask(&unused);
+  };
+  BOOL add(LAScriterion* criterion)
+  {
+    if (!criterion->get_fuse_mask(&masks[num_fused])) return FALSE;
+    mask.add(&masks[num_fused]);
+    fused[num_fused++] = criterion;
+    return TRUE;
+  };
+  LAScriterionFusedMask(U32 max_fused)
+  {
+    num_fused = 0;
+    fused = new LAScriterion*[max_fused];
+    masks = new LASfuseMask[max_fused];
+  };
+  // the fused criteria belong to the LASfilter
+  ~LAScriterionFusedMask()
+  {
+    delete [] fused;
+    delete [] masks;
+  };
+private:
+  LASfuseMask mask;
+  U32 num_fused;
+  LAScriterion** fused;
+  LASfuseMask* masks;
 };
 
 void LASfilter::clean()
 {
   U32 i;
+  clean_stages();
   for (i = 0; i < num_criteria; i++)
   {
     delete criteria[i];
@@ -2039,6 +2059,7 @@ void LASfilter::clean()
   num_criteria = 0;
   criteria = 0;
   counters = 0;
+  in_order = FALSE;
 }
 
 void LASfilter::usage() const
@@ -2156,7 +2177,9 @@ void LASfilter::usage() const
     "  -thin_pulses_with_time 0.0001\n" \
     "  -thin_points_with_time 0.000001\n" \
     "Boolean combination of filters.\n" \
-    "  -filter_and");
+    "  -filter_and\n" \
+    "Apply the filters in the given order without measuring them first.\n" \
+    "  -filter_in_order");
 }
 
 BOOL LASfilter::parse(int argc, char* argv[])
@@ -5278,7 +5301,13 @@ BOOL LASfilter::parse(int argc, char* argv[])
     }
     else if (strncmp(argv[i], "-filter_", 8) == 0)
     {
-      if (strcmp(argv[i], "-filter_and") == 0)
+      if (strcmp(argv[i], "-filter_in_order") == 0)
+      {
+        in_order = TRUE;
+        clean_stages();
+        *argv[i] = '\0';
+      }
+      else if (strcmp(argv[i], "-filter_and") == 0)
       {
         if (num_criteria < 2)
         {
@@ -5390,6 +5419,10 @@ I32 LASfilter::unparse(CHAR* string) const
   {
     n += criteria[i]->get_command(&string[n]);
   }
+  if (num_criteria && in_order)
+  {
+    n += sprintf(&string[n], "-filter_in_order ");
+  }
   return n;
 }
 
@@ -5423,20 +5456,235 @@ BOOL LASfilter::filter(const LASpoint* point)
 {
   U32 i;
 
-  for (i = 0; i < num_criteria; i++)
+  if (stages == 0) compile();
+
+  if (learn_count < LAS_FILTER_LEARN_POINTS)
   {
-    if (criteria[i]->filter(point))
+    return filter_and_learn(point);
+  }
+
+  for (i = 0; i < num_stages; i++)
+  {
+    if (stages[i]->filter(point))
     {
-      counters[i]++;
+      counters[rejecting_criterion(i, point)]++;
       return TRUE; // point was filtered
     }
   }
   return FALSE; // point survived
 }
 
+// the rejections of a fused stage are counted for the criterion that failed
+
+U32 LASfilter::rejecting_criterion(U32 stage, const LASpoint* point) const
+{
+  if (stage_sizes[stage] == 1) return stage_criteria[stage];
+  return stage_criteria[stage] + ((const LAScriterionFusedMask*)stages[stage])->rejected_by(point);
+}
+
+// while learning all stateless stages of a run see every point that reaches
+// the run so that their rejection rates can be compared. the first points are
+// also kept as a sample on which the cost of each stage is timed at the end
+
+BOOL LASfilter::filter_and_learn(const LASpoint* point)
+{
+  U32 i, j;
+  BOOL filtered = FALSE;
+  U32 first = 0;
+
+  if (learn_sampled < LAS_FILTER_SAMPLE_POINTS)
+  {
+    if (learn_sample == 0) learn_sample = new LASpoint[LAS_FILTER_SAMPLE_POINTS];
+    if (learn_sample[learn_sampled].init(point->quantizer, point->num_items, point->items, point->attributer))
+    {
+      learn_sample[learn_sampled] = *point;
+      learn_sampled++;
+    }
+  }
+
+  for (i = 0; i < num_stages; i++)
+  {
+    if (stages[i]->is_stateful())
+    {
+      if (stages[i]->filter(point))
+      {
+        filtered = TRUE;
+        first = i;
+        break;
+      }
+      continue;
+    }
+    for (j = i; (j < num_stages) && !stages[j]->is_stateful(); j++)
+    {
+      stage_evaluated[j]++;
+      if (stages[j]->filter(point))
+      {
+        stage_rejected[j]++;
+        if (!filtered)
+        {
+          filtered = TRUE;
+          first = j;
+        }
+      }
+    }
+    if (filtered) break;
+    i = j - 1;
+  }
+  if (filtered) counters[rejecting_criterion(first, point)]++;
+  learn_count++;
+  if (learn_count == LAS_FILTER_LEARN_POINTS) reorder_stages();
+  return filtered;
+}
+
+// within each run of stateless stages the stage with the smallest cost per
+// rejected point goes first. the stateful stages stay where they are so that
+// they see exactly the points they would see in command line order
+
+void LASfilter::reorder_stages()
+{
+  U32 i, j, k;
+  BOOL reordered = FALSE;
+  time_stages();
+  for (i = 0; i < num_stages; i = j + 1)
+  {
+    for (j = i; (j < num_stages) && !stages[j]->is_stateful(); j++);
+    // insertion sort of the run [i, j)
+    for (k = i + 1; k < j; k++)
+    {
+      U32 m = k;
+      while ((m > i) && (stage_rank(m) < stage_rank(m - 1)))
+      {
+        swap_stages(m, m - 1);
+        reordered = TRUE;
+        m--;
+      }
+    }
+  }
+  if (reordered)
+  {
+    CHAR command[1024];
+    LASMessage(LAS_VERBOSE, "filter criteria reordered after %u points:", learn_count);
+    for (i = 0; i < num_stages; i++)
+    {
+      stages[i]->get_command(command);
+      LASMessage(LAS_VERBOSE, "  %s", command);
+    }
+  }
+}
+
+// a single call costs only a few nanoseconds which is less than reading the
+// clock so each stateless stage is timed on the whole sample at once
+
+void LASfilter::time_stages()
+{
+  U32 i, j, k;
+  for (i = 0; i < num_stages; i++)
+  {
+    if (stages[i]->is_stateful() || (learn_sampled == 0)) continue;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (j = 0; j < LAS_FILTER_SAMPLE_ROUNDS; j++)
+    {
+      for (k = 0; k < learn_sampled; k++)
+      {
+        stages[i]->filter(&learn_sample[k]);
+      }
+    }
+    I64 nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    stage_costs[i] = (F64)nanoseconds / (LAS_FILTER_SAMPLE_ROUNDS * learn_sampled);
+  }
+  delete [] learn_sample;
+  learn_sample = 0;
+  learn_sampled = 0;
+}
+
+F64 LASfilter::stage_rank(U32 i) const
+{
+  F64 cost = stage_costs[i];
+  F64 selectivity = (stage_evaluated[i] ? (F64)stage_rejected[i] / stage_evaluated[i] : 0.0);
+  // stages that reject nothing go last
+  if (selectivity == 0.0) return F64_MAX;
+  return cost / selectivity;
+}
+
+void LASfilter::swap_stages(U32 i, U32 j)
+{
+  LAScriterion* stage = stages[i]; stages[i] = stages[j]; stages[j] = stage;
+  U32 u = stage_criteria[i]; stage_criteria[i] = stage_criteria[j]; stage_criteria[j] = u;
+  u = stage_sizes[i]; stage_sizes[i] = stage_sizes[j]; stage_sizes[j] = u;
+  u = stage_evaluated[i]; stage_evaluated[i] = stage_evaluated[j]; stage_evaluated[j] = u;
+  u = stage_rejected[i]; stage_rejected[i] = stage_rejected[j]; stage_rejected[j] = u;
+  F64 f = stage_costs[i]; stage_costs[i] = stage_costs[j]; stage_costs[j] = f;
+}
+
+void LASfilter::report_statistics()
+{
+  U32 i, j;
+  I64 rejected = 0;
+  for (i = 0; i < num_criteria; i++)
+  {
+    rejected += counters[i];
+  }
+  if (rejected == 0) return;
+  if (stages == 0) compile();
+  CHAR command[1024];
+  LASMessage(LAS_VERBOSE, "filter rejected %lld points:", rejected);
+  for (i = 0; i < num_stages; i++)
+  {
+    I64 count = 0;
+    for (j = 0; j < stage_sizes[i]; j++) count += counters[stage_criteria[i] + j];
+    stages[i]->get_command(command);
+    if (stage_costs[i] > 0.0)
+    {
+      LASMessage(LAS_VERBOSE, "  %10lld by %s(rejected %u of %u learning points at %.1f ns each)", count, command, stage_rejected[i], stage_evaluated[i], stage_costs[i]);
+    }
+    else
+    {
+      LASMessage(LAS_VERBOSE, "  %10lld by %s", count, command);
+    }
+    if (stage_sizes[i] > 1)
+    {
+      for (j = 0; j < stage_sizes[i]; j++)
+      {
+        criteria[stage_criteria[i] + j]->get_command(command);
+        LASMessage(LAS_VERBOSE, "    %10lld by %s", counters[stage_criteria[i] + j], command);
+      }
+    }
+  }
+  for (i = 0; i < num_criteria; i++)
+  {
+    counters[i] = 0;
+  }
+}
+
+BOOL LASfilter::reject_chunk(const LASchunkSummary* chunk, const LASpoint* point)
+{
+  U32 i;
+
+  for (i = 0; i < num_criteria; i++)
+  {
+    // the criteria after a stateful one must see all its survivors
+    if (criteria[i]->is_stateful())
+    {
+      return FALSE;
+    }
+    if (criteria[i]->reject_chunk(chunk, point))
+    {
+      counters[i] += chunk->number_of_points;
+      return TRUE; // all points of the chunk are filtered
+    }
+  }
+  return FALSE;
+}
+
 void LASfilter::reset()
 {
   U32 i;
+  if (stages)
+  {
+    report_statistics();
+    // the next file is learned again
+    compile();
+  }
   for (i = 0; i < num_criteria; i++)
   {
     criteria[i]->reset();
@@ -5449,21 +5697,34 @@ LASfilter::LASfilter()
   num_criteria = 0;
   criteria = 0;
   counters = 0;
+  num_stages = 0;
+  stages = 0;
+  stage_criteria = 0;
+  stage_sizes = 0;
+  stage_evaluated = 0;
+  stage_rejected = 0;
+  stage_costs = 0;
+  learn_count = 0;
+  learn_sample = 0;
+  learn_sampled = 0;
+  in_order = FALSE;
 }
 
 LASfilter::~LASfilter()
 {
+  if (stages) report_statistics();
   if (criteria) clean();
 }
 
 void LASfilter::add_criterion(LAScriterion* filter_criterion)
 {
+  clean_stages();
   if (num_criteria == alloc_criteria)
   {
     U32 i;
     alloc_criteria += 16;
     LAScriterion** temp_criteria = new LAScriterion * [alloc_criteria];
-    int* temp_counters = new int[alloc_criteria];
+    I64* temp_counters = new I64[alloc_criteria];
     if (criteria)
     {
       for (i = 0; i < num_criteria; i++)
@@ -5481,3 +5742,78 @@ void LASfilter::add_criterion(LAScriterion* filter_criterion)
   counters[num_criteria] = 0;
   num_criteria++;
 }
+
+void LASfilter::compile()
+{
+  U32 i, j;
+  clean_stages();
+  stages = new LAScriterion*[num_criteria + 1];
+  stage_criteria = new U32[num_criteria + 1];
+  stage_sizes = new U32[num_criteria + 1];
+  stage_evaluated = new U32[num_criteria + 1];
+  stage_rejected = new U32[num_criteria + 1];
+  stage_costs = new F64[num_criteria + 1];
+  num_stages = 0;
+  i = 0;
+  while (i < num_criteria)
+  {
+    j = i;
+    while ((j < num_criteria) && LAScriterionFusedMask::can_fuse(criteria[j])) j++;
+    stage_criteria[num_stages] = i;
+    if ((j - i) > 1)
+    {
+      LAScriterionFusedMask* fused = new LAScriterionFusedMask(j - i);
+      for (; i < j; i++) fused->add(criteria[i]);
+      stages[num_stages] = fused;
+      stage_sizes[num_stages] = j - stage_criteria[num_stages];
+    }
+    else
+    {
+      stages[num_stages] = criteria[i];
+      stage_sizes[num_stages] = 1;
+      i++;
+    }
+    stage_evaluated[num_stages] = 0;
+    stage_rejected[num_stages] = 0;
+    stage_costs[num_stages] = 0.0;
+    num_stages++;
+  }
+  // learning is only needed when there is something to reorder
+  learn_count = LAS_FILTER_LEARN_POINTS;
+  if (!in_order)
+  {
+    for (i = 1; i < num_stages; i++)
+    {
+      if (!stages[i - 1]->is_stateful() && !stages[i]->is_stateful())
+      {
+        learn_count = 0;
+        break;
+      }
+    }
+  }
+}
+
+void LASfilter::clean_stages()
+{
+  U32 i;
+  for (i = 0; i < num_stages; i++)
+  {
+    if (stage_sizes[i] > 1) delete stages[i];
+  }
+  if (stages) delete[] stages;
+  if (stage_criteria) delete[] stage_criteria;
+  if (stage_sizes) delete[] stage_sizes;
+  if (stage_evaluated) delete[] stage_evaluated;
+  if (stage_rejected) delete[] stage_rejected;
+  if (stage_costs) delete[] stage_costs;
+  if (learn_sample) delete[] learn_sample;
+  num_stages = 0;
+  stages = 0;
+  stage_criteria = 0;
+  stage_sizes = 0;
+  stage_evaluated = 0;
+  stage_rejected = 0;
+  stage_costs = 0;
+  learn_sample = 0;
+  learn_sampled = 0;
+}
@@ -1,3 +1,6 @@
+include(CMakeFindDependencyMacro)
+find_dependency(Threads)
+
 get_filename_component(SELF_DIR "${CMAKE_CURRENT_LIST_FILE}" PATH)
 include(${SELF_DIR}/laslib-targets.cmake)
 get_filename_component(LASlib_INCLUDE_DIRS "${SELF_DIR}/../../../include/LASlib" ABSOLUTE)
@@ -0,0 +1,417 @@
+/*
+===============================================================================
+
+  FILE:  laspipeline.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the LICENSE.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+#include "laspipeline.hpp"
+
+#include "lasmessage.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+
+#define LAS_PIPELINE_BLOCK_SIZE 1024
+#define LAS_PIPELINE_NUMBER_BLOCKS 8
+
+class LASpointBlock
+{
+public:
+  LASpoint* points;
+  I64* p_cnts;
+  U32 count;
+};
+
+// bounded ring of point blocks between exactly one producer and one consumer.
+// the producer owns the blocks in [head, tail + number) and the consumer those
+// in [tail, head). a side that finds the ring full or empty sleeps on the
+// condition variable until the other side has moved its counter
+
+class LASpointRing
+{
+public:
+  BOOL init(const LASquantizer* quantizer, const LASpoint* layout)
+  {
+    for (U32 i = 0; i < LAS_PIPELINE_NUMBER_BLOCKS; i++)
+    {
+      blocks[i].points = new LASpoint[LAS_PIPELINE_BLOCK_SIZE];
+      blocks[i].p_cnts = new I64[LAS_PIPELINE_BLOCK_SIZE];
+      blocks[i].count = 0;
+      for (U32 j = 0; j < LAS_PIPELINE_BLOCK_SIZE; j++)
+      {
+        if (!blocks[i].points[j].init(quantizer, layout->num_items, layout->items, layout->attributer))
+        {
+          return FALSE;
+        }
+      }
+    }
+    return TRUE;
+  };
+  // producer: waits for an empty block. zero once the consumer has cancelled
+  LASpointBlock* produce()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (((head - tail) == LAS_PIPELINE_NUMBER_BLOCKS) && !cancelled)
+    {
+      moved.wait(lock);
+    }
+    if (cancelled) return 0;
+    return &blocks[head % LAS_PIPELINE_NUMBER_BLOCKS];
+  };
+  void publish()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    head++;
+    moved.notify_one();
+  };
+  void finish()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    finished = TRUE;
+    moved.notify_one();
+  };
+  // consumer: waits for a full block. zero once the producer has finished
+  LASpointBlock* consume()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while ((head == tail) && !finished)
+    {
+      moved.wait(lock);
+    }
+    if (head == tail) return 0;
+    return &blocks[tail % LAS_PIPELINE_NUMBER_BLOCKS];
+  };
+  void release()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    tail++;
+    moved.notify_one();
+  };
+  void cancel()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    cancelled.store(TRUE, std::memory_order_release);
+    moved.notify_one();
+  };
+  // lets the producer stop filling a block without taking the lock
+  BOOL is_cancelled() const
+  {
+    return cancelled.load(std::memory_order_acquire);
+  };
+  LASpointRing() : head(0), tail(0), finished(FALSE), cancelled(FALSE)
+  {
+    for (U32 i = 0; i < LAS_PIPELINE_NUMBER_BLOCKS; i++)
+    {
+      blocks[i].points = 0;
+      blocks[i].p_cnts = 0;
+    }
+  };
+  ~LASpointRing()
+  {
+    for (U32 i = 0; i < LAS_PIPELINE_NUMBER_BLOCKS; i++)
+    {
+      if (blocks[i].points) delete [] blocks[i].points;
+      if (blocks[i].p_cnts) delete [] blocks[i].p_cnts;
+    }
+  };
+private:
+  LASpointBlock blocks[LAS_PIPELINE_NUMBER_BLOCKS];
+  std::mutex mutex;
+  std::condition_variable moved;
+  U32 head;
+  U32 tail;
+  BOOL finished;
+  std::atomic<BOOL> cancelled;
+};
+
+// an exception of a stage thread cannot leave that thread. it is kept and
+// either rethrown by read_point() or reported here by close()
+
+static void report_stage_exception(const char* stage, std::exception_ptr exception)
+{
+  try
+  {
+    std::rethrow_exception(exception);
+  }
+  catch (const std::exception& e)
+  {
+    LASMessage(LAS_ERROR, "%s points in the pipeline failed: %s", stage, e.what());
+  }
+  catch (...)
+  {
+    LASMessage(LAS_ERROR, "%s points in the pipeline failed with an unknown exception", stage);
+  }
+}
+
+BOOL LASpipeline::open(LASreader* lasreader, LASwriter* laswriter, BOOL update_inventory, BOOL threaded, const LASpoint* layout)
+{
+  close();
+
+  this->lasreader = lasreader;
+  this->laswriter = laswriter;
+  this->update_inventory = update_inventory;
+  this->threaded = threaded;
+  write_failed = FALSE;
+  read_exception = nullptr;
+  write_exception = nullptr;
+  p_cnt = 0;
+  p_count = 0;
+
+  if (!threaded) return TRUE;
+
+  if (lasreader)
+  {
+    decoded = new LASpointRing();
+    if (!decoded->init(&lasreader->header, &lasreader->point))
+    {
+      laserror("allocating pipeline blocks for %u points", LAS_PIPELINE_NUMBER_BLOCKS * LAS_PIPELINE_BLOCK_SIZE);
+      return FALSE;
+    }
+    read_stage = new std::thread(&LASpipeline::run_read_stage, this);
+  }
+  if (laswriter)
+  {
+    if (layout == 0)
+    {
+      if (lasreader == 0)
+      {
+        laserror("pipeline without lasreader needs the point layout of the laswriter");
+        return FALSE;
+      }
+      layout = &lasreader->point;
+    }
+    encoded = new LASpointRing();
+    if (!encoded->init(&laswriter->quantizer, layout))
+    {
+      laserror("allocating pipeline blocks for %u points", LAS_PIPELINE_NUMBER_BLOCKS * LAS_PIPELINE_BLOCK_SIZE);
+      return FALSE;
+    }
+    write_stage = new std::thread(&LASpipeline::run_write_stage, this);
+  }
+  return TRUE;
+}
+
+LASpoint* LASpipeline::read_point()
+{
+  if (!threaded)
+  {
+    if (lasreader->read_point())
+    {
+      p_cnt = lasreader->p_cnt;
+      return &lasreader->point;
+    }
+    return 0;
+  }
+  if ((read_block == 0) || (read_next == read_block->count))
+  {
+    if (read_block)
+    {
+      decoded->release();
+    }
+    read_block = decoded->consume();
+    if (read_block == 0)
+    {
+      if (read_exception)
+      {
+        // as if the reader had thrown on this thread
+        std::exception_ptr exception = read_exception;
+        read_exception = nullptr;
+        std::rethrow_exception(exception);
+      }
+      return 0;
+    }
+    read_next = 0;
+  }
+  p_cnt = read_block->p_cnts[read_next];
+  return &read_block->points[read_next++];
+}
+
+BOOL LASpipeline::write_point(const LASpoint* point)
+{
+  p_count++;
+  if (!threaded)
+  {
+    if (!laswriter->write_point(point))
+    {
+      write_failed = TRUE;
+      return FALSE;
+    }
+    if (update_inventory) laswriter->update_inventory(point);
+    return TRUE;
+  }
+  if (write_block == 0)
+  {
+    // zero after the write stage failed and cancelled the ring
+    write_block = encoded->produce();
+    if (write_block == 0) return FALSE;
+    write_block->count = 0;
+  }
+  write_block->points[write_block->count++] = *point;
+  if (write_block->count == LAS_PIPELINE_BLOCK_SIZE)
+  {
+    encoded->publish();
+    write_block = 0;
+  }
+  return TRUE;
+}
+
+void LASpipeline::run_read_stage()
+{
+  LASpointBlock* block;
+  BOOL more = TRUE;
+  while (more && (block = decoded->produce()))
+  {
+    block->count = 0;
+    try
+    {
+      while (block->count < LAS_PIPELINE_BLOCK_SIZE)
+      {
+        if (decoded->is_cancelled() || !lasreader->read_point())
+        {
+          more = FALSE;
+          break;
+        }
+        block->points[block->count] = lasreader->point;
+        block->p_cnts[block->count] = lasreader->p_cnt;
+        block->count++;
+      }
+    }
+    catch (...)
+    {
+      // the points before the failure are still handed on. finish() makes
+      // the exception visible to read_point() after the last of them
+      read_exception = std::current_exception();
+      more = FALSE;
+    }
+    if (block->count) decoded->publish();
+  }
+  decoded->finish();
+}
+
+void LASpipeline::run_write_stage()
+{
+  LASpointBlock* block;
+  while ((block = encoded->consume()))
+  {
+    try
+    {
+      for (U32 i = 0; i < block->count; i++)
+      {
+        if (!laswriter->write_point(&block->points[i]))
+        {
+          // the producer sees the cancel and close() reports the failure
+          write_failed = TRUE;
+          encoded->cancel();
+          return;
+        }
+        if (update_inventory) laswriter->update_inventory(&block->points[i]);
+      }
+    }
+    catch (...)
+    {
+      write_exception = std::current_exception();
+      write_failed = TRUE;
+      encoded->cancel();
+      return;
+    }
+    encoded->release();
+  }
+}
+
+BOOL LASpipeline::close()
+{
+  if (read_stage)
+  {
+    // the reader may still be ahead of the consumer
+    decoded->cancel();
+    read_stage->join();
+    delete read_stage;
+    read_stage = 0;
+  }
+  if (write_stage)
+  {
+    if (write_block && write_block->count) encoded->publish();
+    encoded->finish();
+    write_stage->join();
+    delete write_stage;
+    write_stage = 0;
+  }
+  if (decoded)
+  {
+    delete decoded;
+    decoded = 0;
+  }
+  if (encoded)
+  {
+    delete encoded;
+    encoded = 0;
+  }
+  read_block = 0;
+  write_block = 0;
+  read_next = 0;
+  BOOL failed = write_failed;
+  if (read_exception)
+  {
+    // closed before read_point() reached the failure
+    report_stage_exception("reading", read_exception);
+    read_exception = nullptr;
+    failed = TRUE;
+  }
+  if (write_exception)
+  {
+    report_stage_exception("writing", write_exception);
+    write_exception = nullptr;
+  }
+  return !failed;
+}
+
+LASpipeline::LASpipeline()
+{
+  lasreader = 0;
+  laswriter = 0;
+  update_inventory = FALSE;
+  threaded = FALSE;
+  decoded = 0;
+  encoded = 0;
+  read_stage = 0;
+  write_stage = 0;
+  read_block = 0;
+  write_block = 0;
+  read_next = 0;
+  write_failed = FALSE;
+  read_exception = nullptr;
+  write_exception = nullptr;
+  p_cnt = 0;
+  p_count = 0;
+}
+
+LASpipeline::~LASpipeline()
+{
+  close();
+}
@@ -396,6 +396,7 @@ BOOL LASreader::read_point_filtered() {
   while ((this->*read_complex)()) {
     if (!filter->filter(&point)) return TRUE;
   }
+  filter->report_statistics();
   return FALSE;
 }
 
@@ -474,6 +475,9 @@ I32 LASreadOpener::unparse(CHAR* string) const {
   if (io_ibuffer_size != LAS_TOOLS_IO_IBUFFER_SIZE) {
     n += sprintf(string + n, "-io_ibuffer %u ", io_ibuffer_size);
   }
+  if (layer_threads) {
+    n += sprintf(string + n, "-layer_threads %u ", layer_threads);
+  }
   if (!temp_file_base.empty()) {
     n += sprintf(string + n, "-temp_files \"%s\" ", temp_file_base.c_str());
   }
@@ -1174,6 +1178,7 @@ LASreader* LASreadOpener::open(const CHAR* other_file_name, BOOL reset_after_oth
         if (scale_scan_angle != 1.0f) lasreadertxt->set_scale_scan_angle(scale_scan_angle);
         lasreadertxt->set_scale_factor(scale_factor);
         lasreadertxt->set_offset(offset);
+        if (parse_threads) lasreadertxt->set_threads(parse_threads);
         if (number_attributes) {
           for (I32 i = 0; i < number_attributes; i++) {
             lasreadertxt->add_attribute(
@@ -1242,6 +1247,7 @@ LASreader* LASreadOpener::open(const CHAR* other_file_name, BOOL reset_after_oth
       if (scale_scan_angle != 1.0f) lasreadertxt->set_scale_scan_angle(scale_scan_angle);
       lasreadertxt->set_scale_factor(scale_factor);
       lasreadertxt->set_offset(offset);
+      if (parse_threads) lasreadertxt->set_threads(parse_threads);
       if (number_attributes) {
         for (I32 i = 0; i < number_attributes; i++) {
           lasreadertxt->add_attribute(
@@ -2034,6 +2040,18 @@ void LASreadOpener::parse(int argc, char* argv[], BOOL parse_ignore, BOOL suppre
         set_copc_stream_ordered_by_level();
         *argv[i] = '\0';
       }
+    } else if (strcmp(argv[i], "-layer_threads") == 0) {
+      if ((i + 1) >= argc) {
+        laserror("'%s' needs 1 argument: number", argv[i]);
+      }
+      U32 number_threads;
+      if (sscanf(argv[i + 1], "%u", &number_threads) != 1) {
+        laserror("'%s' needs 1 argument: number but '%s' is not a valid number.", argv[i], argv[i + 1]);
+      }
+      set_layer_threads(number_threads);
+      *argv[i] = '\0';
+      *argv[i + 1] = '\0';
+      i += 1;
     } else if (strcmp(argv[i], "-lof") == 0) {
       if ((i + 1) >= argc) {
         laserror("'%s' needs 1 argument: list_of_files", argv[i]);
@@ -2423,6 +2441,10 @@ void LASreadOpener::set_io_ibuffer_size(const U32 buffer_size) {
   this->io_ibuffer_size = buffer_size;
 }
 
+void LASreadOpener::set_layer_threads(const U32 layer_threads) {
+  this->layer_threads = layer_threads;
+}
+
 void LASreadOpener::set_file_name(const CHAR* file_name, BOOL unique) {
   add_file_name(file_name, unique);
 }
@@ -2958,6 +2980,10 @@ void LASreadOpener::set_skip_lines(const U32 number_of_lines) {
   this->skip_lines = number_of_lines;
 }
 
+void LASreadOpener::set_parse_threads(const I32 parse_threads) {
+  this->parse_threads = parse_threads;
+}
+
 void LASreadOpener::set_populate_header(BOOL populate_header) {
   this->populate_header = populate_header;
 }
@@ -3025,6 +3051,7 @@ BOOL LASreadOpener::active() const {
 
 LASreadOpener::LASreadOpener() {
   io_ibuffer_size = LAS_TOOLS_IO_IBUFFER_SIZE;
+  layer_threads = 0;
   file_name = 0;
   file_names = 0;
   file_names_ID = 0;
@@ -3075,6 +3102,7 @@ LASreadOpener::LASreadOpener() {
   point_type = 0;
   parse_string = 0;
   skip_lines = 0;
+  parse_threads = 0;
   populate_header = FALSE;
   keep_lastiling = FALSE;
   keep_copc = FALSE;
@@ -123,6 +123,7 @@ BOOL LASreaderASC::open(const CHAR* file_name, BOOL comma_not_point)
 
   while (!complete)
   {
+    if (!piped) line_start = LASftell(file);
     if (!fgets(line, line_size, file)) break;
 
     // special handling for European numbers
@@ -239,9 +240,30 @@ BOOL LASreaderASC::open(const CHAR* file_name, BOOL comma_not_point)
   header.max_x = xllcenter + (ncols - 1) * cellsize;
   header.max_y = yllcenter + (nrows - 1) * cellsize;
 
+  // the raster is parsed and converted one row at a time
+
+  row_elevations = (F64*)malloc(sizeof(F64)*(ncols > 0 ? ncols : 1));
+  row_points = (I64*)malloc(sizeof(I64)*((nrows > 0 ? nrows : 0) + 1));
+  if ((row_elevations == 0) || (row_points == 0))
+  {
+    laserror("allocating row buffers for %d cols and %d rows", ncols, nrows);
+    return FALSE;
+  }
+
+  // unless piped the offset of each row is indexed while counting the rasters
+
+  if (!piped)
+  {
+    row_offsets = (I64*)malloc(sizeof(I64)*(nrows > 0 ? nrows : 1));
+  }
+  indexing = (row_offsets != 0);
+  row_first = 0;
+  row_last = nrows - 1;
+  col_first = 0;
+  col_last = ncols - 1;
+
   // init the bounding box z and count the rasters
 
-  F64 elevation = 0;
   npoints = 0;
   header.min_z = F64_MAX;
   header.max_z = F64_MIN;
@@ -252,36 +274,11 @@ BOOL LASreaderASC::open(const CHAR* file_name, BOOL comma_not_point)
 
   for (row = 0; row < nrows; row++)
   {
-    for (col = 0; col < ncols; col++)
+    row_points[row] = npoints;
+    I32 cells = read_row(TRUE);
+    for (col = 0; col < cells; col++)
     {
-      if (line[line_curr] == '\0')
-      {
-        if (!fgets(line, line_size, file))
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_idx);
-        }
-
-        // special handling for European numbers
-
-        if (comma_not_point)
-        {
-          I32 i, len = (I32)strlen(line);
-          for (i = 0; i < len; i++)
-          {
-            if (line[i] == ',') line[i] = '.';
-          }
-        }
-
-        // skip leading spaces
-        line_curr = 0;
-        while ((line[line_curr] != '\0') && (line[line_curr] <= ' ')) line_curr++;
-      }
-      // get elevation value
-      sscanf_las(&(line[line_curr]), "%lf", &elevation);
-      // skip parsed number
-      while ((line[line_curr] != '\0') && (line[line_curr] > ' ')) line_curr++;
-      // skip following spaces
-      while ((line[line_curr] != '\0') && (line[line_curr] <= ' ')) line_curr++;
+      F64 elevation = row_elevations[col];
       // should we use the raster
       if (elevation != nodata)
       {
@@ -290,7 +287,18 @@ BOOL LASreaderASC::open(const CHAR* file_name, BOOL comma_not_point)
         if (header.min_z > elevation) header.min_z = elevation;
       }
     }
+    if (cells < ncols)
+    {
+      LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, cells, ncols, npoints);
+      break;
+    }
+  }
+  for (I32 r = (row < nrows ? row + 1 : nrows); r <= nrows; r++)
+  {
+    row_points[r] = npoints;
+    if (row_offsets && (r < nrows)) row_offsets[r] = LASftell(file);
   }
+  indexing = FALSE;
 
   // close the ASC file
 
@@ -375,22 +383,155 @@ void LASreaderASC::set_offset(const F64* offset)
 
 BOOL LASreaderASC::seek(const I64 p_index)
 {
-  return FALSE;
+  if ((file == 0) || (row_offsets == 0) || inside || (p_index < 0) || (p_index >= npoints))
+  {
+    return FALSE;
+  }
+
+  // find the last row whose first point is not after the requested point
+
+  I32 lo = 0;
+  I32 hi = nrows - 1;
+  while (lo < hi)
+  {
+    I32 mid = (lo + hi + 1) / 2;
+    if (row_points[mid] <= p_index)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+
+  row = lo;
+  if (!seek_row(row))
+  {
+    return FALSE;
+  }
+  row_cells = read_row(TRUE);
+
+  // skip the points of this row that come before the requested point
+
+  I64 skip = p_index - row_points[row];
+  for (col = 0; col < row_cells; col++)
+  {
+    if (row_elevations[col] != nodata)
+    {
+      if (skip == 0) break;
+      skip--;
+    }
+  }
+  p_idx = p_index;
+  return TRUE;
 }
 
 BOOL LASreaderASC::read_point_default()
 {
-  F64 elevation;
   while (p_idx < npoints)
   {
-    if (line[line_curr] == '\0')
+    // skip the no data cells of the current row in bulk
+
+    I32 end = (row_cells <= col_last ? row_cells : col_last + 1);
+    while ((col < end) && (row_elevations[col] == nodata)) col++;
+
+    if (col >= end)
     {
-      if (!fgets(line, line_size, file))
+      if (row_cells <= col_last)
       {
-        LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_idx);
+        LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, row_cells, ncols, p_idx);
         npoints = p_idx;
         return FALSE;
       }
+      if (row >= row_last)
+      {
+        return FALSE;
+      }
+      row++;
+      // with the index we jump to the row. otherwise the rows before the window are only tokenized
+      if (seek_rows) seek_row(row);
+      row_cells = read_row(row >= row_first);
+      col = (row >= row_first ? col_first : ncols);
+      continue;
+    }
+
+    F64 elevation = row_elevations[col];
+
+    F64 x = xllcenter + col * cellsize;
+    F64 y = yllcenter + (nrows - row - 1) * cellsize;
+    F64 z = elevation; 
+
+    if (opener->is_offset_adjust() == FALSE)
+    {
+      // compute the quantized x, y, and z values
+      if (!point.set_x(x))
+      {
+        overflow_I32_x++;
+      }
+      if (!point.set_y(y))
+      {
+        overflow_I32_y++;
+      }
+      if (!point.set_z(z))
+      {
+        overflow_I32_z++;
+      }
+    }
+    else 
+    {
+      I64 X = 0;
+      I64 Y = 0;
+      I64 Z = 0;
+
+      if (x >= orig_x_offset)
+        X = ((I64)((x / orig_x_scale_factor) + 0.5));
+      else
+        X = ((I64)((x / orig_x_scale_factor) - 0.5));
+      if (y >= orig_y_offset)
+        Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) + 0.5));
+      else
+        Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) - 0.5));
+      if (z >= orig_z_offset)
+        Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) + 0.5));
+      else
+        Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) - 0.5));
+
+      if (I32_FITS_IN_RANGE(X))
+        point.set_X(X);
+      else
+        overflow_I32_x++;
+      if (I32_FITS_IN_RANGE(Y))
+        point.set_Y(Y);
+      else
+        overflow_I32_y++;
+      if (I32_FITS_IN_RANGE(Z))
+        point.set_Z(Z);
+      else
+        overflow_I32_z++;
+    }
+    p_idx++;
+    p_cnt++;
+    col++;
+    return TRUE;
+  }
+  return FALSE;
+}
+
+// parses the next row of 'ncols' values that may span several lines and
+// converts the values inside the column window to elevations if 'convert'
+// is set. returns how many values of the row were found.
+
+I32 LASreaderASC::read_row(BOOL convert)
+{
+  // when jumping from row to row the values after the window are not needed
+  I32 last = (seek_rows ? col_last + 1 : ncols);
+  I32 c;
+  for (c = 0; c < last; c++)
+  {
+    while (line[line_curr] == '\0')
+    {
+      if (row_offsets) line_start = LASftell(file);
+      if (!fgets(line, line_size, file))
+      {
+        return c;
+      }
 
       // special handling for European numbers
 
@@ -406,83 +547,118 @@ BOOL LASreaderASC::read_point_default()
       // skip leading spaces
       while ((line[line_curr] != '\0') && (line[line_curr] <= ' ')) line_curr++;
     }
-    if (col == ncols)
+    // remember where the row starts while building the index
+    if (indexing && (c == 0))
     {
-      col = 0;
-      row++;
+      row_offsets[row] = line_start + line_curr;
     }
     // get elevation value
-    sscanf_las(&(line[line_curr]), "%lf", &elevation);
+    if (convert && (col_first <= c) && (c <= col_last))
+    {
+      row_elevations[c] = strtod(&(line[line_curr]), 0);
+    }
     // skip parsed number
     while ((line[line_curr] != '\0') && (line[line_curr] > ' ')) line_curr++;
     // skip following spaces
     while ((line[line_curr] != '\0') && (line[line_curr] <= ' ')) line_curr++;
-    // should we use the raster
-    if (elevation != nodata)
-    {
-      F64 x = xllcenter + col * cellsize;
-      F64 y = yllcenter + (nrows - row - 1) * cellsize;
-      F64 z = elevation; 
+  }
+  return (c == last ? ncols : c);
+}
 
-      if (opener->is_offset_adjust() == FALSE)
-      {
-        // compute the quantized x, y, and z values
-        if (!point.set_x(x))
-        {
-          overflow_I32_x++;
-        }
-        if (!point.set_y(y))
-        {
-          overflow_I32_y++;
-        }
-        if (!point.set_z(z))
-        {
-          overflow_I32_z++;
-        }
-      }
-      else 
-      {
-        I64 X = 0;
-        I64 Y = 0;
-        I64 Z = 0;
-
-        if (x >= orig_x_offset)
-          X = ((I64)((x / orig_x_scale_factor) + 0.5));
-        else
-          X = ((I64)((x / orig_x_scale_factor) - 0.5));
-        if (y >= orig_y_offset)
-          Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) + 0.5));
-        else
-          Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) - 0.5));
-        if (z >= orig_z_offset)
-          Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) + 0.5));
-        else
-          Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) - 0.5));
-
-        if (I32_FITS_IN_RANGE(X))
-          point.set_X(X);
-        else
-          overflow_I32_x++;
-        if (I32_FITS_IN_RANGE(Y))
-          point.set_Y(Y);
-        else
-          overflow_I32_y++;
-        if (I32_FITS_IN_RANGE(Z))
-          point.set_Z(Z);
-        else
-          overflow_I32_z++;
-      }
-      p_idx++;
-      p_cnt++;
-      col++;
-      return TRUE;
-    }
-    else
+// continues reading at the first value of row 'r' using the row index
+
+BOOL LASreaderASC::seek_row(const I32 r)
+{
+  if ((row_offsets == 0) || !LASfseek(file, row_offsets[r], SEEK_SET))
+  {
+    return FALSE;
+  }
+  line_start = row_offsets[r];
+  if (!fgets(line, line_size, file))
+  {
+    line[0] = '\0';
+  }
+
+  // special handling for European numbers
+
+  if (comma_not_point)
+  {
+    I32 i, len = (I32)strlen(line);
+    for (i = 0; i < len; i++)
     {
-      col++;
+      if (line[i] == ',') line[i] = '.';
     }
   }
-  return FALSE;
+  line_curr = 0;
+  return TRUE;
+}
+
+// the first call to read_point_default() reads the first row of the window.
+// without the row index the rows before it are skipped there.
+
+void LASreaderASC::start_window()
+{
+  row = (seek_rows ? row_first - 1 : -1);
+  col = col_last + 1;
+  row_cells = ncols;
+}
+
+// restricts reading to the rows and columns that may contain points inside
+// the bounding box. the points are still checked against the exact area.
+
+void LASreaderASC::set_window(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y)
+{
+  F64 first = (min_x - xllcenter) / cellsize - 1.0;
+  F64 last = (max_x - xllcenter) / cellsize + 1.0;
+  col_first = (first < 0.0 ? 0 : (first > ncols ? ncols : (I32)first));
+  col_last = (last < 0.0 ? -1 : (last >= ncols ? ncols - 1 : (I32)last));
+  first = (nrows - 1) - (max_y - yllcenter) / cellsize - 1.0;
+  last = (nrows - 1) - (min_y - yllcenter) / cellsize + 1.0;
+  row_first = (first < 0.0 ? 0 : (first > nrows ? nrows : (I32)first));
+  row_last = (last < 0.0 ? -1 : (last >= nrows ? nrows - 1 : (I32)last));
+  if (col_first > col_last)
+  {
+    row_first = nrows;
+    row_last = nrows - 1;
+  }
+  seek_rows = (row_offsets != 0);
+  if (p_idx == 0)
+  {
+    start_window();
+  }
+}
+
+// reads the entire raster again
+
+BOOL LASreaderASC::inside_none()
+{
+  row_first = 0;
+  row_last = nrows - 1;
+  col_first = 0;
+  col_last = ncols - 1;
+  if (p_idx == 0)
+  {
+    start_window();
+  }
+  return LASreader::inside_none();
+}
+
+BOOL LASreaderASC::inside_tile(const F32 ll_x, const F32 ll_y, const F32 size)
+{
+  set_window(ll_x, ll_y, ll_x + size, ll_y + size);
+  return LASreader::inside_tile(ll_x, ll_y, size);
+}
+
+BOOL LASreaderASC::inside_circle(const F64 center_x, const F64 center_y, const F64 radius)
+{
+  set_window(center_x - radius, center_y - radius, center_x + radius, center_y + radius);
+  return LASreader::inside_circle(center_x, center_y, radius);
+}
+
+BOOL LASreaderASC::inside_rectangle(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y)
+{
+  set_window(min_x, min_y, max_x, max_y);
+  return LASreader::inside_rectangle(min_x, min_y, max_x, max_y);
 }
 
 ByteStreamIn* LASreaderASC::get_stream() const
@@ -540,6 +716,7 @@ BOOL LASreaderASC::reopen(const CHAR* file_name)
   I32 i;
   for (i = 0; i < header_lines; i++)
   {
+    if (!piped) line_start = LASftell(file);
     fgets(line, line_size, file);
   }
 
@@ -554,14 +731,13 @@ BOOL LASreaderASC::reopen(const CHAR* file_name)
     }
   }
 
-  col = 0;
-  row = 0;
   p_idx = 0;
   p_cnt = 0;
   // skip leading spaces
   line_curr = 0;
   while ((line[line_curr] != '\0') && (line[line_curr] <= ' ')) line_curr++;
 
+  start_window();
   return TRUE;
 }
 
@@ -589,6 +765,29 @@ void LASreaderASC::clean()
   yllcenter = F64_MAX;
   cellsize = 0;
   nodata = -9999;
+  if (row_elevations)
+  {
+    free(row_elevations);
+    row_elevations = 0;
+  }
+  if (row_offsets)
+  {
+    free(row_offsets);
+    row_offsets = 0;
+  }
+  if (row_points)
+  {
+    free(row_points);
+    row_points = 0;
+  }
+  line_start = 0;
+  indexing = FALSE;
+  seek_rows = FALSE;
+  row_cells = 0;
+  row_first = 0;
+  row_last = -1;
+  col_first = 0;
+  col_last = -1;
   overflow_I32_x = 0;
   overflow_I32_y = 0;
   overflow_I32_z = 0;
@@ -598,6 +797,9 @@ LASreaderASC::LASreaderASC(LASreadOpener* opener) :LASreader(opener)
 {
   file = 0;
   line = 0;
+  row_elevations = 0;
+  row_offsets = 0;
+  row_points = 0;
   scale_factor = 0;
   offset = 0;
   orig_x_offset = 0.0;
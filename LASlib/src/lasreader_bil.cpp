@@ -93,6 +93,23 @@ BOOL LASreaderBIL::open(const CHAR* file_name)
     LASMessage(LAS_WARNING, "ulycenter was not set. setting to %g", ulycenter);
   }
 
+  // the raster is read and converted one row at a time
+
+  cell_size = (nbits == 32 ? 4 : (nbits == 16 ? 2 : (nbands > 0 ? nbands : 1)));
+  row_buffer = (U8*)malloc((size_t)(ncols > 0 ? ncols : 1)*cell_size);
+  row_elevations = (F32*)malloc(sizeof(F32)*(ncols > 0 ? ncols : 1));
+  row_points = (I64*)malloc(sizeof(I64)*((nrows > 0 ? nrows : 0) + 1));
+  if ((row_buffer == 0) || (row_elevations == 0) || (row_points == 0))
+  {
+    laserror("allocating row buffers for %d cols", ncols);
+    return FALSE;
+  }
+  row_first = 0;
+  row_last = nrows - 1;
+  col_first = 0;
+  col_last = ncols - 1;
+  seek_cols = FALSE;
+
   // open the BIL file
   file = LASfopen(file_name, "rb");
   if (file == 0)
@@ -148,165 +165,29 @@ BOOL LASreaderBIL::open(const CHAR* file_name)
 
   // init the bounding box z and count the rasters
 
-  F32 elevation = 0;
   npoints = 0;
 
-  if (nbits == 32)
-  {
-    if (floatpixels)
-    {
-      for (col = 0; col < ncols; col++)
-      {
-        for (row = 0; row < nrows; row++)
-        {
-          if (fread((void*)&elevation, 4, 1, file) == 1)
-          {
-            if (elevation != nodata)
-            {
-              if (header.max_z < elevation) header.max_z = elevation;
-              if (header.min_z > elevation) header.min_z = elevation;
-              npoints++;
-            }
-          }
-          else
-          {
-            col = ncols;
-            row = nrows;
-          }
-        }
-      }
-    }
-    else
-    {
-      I32 elev;
-      for (col = 0; col < ncols; col++)
-      {
-        for (row = 0; row < nrows; row++)
-        {
-          if (fread((void*)&elev, 4, 1, file) == 1)
-          {
-            elevation = (F32)elev;
-            if (elevation != nodata)
-            {
-              if (header.max_z < elevation) header.max_z = elevation;
-              if (header.min_z > elevation) header.min_z = elevation;
-              npoints++;
-            }
-          }
-          else
-          {
-            col = ncols;
-            row = nrows;
-          }
-        }
-      }
-    }
-  }
-  else if (nbits == 16)
+  // also remember how many points come before each row for seek()
+
+  for (row = 0; row < nrows; row++)
   {
-    if (signedpixels)
+    row_points[row] = npoints;
+    I32 cells = read_row();
+    for (col = 0; col < cells; col++)
     {
-      I16 elev;
-      for (col = 0; col < ncols; col++)
+      F32 elevation = row_elevations[col];
+      if (elevation != nodata)
       {
-        for (row = 0; row < nrows; row++)
-        {
-          if (fread((void*)&elev, 2, 1, file) == 1)
-          {
-            elevation = (F32)elev;
-            if (elevation != nodata)
-            {
-              if (header.max_z < elevation) header.max_z = elevation;
-              if (header.min_z > elevation) header.min_z = elevation;
-              npoints++;
-            }
-          }
-          else
-          {
-            col = ncols;
-            row = nrows;
-          }
-        }
-      }
-    }
-    else
-    {
-      U16 elev;
-      for (col = 0; col < ncols; col++)
-      {
-        for (row = 0; row < nrows; row++)
-        {
-          if (fread((void*)&elev, 2, 1, file) == 1)
-          {
-            elevation = (F32)elev;
-            if (elevation != nodata)
-            {
-              if (header.max_z < elevation) header.max_z = elevation;
-              if (header.min_z > elevation) header.min_z = elevation;
-              npoints++;
-            }
-          }
-          else
-          {
-            col = ncols;
-            row = nrows;
-          }
-        }
+        if (header.max_z < elevation) header.max_z = elevation;
+        if (header.min_z > elevation) header.min_z = elevation;
+        npoints++;
       }
     }
+    if (cells < ncols) break;
   }
-  else
+  for (row = (row < nrows ? row + 1 : nrows); row <= nrows; row++)
   {
-    if (signedpixels)
-    {
-      I8 rgb[4];
-      for (col = 0; col < ncols; col++)
-      {
-        for (row = 0; row < nrows; row++)
-        {
-          if (fread((void*)&rgb, 1, nbands, file) == (U32)nbands)
-          {
-            elevation = (F32)(rgb[0]);
-            if (elevation != nodata)
-            {
-              if (header.max_z < elevation) header.max_z = elevation;
-              if (header.min_z > elevation) header.min_z = elevation;
-              npoints++;
-            }
-          }
-          else
-          {
-            col = ncols;
-            row = nrows;
-          }
-        }
-      }
-    }
-    else
-    {
-      U8 rgb[4];
-      for (col = 0; col < ncols; col++)
-      {
-        for (row = 0; row < nrows; row++)
-        {
-          if (fread((void*)&rgb, 1, nbands, file) == (U32)nbands)
-          {
-            elevation = (F32)(rgb[0]);
-            if (elevation != nodata)
-            {
-              if (header.max_z < elevation) header.max_z = elevation;
-              if (header.min_z > elevation) header.min_z = elevation;
-              npoints++;
-            }
-          }
-          else
-          {
-            col = ncols;
-            row = nrows;
-          }
-        }
-      }
-    }
+    row_points[row] = npoints;
   }
 
   // close the BIL file
@@ -483,7 +364,11 @@ BOOL LASreaderBIL::read_hdr_file(const CHAR* file_name)
     {
       CHAR byteorder[32] = {0};
       sscanf_las(line, "%s %s", dummy, byteorder);
-      if (strcmp(byteorder, "i") && strcmp(byteorder, "I"))
+      if ((strcmp(byteorder, "m") == 0) || (strcmp(byteorder, "M") == 0))
+      {
+        bigendianpixels = TRUE;
+      }
+      else if (strcmp(byteorder, "i") && strcmp(byteorder, "I"))
       {
         LASMessage(LAS_WARNING, "byteorder '%s' not recognized by LASreader_bil", byteorder);
       }
@@ -656,155 +541,292 @@ void LASreaderBIL::set_offset(const F64* offset)
 
 BOOL LASreaderBIL::seek(const I64 p_index)
 {
-  return FALSE;
+  if ((file == 0) || (row_points == 0) || inside || (p_index < 0) || (p_index >= npoints))
+  {
+    return FALSE;
+  }
+
+  // find the last row whose first point is not after the requested point
+
+  I32 lo = 0;
+  I32 hi = nrows - 1;
+  while (lo < hi)
+  {
+    I32 mid = (lo + hi + 1) / 2;
+    if (row_points[mid] <= p_index)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+
+  row = lo;
+  if (!LASfseek(file, (I64)row*ncols*cell_size, SEEK_SET))
+  {
+    return FALSE;
+  }
+  row_cells = read_row();
+
+  // skip the points of this row that come before the requested point
+
+  I64 skip = p_index - row_points[row];
+  for (col = 0; col < row_cells; col++)
+  {
+    if (row_elevations[col] != nodata)
+    {
+      if (skip == 0) break;
+      skip--;
+    }
+  }
+  p_idx = p_index;
+  return TRUE;
 }
 
 BOOL LASreaderBIL::read_point_default()
 {
-  F32 elevation;
   while (p_idx < npoints)
   {
-    if (col == ncols)
-    {
-      col = 0;
-      row++;
-    }
+    // skip the no data cells of the current row in bulk
 
-    if (nbits == 32)
+    I32 end = (row_cells <= col_last ? row_cells : col_last + 1);
+    while ((col < end) && (row_elevations[col] == nodata)) col++;
+
+    if (col >= end)
     {
-      if (floatpixels)
+      if (row_cells <= col_last)
       {
-        if (fread((void*)&elevation, 4, 1, file) != 1)
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_idx);
-          npoints = p_idx;
-          return FALSE;
-        }
+        LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, row_cells, ncols, p_idx);
+        npoints = p_idx;
+        return FALSE;
       }
-      else
+      if (row >= row_last)
       {
-        I32 elev;
-        if (fread((void*)&elev, 4, 1, file) != 1)
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_idx);
-          npoints = p_idx;
-          return FALSE;
-        }
-        elevation = (F32)elev;
+        return FALSE;
       }
+      row++;
+      row_cells = read_row();
+      col = col_first;
+      continue;
     }
-    else if (nbits == 16)
+
+    F32 elevation = row_elevations[col];
+
+    F64 x = ulxcenter + col * xdim;
+    F64 y = ulycenter - row * ydim;
+    F64 z = elevation;
+
+    if (opener->is_offset_adjust() == FALSE) 
     {
-      if (signedpixels)
-      {
-        I16 elev;
-        if (fread((void*)&elev, 2, 1, file) != 1)
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_idx);
-          npoints = p_idx;
-          return FALSE;
-        }
-        elevation = (F32)elev;
+      // compute the quantized x, y, and z values
+      if (!point.set_x(x)) {
+        overflow_I32_x++;
       }
-      else
-      {
-        U16 elev;
-        if (fread((void*)&elev, 2, 1, file) != 1)
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_idx);
-          npoints = p_idx;
-          return FALSE;
-        }
-        elevation = (F32)elev;
+      if (!point.set_y(y)) {
+        overflow_I32_y++;
       }
-    }
-    else
-    {
-      if (signedpixels)
-      {
-        I8 rgb[4];
-        if (fread((void*)rgb, 1, nbands, file) != (U32)nbands)
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_idx);
-          npoints = p_idx;
-          return FALSE;
-        }
-        elevation = rgb[0];
+      if (!point.set_z(z)) {
+        overflow_I32_z++;
       }
+    } 
+    else 
+    {
+      I64 X = 0;
+      I64 Y = 0;
+      I64 Z = 0;
+      if (x >= orig_x_offset)
+        X = ((I64)((x / orig_x_scale_factor) + 0.5));
       else
-      {
-        U8 rgb[4];
-        if (fread((void*)rgb, 1, nbands, file) != (U32)nbands)
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_idx);
-          npoints = p_idx;
-          return FALSE;
-        }
-        elevation = rgb[0];
-      }
+        X = ((I64)((x / orig_x_scale_factor) - 0.5));
+      if (y >= orig_y_offset)
+        Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) + 0.5));
+      else
+        Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) - 0.5));
+      if (z >= orig_z_offset)
+        Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) + 0.5));
+      else
+        Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) - 0.5));
+
+      if (I32_FITS_IN_RANGE(X))
+        point.set_X(X);
+      else
+        overflow_I32_x++;
+      if (I32_FITS_IN_RANGE(Y))
+        point.set_Y(Y);
+      else
+        overflow_I32_y++;
+      if (I32_FITS_IN_RANGE(Z))
+        point.set_Z(Z);
+      else
+        overflow_I32_z++;
     }
+    p_idx++;
+    p_cnt++;
+    col++;
+    return TRUE;
+  }
+  return FALSE;
+}
+
+// reads the current row with a single fread and converts the cells inside the
+// column window to elevations. returns how many cells of the row were read.
 
-    if (elevation != nodata)
+I32 LASreaderBIL::read_row()
+{
+  I32 cells;
+  if (seek_cols)
+  {
+    // only the cells of the window are read. the rest of the row counts as read.
+    if (!LASfseek(file, ((I64)row*ncols + col_first)*cell_size, SEEK_SET))
     {
-      F64 x = ulxcenter + col * xdim;
-      F64 y = ulycenter - row * ydim;
-      F64 z = elevation;
+      return 0;
+    }
+    cells = col_first + (I32)fread((void*)(row_buffer + (size_t)col_first*cell_size), cell_size, col_last - col_first + 1, file);
+    if (cells > col_last) cells = ncols;
+  }
+  else
+  {
+    cells = (I32)fread((void*)row_buffer, cell_size, ncols, file);
+  }
+  I32 end = (cells <= col_last ? cells : col_last + 1);
+  I32 c;
 
-      if (opener->is_offset_adjust() == FALSE) 
+  if (bigendianpixels)
+  {
+    if (nbits == 32)
+    {
+      U32* cell = (U32*)row_buffer;
+      for (c = col_first; c < end; c++)
       {
-        // compute the quantized x, y, and z values
-        if (!point.set_x(x)) {
-          overflow_I32_x++;
-        }
-        if (!point.set_y(y)) {
-          overflow_I32_y++;
-        }
-        if (!point.set_z(z)) {
-          overflow_I32_z++;
-        }
-      } 
-      else 
+        cell[c] = (cell[c] >> 24) | ((cell[c] >> 8) & 0x0000FF00) | ((cell[c] << 8) & 0x00FF0000) | (cell[c] << 24);
+      }
+    }
+    else if (nbits == 16)
+    {
+      U16* cell = (U16*)row_buffer;
+      for (c = col_first; c < end; c++)
       {
-        I64 X = 0;
-        I64 Y = 0;
-        I64 Z = 0;
-        if (x >= orig_x_offset)
-          X = ((I64)((x / orig_x_scale_factor) + 0.5));
-        else
-          X = ((I64)((x / orig_x_scale_factor) - 0.5));
-        if (y >= orig_y_offset)
-          Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) + 0.5));
-        else
-          Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) - 0.5));
-        if (z >= orig_z_offset)
-          Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) + 0.5));
-        else
-          Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) - 0.5));
-
-        if (I32_FITS_IN_RANGE(X))
-          point.set_X(X);
-        else
-          overflow_I32_x++;
-        if (I32_FITS_IN_RANGE(Y))
-          point.set_Y(Y);
-        else
-          overflow_I32_y++;
-        if (I32_FITS_IN_RANGE(Z))
-          point.set_Z(Z);
-        else
-          overflow_I32_z++;
+        cell[c] = (U16)((cell[c] >> 8) | (cell[c] << 8));
       }
-      p_idx++;
-  p_cnt++;
-      col++;
-      return TRUE;    
+    }
+  }
+
+  if (nbits == 32)
+  {
+    if (floatpixels)
+    {
+      if (end > col_first) memcpy((void*)(row_elevations + col_first), (const void*)(row_buffer + 4*col_first), 4*(end - col_first));
     }
     else
     {
-      col++;
+      const I32* cell = (const I32*)row_buffer;
+      for (c = col_first; c < end; c++) row_elevations[c] = (F32)cell[c];
     }
   }
-  return FALSE;
+  else if (nbits == 16)
+  {
+    if (signedpixels)
+    {
+      const I16* cell = (const I16*)row_buffer;
+      for (c = col_first; c < end; c++) row_elevations[c] = (F32)cell[c];
+    }
+    else
+    {
+      const U16* cell = (const U16*)row_buffer;
+      for (c = col_first; c < end; c++) row_elevations[c] = (F32)cell[c];
+    }
+  }
+  else
+  {
+    // only the first band is used as elevation
+    if (signedpixels)
+    {
+      const I8* cell = (const I8*)row_buffer;
+      for (c = col_first; c < end; c++) row_elevations[c] = (F32)cell[c*cell_size];
+    }
+    else
+    {
+      const U8* cell = row_buffer;
+      for (c = col_first; c < end; c++) row_elevations[c] = (F32)cell[c*cell_size];
+    }
+  }
+  return cells;
+}
+
+// positions the file at the first row of the window. the first call to
+// read_point_default() then reads this row.
+
+BOOL LASreaderBIL::start_window()
+{
+  row = row_first - 1;
+  col = col_last + 1;
+  row_cells = ncols;
+  return LASfseek(file, (I64)row_first*ncols*cell_size, SEEK_SET);
+}
+
+// restricts reading to the rows and columns that may contain points inside
+// the bounding box. the points are still checked against the exact area.
+
+void LASreaderBIL::set_window(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y)
+{
+  F64 first = (min_x - ulxcenter) / xdim - 1.0;
+  F64 last = (max_x - ulxcenter) / xdim + 1.0;
+  col_first = (first < 0.0 ? 0 : (first > ncols ? ncols : (I32)first));
+  col_last = (last < 0.0 ? -1 : (last >= ncols ? ncols - 1 : (I32)last));
+  first = (ulycenter - max_y) / ydim - 1.0;
+  last = (ulycenter - min_y) / ydim + 1.0;
+  row_first = (first < 0.0 ? 0 : (first > nrows ? nrows : (I32)first));
+  row_last = (last < 0.0 ? -1 : (last >= nrows ? nrows - 1 : (I32)last));
+  if (col_first > col_last)
+  {
+    row_first = nrows;
+    row_last = nrows - 1;
+  }
+  // seeking over the cells left and right of the window only pays off when
+  // it skips more than the file buffer would read ahead anyway
+  seek_cols = ((I64)(ncols - (col_last - col_first + 1))*cell_size > 2*LAS_TOOLS_IO_IBUFFER_SIZE);
+  if (file && (p_idx == 0))
+  {
+    if (!start_window())
+    {
+      LASMessage(LAS_WARNING, "seeking to row %d of BIL raster failed", row_first);
+    }
+  }
+}
+
+// reads the entire raster again
+
+BOOL LASreaderBIL::inside_none()
+{
+  row_first = 0;
+  row_last = nrows - 1;
+  col_first = 0;
+  col_last = ncols - 1;
+  seek_cols = FALSE;
+  if (file && (p_idx == 0))
+  {
+    if (!start_window())
+    {
+      LASMessage(LAS_WARNING, "seeking to row %d of BIL raster failed", row_first);
+    }
+  }
+  return LASreader::inside_none();
+}
+
+BOOL LASreaderBIL::inside_tile(const F32 ll_x, const F32 ll_y, const F32 size)
+{
+  set_window(ll_x, ll_y, ll_x + size, ll_y + size);
+  return LASreader::inside_tile(ll_x, ll_y, size);
+}
+
+BOOL LASreaderBIL::inside_circle(const F64 center_x, const F64 center_y, const F64 radius)
+{
+  set_window(center_x - radius, center_y - radius, center_x + radius, center_y + radius);
+  return LASreader::inside_circle(center_x, center_y, radius);
+}
+
+BOOL LASreaderBIL::inside_rectangle(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y)
+{
+  set_window(min_x, min_y, max_x, max_y);
+  return LASreader::inside_rectangle(min_x, min_y, max_x, max_y);
 }
 
 ByteStreamIn* LASreaderBIL::get_stream() const
@@ -856,12 +878,10 @@ BOOL LASreaderBIL::reopen(const CHAR* file_name)
     LASMessage(LAS_WARNING, "setvbuf() failed with buffer size %d", 2*LAS_TOOLS_IO_IBUFFER_SIZE);
   }
 
-  col = 0;
-  row = 0;
   p_idx = 0;
   p_cnt = 0;
 
-  return TRUE;
+  return start_window();
 }
 
 void LASreaderBIL::clean()
@@ -884,6 +904,29 @@ void LASreaderBIL::clean()
   nodata = -9999;
   floatpixels = FALSE;
   signedpixels = FALSE;
+  bigendianpixels = FALSE;
+  cell_size = 0;
+  if (row_buffer)
+  {
+    free(row_buffer);
+    row_buffer = 0;
+  }
+  if (row_elevations)
+  {
+    free(row_elevations);
+    row_elevations = 0;
+  }
+  if (row_points)
+  {
+    free(row_points);
+    row_points = 0;
+  }
+  row_cells = 0;
+  row_first = 0;
+  row_last = -1;
+  col_first = 0;
+  col_last = -1;
+  seek_cols = FALSE;
   overflow_I32_x = 0;
   overflow_I32_y = 0;
   overflow_I32_z = 0;
@@ -892,6 +935,9 @@ void LASreaderBIL::clean()
 LASreaderBIL::LASreaderBIL(LASreadOpener* opener) :LASreader(opener)
 {
   file = 0;
+  row_buffer = 0;
+  row_elevations = 0;
+  row_points = 0;
   scale_factor = 0;
   offset = 0;
   orig_x_offset = 0.0;
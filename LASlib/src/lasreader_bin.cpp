@@ -410,6 +410,7 @@ LASreaderBIN::LASreaderBIN(LASreadOpener* opener):LASreader(opener)
 
 LASreaderBIN::~LASreaderBIN()
 {
+  LASnoThrowScope no_throw;
   if (stream) close();
 }
 
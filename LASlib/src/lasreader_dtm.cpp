@@ -1034,110 +1034,68 @@ BOOL LASreaderDTM::open(const CHAR* file_name)
   header.min_z = F64_MAX;
   header.max_z = F64_MIN;
 
-  // init the bounding box z and count the rasters
-
-  npoints = 0;
+  // the raster is stored in columns that are read and converted one at a time
 
   if (data_type == 2) // F32
   {
-    F32 elevation = 0;
-    for (row = 0; row < nrows; row++)
-    {
-      for (col = 0; col < ncols; col++)
-      {
-        if (fread((void*)&elevation, 4, 1, file) == 1)
-        {
-          if (elevation != nodata)
-          {
-            if (header.max_z < elevation) header.max_z = elevation;
-            if (header.min_z > elevation) header.min_z = elevation;
-            npoints++;
-          }
-        }
-        else
-        {
-          col = ncols;
-          row = nrows;
-        }
-      }
-    }
+    cell_size = 4;
   }
   else if (data_type == 1) // I32
   {
-    I32 elevation = 0;
-    for (row = 0; row < nrows; row++)
-    {
-      for (col = 0; col < ncols; col++)
-      {
-        if (fread((void*)&elevation, 4, 1, file) == 1)
-        {
-          if (((F32)elevation) != nodata)
-          {
-            if (header.max_z < elevation) header.max_z = elevation;
-            if (header.min_z > elevation) header.min_z = elevation;
-            npoints++;
-          }
-        }
-        else
-        {
-          col = ncols;
-          row = nrows;
-        }
-      }
-    }
+    cell_size = 4;
   }
   else if (data_type == 0) // I16
   {
-    I16 elevation;
-    for (row = 0; row < nrows; row++)
-    {
-      for (col = 0; col < ncols; col++)
-      {
-        if (fread((void*)&elevation, 2, 1, file) == 1)
-        {
-          if (((F32)elevation) != nodata)
-          {
-            if (header.max_z < elevation) header.max_z = elevation;
-            if (header.min_z > elevation) header.min_z = elevation;
-            npoints++;
-          }
-        }
-        else
-        {
-          col = ncols;
-          row = nrows;
-        }
-      }
-    }
+    cell_size = 2;
   }
   else if (data_type == 3) // F64
   {
-    F64 elevation;
-    for (row = 0; row < nrows; row++)
+    cell_size = 8;
+  }
+  else
+  {
+    laserror("unknown data type %d", (I32)data_type);
+    return FALSE;
+  }
+
+  col_buffer = (U8*)malloc((size_t)(nrows > 0 ? nrows : 1)*cell_size);
+  col_elevations = (F64*)malloc(sizeof(F64)*(nrows > 0 ? nrows : 1));
+  col_points = (I64*)malloc(sizeof(I64)*((ncols > 0 ? ncols : 0) + 1));
+  if ((col_buffer == 0) || (col_elevations == 0) || (col_points == 0))
+  {
+    laserror("allocating column buffers for %d rows", nrows);
+    return FALSE;
+  }
+  row_first = 0;
+  row_last = nrows - 1;
+  col_first = 0;
+  col_last = ncols - 1;
+  seek_rows = FALSE;
+
+  // init the bounding box z and count the rasters. also remember how many
+  // points come before each column for seek()
+
+  npoints = 0;
+
+  for (col = 0; col < ncols; col++)
+  {
+    col_points[col] = npoints;
+    I32 cells = read_col();
+    for (row = 0; row < cells; row++)
     {
-      for (col = 0; col < ncols; col++)
+      F64 elevation = col_elevations[row];
+      if (((F32)elevation) != nodata)
       {
-        if (fread((void*)&elevation, 8, 1, file) == 1)
-        {
-          if (((F32)elevation) != nodata)
-          {
-            if (header.max_z < elevation) header.max_z = elevation;
-            if (header.min_z > elevation) header.min_z = elevation;
-            npoints++;
-          }
-        }
-        else
-        {
-          col = ncols;
-          row = nrows;
-        }
+        if (header.max_z < elevation) header.max_z = elevation;
+        if (header.min_z > elevation) header.min_z = elevation;
+        npoints++;
       }
     }
+    if (cells < nrows) break;
   }
-  else
+  for (col = (col < ncols ? col + 1 : ncols); col <= ncols; col++)
   {
-    laserror("unknown data type %d", (I32)data_type);
-    return FALSE;
+    col_points[col] = npoints;
   }
 
   // update the header point count
@@ -1219,131 +1177,253 @@ void LASreaderDTM::set_offset(const F64* offset)
 
 BOOL LASreaderDTM::seek(const I64 p_index)
 {
-  return FALSE;
+  if ((file == 0) || (col_points == 0) || inside || (p_index < 0) || (p_index >= npoints))
+  {
+    return FALSE;
+  }
+
+  // find the last column whose first point is not after the requested point
+
+  I32 lo = 0;
+  I32 hi = ncols - 1;
+  while (lo < hi)
+  {
+    I32 mid = (lo + hi + 1) / 2;
+    if (col_points[mid] <= p_index)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+
+  col = lo;
+  if (!LASfseek(file, 200 + (I64)col*nrows*cell_size, SEEK_SET))
+  {
+    return FALSE;
+  }
+  col_cells = read_col();
+
+  // skip the points of this column that come before the requested point
+
+  I64 skip = p_index - col_points[col];
+  for (row = 0; row < col_cells; row++)
+  {
+    if (((F32)col_elevations[row]) != nodata)
+    {
+      if (skip == 0) break;
+      skip--;
+    }
+  }
+  p_idx = p_index;
+  return TRUE;
 }
 
 BOOL LASreaderDTM::read_point_default()
 {
   while (p_idx < npoints)
   {
-    if (row == nrows)
-    {
-      row = 0;
-      col++;
-    }
+    // skip the no data cells of the current column in bulk
 
-    F32 elevation;
+    I32 end = (col_cells <= row_last ? col_cells : row_last + 1);
+    while ((row < end) && (((F32)col_elevations[row]) == nodata)) row++;
 
-    if (data_type == 2) // F32
+    if (row >= end)
     {
-      if (fread((void*)&elevation, 4, 1, file) != 1)
+      if (col_cells <= row_last)
       {
-        LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_idx);
+        LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", col_cells, nrows, col, ncols, p_idx);
         npoints = p_idx;
         return FALSE;
       }
-    }
-    else if (data_type == 1) // I32
-    {
-      I32 elev;
-      if (fread((void*)&elev, 4, 1, file) != 1)
+      if (col >= col_last)
       {
-        LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_idx);
-        npoints = p_idx;
         return FALSE;
       }
-      elevation = (F32)elev;
+      col++;
+      col_cells = read_col();
+      row = row_first;
+      continue;
     }
-    else if (data_type == 0) // I16
+
+    F32 elevation = (F32)col_elevations[row];
+
+    F64 x = ll_x + col* xdim;
+    F64 y = ll_y + row * ydim;
+    F64 z = elevation;
+
+    if (opener->is_offset_adjust() == FALSE) 
     {
-      I16 elev;
-      if (fread((void*)&elev, 2, 1, file) != 1)
-      {
-        LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_idx);
-        npoints = p_idx;
-        return FALSE;
+      // compute the quantized x, y, and z values
+      if (!point.set_x(x)) {
+        overflow_I32_x++;
       }
-      elevation = (F32)elev;
-    }
-    else if (data_type == 3) // F64
-    {
-      F64 elev;
-      if (fread((void*)&elev, 8, 1, file) != 1)
-      {
-        LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_idx);
-        npoints = p_idx;
-        return FALSE;
+      if (!point.set_y(y)) {
+        overflow_I32_y++;
       }
-      elevation = (F32)elev;
-    }
-    else
+      if (!point.set_z(z)) {
+        overflow_I32_z++;
+      }
+    } 
+    else 
     {
-      laserror("unknown data type %d", (I32)data_type);
-      return FALSE;
+      I64 X = 0;
+      I64 Y = 0;
+      I64 Z = 0;
+
+      if (x >= orig_x_offset)
+        X = ((I64)((x / orig_x_scale_factor) + 0.5));
+      else
+        X = ((I64)((x / orig_x_scale_factor) - 0.5));
+      if (y >= orig_y_offset)
+        Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) + 0.5));
+      else
+        Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) - 0.5));
+      if (z >= orig_z_offset)
+        Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) + 0.5));
+      else
+        Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) - 0.5));
+
+      if (I32_FITS_IN_RANGE(X))
+        point.set_X(X);
+      else
+        overflow_I32_x++;
+      if (I32_FITS_IN_RANGE(Y))
+        point.set_Y(Y);
+      else
+        overflow_I32_y++;
+      if (I32_FITS_IN_RANGE(Z))
+        point.set_Z(Z);
+      else
+        overflow_I32_z++;
     }
+    p_idx++;
+    p_cnt++;
+    row++;
+    return TRUE;
+  }
+  return FALSE;
+}
+
+// reads the current column with a single fread and converts the cells inside
+// the row window to elevations. returns how many cells of the column were read.
 
-    if (elevation != nodata)
+I32 LASreaderDTM::read_col()
+{
+  I32 cells;
+  if (seek_rows)
+  {
+    // only the cells of the window are read. the rest of the column counts as read.
+    if (!LASfseek(file, 200 + ((I64)col*nrows + row_first)*cell_size, SEEK_SET))
     {
-      F64 x = ll_x + col* xdim;
-      F64 y = ll_y + row * ydim;
-      F64 z = elevation;
+      return 0;
+    }
+    cells = row_first + (I32)fread((void*)(col_buffer + (size_t)row_first*cell_size), cell_size, row_last - row_first + 1, file);
+    if (cells > row_last) cells = nrows;
+  }
+  else
+  {
+    cells = (I32)fread((void*)col_buffer, cell_size, nrows, file);
+  }
+  I32 end = (cells <= row_last ? cells : row_last + 1);
+  I32 r;
 
-      if (opener->is_offset_adjust() == FALSE) 
-      {
-        // compute the quantized x, y, and z values
-        if (!point.set_x(x)) {
-          overflow_I32_x++;
-        }
-        if (!point.set_y(y)) {
-          overflow_I32_y++;
-        }
-        if (!point.set_z(z)) {
-          overflow_I32_z++;
-        }
-      } 
-      else 
-      {
-        I64 X = 0;
-        I64 Y = 0;
-        I64 Z = 0;
-
-        if (x >= orig_x_offset)
-          X = ((I64)((x / orig_x_scale_factor) + 0.5));
-        else
-          X = ((I64)((x / orig_x_scale_factor) - 0.5));
-        if (y >= orig_y_offset)
-          Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) + 0.5));
-        else
-          Y = ((I64)(((y - orig_y_offset) / orig_y_scale_factor) - 0.5));
-        if (z >= orig_z_offset)
-          Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) + 0.5));
-        else
-          Z = ((I64)(((z - orig_z_offset) / orig_z_scale_factor) - 0.5));
-
-        if (I32_FITS_IN_RANGE(X))
-          point.set_X(X);
-        else
-          overflow_I32_x++;
-        if (I32_FITS_IN_RANGE(Y))
-          point.set_Y(Y);
-        else
-          overflow_I32_y++;
-        if (I32_FITS_IN_RANGE(Z))
-          point.set_Z(Z);
-        else
-          overflow_I32_z++;
-      }
-      p_idx++;
-  p_cnt++;
-      row++;
-      return TRUE;
+  if (data_type == 2) // F32
+  {
+    const F32* cell = (const F32*)col_buffer;
+    for (r = row_first; r < end; r++) col_elevations[r] = cell[r];
+  }
+  else if (data_type == 1) // I32
+  {
+    const I32* cell = (const I32*)col_buffer;
+    for (r = row_first; r < end; r++) col_elevations[r] = cell[r];
+  }
+  else if (data_type == 0) // I16
+  {
+    const I16* cell = (const I16*)col_buffer;
+    for (r = row_first; r < end; r++) col_elevations[r] = cell[r];
+  }
+  else // F64
+  {
+    if (end > row_first) memcpy((void*)(col_elevations + row_first), (const void*)(col_buffer + 8*row_first), 8*(end - row_first));
+  }
+  return cells;
+}
+
+// positions the file at the first column of the window. the first call to
+// read_point_default() then reads this column.
+
+BOOL LASreaderDTM::start_window()
+{
+  col = col_first - 1;
+  row = row_last + 1;
+  col_cells = nrows;
+  return LASfseek(file, 200 + (I64)col_first*nrows*cell_size, SEEK_SET);
+}
+
+// restricts reading to the columns and rows that may contain points inside
+// the bounding box. the points are still checked against the exact area.
+
+void LASreaderDTM::set_window(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y)
+{
+  F64 first = (min_x - ll_x) / xdim - 1.0;
+  F64 last = (max_x - ll_x) / xdim + 1.0;
+  col_first = (first < 0.0 ? 0 : (first > ncols ? ncols : (I32)first));
+  col_last = (last < 0.0 ? -1 : (last >= ncols ? ncols - 1 : (I32)last));
+  first = (min_y - ll_y) / ydim - 1.0;
+  last = (max_y - ll_y) / ydim + 1.0;
+  row_first = (first < 0.0 ? 0 : (first > nrows ? nrows : (I32)first));
+  row_last = (last < 0.0 ? -1 : (last >= nrows ? nrows - 1 : (I32)last));
+  if (row_first > row_last)
+  {
+    col_first = ncols;
+    col_last = ncols - 1;
+  }
+  // seeking over the cells below and above the window only pays off when
+  // it skips more than the file buffer would read ahead anyway
+  seek_rows = ((I64)(nrows - (row_last - row_first + 1))*cell_size > 2*LAS_TOOLS_IO_IBUFFER_SIZE);
+  if (file && (p_idx == 0))
+  {
+    if (!start_window())
+    {
+      LASMessage(LAS_WARNING, "seeking to column %d of DTM raster failed", col_first);
     }
-    else
+  }
+}
+
+// reads the entire raster again
+
+BOOL LASreaderDTM::inside_none()
+{
+  row_first = 0;
+  row_last = nrows - 1;
+  col_first = 0;
+  col_last = ncols - 1;
+  seek_rows = FALSE;
+  if (file && (p_idx == 0))
+  {
+    if (!start_window())
     {
-      row++;
+      LASMessage(LAS_WARNING, "seeking to column %d of DTM raster failed", col_first);
     }
   }
-  return FALSE;
+  return LASreader::inside_none();
+}
+
+BOOL LASreaderDTM::inside_tile(const F32 ll_x, const F32 ll_y, const F32 size)
+{
+  set_window(ll_x, ll_y, ll_x + size, ll_y + size);
+  return LASreader::inside_tile(ll_x, ll_y, size);
+}
+
+BOOL LASreaderDTM::inside_circle(const F64 center_x, const F64 center_y, const F64 radius)
+{
+  set_window(center_x - radius, center_y - radius, center_x + radius, center_y + radius);
+  return LASreader::inside_circle(center_x, center_y, radius);
+}
+
+BOOL LASreaderDTM::inside_rectangle(const F64 min_x, const F64 min_y, const F64 max_x, const F64 max_y)
+{
+  set_window(min_x, min_y, max_x, max_y);
+  return LASreader::inside_rectangle(min_x, min_y, max_x, max_y);
 }
 
 ByteStreamIn* LASreaderDTM::get_stream() const
@@ -1403,18 +1483,12 @@ BOOL LASreaderDTM::reopen(const CHAR* file_name)
     LASMessage(LAS_WARNING, "setvbuf() failed with buffer size %d", 2*LAS_TOOLS_IO_IBUFFER_SIZE);
   }
 
-  col = 0;
-  row = 0;
   p_idx = 0;
   p_cnt = 0;
 
-  // skip 200 bytes of header
-  I32 i;
-  for (i = 0; i < 200; i++)
-  {
-    fgetc(file);
-  }
-  return TRUE;
+  // skip 200 bytes of header and the columns before the window
+
+  return start_window();
 }
 
 void LASreaderDTM::clean()
@@ -1430,6 +1504,28 @@ void LASreaderDTM::clean()
   nrows = 0;
   nodata = -9999.0f;
   data_type = -1;
+  cell_size = 0;
+  if (col_buffer)
+  {
+    free(col_buffer);
+    col_buffer = 0;
+  }
+  if (col_elevations)
+  {
+    free(col_elevations);
+    col_elevations = 0;
+  }
+  if (col_points)
+  {
+    free(col_points);
+    col_points = 0;
+  }
+  col_cells = 0;
+  seek_rows = FALSE;
+  row_first = 0;
+  row_last = -1;
+  col_first = 0;
+  col_last = -1;
   ll_x = 0.0;
   ll_y = 0.0;
   xdim = 0;
@@ -1442,6 +1538,9 @@ void LASreaderDTM::clean()
 LASreaderDTM::LASreaderDTM(LASreadOpener* opener) :LASreader(opener)
 {
   file = 0;
+  col_buffer = 0;
+  col_elevations = 0;
+  col_points = 0;
   scale_factor = 0;
   offset = 0;
   orig_x_offset = 0.0;
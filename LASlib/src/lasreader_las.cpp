@@ -34,9 +34,12 @@
 #include "bytestreamin.hpp"
 #include "bytestreamin_file.hpp"
 #include "bytestreamin_istream.hpp"
+#include "bytestreamin_array.hpp"
 #include "lasreadpoint.hpp"
 #include "lasindex.hpp"
 #include "lascopc.hpp"
+#include "lasfilter.hpp"
+#include "lasutility.hpp"
 
 #ifdef _WIN32
 #include <fcntl.h>
@@ -127,6 +130,42 @@ BOOL LASreaderLAS::open(std::istream& stream, BOOL peek_only, U32 decompress_sel
   return open(in, peek_only, decompress_selective);
 }
 
+BOOL LASreaderLAS::open(const U8* data, I64 size, BOOL peek_only, U32 decompress_selective)
+{
+  if (data == 0)
+  {
+    laserror("data pointer is zero");
+    return FALSE;
+  }
+
+  // create input
+  ByteStreamIn* in;
+  if (IS_LITTLE_ENDIAN())
+    in = new ByteStreamInArrayLE(data, size);
+  else
+    in = new ByteStreamInArrayBE(data, size);
+
+  return open(in, peek_only, decompress_selective);
+}
+
+BOOL LASreaderLAS::open(ByteStreamInReadCallback callback, void* user_data, I64 size, BOOL peek_only, U32 decompress_selective)
+{
+  if (callback == 0)
+  {
+    laserror("read callback is zero");
+    return FALSE;
+  }
+
+  // create input
+  ByteStreamIn* in;
+  if (IS_LITTLE_ENDIAN())
+    in = new ByteStreamInCallbackLE(callback, user_data, size);
+  else
+    in = new ByteStreamInCallbackBE(callback, user_data, size);
+
+  return open(in, peek_only, decompress_selective);
+}
+
 BOOL LASreaderLAS::open(ByteStreamIn* stream, BOOL peek_only, U32 decompress_selective)
 {
   U32 i,j;
@@ -1253,6 +1292,25 @@ BOOL LASreaderLAS::open(ByteStreamIn* stream, BOOL peek_only, U32 decompress_sel
           }
           else if (strcmp(header.evlrs[i].user_id, "laszip encoded") == 0 || strcmp(header.evlrs[i].user_id, "LAStools") == 0)
           {
+            if ((strcmp(header.evlrs[i].user_id, "LAStools") == 0) && (header.evlrs[i].record_id == 40) && header.evlrs[i].data)
+            {
+              // the per-chunk summaries for skipping chunks that the filter rejects
+              ByteStreamInArray* in;
+              if (IS_LITTLE_ENDIAN())
+                in = new ByteStreamInArrayLE(header.evlrs[i].data, header.evlrs[i].record_length_after_header);
+              else
+                in = new ByteStreamInArrayBE(header.evlrs[i].data, header.evlrs[i].record_length_after_header);
+              if (chunk_statistics == 0) chunk_statistics = new LASstatistics();
+              if (!chunk_statistics->read_chunks(in, (header.number_of_point_records ? header.number_of_point_records : header.extended_number_of_point_records)))
+              {
+                LASMessage(LAS_WARNING, "corrupt chunk summaries in EVLR. ignoring ...");
+                delete chunk_statistics;
+                chunk_statistics = 0;
+              }
+              delete in;
+              delete [] header.evlrs[i].data;
+              header.evlrs[i].data = 0;
+            }
             // we take our own EVLRs away from everywhere
             evlrs_size -= (60+header.evlrs[i].record_length_after_header);
             i--;
@@ -1364,6 +1422,7 @@ BOOL LASreaderLAS::open(ByteStreamIn* stream, BOOL peek_only, U32 decompress_sel
 
   // create the point reader
   reader = new LASreadPoint(decompress_selective);
+  if (opener && opener->get_layer_threads()) reader->set_layer_threads(opener->get_layer_threads());
 
   // initialize point and the reader
   if (header.laszip)
@@ -1426,6 +1485,7 @@ BOOL LASreaderLAS::open(ByteStreamIn* stream, BOOL peek_only, U32 decompress_sel
   if (!reader->init(stream)) return FALSE;
 
   checked_end = FALSE;
+  next_chunk_start = 0;
 
   return TRUE;
 }
@@ -1448,6 +1508,7 @@ BOOL LASreaderLAS::seek(const I64 p_index)
       if (reader->seek((U32)p_idx, (U32)p_index))
       {
         p_idx = p_index;
+        if (chunk_starts) next_chunk_start = 0;
         return TRUE;
       }
     }
@@ -1455,8 +1516,92 @@ BOOL LASreaderLAS::seek(const I64 p_index)
   return FALSE;
 }
 
+// the chunk summaries come from the EVLR or from a '.stats' sidecar. they
+// are only used with a filter, without a spatial query that seeks itself,
+// and as long as the points have the scale and offset they were made for.
+
+BOOL LASreaderLAS::load_chunk_summaries()
+{
+  if (!use_chunk_summaries || (filter == 0) || !filter->active() || inside)
+  {
+    return FALSE;
+  }
+  if ((chunk_statistics == 0) && file_name)
+  {
+    chunk_statistics = new LASstatistics();
+    if (!chunk_statistics->read(file_name) || !chunk_statistics->is_compatible(&header))
+    {
+      delete chunk_statistics;
+      chunk_statistics = 0;
+    }
+  }
+  if (chunk_statistics == 0)
+  {
+    return FALSE;
+  }
+  U32 c, number_of_chunks = chunk_statistics->number_of_chunks;
+  chunk_starts = new I64[number_of_chunks + 1];
+  chunk_starts[0] = 0;
+  for (c = 0; c < number_of_chunks; c++)
+  {
+    chunk_starts[c + 1] = chunk_starts[c] + chunk_statistics->chunks[c].number_of_points;
+  }
+  if (chunk_starts[number_of_chunks] != npoints)
+  {
+    LASMessage(LAS_WARNING, "chunk summaries cover %lld instead of %lld points. ignoring ...", chunk_starts[number_of_chunks], npoints);
+    delete [] chunk_starts;
+    chunk_starts = 0;
+    return FALSE;
+  }
+  LASMessage(LAS_VERBOSE, "using %u chunk summaries to skip chunks rejected by the filter", number_of_chunks);
+  return TRUE;
+}
+
+void LASreaderLAS::skip_rejected_chunks()
+{
+  if ((chunk_starts == 0) && !load_chunk_summaries())
+  {
+    next_chunk_start = I64_MAX;
+    return;
+  }
+  // find the chunk that contains the next point
+  U32 lo = 0, hi = chunk_statistics->number_of_chunks;
+  while (hi - lo > 1)
+  {
+    U32 mid = (lo + hi) / 2;
+    if (chunk_starts[mid] <= p_idx) lo = mid; else hi = mid;
+  }
+  U32 c = lo;
+  // only whole chunks are skipped
+  if (chunk_starts[c] == p_idx)
+  {
+    while ((c < chunk_statistics->number_of_chunks) && filter->reject_chunk(&(chunk_statistics->chunks[c]), &point))
+    {
+      c++;
+    }
+    if (c == chunk_statistics->number_of_chunks)
+    {
+      p_idx = npoints;
+      checked_end = TRUE;
+      next_chunk_start = I64_MAX;
+      return;
+    }
+    if ((chunk_starts[c] != p_idx) && !seek(chunk_starts[c]))
+    {
+      LASMessage(LAS_WARNING, "cannot seek to point %lld to skip chunks. reading them ...", chunk_starts[c]);
+      next_chunk_start = I64_MAX;
+      return;
+    }
+  }
+  next_chunk_start = chunk_starts[c + 1];
+}
+
 BOOL LASreaderLAS::read_point_default()
 {
+  if (p_idx >= next_chunk_start)
+  {
+    skip_rejected_chunks();
+  }
   if (p_idx < npoints)
   {
     if (reader->read(point.point) == FALSE)
@@ -1522,6 +1667,39 @@ BOOL LASreaderLAS::read_point_default()
   return FALSE;
 }
 
+BOOL LASreaderLAS::peek_chunk(const U8** bytes, U32* num_bytes, U32* num_points)
+{
+  peeked_points = 0;
+  // all points of the chunk must be read (or skipped) as they are
+  if ((reader == 0) || !use_chunk_summaries || (p_idx >= npoints) || inside || (filter && filter->active()))
+  {
+    return FALSE;
+  }
+  if (!reader->peek_chunk(bytes, num_bytes, num_points))
+  {
+    return FALSE;
+  }
+  if ((p_idx + *num_points) > npoints)
+  {
+    return FALSE;
+  }
+  peeked_points = *num_points;
+  return TRUE;
+}
+
+BOOL LASreaderLAS::skip_chunk()
+{
+  // points that are skipped cannot be transformed
+  if ((peeked_points == 0) || transform || !reader->skip_chunk())
+  {
+    return FALSE;
+  }
+  p_idx += peeked_points;
+  p_cnt += peeked_points;
+  peeked_points = 0;
+  return TRUE;
+}
+
 ByteStreamIn* LASreaderLAS::get_stream() const
 {
   return stream;
@@ -1556,6 +1734,16 @@ void LASreaderLAS::close(BOOL close_stream)
       file_name = 0;
     }
   }
+  if (chunk_statistics)
+  {
+    delete chunk_statistics;
+    chunk_statistics = 0;
+  }
+  if (chunk_starts)
+  {
+    delete [] chunk_starts;
+    chunk_starts = 0;
+  }
 }
 
 LASreaderLAS::LASreaderLAS(LASreadOpener* opener) : LASreader(opener)
@@ -1567,10 +1755,16 @@ LASreaderLAS::LASreaderLAS(LASreadOpener* opener) : LASreader(opener)
   reader = 0;
   keep_copc = FALSE;
   checked_end = FALSE;
+  use_chunk_summaries = TRUE;
+  chunk_statistics = 0;
+  chunk_starts = 0;
+  next_chunk_start = I64_MAX;
+  peeked_points = 0;
 }
 
 LASreaderLAS::~LASreaderLAS()
 {
+  LASnoThrowScope no_throw;
   if (reader || stream) close(TRUE);
 }
 
@@ -1634,6 +1828,10 @@ BOOL LASreaderLASrescale::open(ByteStreamIn* stream, BOOL peek_only, U32 decompr
     rescale_z = TRUE;
   }
 
+  // the chunk summaries are in the integers of the original quantization
+
+  if (rescale_x || rescale_y || rescale_z) use_chunk_summaries = FALSE;
+
   // (maybe) make sure rescale does not cause integer overflow for bounding box
 
   if (check_for_overflow)
@@ -1776,6 +1974,10 @@ BOOL LASreaderLASreoffset::open(ByteStreamIn* stream, BOOL peek_only, U32 decomp
     reoffset_z = TRUE;
   }
 
+  // the chunk summaries are in the integers of the original quantization
+
+  if (reoffset_x || reoffset_y || reoffset_z) use_chunk_summaries = FALSE;
+
   // make sure reoffset does not cause integer overflow for bounding box
 
   F64 temp_f;
@@ -1931,6 +2133,10 @@ BOOL LASreaderLASrescalereoffset::open(ByteStreamIn* stream, BOOL peek_only, U32
     reoffset_z = TRUE;
   }
 
+  // the chunk summaries are in the integers of the original quantization
+
+  if (reoffset_x || reoffset_y || reoffset_z) use_chunk_summaries = FALSE;
+
   // make sure rescale & reoffset do not cause integer overflow for bounding box
 
   F64 temp_f;
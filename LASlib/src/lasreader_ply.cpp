@@ -87,6 +87,10 @@ BOOL LASreaderPLY::open(FILE* file, const CHAR* file_name, U8 point_type, BOOL p
 
   this->file = file;
 
+  // remember how many attributes were added before parsing the header
+
+  I32 number_given_attributes = number_attributes;
+
   // create parse string
 
   if (!parse_header())
@@ -436,7 +440,9 @@ BOOL LASreaderPLY::open(FILE* file, const CHAR* file_name, U8 point_type, BOOL p
 
     this->file = file;
 
-    // load the header a second time
+    // load the header a second time without adding its attributes again
+
+    number_attributes = number_given_attributes;
 
     if (!parse_header())
     {
@@ -644,6 +650,17 @@ BOOL LASreaderPLY::read_point_default()
     {
       if (streamin) // binary
       {
+        if ((block_next == block_count) && !read_binary_block())
+        {
+          LASMessage(LAS_WARNING, "end-of-file after %lld of %lld points", p_idx, npoints);
+
+          npoints = p_idx;
+          if (!populated_header)
+          {
+            populate_bounding_box();
+          }
+          return FALSE;
+        }
         read_binary_point();
       }
       else // ascii
@@ -834,6 +851,22 @@ void LASreaderPLY::clean()
     free(type_string);
     type_string = 0;
   }
+  if (vertex_block)
+  {
+    free(vertex_block);
+    vertex_block = 0;
+  }
+  if (vertex_values)
+  {
+    free(vertex_values);
+    vertex_values = 0;
+  }
+  number_properties = 0;
+  vertex_size = 0;
+  block_size = 0;
+  block_count = 0;
+  block_next = 0;
+  block_vertices = 0;
   populated_header = FALSE;
 }
 
@@ -845,6 +878,9 @@ LASreaderPLY::LASreaderPLY(LASreadOpener* opener) :LASreader(opener)
   point_type = 0;
   parse_string = 0;
   type_string = 0;
+  swap_bytes = FALSE;
+  vertex_block = 0;
+  vertex_values = 0;
   scale_factor = 0;
   offset = 0;
   translate_intensity = 0.0f;
@@ -1039,111 +1075,227 @@ BOOL LASreaderPLY::set_attribute(I32 index, F64 value)
   return TRUE;
 }
 
-F64 LASreaderPLY::read_binary_value(CHAR type)
+void LASreaderPLY::compile_vertex_layout()
 {
-  F64 value = 0;
+  const CHAR* p = parse_string;
+  const CHAR* t = type_string;
 
-  if (type == 'f')
-  {
-    F32 temp_f32;
-    streamin->get32bitsLE((U8*)&temp_f32);
-    value = (F64)temp_f32;
-  }
-  else if (type == 'd')
-  {
-    streamin->get64bitsLE((U8*)&value);
-  }
-  else if (type == 'C')
-  {
-    U8 temp_u8 = (U8)(streamin->getByte());
-    value = (F64)temp_u8;
-  }
-  else if (type == 'c')
-  {
-    I8 temp_i8 = (I8)(streamin->getByte());
-    value = (F64)temp_i8;
-  }
-  else if (type == 'I')
+  number_properties = 0;
+  vertex_size = 0;
+
+  // map every property once to its offset, type, and target within a vertex
+
+  while (p[0] && t[0])
   {
-    U32 temp_u32;
-    streamin->get32bitsLE((U8*)&temp_u32);
-    value = (F64)temp_u32;
+    property_offsets[number_properties] = vertex_size;
+    property_fields[number_properties] = p[0];
+    property_types[number_properties] = t[0];
+    property_attributes[number_properties] = -1;
+    if ((p[0] >= '0') && (p[0] <= '9')) // attribute number 0 to 9
+    {
+      property_attributes[number_properties] = (I32)(p[0] - '0');
+    }
+    else if (p[0] == '(') // attribute number 10 or higher
+    {
+      I32 index = 0;
+      while (p[1] >= '0' && p[1] <= '9')
+      {
+        p++;
+        index = 10*index + (I32)(p[0] - '0');
+      }
+      property_attributes[number_properties] = index;
+    }
+    if (t[0] == 'd')
+    {
+      vertex_size += 8;
+    }
+    else if ((t[0] == 'C') || (t[0] == 'c'))
+    {
+      vertex_size += 1;
+    }
+    else if ((t[0] == 'S') || (t[0] == 's'))
+    {
+      vertex_size += 2;
+    }
+    else
+    {
+      vertex_size += 4;
+    }
+    number_properties++;
+    p++;
+    t++;
   }
-  else if (type == 'i')
+
+  // allocate a block of vertices that is about the size of the input buffer
+
+  block_size = LAS_TOOLS_IO_IBUFFER_SIZE / (vertex_size ? vertex_size : 1);
+  if (block_size == 0) block_size = 1;
+  if (vertex_block) free(vertex_block);
+  vertex_block = (U8*)malloc((size_t)block_size*vertex_size);
+  if (vertex_values) free(vertex_values);
+  vertex_values = (F64*)malloc(sizeof(F64)*(size_t)block_size*(number_properties ? number_properties : 1));
+  block_count = 0;
+  block_next = 0;
+  block_vertices = 0;
+}
+
+BOOL LASreaderPLY::read_binary_block()
+{
+  // read as many vertices as fit into the block with one fread
+
+  U32 count = block_size;
+  if ((npoints - block_vertices) < (I64)count)
   {
-    I32 temp_i32;
-    streamin->get32bitsLE((U8*)&temp_i32);
-    value = (F64)temp_i32;
+    count = (U32)(npoints - block_vertices);
   }
-  else if (type == 'S')
+  if (count) count = (U32)fread(vertex_block, vertex_size, count, file);
+  block_count = count;
+  block_next = 0;
+  block_vertices += count;
+  if (count == 0)
   {
-    U16 temp_u16;
-    streamin->get16bitsLE((U8*)&temp_u16);
-    value = (F64)temp_u16;
+    return FALSE;
   }
-  else if (type == 's')
+
+  // convert each property for the entire block in a tight loop
+
+  U32 i, k;
+  for (k = 0; k < number_properties; k++)
   {
-    I16 temp_i16;
-    streamin->get16bitsLE((U8*)&temp_i16);
-    value = (F64)temp_i16;
+    const U8* bytes = vertex_block + property_offsets[k];
+    F64* values = vertex_values + (size_t)k*block_size;
+    switch (property_types[k])
+    {
+    case 'f':
+      for (i = 0; i < count; i++, bytes += vertex_size)
+      {
+        U32 temp_u32;
+        F32 temp_f32;
+        memcpy(&temp_u32, bytes, 4);
+        if (swap_bytes) temp_u32 = ((temp_u32 >> 24) | ((temp_u32 >> 8) & 0xFF00) | ((temp_u32 << 8) & 0xFF0000) | (temp_u32 << 24));
+        memcpy(&temp_f32, &temp_u32, 4);
+        values[i] = (F64)temp_f32;
+      }
+      break;
+    case 'd':
+      for (i = 0; i < count; i++, bytes += vertex_size)
+      {
+        U8 temp_u8[8];
+        if (swap_bytes)
+        {
+          temp_u8[0] = bytes[7]; temp_u8[1] = bytes[6]; temp_u8[2] = bytes[5]; temp_u8[3] = bytes[4];
+          temp_u8[4] = bytes[3]; temp_u8[5] = bytes[2]; temp_u8[6] = bytes[1]; temp_u8[7] = bytes[0];
+          memcpy(&values[i], temp_u8, 8);
+        }
+        else
+        {
+          memcpy(&values[i], bytes, 8);
+        }
+      }
+      break;
+    case 'C':
+      for (i = 0; i < count; i++, bytes += vertex_size)
+      {
+        values[i] = (F64)bytes[0];
+      }
+      break;
+    case 'c':
+      for (i = 0; i < count; i++, bytes += vertex_size)
+      {
+        values[i] = (F64)((I8)bytes[0]);
+      }
+      break;
+    case 'I':
+    case 'i':
+      for (i = 0; i < count; i++, bytes += vertex_size)
+      {
+        U32 temp_u32;
+        memcpy(&temp_u32, bytes, 4);
+        if (swap_bytes) temp_u32 = ((temp_u32 >> 24) | ((temp_u32 >> 8) & 0xFF00) | ((temp_u32 << 8) & 0xFF0000) | (temp_u32 << 24));
+        values[i] = (property_types[k] == 'I' ? (F64)temp_u32 : (F64)((I32)temp_u32));
+      }
+      break;
+    case 'S':
+    case 's':
+      for (i = 0; i < count; i++, bytes += vertex_size)
+      {
+        U16 temp_u16;
+        memcpy(&temp_u16, bytes, 2);
+        if (swap_bytes) temp_u16 = (U16)((temp_u16 >> 8) | (temp_u16 << 8));
+        values[i] = (property_types[k] == 'S' ? (F64)temp_u16 : (F64)((I16)temp_u16));
+      }
+      break;
+    default:
+      for (i = 0; i < count; i++)
+      {
+        values[i] = 0.0;
+      }
+    }
   }
-  return value;
+  return TRUE;
 }
 
 BOOL LASreaderPLY::read_binary_point()
 {
-  const CHAR* p = parse_string;
-  const CHAR* t = type_string;
+  if (block_next == block_count)
+  {
+    if (!read_binary_block()) return FALSE;
+  }
+
+  const F64* values = vertex_values + block_next;
+  block_next++;
 
   F64 value;
+  U32 k;
 
-  while (p[0])
+  for (k = 0; k < number_properties; k++, values += block_size)
   {
-    value = read_binary_value(t[0]);
-    if (p[0] == 'x') // we expect the x coordinate
+    value = values[0];
+    CHAR field = property_fields[k];
+    if (field == 'x') // we expect the x coordinate
     {
       point.coordinates[0] = value;
     }
-    else if (p[0] == 'y') // we expect the y coordinate
+    else if (field == 'y') // we expect the y coordinate
     {
       point.coordinates[1] = value;
     }
-    else if (p[0] == 'z') // we expect the x coordinate
+    else if (field == 'z') // we expect the x coordinate
     {
       point.coordinates[2] = value;
     }
-    else if (p[0] == 't') // we expect the gps time
+    else if (field == 't') // we expect the gps time
     {
       point.set_gps_time(value);
     }
-    else if (p[0] == 'R') // we expect the red channel of the RGB field
+    else if (field == 'R') // we expect the red channel of the RGB field
     {
       point.rgb[0] = U16_QUANTIZE(value);
     }
-    else if (p[0] == 'G') // we expect the green channel of the RGB field
+    else if (field == 'G') // we expect the green channel of the RGB field
     {
       point.rgb[1] = U16_QUANTIZE(value);
     }
-    else if (p[0] == 'B') // we expect the blue channel of the RGB field
+    else if (field == 'B') // we expect the blue channel of the RGB field
     {
       point.rgb[2] = U16_QUANTIZE(value);
     }
-    else if (p[0] == 'I') // we expect the NIR channel of LAS 1.4 point type 8
+    else if (field == 'I') // we expect the NIR channel of LAS 1.4 point type 8
     {
       point.rgb[3] = U16_QUANTIZE(value);
     }
-    else if (p[0] == 's') // we expect a string or a number that we don't care about
+    else if (field == 's') // we expect a string or a number that we don't care about
     {
       // ignore
     }
-    else if (p[0] == 'i') // we expect the intensity
+    else if (field == 'i') // we expect the intensity
     {
       if (translate_intensity != 0.0f) value = value+translate_intensity;
       if (scale_intensity != 1.0f) value = value*scale_intensity;
       if (value < 0.0 || value >= 65535.5) LASMessage(LAS_WARNING, "intensity %g is out of range of unsigned short", value);
       point.set_intensity(U16_QUANTIZE(value));
     }
-    else if (p[0] == 'n') // we expect the number of returns of given pulse
+    else if (field == 'n') // we expect the number of returns of given pulse
     {
       if (point_type > 5)
       {
@@ -1156,7 +1308,7 @@ BOOL LASreaderPLY::read_binary_point()
         point.set_number_of_returns(U8_QUANTIZE(value) & 7);
       }
     }
-    else if (p[0] == 'r') // we expect the number of the return
+    else if (field == 'r') // we expect the number of the return
     {
       if (point_type > 5)
       {
@@ -1169,42 +1321,28 @@ BOOL LASreaderPLY::read_binary_point()
         point.set_return_number(U8_QUANTIZE(value) & 7);
       }
     }
-    else if (p[0] == 'c') // we expect the classification
+    else if (field == 'c') // we expect the classification
     {
       point.set_classification_int(static_cast<I32>(value));
     }
-    else if (p[0] == 'u') // we expect the user data
+    else if (field == 'u') // we expect the user data
     {
       if ((value < 0) || (value > 255)) LASMessage(LAS_WARNING, "user data %g is out of range of eight bits", value);
       point.set_user_data(U8_QUANTIZE(value));
     }
-    else if (p[0] == 'p') // we expect the point source ID
+    else if (field == 'p') // we expect the point source ID
     {
       if ((value < 0) || (value > 65535)) LASMessage(LAS_WARNING, "point source ID %g is out of range of sixteen bits", value);
       point.set_point_source_ID(U16_QUANTIZE(value));
     }
-    else if ((p[0] >= '0') && (p[0] <= '9')) // we expect attribute number 0 to 9
-    {
-      I32 index = (I32)(p[0] - '0');
-      if (!set_attribute(index, value)) return FALSE;
-    }
-    else if (p[0] == '(') // we expect attribute number 10 or higher
+    else if (property_attributes[k] >= 0) // we expect an attribute
     {
-      p++;
-      I32 index = 0;
-      while (p[0] >= '0' && p[0] <= '9')
-      {
-        index = 10*index + (I32)(p[0] - '0');
-        p++;
-      }
-      if (!set_attribute(index, value)) return FALSE;
+      if (!set_attribute(property_attributes[k], value)) return FALSE;
     }
     else
     {
-      laserror("unknown symbol '%c' in parse string", p[0]);
+      laserror("unknown symbol '%c' in parse string", field);
     }
-    p++;
-    t++;
   }
   return TRUE;
 }
@@ -1579,10 +1717,12 @@ BOOL LASreaderPLY::parse_header()
       if (strncmp(&line[7], "binary_little_endian", 20) == 0)
       {
         streamin = new ByteStreamInFileLE(file);
+        swap_bytes = FALSE;
       }
-      else if (strncmp(&line[7], "binary_big_endian", 18) == 0)
+      else if (strncmp(&line[7], "binary_big_endian", 17) == 0)
       {
         streamin = new ByteStreamInFileBE(file);
+        swap_bytes = TRUE;
       }
       else if (strncmp(&line[7], "ascii", 5) == 0)
       {
@@ -1844,6 +1984,11 @@ BOOL LASreaderPLY::parse_header()
     LASMessage(LAS_VERBOSE, "parsed: %s", line);
   }
 
+  if (streamin) // binary
+  {
+    compile_vertex_layout();
+  }
+
   return TRUE;
 }
 
@@ -453,6 +453,7 @@ LASreaderQFIT::LASreaderQFIT(LASreadOpener* opener) :LASreader(opener)
 
 LASreaderQFIT::~LASreaderQFIT()
 {
+  LASnoThrowScope no_throw;
   if (stream) close();
 }
 
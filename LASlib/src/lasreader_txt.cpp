@@ -36,6 +36,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <thread>
+#include <vector>
+
 #ifdef _WIN32
 #include <windows.h>
 #endif
@@ -627,6 +630,10 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
     // populate scale and offset
 
     populate_scale_and_offset();
+    if (!fit_scale_and_offset())
+    {
+      return FALSE;
+    }
 
     // populate bounding box
 
@@ -1010,6 +1017,25 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
       }
     }
 
+    // when reading in batches the first batch is a sample for the provisional scale and offset
+
+    if (threads && read_batch())
+    {
+      for (i = 0; i < batch_count; i++)
+      {
+        if (batch_parsed[i])
+        {
+          const F64* coordinates = batch_points[i].coordinates;
+          if (coordinates[0] < header.min_x) header.min_x = coordinates[0];
+          else if (coordinates[0] > header.max_x) header.max_x = coordinates[0];
+          if (coordinates[1] < header.min_y) header.min_y = coordinates[1];
+          else if (coordinates[1] > header.max_y) header.max_y = coordinates[1];
+          if (coordinates[2] < header.min_z) header.min_z = coordinates[2];
+          else if (coordinates[2] > header.max_z) header.max_z = coordinates[2];
+        }
+      }
+    }
+
     // set scale and offset
 
     populate_scale_and_offset();
@@ -1098,6 +1124,164 @@ void LASreaderTXT::set_offset(const F64* offset)
   }
 }
 
+void LASreaderTXT::set_threads(I32 threads)
+{
+  this->threads = threads;
+}
+
+BOOL LASreaderTXT::init_batch()
+{
+  I32 i;
+  batch_size = 65536;
+  batch_capacity = 64 * batch_size;
+  batch_lines = (CHAR*)malloc(batch_capacity);
+  batch_starts = new I32[batch_size];
+  batch_parsed = new BOOL[batch_size];
+  batch_points = new LASpoint[batch_size];
+  if ((batch_lines == 0) || (batch_starts == 0) || (batch_parsed == 0) || (batch_points == 0))
+  {
+    laserror("allocating batch of %d lines", batch_size);
+    return FALSE;
+  }
+  for (i = 0; i < batch_size; i++)
+  {
+    batch_points[i].init(&header, header.point_data_format, header.point_data_record_length, &header);
+  }
+  // every parser has its own line and point but shares how to parse them
+  parsers = new LASreaderTXT*[threads];
+  for (i = 0; i < threads; i++)
+  {
+    LASreaderTXT* parser = new LASreaderTXT(opener);
+    parser->point_type = point_type;
+    parser->translate_intensity = translate_intensity;
+    parser->scale_intensity = scale_intensity;
+    parser->translate_scan_angle = translate_scan_angle;
+    parser->scale_scan_angle = scale_scan_angle;
+    memcpy(parser->attribute_pre_scales, attribute_pre_scales, sizeof(attribute_pre_scales));
+    memcpy(parser->attribute_pre_offsets, attribute_pre_offsets, sizeof(attribute_pre_offsets));
+    memcpy(parser->attribute_starts, attribute_starts, sizeof(attribute_starts));
+    if (header.number_attributes)
+    {
+      parser->header.init_attributes(header.number_attributes, header.attributes);
+    }
+    parser->point.init(&header, header.point_data_format, header.point_data_record_length, &header);
+    parsers[i] = parser;
+  }
+  batch_count = 0;
+  batch_next = 0;
+  return TRUE;
+}
+
+BOOL LASreaderTXT::read_batch()
+{
+  if ((batch_lines == 0) && !init_batch())
+  {
+    return FALSE;
+  }
+
+  // read as many lines as fit into the batch
+
+  I32 used = 0;
+  batch_count = 0;
+  batch_next = 0;
+  while ((batch_count < batch_size) && ((used + 512) <= batch_capacity) && fgets(batch_lines + used, 512, file))
+  {
+    batch_starts[batch_count] = used;
+    used += (I32)strlen(batch_lines + used) + 1;
+    batch_count++;
+  }
+  if (batch_count == 0)
+  {
+    return FALSE;
+  }
+
+  // parse contiguous ranges of lines on every thread
+
+  if (threads > 1)
+  {
+    I32 lines_per_thread = (batch_count + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (I32 t = 0; t < threads; t++)
+    {
+      I32 begin = t * lines_per_thread;
+      I32 end = (begin + lines_per_thread < batch_count ? begin + lines_per_thread : batch_count);
+      if (begin < end) workers.push_back(std::thread(&LASreaderTXT::parse_batch, this, t, begin, end));
+    }
+    for (size_t t = 0; t < workers.size(); t++) workers[t].join();
+  }
+  else
+  {
+    parse_batch(0, 0, batch_count);
+  }
+  return TRUE;
+}
+
+void LASreaderTXT::parse_batch(I32 parser, I32 begin, I32 end)
+{
+  LASreaderTXT* p = parsers[parser];
+  for (I32 i = begin; i < end; i++)
+  {
+    strcpy(p->line, batch_lines + batch_starts[i]);
+    batch_parsed[i] = p->parse(parse_string);
+    if (batch_parsed[i])
+    {
+      batch_points[i] = p->point;
+      batch_points[i].coordinates[0] = p->point.coordinates[0];
+      batch_points[i].coordinates[1] = p->point.coordinates[1];
+      batch_points[i].coordinates[2] = p->point.coordinates[2];
+    }
+  }
+}
+
+BOOL LASreaderTXT::next_batch_point()
+{
+  I32 i = batch_next;
+  batch_next++;
+  if (batch_parsed[i])
+  {
+    point = batch_points[i];
+    point.coordinates[0] = batch_points[i].coordinates[0];
+    point.coordinates[1] = batch_points[i].coordinates[1];
+    point.coordinates[2] = batch_points[i].coordinates[2];
+    return TRUE;
+  }
+  // keep the line for the warning
+  strcpy(line, batch_lines + batch_starts[i]);
+  return FALSE;
+}
+
+void LASreaderTXT::clean_batch()
+{
+  if (parsers)
+  {
+    for (I32 i = 0; i < threads; i++) delete parsers[i];
+    delete[] parsers;
+    parsers = 0;
+  }
+  if (batch_lines)
+  {
+    free(batch_lines);
+    batch_lines = 0;
+  }
+  if (batch_starts)
+  {
+    delete[] batch_starts;
+    batch_starts = 0;
+  }
+  if (batch_parsed)
+  {
+    delete[] batch_parsed;
+    batch_parsed = 0;
+  }
+  if (batch_points)
+  {
+    delete[] batch_points;
+    batch_points = 0;
+  }
+  batch_count = 0;
+  batch_next = 0;
+}
+
 void LASreaderTXT::add_attribute(I32 data_type, const char* name, const char* description, F64 scale, F64 offset, F64 pre_scale, F64 pre_offset, F64 no_data)
 {
   attributes_data_types[number_attributes] = data_type;
@@ -1138,6 +1322,8 @@ BOOL LASreaderTXT::seek(const I64 p_index)
   {
     if (piped) return FALSE;
     fseek(file, 0, SEEK_SET);
+    batch_count = 0;
+    batch_next = 0;
     // skip lines if we have to
     int i;
     for (i = 0; i < skip_lines; i++) fgets(line, 512, file);
@@ -1184,9 +1370,9 @@ BOOL LASreaderTXT::read_point_default()
   {
     while (true)
     {
-      if (fgets(line, 512, file))
+      if (threads ? ((batch_next < batch_count) || read_batch()) : (fgets(line, 512, file) != 0))
       {
-        if (parse(parse_string))
+        if (threads ? next_batch_point() : parse(parse_string))
         {
           break;
         }
@@ -1215,7 +1401,8 @@ BOOL LASreaderTXT::read_point_default()
             }
           }
           npoints = p_idx;
-          populate_bounding_box();
+          // keep the exact bounding box for quantizing again after an overflow
+          if (!quantization_overflow) populate_bounding_box();
         }
         return FALSE;
       }
@@ -1224,9 +1411,17 @@ BOOL LASreaderTXT::read_point_default()
   // compute the quantized x, y, and z values
   if (opener->is_offset_adjust() == FALSE) 
   {
-    point.set_X((I32)header.get_X(point.coordinates[0]));
-    point.set_Y((I32)header.get_Y(point.coordinates[1]));
-    point.set_Z((I32)header.get_Z(point.coordinates[2]));
+    I64 X = header.get_X(point.coordinates[0]);
+    I64 Y = header.get_Y(point.coordinates[1]);
+    I64 Z = header.get_Z(point.coordinates[2]);
+    if (!populated_header && !quantization_overflow && ((X < I32_MIN) || (X > I32_MAX) || (Y < I32_MIN) || (Y > I32_MAX) || (Z < I32_MIN) || (Z > I32_MAX)))
+    {
+      LASMessage(LAS_WARNING, "point %lld at (%g %g %g) does not fit into 32 bit integers with the scale and offset chosen from the first points", p_idx, point.coordinates[0], point.coordinates[1], point.coordinates[2]);
+      quantization_overflow = TRUE;
+    }
+    point.set_X((I32)X);
+    point.set_Y((I32)Y);
+    point.set_Z((I32)Z);
   } 
   else
   {
@@ -1321,9 +1516,23 @@ BOOL LASreaderTXT::reopen(const char* file_name)
     LASMessage(LAS_WARNING, "setvbuf() failed with buffer size %d", 10 * LAS_TOOLS_IO_IBUFFER_SIZE);
   }
 
-  // skip lines if we have to
+  // skip lines or the PTS or PTX header if we have to
 
-  for (i = 0; i < skip_lines; i++) fgets(line, 512, file);
+  if (skip_lines)
+  {
+    for (i = 0; i < skip_lines; i++) fgets(line, 512, file);
+  }
+  else if (ipts)
+  {
+    fgets(line, 512, file);
+  }
+  else if (iptx || iptx_transform)
+  {
+    for (i = 0; i < 10; i++) fgets(line, 512, file);
+  }
+
+  batch_count = 0;
+  batch_next = 0;
 
   // read the first line with full parse_string
 
@@ -1352,6 +1561,35 @@ BOOL LASreaderTXT::reopen(const char* file_name)
     file = 0;
     return FALSE;
   }
+
+  // after an overflow quantize again with the bounding box of all points
+
+  if (quantization_overflow)
+  {
+    populate_scale_and_offset();
+    if (!fit_scale_and_offset())
+    {
+      fclose(file);
+      file = 0;
+      return FALSE;
+    }
+
+    for (i = 0; i < 5; i++) header.number_of_points_by_return[i] = 0;
+    for (i = 0; i < 15; i++) header.extended_number_of_points_by_return[i] = 0;
+
+    header.min_x = header.max_x = point.coordinates[0];
+    header.min_y = header.max_y = point.coordinates[1];
+    header.min_z = header.max_z = point.coordinates[2];
+
+    for (i = 0; i < number_attributes; i++)
+    {
+      header.attributes[i].set_min(point.extra_bytes + attribute_starts[i]);
+      header.attributes[i].set_max(point.extra_bytes + attribute_starts[i]);
+    }
+
+    quantization_overflow = FALSE;
+  }
+
   p_idx = 0;
   p_cnt = 0;
   return TRUE;
@@ -1374,8 +1612,10 @@ void LASreaderTXT::clean()
     free(parse_string_unparsed);
     parse_string_unparsed = 0;
   }
+  clean_batch();
   skip_lines = 0;
   populated_header = FALSE;
+  quantization_overflow = FALSE;
 }
 
 LASreaderTXT::LASreaderTXT(LASreadOpener* opener) :LASreader(opener)
@@ -1401,6 +1641,14 @@ LASreaderTXT::LASreaderTXT(LASreadOpener* opener) :LASreader(opener)
   orig_x_scale_factor = 0.01;
   orig_y_scale_factor = 0.01;
   orig_z_scale_factor = 0.01;
+  threads = 0;
+  batch_size = 0;
+  batch_capacity = 0;
+  batch_lines = 0;
+  batch_starts = 0;
+  batch_parsed = 0;
+  batch_points = 0;
+  parsers = 0;
   clean();
 }
 
@@ -2416,6 +2664,47 @@ void LASreaderTXT::populate_scale_and_offset()
   orig_z_offset = header.z_offset;
 }
 
+// the bounding box must quantize into 32 bit integers. a scale factor that
+// was not specified is made coarser by factors of ten until it does
+
+BOOL LASreaderTXT::fit_scale_and_offset()
+{
+  F64* scale[3] = { &header.x_scale_factor, &header.y_scale_factor, &header.z_scale_factor };
+  F64* offs[3] = { &header.x_offset, &header.y_offset, &header.z_offset };
+  F64 min[3] = { header.min_x, header.min_y, header.min_z };
+  F64 max[3] = { header.max_x, header.max_y, header.max_z };
+  BOOL coarsened = FALSE;
+  for (I32 i = 0; i < 3; i++)
+  {
+    if (!F64_IS_FINITE(min[i]) || !F64_IS_FINITE(max[i])) continue;
+    while ((((min[i] - *offs[i]) / *scale[i]) < I32_MIN) || (((max[i] - *offs[i]) / *scale[i]) > I32_MAX))
+    {
+      if (scale_factor || (*scale[i] >= 1e6))
+      {
+        laserror("coordinates from (%g %g %g) to (%g %g %g) do not fit into 32 bit integers with scale factor (%g %g %g) and offset (%g %g %g). use a coarser '-set_scale' or another '-set_offset'",
+          header.min_x, header.min_y, header.min_z, header.max_x, header.max_y, header.max_z,
+          header.x_scale_factor, header.y_scale_factor, header.z_scale_factor, header.x_offset, header.y_offset, header.z_offset);
+        return FALSE;
+      }
+      *scale[i] *= 10;
+      if (!offset) *offs[i] = ((I64)((min[i] + max[i]) / *scale[i] / 20000000)) * 10000000 * *scale[i];
+      coarsened = TRUE;
+    }
+  }
+  if (coarsened)
+  {
+    LASMessage(LAS_WARNING, "coarsened scale factor to (%g %g %g) so that coordinates from (%g %g %g) to (%g %g %g) fit into 32 bit integers",
+      header.x_scale_factor, header.y_scale_factor, header.z_scale_factor, header.min_x, header.min_y, header.min_z, header.max_x, header.max_y, header.max_z);
+    orig_x_scale_factor = header.x_scale_factor;
+    orig_y_scale_factor = header.y_scale_factor;
+    orig_z_scale_factor = header.z_scale_factor;
+    orig_x_offset = header.x_offset;
+    orig_y_offset = header.y_offset;
+    orig_z_offset = header.z_offset;
+  }
+  return TRUE;
+}
+
 void LASreaderTXT::populate_bounding_box()
 {
   // compute quantized and then unquantized bounding box
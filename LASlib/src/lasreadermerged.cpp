@@ -1340,6 +1340,56 @@ BOOL LASreaderMerged::read_point_default()
   return FALSE;
 }
 
+BOOL LASreaderMerged::peek_chunk(const U8** bytes, U32* num_bytes, U32* num_points)
+{
+  // the points of all files must be read as they are
+  if ((lasreaderlas == 0) || rescale || reoffset || point_type_change || point_size_change || additional_attribute_change || files_are_flightlines || apply_file_source_ID || transform || (filter && filter->active()) || inside || inside_depth)
+  {
+    return FALSE;
+  }
+  if (file_name_current == 0)
+  {
+    if (!open_next_file()) return FALSE;
+  }
+  while (lasreaderlas->p_idx >= lasreaderlas->npoints)
+  {
+    // the last file stays open for reading its end
+    if (file_name_current == file_name_number) return FALSE;
+    lasreaderlas->close();
+    point.zero();
+    if (!open_next_file()) return FALSE;
+  }
+  // only the chunks of files compressed like the first one can be copied
+  if (laszip_file != file_name_current)
+  {
+    const LASzip* laszip = lasreaderlas->header.laszip;
+    laszip_file = file_name_current;
+    laszip_same = header.laszip && laszip && (laszip->compressor == header.laszip->compressor) && (laszip->coder == header.laszip->coder) && (laszip->num_items == header.laszip->num_items);
+    for (U32 i = 0; laszip_same && (i < laszip->num_items); i++)
+    {
+      laszip_same = (laszip->items[i].type == header.laszip->items[i].type) && (laszip->items[i].size == header.laszip->items[i].size) && (laszip->items[i].version == header.laszip->items[i].version);
+    }
+  }
+  if (!laszip_same)
+  {
+    return FALSE;
+  }
+  return lasreaderlas->peek_chunk(bytes, num_bytes, num_points);
+}
+
+BOOL LASreaderMerged::skip_chunk()
+{
+  I64 p_skip = lasreaderlas->p_idx;
+  if (!lasreaderlas->skip_chunk())
+  {
+    return FALSE;
+  }
+  p_skip = lasreaderlas->p_idx - p_skip;
+  p_idx += p_skip;
+  p_cnt += p_skip;
+  return TRUE;
+}
+
 void LASreaderMerged::close(BOOL close_stream)
 {
   if (lasreader)
@@ -1377,6 +1427,8 @@ void LASreaderMerged::clean()
   point_type_change = FALSE;
   point_size_change = FALSE;
   additional_attribute_change = FALSE;
+  laszip_file = U32_MAX;
+  laszip_same = FALSE;
   rescale = FALSE;
   reoffset = FALSE;
   if (scale_factor)
@@ -1454,6 +1506,7 @@ LASreaderMerged::LASreaderMerged(LASreadOpener* opener) :LASreader(opener)
 
 LASreaderMerged::~LASreaderMerged()
 {
+  LASnoThrowScope no_throw;
   if (lasreader) close();
   clean();
 }
@@ -208,6 +208,7 @@ LASreaderPipeOn::LASreaderPipeOn(LASreadOpener* opener) :LASreader(opener)
 
 LASreaderPipeOn::~LASreaderPipeOn()
 {
+  LASnoThrowScope no_throw;
   if (lasreader || laswriter) close();
   if (lasreader) delete lasreader;
 }
@@ -287,6 +287,7 @@ LASreaderStored::LASreaderStored(LASreadOpener* opener) :LASreader(opener)
 
 LASreaderStored::~LASreaderStored()
 {
+  LASnoThrowScope no_throw;
   if (lasreader || laswriter) close();
   if (lasreader) delete lasreader;
   if (laswriter) delete laswriter;
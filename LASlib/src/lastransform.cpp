@@ -257,6 +257,10 @@ class LASoperationTranslateZ : public LASoperation
     {
         return sprintf(string, "-%s %lf ", name(), offset);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_Z;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_Z;
@@ -351,6 +355,14 @@ class LASoperationTranslateXYZ : public LASoperation
         this->offset[2] = z_offset;
     };
 
+    inline BOOL get_affine(F64* matrix, U32* coordinates) const
+    {
+        matrix[0] = 1.0; matrix[1] = 0.0; matrix[2] = 0.0; matrix[3] = offset[0];
+        matrix[4] = 0.0; matrix[5] = 1.0; matrix[6] = 0.0; matrix[7] = offset[1];
+        matrix[8] = 0.0; matrix[9] = 0.0; matrix[10] = 1.0; matrix[11] = offset[2];
+        *coordinates = LASTRANSFORM_XYZ_COORDINATE;
+        return TRUE;
+    };
    private:
     F64 offset[3];
 };
@@ -457,6 +469,10 @@ class LASoperationScaleZ : public LASoperation
     {
         return sprintf(string, "-%s %lf ", name(), scale);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_Z;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_Z;
@@ -550,6 +566,14 @@ class LASoperationScaleXYZ : public LASoperation
         this->scale[2] = z_scale;
     };
 
+    inline BOOL get_affine(F64* matrix, U32* coordinates) const
+    {
+        matrix[0] = scale[0]; matrix[1] = 0.0; matrix[2] = 0.0; matrix[3] = 0.0;
+        matrix[4] = 0.0; matrix[5] = scale[1]; matrix[6] = 0.0; matrix[7] = 0.0;
+        matrix[8] = 0.0; matrix[9] = 0.0; matrix[10] = scale[2]; matrix[11] = 0.0;
+        *coordinates = LASTRANSFORM_XYZ_COORDINATE;
+        return TRUE;
+    };
    private:
     F64 scale[3];
 };
@@ -659,6 +683,10 @@ class LASoperationTranslateThenScaleZ : public LASoperation
     {
         return sprintf(string, "-%s %lf %lf ", name(), offset, scale);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_Z;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_Z;
@@ -804,6 +832,10 @@ class LASoperationTranslateScaleTranslateZ : public LASoperation
     {
         return sprintf(string, "-%s %lf %lf ", name(), offset, scale);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_Z;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_Z;
@@ -899,6 +931,14 @@ class LASoperationRotateXY : public LASoperation
         sin_angle = sin(3.141592653589793238462643383279502884197169 / 180 * angle);
     };
 
+    inline BOOL get_affine(F64* matrix, U32* coordinates) const
+    {
+        matrix[0] = cos_angle; matrix[1] = -sin_angle; matrix[2] = 0.0; matrix[3] = x_offset - cos_angle * x_offset + sin_angle * y_offset;
+        matrix[4] = sin_angle; matrix[5] = cos_angle; matrix[6] = 0.0; matrix[7] = y_offset - sin_angle * x_offset - cos_angle * y_offset;
+        matrix[8] = 0.0; matrix[9] = 0.0; matrix[10] = 1.0; matrix[11] = 0.0;
+        *coordinates = LASTRANSFORM_XY_COORDINATE;
+        return TRUE;
+    };
    private:
     F64 angle;
     F64 x_offset, y_offset;
@@ -964,6 +1004,14 @@ class LASoperationRotateXZ : public LASoperation
         sin_angle = sin(3.141592653589793238462643383279502884197169 / 180 * angle);
     };
 
+    inline BOOL get_affine(F64* matrix, U32* coordinates) const
+    {
+        matrix[0] = cos_angle; matrix[1] = 0.0; matrix[2] = -sin_angle; matrix[3] = x_offset - cos_angle * x_offset + sin_angle * z_offset;
+        matrix[4] = 0.0; matrix[5] = 1.0; matrix[6] = 0.0; matrix[7] = 0.0;
+        matrix[8] = sin_angle; matrix[9] = 0.0; matrix[10] = cos_angle; matrix[11] = z_offset - sin_angle * x_offset - cos_angle * z_offset;
+        *coordinates = LASTRANSFORM_X_COORDINATE | LASTRANSFORM_Z_COORDINATE;
+        return TRUE;
+    };
    private:
     F64 angle;
     F64 x_offset, z_offset;
@@ -1029,6 +1077,14 @@ class LASoperationRotateYZ : public LASoperation
         sin_angle = sin(3.141592653589793238462643383279502884197169 / 180 * angle);
     };
 
+    inline BOOL get_affine(F64* matrix, U32* coordinates) const
+    {
+        matrix[0] = 1.0; matrix[1] = 0.0; matrix[2] = 0.0; matrix[3] = 0.0;
+        matrix[4] = 0.0; matrix[5] = cos_angle; matrix[6] = -sin_angle; matrix[7] = y_offset - cos_angle * y_offset + sin_angle * z_offset;
+        matrix[8] = 0.0; matrix[9] = sin_angle; matrix[10] = cos_angle; matrix[11] = z_offset - sin_angle * y_offset - cos_angle * z_offset;
+        *coordinates = LASTRANSFORM_Y_COORDINATE | LASTRANSFORM_Z_COORDINATE;
+        return TRUE;
+    };
    private:
     F64 angle;
     F64 y_offset, z_offset;
@@ -1107,6 +1163,14 @@ class LASoperationTransformHelmert : public LASoperation
         scale = 1.0 + (1.0e-6 * m);
     };
 
+    inline BOOL get_affine(F64* matrix, U32* coordinates) const
+    {
+        matrix[0] = scale; matrix[1] = -scale * rz_rad; matrix[2] = scale * ry_rad; matrix[3] = dx;
+        matrix[4] = scale * rz_rad; matrix[5] = scale; matrix[6] = -scale * rx_rad; matrix[7] = dy;
+        matrix[8] = -scale * ry_rad; matrix[9] = scale * rx_rad; matrix[10] = scale; matrix[11] = dz;
+        *coordinates = LASTRANSFORM_XYZ_COORDINATE;
+        return TRUE;
+    };
    private:
     F64 dx, dy, dz, rx, ry, rz, m, rx_rad, ry_rad, rz_rad, scale;
 };
@@ -1170,6 +1234,14 @@ class LASoperationTransformAffine : public LASoperation
         this->ty = ty;
     };
 
+    inline BOOL get_affine(F64* matrix, U32* coordinates) const
+    {
+        matrix[0] = r * cosw; matrix[1] = r * sinw; matrix[2] = 0.0; matrix[3] = tx;
+        matrix[4] = -r * sinw; matrix[5] = r * cosw; matrix[6] = 0.0; matrix[7] = ty;
+        matrix[8] = 0.0; matrix[9] = 0.0; matrix[10] = 1.0; matrix[11] = 0.0;
+        *coordinates = LASTRANSFORM_XY_COORDINATE;
+        return TRUE;
+    };
    private:
     F64 r, w, cosw, sinw, tx, ty;
 };
@@ -1185,6 +1257,10 @@ class LASoperationClampZ : public LASoperation
     {
         return sprintf(string, "-%s %lf %lf ", name(), below, above);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_Z;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_Z;
@@ -1258,6 +1334,10 @@ class LASoperationClampZbelow : public LASoperation
     {
         return sprintf(string, "-%s %lf ", name(), below);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_Z;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_Z;
@@ -1317,6 +1397,10 @@ class LASoperationClampZabove : public LASoperation
     {
         return sprintf(string, "-%s %lf ", name(), above);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_Z;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_Z;
@@ -1376,6 +1460,10 @@ class LASoperationClampRGBto8Bit : public LASoperation
     {
         return sprintf(string, "-%s ", name());
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_RGB;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_RGB;
@@ -1529,6 +1617,10 @@ class LASoperationCopyIntensityIntoZ : public LASoperation
     {
         return sprintf(string, "-%s ", name());
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_Z;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
@@ -1559,6 +1651,10 @@ class LASoperationCopyUserDataIntoZ : public LASoperation
     {
         return sprintf(string, "-%s ", name());
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_Z;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_USER_DATA;
@@ -1668,6 +1764,10 @@ class LASoperationTranslateRawZ : public LASoperation
     {
         return sprintf(string, "-%s %d ", name(), offset);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_Z;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_Z;
@@ -1813,6 +1913,10 @@ class LASoperationClampRawZ : public LASoperation
     {
         return sprintf(string, "-%s %d %d ", name(), below, above);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_Z;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_Z;
@@ -1873,6 +1977,10 @@ class LASoperationSetIntensity : public LASoperation
     {
         return sprintf(string, "-%s %d ", name(), (I32)intensity);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
+    };
     inline F64* transform_coords_for_offset_adjustment(F64 x, F64 y, F64 z)
     {
       return get_offset_adjust_coord_without_trafo_changes(x, y, z);
@@ -1903,6 +2011,10 @@ class LASoperationScaleIntensity : public LASoperation
     {
         return sprintf(string, "-%s %g ", name(), scale);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
@@ -1938,6 +2050,10 @@ class LASoperationTranslateIntensity : public LASoperation
     {
         return sprintf(string, "-%s %g ", name(), offset);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
@@ -1973,6 +2089,10 @@ class LASoperationTranslateThenScaleIntensity : public LASoperation
     {
         return sprintf(string, "-%s %g %g ", name(), offset, scale);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
@@ -2010,6 +2130,10 @@ class LASoperationClampIntensity : public LASoperation
     {
         return sprintf(string, "-%s %u %u ", name(), (U32)below, (U32)above);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
@@ -2049,6 +2173,10 @@ class LASoperationClampIntensityBelow : public LASoperation
     {
         return sprintf(string, "-%s %u ", name(), (U32)below);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
@@ -2084,6 +2212,10 @@ class LASoperationClampIntensityAbove : public LASoperation
     {
         return sprintf(string, "-%s %u ", name(), (U32)above);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
@@ -2119,6 +2251,10 @@ class LASoperationMapIntensity : public LASoperation
     {
         return sprintf(string, "-%s \"%s\" ", name(), map_file_name);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
@@ -3160,6 +3296,10 @@ class LASoperationSetClassification : public LASoperation
     {
         return sprintf(string, "-%s %d ", name(), classification);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION;
+    };
     inline F64* transform_coords_for_offset_adjustment(F64 x, F64 y, F64 z)
     {
       return get_offset_adjust_coord_without_trafo_changes(x, y, z);
@@ -3189,6 +3329,10 @@ class LASoperationChangeClassificationFromTo : public LASoperation
     {
         return sprintf(string, "-%s %d %d ", name(), class_from, class_to);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION;
@@ -3261,6 +3405,10 @@ class LASoperationClassifyZbelowAs : public LASoperation
     {
         return sprintf(string, "-%s %lf %d ", name(), z_below, class_to);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_Z;
@@ -3310,6 +3458,10 @@ class LASoperationClassifyZaboveAs : public LASoperation
     {
         return sprintf(string, "-%s %lf %d ", name(), z_above, class_to);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_Z;
@@ -3358,6 +3510,10 @@ class LASoperationClassifyZbetweenAs : public LASoperation
     {
         return sprintf(string, "-%s %lf %lf %d ", name(), z_below, z_above, class_to);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_Z;
@@ -3409,6 +3565,10 @@ class LASoperationClassifyIntensityBelowAs : public LASoperation
     {
         return sprintf(string, "-%s %d %d ", name(), (I32)intensity_below, (I32)class_to);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
@@ -3448,6 +3608,10 @@ class LASoperationClassifyIntensityAboveAs : public LASoperation
     {
         return sprintf(string, "-%s %d %d ", name(), (I32)intensity_above, (I32)class_to);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
@@ -3487,6 +3651,10 @@ class LASoperationClassifyIntensityBetweenAs : public LASoperation
     {
         return sprintf(string, "-%s %d %d %d ", name(), (I32)intensity_below, (I32)intensity_above, (I32)class_to);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
@@ -3654,6 +3822,10 @@ class LASoperationCopyIntensityIntoClassification : public LASoperation
     {
         return sprintf(string, "-%s ", name());
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
@@ -3681,6 +3853,10 @@ class LASoperationSetWithheldFlag : public LASoperation
     {
         return sprintf(string, "-%s %d ", name(), flag);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_FLAGS;
+    };
     inline F64* transform_coords_for_offset_adjustment(F64 x, F64 y, F64 z)
     {
       return get_offset_adjust_coord_without_trafo_changes(x, y, z);
@@ -3711,6 +3887,10 @@ class LASoperationSetSyntheticFlag : public LASoperation
     {
         return sprintf(string, "-%s %d ", name(), flag);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_FLAGS;
+    };
     inline F64* transform_coords_for_offset_adjustment(F64 x, F64 y, F64 z)
     {
       return get_offset_adjust_coord_without_trafo_changes(x, y, z);
@@ -3741,6 +3921,10 @@ class LASoperationSetKeypointFlag : public LASoperation
     {
         return sprintf(string, "-%s %d ", name(), flag);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_FLAGS;
+    };
     inline F64* transform_coords_for_offset_adjustment(F64 x, F64 y, F64 z)
     {
       return get_offset_adjust_coord_without_trafo_changes(x, y, z);
@@ -3771,6 +3955,10 @@ class LASoperationSetExtendedOverlapFlag : public LASoperation
     {
         return sprintf(string, "-%s %d ", name(), flag);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_FLAGS;
+    };
     inline F64* transform_coords_for_offset_adjustment(F64 x, F64 y, F64 z)
     {
       return get_offset_adjust_coord_without_trafo_changes(x, y, z);
@@ -3801,6 +3989,10 @@ class LASoperationSetScanDirectionFlag : public LASoperation
     {
         return sprintf(string, "-%s %d ", name(), flag);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_FLAGS;
+    };
     inline F64* transform_coords_for_offset_adjustment(F64 x, F64 y, F64 z)
     {
       return get_offset_adjust_coord_without_trafo_changes(x, y, z);
@@ -3831,6 +4023,10 @@ class LASoperationSetEdgeOfFlightLine : public LASoperation
     {
         return sprintf(string, "-%s %d ", name(), flag);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_FLAGS;
+    };
     inline F64* transform_coords_for_offset_adjustment(F64 x, F64 y, F64 z)
     {
       return get_offset_adjust_coord_without_trafo_changes(x, y, z);
@@ -3891,6 +4087,10 @@ class LASoperationSetUserData : public LASoperation
     {
         return sprintf(string, "-%s %d ", name(), user_data);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_USER_DATA;
+    };
     inline F64* transform_coords_for_offset_adjustment(F64 x, F64 y, F64 z)
     {
       return get_offset_adjust_coord_without_trafo_changes(x, y, z);
@@ -3921,6 +4121,10 @@ class LASoperationScaleUserData : public LASoperation
     {
         return sprintf(string, "-%s %g ", name(), scale);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_USER_DATA;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_USER_DATA;
@@ -3955,6 +4159,10 @@ class LASoperationChangeUserDataFromTo : public LASoperation
     {
         return sprintf(string, "-%s %d %d ", name(), user_data_from, user_data_to);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_USER_DATA;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_USER_DATA;
@@ -3992,6 +4200,10 @@ class LASoperationMapUserData : public LASoperation
     {
         return sprintf(string, "-%s \"%s\" ", name(), map_file_name);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_USER_DATA;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_USER_DATA;
@@ -4058,6 +4270,10 @@ class LASoperationCopyClassificationIntoUserData : public LASoperation
     {
         return sprintf(string, "-%s ", name());
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_USER_DATA;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION;
@@ -4085,6 +4301,10 @@ class LASoperationCopyUserDataIntoClassification : public LASoperation
     {
         return sprintf(string, "-%s ", name());
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_USER_DATA;
@@ -4887,6 +5107,10 @@ class LASoperationSetRGB : public LASoperation
     {
         return sprintf(string, "-%s %d %d %d ", name(), RGB[0], RGB[1], RGB[2]);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_RGB;
+    };
     inline F64* transform_coords_for_offset_adjustment(F64 x, F64 y, F64 z)
     {
       return get_offset_adjust_coord_without_trafo_changes(x, y, z);
@@ -4919,6 +5143,10 @@ class LASoperationSetRGBofClass : public LASoperation
     {
         return sprintf(string, "-%s %d %d %d %d ", name(), c, RGB[0], RGB[1], RGB[2]);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_RGB;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION;
@@ -4958,6 +5186,10 @@ class LASoperationSetNIR : public LASoperation
     {
         return sprintf(string, "-%s %d ", name(), value);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_NIR;
+    };
     inline F64* transform_coords_for_offset_adjustment(F64 x, F64 y, F64 z)
     {
       return get_offset_adjust_coord_without_trafo_changes(x, y, z);
@@ -4988,6 +5220,10 @@ class LASoperationSetRGBofExtendedClass : public LASoperation
     {
         return sprintf(string, "-%s %d %d %d %d ", name(), c, RGB[0], RGB[1], RGB[2]);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_RGB;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION;
@@ -5027,6 +5263,10 @@ class LASoperationScaleRGB : public LASoperation
     {
         return sprintf(string, "-%s %g %g %g ", name(), scale[0], scale[1], scale[2]);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_RGB;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_RGB;
@@ -5065,6 +5305,10 @@ class LASoperationScaleRGBdown : public LASoperation
     {
         return sprintf(string, "-%s ", name());
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_RGB;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_RGB;
@@ -5094,6 +5338,10 @@ class LASoperationScaleRGBup : public LASoperation
     {
         return sprintf(string, "-%s ", name());
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_RGB;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_RGB;
@@ -5123,6 +5371,10 @@ class LASoperationScaleRGBto8bit : public LASoperation
     {
         return sprintf(string, "-%s ", name());
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_RGB;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_RGB;
@@ -5155,6 +5407,10 @@ class LASoperationScaleRGBto16bit : public LASoperation
     {
         return sprintf(string, "-%s ", name());
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_RGB;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_RGB;
@@ -5187,6 +5443,10 @@ class LASoperationScaleNIR : public LASoperation
     {
         return sprintf(string, "-%s %g ", name(), scale);
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_NIR;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_NIR;
@@ -5221,6 +5481,10 @@ class LASoperationScaleNIRdown : public LASoperation
     {
         return sprintf(string, "-%s ", name());
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_NIR;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_NIR;
@@ -5248,6 +5512,10 @@ class LASoperationScaleNIRup : public LASoperation
     {
         return sprintf(string, "-%s ", name());
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_NIR;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_NIR;
@@ -5275,6 +5543,10 @@ class LASoperationScaleNIRto8bit : public LASoperation
     {
         return sprintf(string, "-%s ", name());
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_NIR;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_NIR;
@@ -5305,6 +5577,10 @@ class LASoperationScaleNIRto16bit : public LASoperation
     {
         return sprintf(string, "-%s ", name());
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_NIR;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_NIR;
@@ -5448,6 +5724,10 @@ class LASoperationSwitchRG : public LASoperation
     {
         return sprintf(string, "-%s ", name());
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_RGB;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_RGB;
@@ -5477,6 +5757,10 @@ class LASoperationSwitchRB : public LASoperation
     {
         return sprintf(string, "-%s ", name());
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_RGB;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_RGB;
@@ -5506,6 +5790,10 @@ class LASoperationSwitchGB : public LASoperation
     {
         return sprintf(string, "-%s ", name());
     };
+    inline U32 get_recompress_selective() const
+    {
+        return LASZIP_DECOMPRESS_SELECTIVE_RGB;
+    };
     inline U32 get_decompress_selective() const
     {
         return LASZIP_DECOMPRESS_SELECTIVE_RGB;
@@ -6564,6 +6852,115 @@ class LASoperationTranslateAttribute : public LASoperation
     F64 offset;
 };
 
+// consecutive operations that are affine in x, y and z are composed into
+// one matrix. the chain dequantizes the coordinates once, transforms them and
+// quantizes only the coordinates that any of its operations writes so there
+// is no rounding to the integer grid between the operations
+
+class LASoperationAffineChain : public LASoperation
+{
+   public:
+    inline const CHAR* name() const
+    {
+        return "affine_chain";
+    };
+    inline I32 get_command(CHAR* string) const
+    {
+        I32 n = 0;
+        for (U32 i = 0; i < num_chained; i++) n += chained[i]->get_command(&string[n]);
+        return n;
+    };
+    inline U32 get_decompress_selective() const
+    {
+        U32 decompress_selective = LASZIP_DECOMPRESS_SELECTIVE_CHANNEL_RETURNS_XY;
+        for (U32 i = 0; i < num_chained; i++) decompress_selective |= chained[i]->get_decompress_selective();
+        return decompress_selective;
+    };
+    inline U32 get_recompress_selective() const
+    {
+        U32 recompress_selective = 0;
+        for (U32 i = 0; i < num_chained; i++) recompress_selective |= chained[i]->get_recompress_selective();
+        return recompress_selective;
+    };
+    inline F64* transform_coords_for_offset_adjustment(F64 x, F64 y, F64 z)
+    {
+      F64* tranformed_coord = new F64[3]{0.0, 0.0, 0.0};
+      tranformed_coord[0] = matrix[0] * x + matrix[1] * y + matrix[2] * z + matrix[3];
+      tranformed_coord[1] = matrix[4] * x + matrix[5] * y + matrix[6] * z + matrix[7];
+      tranformed_coord[2] = matrix[8] * x + matrix[9] * y + matrix[10] * z + matrix[11];
+      return tranformed_coord;
+    };
+    inline void transform(LASpoint* point)
+    {
+        F64 x = point->get_x();
+        F64 y = point->get_y();
+        F64 z = point->get_z();
+        if (coordinates & LASTRANSFORM_X_COORDINATE)
+        {
+          if (!point->set_x(matrix[0] * x + matrix[1] * y + matrix[2] * z + matrix[3]))
+          {
+            overflow++;
+          }
+        }
+        if (coordinates & LASTRANSFORM_Y_COORDINATE)
+        {
+          if (!point->set_y(matrix[4] * x + matrix[5] * y + matrix[6] * z + matrix[7]))
+          {
+            overflow++;
+          }
+        }
+        if (coordinates & LASTRANSFORM_Z_COORDINATE)
+        {
+          if (!point->set_z(matrix[8] * x + matrix[9] * y + matrix[10] * z + matrix[11]))
+          {
+            overflow++;
+          }
+        }
+    };
+    inline BOOL get_affine(F64* matrix, U32* coordinates) const
+    {
+        memcpy(matrix, this->matrix, 12 * sizeof(F64));
+        *coordinates = this->coordinates;
+        return TRUE;
+    };
+    // the operation is applied after those already in the chain
+    BOOL add(LASoperation* operation)
+    {
+        F64 m[12];
+        F64 c[12];
+        U32 op_coordinates;
+        if (!operation->get_affine(m, &op_coordinates)) return FALSE;
+        for (U32 r = 0; r < 3; r++)
+        {
+          for (U32 k = 0; k < 4; k++)
+          {
+            c[4 * r + k] = m[4 * r] * matrix[k] + m[4 * r + 1] * matrix[4 + k] + m[4 * r + 2] * matrix[8 + k];
+          }
+          c[4 * r + 3] += m[4 * r + 3];
+        }
+        memcpy(matrix, c, 12 * sizeof(F64));
+        coordinates |= op_coordinates;
+        chained[num_chained++] = operation;
+        return TRUE;
+    };
+    LASoperationAffineChain(U32 max_chained)
+    {
+        memset(matrix, 0, 12 * sizeof(F64));
+        matrix[0] = matrix[5] = matrix[10] = 1.0;
+        coordinates = 0;
+        num_chained = 0;
+        chained = new LASoperation*[max_chained];
+    };
+    // the chained operations belong to the LAStransform
+    ~LASoperationAffineChain() { delete [] chained; };
+
+   private:
+    F64 matrix[12];
+    U32 coordinates;
+    U32 num_chained;
+    LASoperation** chained;
+};
+
 void LAStransform::check_for_overflow() const
 {
     U32 i;
@@ -6576,11 +6973,21 @@ void LAStransform::check_for_overflow() const
             LASMessage(LAS_WARNING, "total of  %lld overflows caused by '%s'", operations[i]->get_overflow(), command);
         }
     }
+    for (i = 0; i < num_stages; i++)
+    {
+        if ((stage_sizes[i] > 1) && stages[i]->get_overflow())
+        {
+            char command[4096];
+            stages[i]->get_command(command);
+            LASMessage(LAS_WARNING, "total of  %lld overflows caused by '%s'", stages[i]->get_overflow(), command);
+        }
+    }
 }
 
 void LAStransform::clean()
 {
     U32 i;
+    clean_stages();
     for (i = 0; i < num_operations; i++)
     {
         delete operations[i];
@@ -10755,6 +11162,17 @@ U32 LAStransform::get_decompress_selective() const
     return decompress_selective;
 }
 
+U32 LAStransform::get_recompress_selective() const
+{
+    U32 recompress_selective = 0;
+    U32 i;
+    for (i = 0; i < num_operations; i++)
+    {
+        recompress_selective |= operations[i]->get_recompress_selective();
+    }
+    return recompress_selective;
+}
+
 void LAStransform::transform(LASpoint* point)
 {
     U32 i;
@@ -10765,8 +11183,9 @@ void LAStransform::transform(LASpoint* point)
             return;
         }
     }
-    for (i = 0; i < num_operations; i++) {
-      operations[i]->transform(point);
+    if (stages == 0) compile();
+    for (i = 0; i < num_stages; i++) {
+      stages[i]->transform(point);
     }
 }
 
@@ -10777,6 +11196,10 @@ void LAStransform::reset()
     {
         operations[i]->reset();
     }
+    for (i = 0; i < num_stages; i++)
+    {
+        if (stage_sizes[i] > 1) stages[i]->reset();
+    }
     memset(registers, 0, sizeof(F64) * 16);
 }
 
@@ -10789,6 +11212,9 @@ LAStransform::LAStransform()
     operations = 0;
     is_filtered = FALSE;
     filter = 0;
+    num_stages = 0;
+    stages = 0;
+    stage_sizes = 0;
 }
 
 LAStransform::~LAStransform()
@@ -10801,6 +11227,7 @@ LAStransform::~LAStransform()
 void LAStransform::adjust_offset(LASreader* lasreader, F64* scale_factor) 
 {
   if (!operations || !lasreader) return;
+  clean_stages();
 
   BOOL min_max_known = TRUE;
   F64* adj_offset = new F64[3]{0.0, 0.0, 0.0};
@@ -10919,6 +11346,7 @@ void LAStransform::adjust_offset(LASreader* lasreader, F64* scale_factor)
 
 void LAStransform::add_operation(LASoperation* transform_operation)
 {
+    clean_stages();
     if (num_operations == alloc_operations)
     {
         U32 i;
@@ -10940,6 +11368,7 @@ void LAStransform::add_operation(LASoperation* transform_operation)
 
 void LAStransform::delete_operation(const CHAR* name)
 {
+    clean_stages();
     if (operations)
     {
         U32 i;
@@ -10978,3 +11407,50 @@ void LAStransform::unsetPointSource()
 {
     delete_operation("set_point_source");
 }
+
+void LAStransform::compile()
+{
+    U32 i, j;
+    clean_stages();
+    stages = new LASoperation*[num_operations + 1];
+    stage_sizes = new U32[num_operations + 1];
+    num_stages = 0;
+    i = 0;
+    while (i < num_operations)
+    {
+        F64 matrix[12];
+        U32 coordinates;
+        j = i;
+        // the offset adjusting operations requantize with their own offsets
+        while ((j < num_operations) && !operations[j]->get_offset_adjust() && operations[j]->get_affine(matrix, &coordinates)) j++;
+        if ((j - i) > 1)
+        {
+            LASoperationAffineChain* chain = new LASoperationAffineChain(j - i);
+            for (U32 k = i; k < j; k++) chain->add(operations[k]);
+            stages[num_stages] = chain;
+            stage_sizes[num_stages] = j - i;
+            i = j;
+        }
+        else
+        {
+            stages[num_stages] = operations[i];
+            stage_sizes[num_stages] = 1;
+            i++;
+        }
+        num_stages++;
+    }
+}
+
+void LAStransform::clean_stages()
+{
+    U32 i;
+    for (i = 0; i < num_stages; i++)
+    {
+        if (stage_sizes[i] > 1) delete stages[i];
+    }
+    if (stages) delete[] stages;
+    if (stage_sizes) delete[] stage_sizes;
+    num_stages = 0;
+    stages = 0;
+    stage_sizes = 0;
+}
@@ -31,10 +31,16 @@
 #include "lasutility.hpp"
 
 #include "lasmessage.hpp"
+#include "bytestreamin_file.hpp"
+#include "bytestreamout_file.hpp"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <string>
 
 LASinventory::LASinventory()
 {
@@ -400,6 +406,546 @@ BOOL LASsummary::add(const LASpoint* point)
   return TRUE;
 }
 
+static BOOL lassummary_write_point(ByteStreamOut* stream, const LASpoint* point)
+{
+  // the 25 bytes from X to the extended return counts are laid out as in LASpoint::copy_to()
+  if (!stream->putBytes((const U8*)&(point->X), 25)) return FALSE;
+  if (!stream->put64bitsLE((const U8*)&(point->gps_time))) return FALSE;
+  for (U32 i = 0; i < 4; i++)
+  {
+    if (!stream->put16bitsLE((const U8*)&(point->rgb[i]))) return FALSE;
+  }
+  U8 index = point->wavepacket.getIndex();
+  U64 offset = point->wavepacket.getOffset();
+  U32 size = point->wavepacket.getSize();
+  F32 location = point->wavepacket.getLocation();
+  F32 xt = point->wavepacket.getXt();
+  F32 yt = point->wavepacket.getYt();
+  F32 zt = point->wavepacket.getZt();
+  if (!stream->putByte(index)) return FALSE;
+  if (!stream->put64bitsLE((const U8*)&offset)) return FALSE;
+  if (!stream->put32bitsLE((const U8*)&size)) return FALSE;
+  if (!stream->put32bitsLE((const U8*)&location)) return FALSE;
+  if (!stream->put32bitsLE((const U8*)&xt)) return FALSE;
+  if (!stream->put32bitsLE((const U8*)&yt)) return FALSE;
+  if (!stream->put32bitsLE((const U8*)&zt)) return FALSE;
+  U16 extra_bytes_number = (U16)point->extra_bytes_number;
+  if (!stream->put16bitsLE((const U8*)&extra_bytes_number)) return FALSE;
+  if (extra_bytes_number && !stream->putBytes(point->extra_bytes, extra_bytes_number)) return FALSE;
+  return TRUE;
+}
+
+static void lassummary_read_point(ByteStreamIn* stream, LASpoint* point)
+{
+  stream->getBytes((U8*)&(point->X), 25);
+  stream->get64bitsLE((U8*)&(point->gps_time));
+  for (U32 i = 0; i < 4; i++)
+  {
+    stream->get16bitsLE((U8*)&(point->rgb[i]));
+  }
+  U8 index = stream->getByte();
+  U64 offset;
+  U32 size;
+  F32 location, xt, yt, zt;
+  stream->get64bitsLE((U8*)&offset);
+  stream->get32bitsLE((U8*)&size);
+  stream->get32bitsLE((U8*)&location);
+  stream->get32bitsLE((U8*)&xt);
+  stream->get32bitsLE((U8*)&yt);
+  stream->get32bitsLE((U8*)&zt);
+  point->wavepacket.setIndex(index);
+  point->wavepacket.setOffset(offset);
+  point->wavepacket.setSize(size);
+  point->wavepacket.setLocation(location);
+  point->wavepacket.setXt(xt);
+  point->wavepacket.setYt(yt);
+  point->wavepacket.setZt(zt);
+  U16 extra_bytes_number;
+  stream->get16bitsLE((U8*)&extra_bytes_number);
+  if (point->extra_bytes_number != extra_bytes_number)
+  {
+    if (point->extra_bytes) delete [] point->extra_bytes;
+    point->extra_bytes = (extra_bytes_number ? new U8[extra_bytes_number] : 0);
+    point->extra_bytes_number = extra_bytes_number;
+  }
+  if (extra_bytes_number) stream->getBytes(point->extra_bytes, extra_bytes_number);
+}
+
+static BOOL lassummary_write_counters(ByteStreamOut* stream, const I64* counters, U32 number)
+{
+  for (U32 i = 0; i < number; i++)
+  {
+    if (!stream->put64bitsLE((const U8*)&(counters[i]))) return FALSE;
+  }
+  return TRUE;
+}
+
+static void lassummary_read_counters(ByteStreamIn* stream, I64* counters, U32 number)
+{
+  for (U32 i = 0; i < number; i++)
+  {
+    stream->get64bitsLE((U8*)&(counters[i]));
+  }
+}
+
+BOOL LASsummary::write(ByteStreamOut* stream) const
+{
+  if (!stream->putByte(first ? 0 : 1)) return FALSE;
+  if (!stream->put64bitsLE((const U8*)&number_of_point_records)) return FALSE;
+  if (!lassummary_write_counters(stream, number_of_points_by_return, 16)) return FALSE;
+  if (!lassummary_write_counters(stream, number_of_returns, 16)) return FALSE;
+  if (!lassummary_write_counters(stream, classification, 32)) return FALSE;
+  if (!lassummary_write_counters(stream, extended_classification, 256)) return FALSE;
+  if (!lassummary_write_counters(stream, &flagged_synthetic, 1)) return FALSE;
+  if (!lassummary_write_counters(stream, flagged_synthetic_classification, 256)) return FALSE;
+  if (!lassummary_write_counters(stream, &flagged_keypoint, 1)) return FALSE;
+  if (!lassummary_write_counters(stream, flagged_keypoint_classification, 256)) return FALSE;
+  if (!lassummary_write_counters(stream, &flagged_withheld, 1)) return FALSE;
+  if (!lassummary_write_counters(stream, flagged_withheld_classification, 256)) return FALSE;
+  if (!lassummary_write_counters(stream, &flagged_extended_overlap, 1)) return FALSE;
+  if (!lassummary_write_counters(stream, flagged_extended_overlap_classification, 256)) return FALSE;
+  if (!lassummary_write_point(stream, &min)) return FALSE;
+  if (!lassummary_write_point(stream, &max)) return FALSE;
+  for (U32 i = 0; i < 3; i++)
+  {
+    if (!stream->put16bitsLE((const U8*)&(xyz_low_digits_10[i]))) return FALSE;
+    if (!stream->put16bitsLE((const U8*)&(xyz_low_digits_100[i]))) return FALSE;
+    if (!stream->put16bitsLE((const U8*)&(xyz_low_digits_1000[i]))) return FALSE;
+    if (!stream->put16bitsLE((const U8*)&(xyz_low_digits_10000[i]))) return FALSE;
+  }
+  if (!lassummary_write_counters(stream, xyz_fluff_10, 3)) return FALSE;
+  if (!lassummary_write_counters(stream, xyz_fluff_100, 3)) return FALSE;
+  if (!lassummary_write_counters(stream, xyz_fluff_1000, 3)) return FALSE;
+  if (!lassummary_write_counters(stream, xyz_fluff_10000, 3)) return FALSE;
+  return TRUE;
+}
+
+BOOL LASsummary::read(ByteStreamIn* stream)
+{
+  try
+  {
+    first = (stream->getByte() == 0);
+    stream->get64bitsLE((U8*)&number_of_point_records);
+    lassummary_read_counters(stream, number_of_points_by_return, 16);
+    lassummary_read_counters(stream, number_of_returns, 16);
+    lassummary_read_counters(stream, classification, 32);
+    lassummary_read_counters(stream, extended_classification, 256);
+    lassummary_read_counters(stream, &flagged_synthetic, 1);
+    lassummary_read_counters(stream, flagged_synthetic_classification, 256);
+    lassummary_read_counters(stream, &flagged_keypoint, 1);
+    lassummary_read_counters(stream, flagged_keypoint_classification, 256);
+    lassummary_read_counters(stream, &flagged_withheld, 1);
+    lassummary_read_counters(stream, flagged_withheld_classification, 256);
+    lassummary_read_counters(stream, &flagged_extended_overlap, 1);
+    lassummary_read_counters(stream, flagged_extended_overlap_classification, 256);
+    lassummary_read_point(stream, &min);
+    lassummary_read_point(stream, &max);
+    for (U32 i = 0; i < 3; i++)
+    {
+      stream->get16bitsLE((U8*)&(xyz_low_digits_10[i]));
+      stream->get16bitsLE((U8*)&(xyz_low_digits_100[i]));
+      stream->get16bitsLE((U8*)&(xyz_low_digits_1000[i]));
+      stream->get16bitsLE((U8*)&(xyz_low_digits_10000[i]));
+    }
+    lassummary_read_counters(stream, xyz_fluff_10, 3);
+    lassummary_read_counters(stream, xyz_fluff_100, 3);
+    lassummary_read_counters(stream, xyz_fluff_1000, 3);
+    lassummary_read_counters(stream, xyz_fluff_10000, 3);
+  }
+  catch (...)
+  {
+    return FALSE;
+  }
+  return TRUE;
+}
+
+void LASchunkSummary::reset()
+{
+  number_of_points = 0;
+  min_X = max_X = 0;
+  min_Y = max_Y = 0;
+  min_Z = max_Z = 0;
+  min_gps_time = max_gps_time = 0.0;
+  min_intensity = max_intensity = 0;
+  return_numbers = 0;
+  memset(classifications, 0, 32);
+}
+
+void LASchunkSummary::add(const LASpoint* point)
+{
+  if (number_of_points == 0)
+  {
+    min_X = max_X = point->get_X();
+    min_Y = max_Y = point->get_Y();
+    min_Z = max_Z = point->get_Z();
+    min_gps_time = max_gps_time = point->get_gps_time();
+    min_intensity = max_intensity = point->get_intensity();
+  }
+  else
+  {
+    if (point->get_X() < min_X) min_X = point->get_X();
+    else if (point->get_X() > max_X) max_X = point->get_X();
+    if (point->get_Y() < min_Y) min_Y = point->get_Y();
+    else if (point->get_Y() > max_Y) max_Y = point->get_Y();
+    if (point->get_Z() < min_Z) min_Z = point->get_Z();
+    else if (point->get_Z() > max_Z) max_Z = point->get_Z();
+    if (point->get_gps_time() < min_gps_time) min_gps_time = point->get_gps_time();
+    else if (point->get_gps_time() > max_gps_time) max_gps_time = point->get_gps_time();
+    if (point->get_intensity() < min_intensity) min_intensity = point->get_intensity();
+    else if (point->get_intensity() > max_intensity) max_intensity = point->get_intensity();
+  }
+  U8 classification = point->get_classification();
+  classifications[classification >> 3] |= (1 << (classification & 7));
+  return_numbers |= (1 << (point->extended_point_type ? point->get_extended_return_number() : point->get_return_number()));
+  number_of_points++;
+}
+
+BOOL LASchunkSummary::write(ByteStreamOut* stream) const
+{
+  if (!stream->put32bitsLE((const U8*)&number_of_points)) return FALSE;
+  if (!stream->put32bitsLE((const U8*)&min_X)) return FALSE;
+  if (!stream->put32bitsLE((const U8*)&max_X)) return FALSE;
+  if (!stream->put32bitsLE((const U8*)&min_Y)) return FALSE;
+  if (!stream->put32bitsLE((const U8*)&max_Y)) return FALSE;
+  if (!stream->put32bitsLE((const U8*)&min_Z)) return FALSE;
+  if (!stream->put32bitsLE((const U8*)&max_Z)) return FALSE;
+  if (!stream->put64bitsLE((const U8*)&min_gps_time)) return FALSE;
+  if (!stream->put64bitsLE((const U8*)&max_gps_time)) return FALSE;
+  if (!stream->put16bitsLE((const U8*)&min_intensity)) return FALSE;
+  if (!stream->put16bitsLE((const U8*)&max_intensity)) return FALSE;
+  if (!stream->put16bitsLE((const U8*)&return_numbers)) return FALSE;
+  if (!stream->putBytes(classifications, 32)) return FALSE;
+  return TRUE;
+}
+
+BOOL LASchunkSummary::read(ByteStreamIn* stream)
+{
+  try
+  {
+    stream->get32bitsLE((U8*)&number_of_points);
+    stream->get32bitsLE((U8*)&min_X);
+    stream->get32bitsLE((U8*)&max_X);
+    stream->get32bitsLE((U8*)&min_Y);
+    stream->get32bitsLE((U8*)&max_Y);
+    stream->get32bitsLE((U8*)&min_Z);
+    stream->get32bitsLE((U8*)&max_Z);
+    stream->get64bitsLE((U8*)&min_gps_time);
+    stream->get64bitsLE((U8*)&max_gps_time);
+    stream->get16bitsLE((U8*)&min_intensity);
+    stream->get16bitsLE((U8*)&max_intensity);
+    stream->get16bitsLE((U8*)&return_numbers);
+    stream->getBytes(classifications, 32);
+  }
+  catch (...)
+  {
+    return FALSE;
+  }
+  return TRUE;
+}
+
+// the sidecar is only valid for the exact file it was computed for
+
+static BOOL lasstatistics_file_key(const CHAR* file_name, I64& file_size, I64& file_time)
+{
+  if (file_name == 0) return FALSE;
+  FILE* file = LASfopen(file_name, "rb");
+  if (file == 0) return FALSE;
+#ifdef _WIN32
+  struct _stat64 info;
+  BOOL success = (_fstat64(_fileno(file), &info) == 0);
+#else
+  struct stat info;
+  BOOL success = (fstat(fileno(file), &info) == 0);
+#endif
+  fclose(file);
+  if (!success) return FALSE;
+  file_size = (I64)info.st_size;
+#if defined(__linux__)
+  file_time = ((I64)info.st_mtim.tv_sec) * 1000000000 + (I64)info.st_mtim.tv_nsec;
+#else
+  file_time = (I64)info.st_mtime;
+#endif
+  return TRUE;
+}
+
+static std::string lasstatistics_file_name(const CHAR* file_name)
+{
+  return std::string(file_name) + ".stats";
+}
+
+void LASstatistics::init(const LASheader* header, U32 chunk_size)
+{
+  number_of_first_returns = 0;
+  number_of_intermediate_returns = 0;
+  number_of_last_returns = 0;
+  number_of_single_returns = 0;
+  number_of_all_returns = 0;
+  this->chunk_size = (chunk_size ? chunk_size : U32_MAX);
+  number_of_chunks = 0;
+  point_in_chunk = 0;
+  point_data_format = (header ? header->point_data_format : 0);
+  point_data_record_length = (header ? header->point_data_record_length : 0);
+  scale_factor[0] = (header ? header->x_scale_factor : 0.0);
+  scale_factor[1] = (header ? header->y_scale_factor : 0.0);
+  scale_factor[2] = (header ? header->z_scale_factor : 0.0);
+  offset[0] = (header ? header->x_offset : 0.0);
+  offset[1] = (header ? header->y_offset : 0.0);
+  offset[2] = (header ? header->z_offset : 0.0);
+  file_size = -1;
+  file_time = -1;
+  chunked = TRUE;
+}
+
+void LASstatistics::add(const LASpoint* point)
+{
+  summary.add(point);
+  if (point->is_first()) number_of_first_returns++;
+  if (point->is_intermediate()) number_of_intermediate_returns++;
+  if (point->is_last()) number_of_last_returns++;
+  if (point->is_single()) number_of_single_returns++;
+  number_of_all_returns++;
+  if (!chunked) return;
+  if (point_in_chunk == 0)
+  {
+    if (number_of_chunks == alloc_chunks)
+    {
+      alloc_chunks = (alloc_chunks ? 2 * alloc_chunks : 256);
+      chunks = (LASchunkSummary*)realloc_las(chunks, alloc_chunks * sizeof(LASchunkSummary));
+    }
+    chunks[number_of_chunks].reset();
+    number_of_chunks++;
+  }
+  chunks[number_of_chunks - 1].add(point);
+  point_in_chunk++;
+  if (point_in_chunk == chunk_size) point_in_chunk = 0;
+}
+
+void LASstatistics::chunk()
+{
+  point_in_chunk = 0;
+}
+
+BOOL LASstatistics::is_compatible(const LASheader* header) const
+{
+  if (header->point_data_format != point_data_format) return FALSE;
+  if (header->point_data_record_length != point_data_record_length) return FALSE;
+  if ((header->x_scale_factor != scale_factor[0]) || (header->y_scale_factor != scale_factor[1]) || (header->z_scale_factor != scale_factor[2])) return FALSE;
+  if ((header->x_offset != offset[0]) || (header->y_offset != offset[1]) || (header->z_offset != offset[2])) return FALSE;
+  I64 npoints = (header->number_of_point_records ? header->number_of_point_records : header->extended_number_of_point_records);
+  return (npoints == summary.number_of_point_records);
+}
+
+BOOL LASstatistics::write(ByteStreamOut* stream) const
+{
+  if (!stream->putBytes((const U8*)"LASS", 4))
+  {
+    LASMessage(LAS_WARNING, "(LASstatistics): writing signature");
+    return FALSE;
+  }
+  U32 version = 0;
+  if (!stream->put32bitsLE((const U8*)&version))
+  {
+    LASMessage(LAS_WARNING, "(LASstatistics): writing version");
+    return FALSE;
+  }
+  if (!stream->put64bitsLE((const U8*)&file_size) || !stream->put64bitsLE((const U8*)&file_time))
+  {
+    LASMessage(LAS_WARNING, "(LASstatistics): writing file key");
+    return FALSE;
+  }
+  if (!stream->putByte(point_data_format) || !stream->put16bitsLE((const U8*)&point_data_record_length))
+  {
+    LASMessage(LAS_WARNING, "(LASstatistics): writing point type");
+    return FALSE;
+  }
+  for (U32 i = 0; i < 3; i++)
+  {
+    if (!stream->put64bitsLE((const U8*)&(scale_factor[i])) || !stream->put64bitsLE((const U8*)&(offset[i])))
+    {
+      LASMessage(LAS_WARNING, "(LASstatistics): writing scale factor and offset");
+      return FALSE;
+    }
+  }
+  if (!summary.write(stream))
+  {
+    LASMessage(LAS_WARNING, "(LASstatistics): writing LASsummary");
+    return FALSE;
+  }
+  if (!stream->put64bitsLE((const U8*)&number_of_first_returns) ||
+      !stream->put64bitsLE((const U8*)&number_of_intermediate_returns) ||
+      !stream->put64bitsLE((const U8*)&number_of_last_returns) ||
+      !stream->put64bitsLE((const U8*)&number_of_single_returns) ||
+      !stream->put64bitsLE((const U8*)&number_of_all_returns))
+  {
+    LASMessage(LAS_WARNING, "(LASstatistics): writing return counts");
+    return FALSE;
+  }
+  return write_chunks(stream);
+}
+
+BOOL LASstatistics::write_chunks(ByteStreamOut* stream) const
+{
+  if (!stream->put32bitsLE((const U8*)&chunk_size) || !stream->put32bitsLE((const U8*)&number_of_chunks))
+  {
+    LASMessage(LAS_WARNING, "(LASstatistics): writing number of chunks");
+    return FALSE;
+  }
+  for (U32 i = 0; i < number_of_chunks; i++)
+  {
+    if (!chunks[i].write(stream))
+    {
+      LASMessage(LAS_WARNING, "(LASstatistics): writing chunk summary %u", i);
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+
+BOOL LASstatistics::read(ByteStreamIn* stream)
+{
+  CHAR signature[4];
+  U32 version;
+  try
+  {
+    stream->getBytes((U8*)signature, 4);
+    if (strncmp(signature, "LASS", 4) != 0) return FALSE;
+    stream->get32bitsLE((U8*)&version);
+    if (version != 0) return FALSE;
+    stream->get64bitsLE((U8*)&file_size);
+    stream->get64bitsLE((U8*)&file_time);
+    point_data_format = stream->getByte();
+    stream->get16bitsLE((U8*)&point_data_record_length);
+    for (U32 i = 0; i < 3; i++)
+    {
+      stream->get64bitsLE((U8*)&(scale_factor[i]));
+      stream->get64bitsLE((U8*)&(offset[i]));
+    }
+    if (!summary.read(stream)) return FALSE;
+    stream->get64bitsLE((U8*)&number_of_first_returns);
+    stream->get64bitsLE((U8*)&number_of_intermediate_returns);
+    stream->get64bitsLE((U8*)&number_of_last_returns);
+    stream->get64bitsLE((U8*)&number_of_single_returns);
+    stream->get64bitsLE((U8*)&number_of_all_returns);
+  }
+  catch (...)
+  {
+    return FALSE;
+  }
+  // the keyed file cannot hold more points than fit into its size
+  I64 npoints = summary.number_of_point_records;
+  if (point_data_record_length && (npoints > file_size / point_data_record_length)) npoints = file_size / point_data_record_length;
+  return read_chunks(stream, npoints);
+}
+
+// the number of chunks comes from a file and is trusted only as far as every
+// chunk holds at least one of the 'npoints' points
+
+BOOL LASstatistics::read_chunks(ByteStreamIn* stream, I64 npoints)
+{
+  try
+  {
+    stream->get32bitsLE((U8*)&chunk_size);
+    stream->get32bitsLE((U8*)&number_of_chunks);
+  }
+  catch (...)
+  {
+    return FALSE;
+  }
+  if ((npoints < 0) || ((I64)number_of_chunks > npoints + 1))
+  {
+    number_of_chunks = 0;
+    return FALSE;
+  }
+  if (number_of_chunks > alloc_chunks)
+  {
+    LASchunkSummary* temp = (LASchunkSummary*)realloc(chunks, (size_t)number_of_chunks * sizeof(LASchunkSummary));
+    if (temp == 0)
+    {
+      number_of_chunks = 0;
+      return FALSE;
+    }
+    chunks = temp;
+    alloc_chunks = number_of_chunks;
+  }
+  for (U32 i = 0; i < number_of_chunks; i++)
+  {
+    if (!chunks[i].read(stream)) return FALSE;
+  }
+  point_in_chunk = 0;
+  return TRUE;
+}
+
+BOOL LASstatistics::read(const CHAR* file_name)
+{
+  I64 size, time;
+  if (!lasstatistics_file_key(file_name, size, time)) return FALSE;
+  std::string fn = lasstatistics_file_name(file_name);
+  FILE* file = LASfopen(fn.c_str(), "rb");
+  if (file == 0) return FALSE;
+  ByteStreamIn* stream;
+  if (IS_LITTLE_ENDIAN())
+    stream = new ByteStreamInFileLE(file);
+  else
+    stream = new ByteStreamInFileBE(file);
+  BOOL success = read(stream);
+  delete stream;
+  fclose(file);
+  if (!success)
+  {
+    LASMessage(LAS_WARNING, "(LASstatistics): ignoring corrupt '%s'", fn.c_str());
+    return FALSE;
+  }
+  if ((file_size != size) || (file_time != time))
+  {
+    LASMessage(LAS_VERBOSE, "(LASstatistics): ignoring outdated '%s'", fn.c_str());
+    return FALSE;
+  }
+  return TRUE;
+}
+
+BOOL LASstatistics::write(const CHAR* file_name)
+{
+  if (!lasstatistics_file_key(file_name, file_size, file_time))
+  {
+    LASMessage(LAS_WARNING, "(LASstatistics): cannot stat '%s'", file_name);
+    return FALSE;
+  }
+  std::string fn = lasstatistics_file_name(file_name);
+  FILE* file = LASfopen(fn.c_str(), "wb");
+  if (file == 0)
+  {
+    LASMessage(LAS_WARNING, "(LASstatistics): cannot open file '%s' for write", fn.c_str());
+    return FALSE;
+  }
+  ByteStreamOut* stream;
+  if (IS_LITTLE_ENDIAN())
+    stream = new ByteStreamOutFileLE(file);
+  else
+    stream = new ByteStreamOutFileBE(file);
+  BOOL success = write(stream);
+  delete stream;
+  fclose(file);
+  if (success)
+  {
+    LASMessage(LAS_VERBOSE, "wrote statistics of %lld points in %u chunks to '%s'", number_of_all_returns, number_of_chunks, fn.c_str());
+  }
+  return success;
+}
+
+LASstatistics::LASstatistics()
+{
+  chunks = 0;
+  alloc_chunks = 0;
+  init(0, LASZIP_CHUNK_SIZE_DEFAULT);
+  // the chunk summaries are only needed for a sidecar
+  chunked = FALSE;
+}
+
+LASstatistics::~LASstatistics()
+{
+  if (chunks) free(chunks);
+}
+
 F64 LASbin::get_step() const
 {
   return step;
@@ -1369,6 +1915,133 @@ void LAShistogram::reset()
   if (return_map_bin_intensity) return_map_bin_intensity->reset();
 }
 
+// tiles of 64 x 64 cells with one 64 bit row per line of cells
+
+#define LAS_OCCUPANCY_TILE_BITS 6
+#define LAS_OCCUPANCY_TILE_ROWS 64
+
+// a scan line crosses several tiles so the recently used tiles are cached by
+// the lowest three bits of their x and y position
+
+#define LAS_OCCUPANCY_CACHE_BITS 3
+#define LAS_OCCUPANCY_CACHE_MASK ((1 << LAS_OCCUPANCY_CACHE_BITS) - 1)
+
+U64* LAStileHash::find(I64 key) const
+{
+  U32 i = slot(key);
+  while (tiles[i])
+  {
+    if (keys[i] == key) return tiles[i];
+    i = (i + 1) & (capacity - 1);
+  }
+  return 0;
+}
+
+U64* LAStileHash::get(I64 key)
+{
+  U32 i = slot(key);
+  while (tiles[i])
+  {
+    if (keys[i] == key) return tiles[i];
+    i = (i + 1) & (capacity - 1);
+  }
+  if (2*(number + 1) > capacity)
+  {
+    grow();
+    i = slot(key);
+    while (tiles[i]) i = (i + 1) & (capacity - 1);
+  }
+  keys[i] = key;
+  tiles[i] = new U64[words];
+  memset(tiles[i], 0, words*sizeof(U64));
+  number++;
+  return tiles[i];
+}
+
+void LAStileHash::reset()
+{
+  for (U32 i = 0; i < capacity; i++)
+  {
+    if (tiles[i])
+    {
+      delete [] tiles[i];
+      tiles[i] = 0;
+    }
+  }
+  number = 0;
+}
+
+void LAStileHash::grow()
+{
+  U32 old_capacity = capacity;
+  I64* old_keys = keys;
+  U64** old_tiles = tiles;
+  capacity = 2*capacity;
+  keys = new I64[capacity];
+  tiles = new U64*[capacity];
+  memset(tiles, 0, capacity*sizeof(U64*));
+  for (U32 j = 0; j < old_capacity; j++)
+  {
+    if (old_tiles[j])
+    {
+      U32 i = slot(old_keys[j]);
+      while (tiles[i]) i = (i + 1) & (capacity - 1);
+      keys[i] = old_keys[j];
+      tiles[i] = old_tiles[j];
+    }
+  }
+  delete [] old_keys;
+  delete [] old_tiles;
+}
+
+LAStileHash::LAStileHash(U32 words)
+{
+  this->words = words;
+  number = 0;
+  capacity = 256;
+  keys = new I64[capacity];
+  tiles = new U64*[capacity];
+  memset(tiles, 0, capacity*sizeof(U64*));
+}
+
+LAStileHash::~LAStileHash()
+{
+  reset();
+  delete [] keys;
+  delete [] tiles;
+}
+
+static inline I64 occupancy_tile_key(I32 pos_x, I32 pos_y)
+{
+  return (((I64)(pos_y >> LAS_OCCUPANCY_TILE_BITS)) << 32) | (I64)((U32)(pos_x >> LAS_OCCUPANCY_TILE_BITS));
+}
+
+static inline U32 occupancy_popcount(U64 bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return (U32)__builtin_popcountll(bits);
+#else
+  bits = bits - ((bits >> 1) & 0x5555555555555555ull);
+  bits = (bits & 0x3333333333333333ull) + ((bits >> 2) & 0x3333333333333333ull);
+  bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+  return (U32)((bits * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+static U32 occupancy_count_tile(const U64* tile)
+{
+  // independent sums that the compiler can vectorize
+  U32 counts[4] = {0, 0, 0, 0};
+  for (U32 i = 0; i < LAS_OCCUPANCY_TILE_ROWS; i += 4)
+  {
+    counts[0] += occupancy_popcount(tile[i]);
+    counts[1] += occupancy_popcount(tile[i + 1]);
+    counts[2] += occupancy_popcount(tile[i + 2]);
+    counts[3] += occupancy_popcount(tile[i + 3]);
+  }
+  return counts[0] + counts[1] + counts[2] + counts[3];
+}
+
 BOOL LASoccupancyGrid::add(const LASpoint* point)
 {
   I32 pos_x, pos_y;
@@ -1377,7 +2050,6 @@ BOOL LASoccupancyGrid::add(const LASpoint* point)
     grid_spacing = -grid_spacing;
     pos_x = I32_FLOOR(point->get_x() / grid_spacing);
     pos_y = I32_FLOOR(point->get_y() / grid_spacing);
-    anker = pos_y;
     min_x = max_x = pos_x;
     min_y = max_y = pos_y;
   }
@@ -1396,7 +2068,6 @@ BOOL LASoccupancyGrid::add(I32 pos_x, I32 pos_y)
   if (grid_spacing < 0)
   {
     grid_spacing = -grid_spacing;
-    anker = pos_y;
     min_x = max_x = pos_x;
     min_y = max_y = pos_y;
   }
@@ -1410,125 +2081,27 @@ BOOL LASoccupancyGrid::add(I32 pos_x, I32 pos_y)
 
 BOOL LASoccupancyGrid::add_internal(I32 pos_x, I32 pos_y)
 {
-  pos_y = pos_y - anker;
-  BOOL no_x_anker = FALSE;
-  U32* array_size;
-  I32** ankers;
-  U32*** array;
-  U16** array_sizes;
-  if (pos_y < 0)
-  {
-    pos_y = -pos_y - 1;
-    ankers = &minus_ankers;
-    if ((U32)pos_y < minus_plus_size && minus_plus_sizes[pos_y])
-    {
-      pos_x -= minus_ankers[pos_y];
-      if (pos_x < 0)
-      {
-        pos_x = -pos_x - 1;
-        array_size = &minus_minus_size;
-        array = &minus_minus;
-        array_sizes = &minus_minus_sizes;
-      }
-      else
-      {
-        array_size = &minus_plus_size;
-        array = &minus_plus;
-        array_sizes = &minus_plus_sizes;
-      }
-    }
-    else
-    {
-      no_x_anker = TRUE;
-      array_size = &minus_plus_size;
-      array = &minus_plus;
-      array_sizes = &minus_plus_sizes;
-    }
-  }
-  else
-  {
-    ankers = &plus_ankers;
-    if ((U32)pos_y < plus_plus_size && plus_plus_sizes[pos_y])
-    {
-      pos_x -= plus_ankers[pos_y];
-      if (pos_x < 0)
-      {
-        pos_x = -pos_x - 1;
-        array_size = &plus_minus_size;
-        array = &plus_minus;
-        array_sizes = &plus_minus_sizes;
-      }
-      else
-      {
-        array_size = &plus_plus_size;
-        array = &plus_plus;
-        array_sizes = &plus_plus_sizes;
-      }
-    }
-    else
-    {
-      no_x_anker = TRUE;
-      array_size = &plus_plus_size;
-      array = &plus_plus;
-      array_sizes = &plus_plus_sizes;
-    }
-  }
-#pragma warning(push)
-#pragma warning(disable : 6011)
-  // maybe grow banded grid in y direction
-  if ((U32)pos_y >= *array_size)
-  {
-    U32 array_size_new = ((pos_y/1024)+1)*1024;
-    if (*array_size)
-    {
-      if (array == &minus_plus || array == &plus_plus) *ankers = (I32*)realloc_las(*ankers, array_size_new*sizeof(I32));
-      *array = (U32**)realloc_las(*array, array_size_new*sizeof(U32*));
-      *array_sizes = (U16*)realloc_las(*array_sizes, array_size_new*sizeof(U16));
-    }
-    else
-    {
-      if (array == &minus_plus || array == &plus_plus) *ankers = (I32*)malloc(array_size_new*sizeof(I32));
-      *array = (U32**)malloc(array_size_new*sizeof(U32*));
-      *array_sizes = (U16*)malloc(array_size_new*sizeof(U16));
-    }
-    for (U32 i = *array_size; i < array_size_new; i++)
-    {
-      (*array)[i] = 0;
-      (*array_sizes)[i] = 0;
-    }
-    *array_size = array_size_new;
-  }
-  // is this the first x anker for this y pos?
-  if (no_x_anker)
-  {
-    (*ankers)[pos_y] = pos_x;
-    pos_x = 0;
-  }
-  // maybe grow banded grid in x direction
-  U32 pos_x_pos = pos_x/32;
-  if (pos_x_pos >= (*array_sizes)[pos_y])
-  {
-    U32 array_sizes_new = ((pos_x_pos/256)+1)*256;
-    if ((*array_sizes)[pos_y])
-    {
-      (*array)[pos_y] = (U32*)realloc_las((*array)[pos_y], array_sizes_new*sizeof(U32));
-    }
-    else
-    {
-      (*array)[pos_y] = (U32*)malloc(array_sizes_new*sizeof(U32));
-    }
-    for (U16 i = (*array_sizes)[pos_y]; i < array_sizes_new; i++)
-    {
-      (*array)[pos_y][i] = 0;
-    }
-    (*array_sizes)[pos_y] = array_sizes_new;
-  }
-  U32 pos_x_bit = 1 << (pos_x%32);
-  if ((*array)[pos_y][pos_x_pos] & pos_x_bit) return FALSE;
-  (*array)[pos_y][pos_x_pos] |= pos_x_bit;
+  I64 key = occupancy_tile_key(pos_x, pos_y);
+  // consecutive points usually fall into one of the recently used tiles
+  U32 slot = (((pos_y >> LAS_OCCUPANCY_TILE_BITS) & LAS_OCCUPANCY_CACHE_MASK) << LAS_OCCUPANCY_CACHE_BITS) | ((pos_x >> LAS_OCCUPANCY_TILE_BITS) & LAS_OCCUPANCY_CACHE_MASK);
+  if (cache_tiles[slot] == 0 || key != cache_keys[slot])
+  {
+    if (tiles == 0) tiles = new LAStileHash(LAS_OCCUPANCY_TILE_ROWS);
+    cache_tiles[slot] = tiles->get(key);
+    cache_keys[slot] = key;
+  }
+  U64& row = cache_tiles[slot][pos_y & (LAS_OCCUPANCY_TILE_ROWS - 1)];
+  U64 bit = ((U64)1) << (pos_x & (LAS_OCCUPANCY_TILE_ROWS - 1));
+  if (row & bit) return FALSE;
+  row |= bit;
   num_occupied++;
   return TRUE;
-#pragma warning(pop)
+}
+
+const U64* LASoccupancyGrid::get_tile(I32 pos_x, I32 pos_y) const
+{
+  if (tiles == 0) return 0;
+  return tiles->find(occupancy_tile_key(pos_x, pos_y));
 }
 
 BOOL LASoccupancyGrid::occupied(const LASpoint* point) const
@@ -1544,129 +2117,96 @@ BOOL LASoccupancyGrid::occupied(I32 pos_x, I32 pos_y) const
   {
     return FALSE;
   }
-  pos_y = pos_y - anker;
-  U32 array_size;
-  const U32* const * array;
-  const U16* array_sizes;
-  if (pos_y < 0)
+  const U64* tile = get_tile(pos_x, pos_y);
+  if (tile == 0)
   {
-    pos_y = -pos_y - 1;
-    if ((U32)pos_y < minus_plus_size && minus_plus_sizes[pos_y])
-    {
-      pos_x -= minus_ankers[pos_y];
-      if (pos_x < 0)
-      {
-        pos_x = -pos_x - 1;
-        array_size = minus_minus_size;
-        array = minus_minus;
-        array_sizes = minus_minus_sizes;
-      }
-      else
-      {
-        array_size = minus_plus_size;
-        array = minus_plus;
-        array_sizes = minus_plus_sizes;
-      }
-    }
-    else
-    {
-      return FALSE;
-    }
+    return FALSE;
   }
-  else
+  if (tile[pos_y & (LAS_OCCUPANCY_TILE_ROWS - 1)] & (((U64)1) << (pos_x & (LAS_OCCUPANCY_TILE_ROWS - 1)))) return TRUE;
+  return FALSE;
+}
+
+BOOL LASoccupancyGrid::active() const
+{
+  if (grid_spacing < 0) return FALSE;
+  return TRUE;
+}
+
+BOOL LASoccupancyGrid::merge(const LASoccupancyGrid* other)
+{
+  if (other == 0 || !other->active())
   {
-    if ((U32)pos_y < plus_plus_size && plus_plus_sizes[pos_y])
-    {
-      pos_x -= plus_ankers[pos_y];
-      if (pos_x < 0)
-      {
-        pos_x = -pos_x - 1;
-        array_size = plus_minus_size;
-        array = plus_minus;
-        array_sizes = plus_minus_sizes;
-      }
-      else
-      {
-        array_size = plus_plus_size;
-        array = plus_plus;
-        array_sizes = plus_plus_sizes;
-      }
-    }
-    else
-    {
-      return FALSE;
-    }
+    return TRUE;
   }
-  // maybe out of bounds in y direction
-  if ((U32)pos_y >= array_size)
+  F32 spacing = (grid_spacing < 0 ? -grid_spacing : grid_spacing);
+  if (spacing != other->grid_spacing)
   {
+    LASMessage(LAS_WARNING, "cannot merge occupancy grids with spacing %g and %g", spacing, other->grid_spacing);
     return FALSE;
   }
-  // maybe out of bounds in x direction
-  U32 pos_x_pos = pos_x/32;
-  if (pos_x_pos >= array_sizes[pos_y])
+  if (grid_spacing < 0)
   {
-    return FALSE;
+    grid_spacing = -grid_spacing;
+    min_x = other->min_x;
+    min_y = other->min_y;
+    max_x = other->max_x;
+    max_y = other->max_y;
   }
-  U32 pos_x_bit = 1 << (pos_x%32);
-  if (array[pos_y][pos_x_pos] & pos_x_bit) return TRUE;
-  return FALSE;
+  else
+  {
+    if (other->min_x < min_x) min_x = other->min_x;
+    if (other->min_y < min_y) min_y = other->min_y;
+    if (other->max_x > max_x) max_x = other->max_x;
+    if (other->max_y > max_y) max_y = other->max_y;
+  }
+  if (other->tiles == 0)
+  {
+    return TRUE;
+  }
+  if (tiles == 0) tiles = new LAStileHash(LAS_OCCUPANCY_TILE_ROWS);
+  for (U32 j = 0; j < other->tiles->capacity; j++)
+  {
+    const U64* other_tile = other->tiles->tiles[j];
+    if (other_tile == 0) continue;
+    U64* tile = tiles->get(other->tiles->keys[j]);
+    num_occupied -= occupancy_count_tile(tile);
+    for (U32 i = 0; i < LAS_OCCUPANCY_TILE_ROWS; i++) tile[i] |= other_tile[i];
+    num_occupied += occupancy_count_tile(tile);
+  }
+  return TRUE;
 }
 
-BOOL LASoccupancyGrid::active() const
+U32 LASoccupancyGrid::get_num_tiles() const
 {
-  if (grid_spacing < 0) return FALSE;
-  return TRUE;
+  if (tiles == 0) return 0;
+  return tiles->number;
+}
+
+U32 LASoccupancyGrid::count_occupied() const
+{
+  U32 count = 0;
+  if (tiles)
+  {
+    for (U32 i = 0; i < tiles->capacity; i++)
+    {
+      if (tiles->tiles[i]) count += occupancy_count_tile(tiles->tiles[i]);
+    }
+  }
+  return count;
 }
 
 void LASoccupancyGrid::reset()
 {
-#pragma warning(push)
-#pragma warning(disable : 6001)
   min_x = min_y = max_x = max_y = 0;
   if (grid_spacing > 0) grid_spacing = -grid_spacing;
-  if (minus_minus_size)
-  {
-    for (U32 i = 0; i < minus_minus_size; i++) if (minus_minus[i]) free(minus_minus[i]);
-    free(minus_minus);
-    minus_minus = 0;
-    free(minus_minus_sizes);
-    minus_minus_sizes = 0;
-    minus_minus_size = 0;
-  }
-  if (minus_plus_size)
-  {
-    free(minus_ankers);
-    minus_ankers = 0;
-    for (U32 i = 0; i < minus_plus_size; i++) if (minus_plus[i]) free(minus_plus[i]);
-    free(minus_plus);
-    minus_plus = 0;
-    free(minus_plus_sizes);
-    minus_plus_sizes = 0;
-    minus_plus_size = 0;
-  }
-  if (plus_minus_size)
-  {
-    for (U32 i = 0; i < plus_minus_size; i++) if (plus_minus[i]) free(plus_minus[i]);
-    free(plus_minus);
-    plus_minus = 0;
-    free(plus_minus_sizes);
-    plus_minus_sizes = 0;
-    plus_minus_size = 0;
-  }
-  if (plus_plus_size)
-  {
-    free(plus_ankers);
-    plus_ankers = 0;
-    for (U32 i = 0; i < plus_plus_size; i++) if (plus_plus[i]) free(plus_plus[i]);
-    free(plus_plus);
-    plus_plus = 0;
-    free(plus_plus_sizes);
-    plus_plus_sizes = 0;
-    plus_plus_size = 0;
+  if (tiles)
+  {
+    delete tiles;
+    tiles = 0;
   }
+  memset(cache_keys, 0, sizeof(cache_keys));
+  memset(cache_tiles, 0, sizeof(cache_tiles));
   num_occupied = 0;
-#pragma warning(pop)
 }
 
 BOOL LASoccupancyGrid::write_asc_grid(const CHAR* file_name) const
@@ -1704,22 +2244,10 @@ LASoccupancyGrid::LASoccupancyGrid(F32 grid_spacing)
 {
   min_x = min_y = max_x = max_y = 0;
   this->grid_spacing = -grid_spacing;
-  minus_ankers = 0;
-  minus_minus_size = 0;
-  minus_minus = 0; 
-  minus_minus_sizes = 0;
-  minus_plus_size = 0;
-  minus_plus = 0;
-  minus_plus_sizes = 0;
-  plus_ankers = 0;
-  plus_minus_size = 0;
-  plus_minus = 0;
-  plus_minus_sizes = 0;
-  plus_plus_size = 0;
-  plus_plus = 0;
-  plus_plus_sizes = 0;
+  tiles = 0;
+  memset(cache_keys, 0, sizeof(cache_keys));
+  memset(cache_tiles, 0, sizeof(cache_tiles));
   num_occupied = 0;
-  anker = 0;
 }
 
 LASoccupancyGrid::~LASoccupancyGrid()
@@ -36,6 +36,7 @@
 #include "laswriter_qfit.hpp"
 #include "laswriter_wrl.hpp"
 #include "laswriter_txt.hpp"
+#include "laszip_decompress_selective_v3.hpp"
 
 #include <stdlib.h>
 #include <string.h>
@@ -57,6 +58,7 @@ LASwriter* LASwriteOpener::open(const LASheader* header)
   if (use_nil)
   {
     LASwriterLAS* laswriterlas = new LASwriterLAS();
+    laswriterlas->set_adaptive_chunking(chunk_gps_time_gap, chunk_cell_size, chunk_target_bytes);
     if (!laswriterlas->open(header, (format == LAS_TOOLS_FORMAT_LAZ ? (native ? LASZIP_COMPRESSOR_LAYERED_CHUNKED : LASZIP_COMPRESSOR_CHUNKED) : LASZIP_COMPRESSOR_NONE), 2, chunk_size))
     {
       laserror("cannot open laswriterlas to NULL");
@@ -70,6 +72,10 @@ LASwriter* LASwriteOpener::open(const LASheader* header)
     if (format <= LAS_TOOLS_FORMAT_LAZ)
     {
       LASwriterLAS* laswriterlas = new LASwriterLAS();
+      laswriterlas->set_statistics_sidecar(statistics_sidecar);
+      // adaptive chunks are only useful to readers that know their bounds
+      laswriterlas->set_chunk_summaries(chunk_summaries || get_adaptive_chunking());
+      laswriterlas->set_adaptive_chunking(chunk_gps_time_gap, chunk_cell_size, chunk_target_bytes);
       if (!laswriterlas->open(file_name, header, (format == LAS_TOOLS_FORMAT_LAZ ? (native ? LASZIP_COMPRESSOR_LAYERED_CHUNKED : LASZIP_COMPRESSOR_CHUNKED) : LASZIP_COMPRESSOR_NONE), 2, chunk_size, io_obuffer_size))
       {
         laserror("cannot open laswriterlas with file name '%s'", file_name);
@@ -136,6 +142,7 @@ LASwriter* LASwriteOpener::open(const LASheader* header)
     if (format <= LAS_TOOLS_FORMAT_LAZ)
     {
       LASwriterLAS* laswriterlas = new LASwriterLAS();
+      laswriterlas->set_adaptive_chunking(chunk_gps_time_gap, chunk_cell_size, chunk_target_bytes);
       if (!laswriterlas->open(stdout, header, (format == LAS_TOOLS_FORMAT_LAZ ? (native ? LASZIP_COMPRESSOR_LAYERED_CHUNKED : LASZIP_COMPRESSOR_CHUNKED) : LASZIP_COMPRESSOR_NONE), 2, chunk_size))
       {
         laserror("cannot open laswriterlas to stdout");
@@ -231,6 +238,11 @@ void LASwriteOpener::usage() const
                        "  -odix _classified (specify file name appendix)\n" \
                        "  -ocut 2 (cut the last two characters from name)\n" \
                        "  -olas -olaz -otxt -obin -oqi (specify format)\n" \
+                       "  -stats_sidecar (also write a '.stats' file for lasinfo)\n" \
+                       "  -chunk_summaries (store min/max of each chunk for fast filtering)\n" \
+                       "  -chunk_gps_gap 0.5 (new LAZ chunk where GPS time jumps by 0.5 sec)\n" \
+                       "  -chunk_cell 100 (new LAZ chunk where points leave a 100 by 100 cell)\n" \
+                       "  -chunk_bytes 1000000 (new LAZ chunk after about 1 MB compressed)\n" \
                        "  -stdout (pipe to stdout)\n" \
                        "  -nil    (pipe to NULL)\n", DIRECTORY_SLASH, DIRECTORY_SLASH);
 }
@@ -371,6 +383,64 @@ BOOL LASwriteOpener::parse(int argc, char* argv[])
       set_chunk_size(atoi(argv[i+1]));
       *argv[i]='\0'; *argv[i+1]='\0'; i+=1;
     }
+    else if (strcmp(argv[i],"-stats_sidecar") == 0)
+    {
+      set_statistics_sidecar(TRUE);
+      *argv[i]='\0';
+    }
+    else if (strcmp(argv[i],"-chunk_summaries") == 0)
+    {
+      set_chunk_summaries(TRUE);
+      *argv[i]='\0';
+    }
+    else if (strcmp(argv[i],"-chunk_gps_gap") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        laserror("'%s' needs 1 argument: seconds", argv[i]);
+        return FALSE;
+      }
+      F64 gap;
+      if ((sscanf(argv[i+1], "%lf", &gap) != 1) || (gap <= 0.0))
+      {
+        laserror("'%s' needs 1 argument: seconds but '%s' is no positive number", argv[i], argv[i+1]);
+        return FALSE;
+      }
+      set_chunk_gps_time_gap(gap);
+      *argv[i]='\0'; *argv[i+1]='\0'; i+=1;
+    }
+    else if (strcmp(argv[i],"-chunk_cell") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        laserror("'%s' needs 1 argument: size", argv[i]);
+        return FALSE;
+      }
+      F64 size;
+      if ((sscanf(argv[i+1], "%lf", &size) != 1) || (size <= 0.0))
+      {
+        laserror("'%s' needs 1 argument: size but '%s' is no positive number", argv[i], argv[i+1]);
+        return FALSE;
+      }
+      set_chunk_cell_size(size);
+      *argv[i]='\0'; *argv[i+1]='\0'; i+=1;
+    }
+    else if (strcmp(argv[i],"-chunk_bytes") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        laserror("'%s' needs 1 argument: number_bytes", argv[i]);
+        return FALSE;
+      }
+      U32 bytes;
+      if ((sscanf(argv[i+1], "%u", &bytes) != 1) || (bytes == 0))
+      {
+        laserror("'%s' needs 1 argument: number_bytes but '%s' is no positive number", argv[i], argv[i+1]);
+        return FALSE;
+      }
+      set_chunk_target_bytes(bytes);
+      *argv[i]='\0'; *argv[i+1]='\0'; i+=1;
+    }
     else if (strcmp(argv[i],"-oparse") == 0)
     {
       if ((i+1) >= argc)
@@ -783,6 +853,31 @@ void LASwriteOpener::set_force(BOOL force)
   this->force = force;
 }
 
+void LASwriteOpener::set_statistics_sidecar(BOOL statistics_sidecar)
+{
+  this->statistics_sidecar = statistics_sidecar;
+}
+
+void LASwriteOpener::set_chunk_summaries(BOOL chunk_summaries)
+{
+  this->chunk_summaries = chunk_summaries;
+}
+
+void LASwriteOpener::set_chunk_gps_time_gap(F64 chunk_gps_time_gap)
+{
+  this->chunk_gps_time_gap = chunk_gps_time_gap;
+}
+
+void LASwriteOpener::set_chunk_cell_size(F64 chunk_cell_size)
+{
+  this->chunk_cell_size = chunk_cell_size;
+}
+
+void LASwriteOpener::set_chunk_target_bytes(U32 chunk_target_bytes)
+{
+  this->chunk_target_bytes = chunk_target_bytes;
+}
+
 void LASwriteOpener::set_chunk_size(U32 chunk_size)
 {
   this->chunk_size = chunk_size;
@@ -1111,6 +1206,22 @@ I32 LASwriteOpener::get_format() const
   }
 }
 
+// the LAS 1.4 layers that the output touches. only the ASCII writer is picky
+// because all binary formats store (almost) every field of the point.
+
+U32 LASwriteOpener::get_decompress_selective() const
+{
+  if (use_nil)
+  {
+    return LASZIP_DECOMPRESS_SELECTIVE_CHANNEL_RETURNS_XY;
+  }
+  if (get_format() == LAS_TOOLS_FORMAT_TXT)
+  {
+    return LASwriterTXT::get_decompress_selective(parse_string, (opts || optx));
+  }
+  return LASZIP_DECOMPRESS_SELECTIVE_ALL;
+}
+
 void LASwriteOpener::set_parse_string(const CHAR* parse_string)
 {
   if (this->parse_string) free(this->parse_string);
@@ -1237,6 +1348,11 @@ LASwriteOpener::LASwriteOpener()
   specified = FALSE;
   force = FALSE;
   chunk_size = LASZIP_CHUNK_SIZE_DEFAULT;
+  statistics_sidecar = FALSE;
+  chunk_summaries = FALSE;
+  chunk_gps_time_gap = 0.0;
+  chunk_cell_size = 0.0;
+  chunk_target_bytes = 0;
   use_stdout = FALSE;
   use_nil = FALSE;
 }
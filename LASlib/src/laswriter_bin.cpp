@@ -298,5 +298,6 @@ LASwriterBIN::LASwriterBIN()
 
 LASwriterBIN::~LASwriterBIN()
 {
+  LASnoThrowScope no_throw;
   if (file) close();
 }
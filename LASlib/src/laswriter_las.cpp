@@ -34,16 +34,25 @@
 #include "bytestreamout_nil.hpp"
 #include "bytestreamout_file.hpp"
 #include "bytestreamout_ostream.hpp"
+#include "bytestreamout_array.hpp"
 #include "laswritepoint.hpp"
+#include "lasutility.hpp"
 
 #ifdef _WIN32
 #include <fcntl.h>
 #include <io.h>
 #endif
 
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
+// adaptive chunking never cuts chunks with fewer points than this
+#define LAS_ADAPTIVE_CHUNK_MIN_POINTS 1000
+// a chunk counts as spatially coherent while at most one in this many of its
+// points lay outside the grid cell in which it began
+#define LAS_ADAPTIVE_CHUNK_STRAY_RATIO 16
+
 BOOL LASwriterLAS::refile(FILE* file)
 {
   if (stream == 0) return FALSE;
@@ -84,7 +93,19 @@ BOOL LASwriterLAS::open(const char* file_name, const LASheader* header, U32 comp
   else
     out = new ByteStreamOutFileBE(file);
 
-  return open(out, header, compressor, requested_version, chunk_size);
+  if (!open(out, header, compressor, requested_version, chunk_size))
+  {
+    return FALSE;
+  }
+
+  if (statistics_sidecar || chunk_summaries)
+  {
+    statistics = new LASstatistics();
+    statistics->init(header, ((compressor >= LASZIP_COMPRESSOR_POINTWISE_CHUNKED) ? (chunk_max_points ? 0 : (U32)chunk_size) : LASZIP_CHUNK_SIZE_DEFAULT));
+    statistics_file_name = LASCopyString(file_name);
+  }
+
+  return TRUE;
 }
 
 BOOL LASwriterLAS::open(FILE* file, const LASheader* header, U32 compressor, I32 requested_version, I32 chunk_size)
@@ -125,6 +146,23 @@ BOOL LASwriterLAS::open(std::ostream& stream, const LASheader* header, U32 compr
   return open(out, header, compressor, requested_version, chunk_size);
 }
 
+BOOL LASwriterLAS::open(ByteStreamOutWriteCallback callback, void* user_data, const LASheader* header, U32 compressor, I32 requested_version, I32 chunk_size)
+{
+  if (callback == 0)
+  {
+    laserror("write callback is zero");
+    return FALSE;
+  }
+
+  ByteStreamOut* out;
+  if (IS_LITTLE_ENDIAN())
+    out = new ByteStreamOutCallbackLE(callback, user_data);
+  else
+    out = new ByteStreamOutCallbackBE(callback, user_data);
+
+  return open(out, header, compressor, requested_version, chunk_size);
+}
+
 BOOL LASwriterLAS::open(ByteStreamOut* stream, const LASheader* header, U32 compressor, I32 requested_version, I32 chunk_size)
 {
   U32 i, j;
@@ -181,6 +219,22 @@ BOOL LASwriterLAS::open(ByteStreamOut* stream, const LASheader* header, U32 comp
     return FALSE;
   }
 
+  // adaptive chunking writes variable-sized chunks and is limited to the new point types
+
+  chunk_max_points = 0;
+  if ((chunk_gps_time_gap > 0.0) || (chunk_cell_size > 0.0) || chunk_target_bytes)
+  {
+    if (compressor && (point_data_format > 5))
+    {
+      chunk_max_points = ((chunk_size > 0) ? (U32)chunk_size : U32_MAX);
+      chunk_size = 0;
+    }
+    else if (compressor)
+    {
+      LASMessage(LAS_WARNING, "adaptive chunking not available for point type %d. using chunks of %d points", point_data_format, chunk_size);
+    }
+  }
+
   // do we need a LASzip VLR (because we compress or use non-standard points?)
 
   LASzip* laszip = 0;
@@ -893,14 +947,92 @@ BOOL LASwriterLAS::open(ByteStreamOut* stream, const LASheader* header, U32 comp
 BOOL LASwriterLAS::write_point(const LASpoint* point)
 {
   p_count++;
+  if (chunk_max_points && starts_new_chunk(point))
+  {
+    if (!chunk()) return FALSE;
+  }
+  if (statistics) statistics->add(point);
   return writer->write(point->point);
 }
 
+// decides whether the point should be the first of a new chunk. a flight line
+// change shows as a jump in GPS time and a spatially coherent chunk stays in
+// one grid cell. points in scan order cross cell borders all the time, so the
+// cell only cuts chunks whose points rarely strayed from it. the byte size only
+// changes noticeably every few hundred points
+
+BOOL LASwriterLAS::starts_new_chunk(const LASpoint* point)
+{
+  BOOL cut = FALSE;
+  U32 count = writer->get_chunk_count();
+  I64 cell_x = 0;
+  I64 cell_y = 0;
+  BOOL left_cell = FALSE;
+  if (chunk_cell_size > 0.0)
+  {
+    cell_x = (I64)floor(point->get_x() / chunk_cell_size);
+    cell_y = (I64)floor(point->get_y() / chunk_cell_size);
+    left_cell = ((cell_x != chunk_cell_x) || (cell_y != chunk_cell_y));
+  }
+  if (count >= chunk_max_points)
+  {
+    cut = TRUE;
+  }
+  else if (count >= LAS_ADAPTIVE_CHUNK_MIN_POINTS)
+  {
+    if ((chunk_gps_time_gap > 0.0) && (fabs(point->gps_time - chunk_last_gps_time) > chunk_gps_time_gap))
+    {
+      cut = TRUE;
+    }
+    else if (left_cell && ((U64)chunk_cell_strays*LAS_ADAPTIVE_CHUNK_STRAY_RATIO <= count))
+    {
+      cut = TRUE;
+    }
+    else if (chunk_target_bytes && ((count & 255) == 0) && (writer->get_chunk_bytes() >= chunk_target_bytes))
+    {
+      cut = TRUE;
+    }
+  }
+  if (cut || (count == 0))
+  {
+    chunk_cell_x = cell_x;
+    chunk_cell_y = cell_y;
+    chunk_cell_strays = 0;
+  }
+  else if (left_cell)
+  {
+    chunk_cell_strays++;
+  }
+  chunk_last_gps_time = point->gps_time;
+  return cut;
+}
+
 BOOL LASwriterLAS::chunk()
 {
+  if (statistics) statistics->chunk();
   return writer->chunk();
 }
 
+BOOL LASwriterLAS::can_copy_chunks(const LASzip* laszip) const
+{
+  return (writer && (chunk_max_points == 0) && writer->is_compatible(laszip));
+}
+
+BOOL LASwriterLAS::write_chunk(const U8* bytes, U32 num_bytes, U32 num_points)
+{
+  // the points of a copied chunk are neither seen by the statistics nor by adaptive chunking
+  if (statistics || chunk_max_points) return FALSE;
+  if (!writer->write_chunk(bytes, num_bytes, num_points)) return FALSE;
+  p_count += num_points;
+  return TRUE;
+}
+
+BOOL LASwriterLAS::copy_layers(const U8* bytes, U32 num_bytes, U32 compress_selective)
+{
+  if (chunk_max_points) return FALSE;
+  return writer->copy_layers(bytes, num_bytes, compress_selective);
+}
+
 BOOL LASwriterLAS::update_header(const LASheader* header, BOOL use_inventory, BOOL update_extra_bytes)
 {
   I32 i;
@@ -1214,9 +1346,62 @@ BOOL LASwriterLAS::update_header(const LASheader* header, BOOL use_inventory, BO
   return TRUE;
 }
 
+// appends the per-chunk summaries as the EVLR "LAStools" 40 after all other
+// EVLRs and then patches the number (and maybe the start) of EVLRs in the header
+
+BOOL LASwriterLAS::write_chunk_summaries()
+{
+  ByteStreamOutArray* out;
+  if (IS_LITTLE_ENDIAN())
+    out = new ByteStreamOutArrayLE();
+  else
+    out = new ByteStreamOutArrayBE();
+  if (!statistics->write_chunks(out))
+  {
+    delete out;
+    return FALSE;
+  }
+
+  I64 start_of_evlr = stream->tell();
+  U16 reserved = 0;
+  CHAR user_id[16];
+  memset(user_id, 0, 16);
+  strcpy(user_id, "LAStools");
+  U16 record_id = 40;
+  U64 record_length_after_header = out->getSize();
+  CHAR description[32];
+  memset(description, 0, 32);
+  strcpy(description, "by LAStools of rapidlasso GmbH");
+
+  BOOL success = stream->put16bitsLE((const U8*)&reserved);
+  success = success && stream->putBytes((const U8*)user_id, 16);
+  success = success && stream->put16bitsLE((const U8*)&record_id);
+  success = success && stream->put64bitsLE((const U8*)&record_length_after_header);
+  success = success && stream->putBytes((const U8*)description, 32);
+  success = success && stream->putBytes(out->getData(), (U32)record_length_after_header);
+  delete out;
+  if (!success)
+  {
+    laserror("writing EVLR with chunk summaries");
+    return FALSE;
+  }
+
+  if (number_of_extended_variable_length_records == 0)
+  {
+    stream->seek(header_start_position + 235);
+    stream->put64bitsLE((const U8*)&start_of_evlr);
+  }
+  U32 number = number_of_extended_variable_length_records + 1;
+  stream->seek(header_start_position + 243);
+  stream->put32bitsLE((const U8*)&number);
+  stream->seekEnd();
+  return TRUE;
+}
+
 I64 LASwriterLAS::close(BOOL update_npoints)
 {
   I64 bytes = 0;
+  BOOL write_sidecar = statistics_sidecar;
 
   if (p_count != npoints)
   {
@@ -1317,6 +1502,19 @@ I64 LASwriterLAS::close(BOOL update_npoints)
     }
   }
 
+  if (chunk_summaries && statistics)
+  {
+    if (writing_las_1_4 && stream->isSeekable())
+    {
+      write_chunk_summaries();
+    }
+    else
+    {
+      LASMessage(LAS_WARNING, "chunk summaries need a seekable LAS 1.4 output. storing them in '.stats' sidecar instead");
+      write_sidecar = TRUE;
+    }
+  }
+
   if (stream)
   {
     if (update_npoints && p_count != npoints)
@@ -1358,6 +1556,12 @@ I64 LASwriterLAS::close(BOOL update_npoints)
       }
     }
     bytes = stream->tell() - header_start_position;
+    // a buffering stream (e.g. to a write callback) still holds the last bytes
+    if (!stream->flush())
+    {
+      LASMessage(LAS_ERROR, "flushing the last bytes of the output failed");
+      bytes = 0;
+    }
     if (delete_stream)
     {
       delete stream;
@@ -1371,6 +1575,18 @@ I64 LASwriterLAS::close(BOOL update_npoints)
     file = 0;
   }
 
+  if (statistics)
+  {
+    if (write_sidecar)
+    {
+      statistics->write(statistics_file_name);
+    }
+    delete statistics;
+    statistics = 0;
+    free(statistics_file_name);
+    statistics_file_name = 0;
+  }
+
   npoints = p_count;
   p_count = 0;
 
@@ -1395,9 +1611,22 @@ LASwriterLAS::LASwriterLAS()
   number_of_extended_variable_length_records = 0;
   evlrs = 0;
   header_start_position = 0;
+  statistics_sidecar = FALSE;
+  statistics_file_name = 0;
+  statistics = 0;
+  chunk_summaries = FALSE;
+  chunk_gps_time_gap = 0.0;
+  chunk_cell_size = 0.0;
+  chunk_target_bytes = 0;
+  chunk_max_points = 0;
+  chunk_last_gps_time = 0.0;
+  chunk_cell_x = 0;
+  chunk_cell_y = 0;
+  chunk_cell_strays = 0;
 }
 
 LASwriterLAS::~LASwriterLAS()
 {
+  LASnoThrowScope no_throw;
   if (writer || stream) close();
 }
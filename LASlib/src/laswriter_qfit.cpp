@@ -308,5 +308,6 @@ LASwriterQFIT::LASwriterQFIT()
 
 LASwriterQFIT::~LASwriterQFIT()
 {
+  LASnoThrowScope no_throw;
   if (file) close();
 }
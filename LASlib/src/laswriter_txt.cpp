@@ -31,6 +31,7 @@
 #include "laswriter_txt.hpp"
 
 #include "lasmessage.hpp"
+#include "laszip_decompress_selective_v3.hpp"
 
 #include <stdlib.h>
 #include <string.h>
@@ -259,6 +260,72 @@ BOOL LASwriterTXT::open(FILE* file, const LASheader* header, const CHAR* parse_s
   return check_parse_string(this->parse_string);
 }
 
+U32 LASwriterTXT::get_decompress_selective(const CHAR* parse_string, BOOL pts_or_ptx)
+{
+  if ((parse_string == 0) || (strcmp(parse_string, "original") == 0))
+  {
+    // PTS and PTX take their parse string from a VLR of the input
+    if (pts_or_ptx) return LASZIP_DECOMPRESS_SELECTIVE_ALL;
+    // the defaults of open() are 'xyz', 'xyzt', 'xyzRGB' or 'xyztRGB'
+    return LASZIP_DECOMPRESS_SELECTIVE_CHANNEL_RETURNS_XY | LASZIP_DECOMPRESS_SELECTIVE_Z | LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME | LASZIP_DECOMPRESS_SELECTIVE_RGB;
+  }
+  U32 decompress_selective = LASZIP_DECOMPRESS_SELECTIVE_CHANNEL_RETURNS_XY;
+  const CHAR* p = parse_string;
+  while (p[0])
+  {
+    switch (p[0])
+    {
+    case 'z': // the z coordinate
+    case 'Z': // the unscaled and unoffset integer z coordinate
+      decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_Z;
+      break;
+    case 't': // the gps time
+      decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME;
+      break;
+    case 'R': // the red channel of the RGB field
+    case 'G': // the green channel of the RGB field
+    case 'B': // the blue channel of the RGB field
+      decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_RGB;
+      break;
+    case 'i': // the intensity
+      decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
+      break;
+    case 'a': // the scan angle
+      decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_SCAN_ANGLE;
+      break;
+    case 'c': // the classification
+      decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION;
+      break;
+    case 'u': // the user data
+      decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_USER_DATA;
+      break;
+    case 'p': // the point source ID
+      decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_POINT_SOURCE;
+      break;
+    case 'e': // the edge of flight line flag
+    case 'd': // the direction of scan flag
+    case 'h': // the withheld flag
+    case 'k': // the keypoint flag
+    case 'g': // the synthetic flag
+    case 'o': // the overlap flag
+      decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_FLAGS;
+      break;
+    case 'w': // the wavepacket descriptor index
+    case 'W': // all wavepacket attributes
+      decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_WAVEPACKET;
+      break;
+    default:
+      if (p[0] >= '0' && p[0] <= '9') // an extra bytes attribute
+      {
+        decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_EXTRA_BYTES;
+      }
+      // 'x', 'y', 'X', 'Y', 'n', 'r', 'l' come with the first layer and 's', 'm', 'M' need nothing
+    }
+    p++;
+  }
+  return decompress_selective;
+}
+
 static void lidardouble2string(CHAR* string, double value)
 {
   int len;
@@ -590,6 +657,7 @@ LASwriterTXT::LASwriterTXT()
 
 LASwriterTXT::~LASwriterTXT()
 {
+  LASnoThrowScope no_throw;
   if (file) close();
 }
 
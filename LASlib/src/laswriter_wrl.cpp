@@ -246,5 +246,6 @@ LASwriterWRL::LASwriterWRL()
 
 LASwriterWRL::~LASwriterWRL()
 {
+  LASnoThrowScope no_throw;
   if (file) close();
 }
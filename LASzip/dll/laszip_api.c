@@ -742,6 +742,33 @@ laszip_open_writer
   return 1;
 };
 
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_open_writer_callback_def)
+(
+    laszip_POINTER                     pointer
+    , laszip_write_callback            callback
+    , void*                            user_data
+    , laszip_BOOL                      compress
+    , laszip_BOOL                      do_not_write_header
+);
+laszip_open_writer_callback_def laszip_open_writer_callback_ptr = 0;
+LASZIP_API laszip_I32
+laszip_open_writer_callback
+(
+    laszip_POINTER                     pointer
+    , laszip_write_callback            callback
+    , void*                            user_data
+    , laszip_BOOL                      compress
+    , laszip_BOOL                      do_not_write_header
+)
+{
+  if (laszip_open_writer_callback_ptr)
+  {
+    return (*laszip_open_writer_callback_ptr)(pointer, callback, user_data, compress, do_not_write_header);
+  }
+  return 1;
+};
+
 /*---------------------------------------------------------------------------*/
 typedef laszip_I32 (*laszip_write_point_def)
 (
@@ -761,6 +788,50 @@ laszip_write_point
   return 1;
 };
 
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_write_points_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_point_struct*       points
+    , const laszip_U32                 count
+);
+laszip_write_points_def laszip_write_points_ptr = 0;
+LASZIP_API laszip_I32
+laszip_write_points(
+    laszip_POINTER                     pointer
+    , const laszip_point_struct*       points
+    , const laszip_U32                 count
+)
+{
+  if (laszip_write_points_ptr)
+  {
+    return (*laszip_write_points_ptr)(pointer, points, count);
+  }
+  return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_write_points_columns_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_columns_struct*     columns
+    , const laszip_U32                 count
+);
+laszip_write_points_columns_def laszip_write_points_columns_ptr = 0;
+LASZIP_API laszip_I32
+laszip_write_points_columns(
+    laszip_POINTER                     pointer
+    , const laszip_columns_struct*     columns
+    , const laszip_U32                 count
+)
+{
+  if (laszip_write_points_columns_ptr)
+  {
+    return (*laszip_write_points_columns_ptr)(pointer, columns, count);
+  }
+  return 1;
+}
+
 /*---------------------------------------------------------------------------*/
 typedef laszip_I32 (*laszip_write_indexed_point_def)
 (
@@ -883,6 +954,58 @@ laszip_open_reader
   return 1;
 };
 
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_open_reader_array_def)
+(
+    laszip_POINTER                     pointer
+    , const laszip_U8*                 data
+    , laszip_I64                       size
+    , laszip_BOOL*                     is_compressed
+);
+laszip_open_reader_array_def laszip_open_reader_array_ptr = 0;
+LASZIP_API laszip_I32
+laszip_open_reader_array
+(
+    laszip_POINTER                     pointer
+    , const laszip_U8*                 data
+    , laszip_I64                       size
+    , laszip_BOOL*                     is_compressed
+)
+{
+  if (laszip_open_reader_array_ptr)
+  {
+    return (*laszip_open_reader_array_ptr)(pointer, data, size, is_compressed);
+  }
+  return 1;
+};
+
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_open_reader_callback_def)
+(
+    laszip_POINTER                     pointer
+    , laszip_read_callback             callback
+    , void*                            user_data
+    , laszip_I64                       size
+    , laszip_BOOL*                     is_compressed
+);
+laszip_open_reader_callback_def laszip_open_reader_callback_ptr = 0;
+LASZIP_API laszip_I32
+laszip_open_reader_callback
+(
+    laszip_POINTER                     pointer
+    , laszip_read_callback             callback
+    , void*                            user_data
+    , laszip_I64                       size
+    , laszip_BOOL*                     is_compressed
+)
+{
+  if (laszip_open_reader_callback_ptr)
+  {
+    return (*laszip_open_reader_callback_ptr)(pointer, callback, user_data, size, is_compressed);
+  }
+  return 1;
+};
+
 /*---------------------------------------------------------------------------*/
 typedef laszip_I32 (*laszip_has_spatial_index_def)
 (
@@ -993,6 +1116,56 @@ laszip_read_inside_point(
   return 1;
 }
 
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_read_points_def)
+(
+    laszip_POINTER                     pointer
+    , laszip_point_struct*             points
+    , laszip_U8*                       extra_bytes
+    , const laszip_U32                 max_count
+    , laszip_U32*                      count
+);
+laszip_read_points_def laszip_read_points_ptr = 0;
+LASZIP_API laszip_I32
+laszip_read_points(
+    laszip_POINTER                     pointer
+    , laszip_point_struct*             points
+    , laszip_U8*                       extra_bytes
+    , const laszip_U32                 max_count
+    , laszip_U32*                      count
+)
+{
+  if (laszip_read_points_ptr)
+  {
+    return (*laszip_read_points_ptr)(pointer, points, extra_bytes, max_count, count);
+  }
+  return 1;
+}
+
+/*---------------------------------------------------------------------------*/
+typedef laszip_I32 (*laszip_read_points_columns_def)
+(
+    laszip_POINTER                     pointer
+    , laszip_columns_struct*           columns
+    , const laszip_U32                 max_count
+    , laszip_U32*                      count
+);
+laszip_read_points_columns_def laszip_read_points_columns_ptr = 0;
+LASZIP_API laszip_I32
+laszip_read_points_columns(
+    laszip_POINTER                     pointer
+    , laszip_columns_struct*           columns
+    , const laszip_U32                 max_count
+    , laszip_U32*                      count
+)
+{
+  if (laszip_read_points_columns_ptr)
+  {
+    return (*laszip_read_points_columns_ptr)(pointer, columns, max_count, count);
+  }
+  return 1;
+}
+
 /*---------------------------------------------------------------------------*/
 typedef laszip_I32 (*laszip_close_reader_def)
 (
@@ -1195,11 +1368,26 @@ laszip_I32 laszip_load_dll()
      FreeLibrary(laszip_HINSTANCE);
      return 1;
   }
+  laszip_open_writer_callback_ptr = (laszip_open_writer_callback_def)GetProcAddress(laszip_HINSTANCE, "laszip_open_writer_callback");
+  if (laszip_open_writer_callback_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
   laszip_write_point_ptr = (laszip_write_point_def)GetProcAddress(laszip_HINSTANCE, "laszip_write_point");
   if (laszip_write_point_ptr == NULL) {
      FreeLibrary(laszip_HINSTANCE);
      return 1;
   }
+  laszip_write_points_ptr = (laszip_write_points_def)GetProcAddress(laszip_HINSTANCE, "laszip_write_points");
+  if (laszip_write_points_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
+  laszip_write_points_columns_ptr = (laszip_write_points_columns_def)GetProcAddress(laszip_HINSTANCE, "laszip_write_points_columns");
+  if (laszip_write_points_columns_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
   laszip_write_indexed_point_ptr = (laszip_write_indexed_point_def)GetProcAddress(laszip_HINSTANCE, "laszip_write_indexed_point");
   if (laszip_write_indexed_point_ptr == NULL) {
      FreeLibrary(laszip_HINSTANCE);
@@ -1230,6 +1418,16 @@ laszip_I32 laszip_load_dll()
      FreeLibrary(laszip_HINSTANCE);
      return 1;
   }
+  laszip_open_reader_array_ptr = (laszip_open_reader_array_def)GetProcAddress(laszip_HINSTANCE, "laszip_open_reader_array");
+  if (laszip_open_reader_array_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
+  laszip_open_reader_callback_ptr = (laszip_open_reader_callback_def)GetProcAddress(laszip_HINSTANCE, "laszip_open_reader_callback");
+  if (laszip_open_reader_callback_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
   laszip_has_spatial_index_ptr = (laszip_has_spatial_index_def)GetProcAddress(laszip_HINSTANCE, "laszip_has_spatial_index");
   if (laszip_has_spatial_index_ptr == NULL) {
      FreeLibrary(laszip_HINSTANCE);
@@ -1255,6 +1453,16 @@ laszip_I32 laszip_load_dll()
      FreeLibrary(laszip_HINSTANCE);
      return 1;
   }
+  laszip_read_points_ptr = (laszip_read_points_def)GetProcAddress(laszip_HINSTANCE, "laszip_read_points");
+  if (laszip_read_points_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
+  laszip_read_points_columns_ptr = (laszip_read_points_columns_def)GetProcAddress(laszip_HINSTANCE, "laszip_read_points_columns");
+  if (laszip_read_points_columns_ptr == NULL) {
+     FreeLibrary(laszip_HINSTANCE);
+     return 1;
+  }
   laszip_close_reader_ptr = (laszip_close_reader_def)GetProcAddress(laszip_HINSTANCE, "laszip_close_reader");
   if (laszip_close_reader_ptr == NULL) {
      FreeLibrary(laszip_HINSTANCE);
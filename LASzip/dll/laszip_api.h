@@ -24,6 +24,8 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- read from memory or a read callback and write to a write callback
+    18 October 2026 -- bulk laszip_read_points() and laszip_write_points() for bindings
     22 August 2017 -- Add version info.
     4 August 2017 -- 'laszip_set_point_type_and_size()' as minimal setup for ostream writer
     3 August 2017 -- new 'laszip_create_laszip_vlr()' gets VLR as C++ std::vector
@@ -225,12 +227,53 @@ typedef struct laszip_point
 
 } laszip_point_struct;
 
+/* columns for the bulk point calls. only the non-zero pointers are filled  */
+/* or consumed. for writing, the fields without column are taken from the  */
+/* point returned by laszip_get_point_pointer().                          */
+
+typedef struct laszip_columns
+{
+  laszip_F64* xyz;                  // 3 per point: scaled and offset x, y, z
+  laszip_I32* XYZ;                  // 3 per point: raw integer X, Y, Z
+  laszip_U16* intensity;
+  laszip_U8* return_number;         // extended for point types 6 to 10
+  laszip_U8* number_of_returns;     // extended for point types 6 to 10
+  laszip_U8* classification;        // extended for point types 6 to 10
+  laszip_U8* classification_flags;  // bit 0 synthetic, 1 keypoint, 2 withheld, 3 overlap
+  laszip_U8* scanner_channel;
+  laszip_U8* scan_direction_flag;
+  laszip_U8* edge_of_flight_line;
+  laszip_I16* scan_angle;           // scan angle rank or extended scan angle
+  laszip_U8* user_data;
+  laszip_U16* point_source_ID;
+  laszip_F64* gps_time;
+  laszip_U16* rgb;                  // 4 per point: R, G, B, NIR
+  laszip_U8* extra_bytes;           // num_extra_bytes per point
+} laszip_columns_struct;
+
 typedef void(*laszip_message_handler)(
   enum LAS_MESSAGE_TYPE                type
   , const char*                        msg
   , void*                              user_data
 );
 
+// reads up to 'num_bytes' starting at 'offset' and returns the number of bytes
+// read (fewer only at the end of the data, negative on error)
+typedef laszip_I64(*laszip_read_callback)(
+  void*                                user_data
+  , laszip_U8*                         buffer
+  , laszip_I64                         offset
+  , laszip_I64                         num_bytes
+);
+
+// writes 'num_bytes' starting at 'offset' and returns 1 on success
+typedef laszip_BOOL(*laszip_write_callback)(
+  void*                                user_data
+  , const laszip_U8*                   buffer
+  , laszip_I64                         offset
+  , laszip_I64                         num_bytes
+);
+
 /*---------------------------------------------------------------------------*/
 /*------ DLL constants for selective decompression via LASzip DLL -----------*/
 /*---------------------------------------------------------------------------*/
@@ -505,12 +548,38 @@ laszip_open_writer(
     , laszip_BOOL                      compress
 );
 
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_open_writer_callback(
+    laszip_POINTER                     pointer
+    , laszip_write_callback            callback
+    , void*                            user_data
+    , laszip_BOOL                      compress
+    , laszip_BOOL                      do_not_write_header
+);
+
 /*---------------------------------------------------------------------------*/
 LASZIP_API laszip_I32
 laszip_write_point(
     laszip_POINTER                     pointer
 );
 
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_write_points(
+    laszip_POINTER                     pointer
+    , const laszip_point_struct*       points
+    , const laszip_U32                 count
+);
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_write_points_columns(
+    laszip_POINTER                     pointer
+    , const laszip_columns_struct*     columns
+    , const laszip_U32                 count
+);
+
 /*---------------------------------------------------------------------------*/
 LASZIP_API laszip_I32
 laszip_write_indexed_point(
@@ -551,6 +620,27 @@ laszip_open_reader(
     , laszip_BOOL*                     is_compressed
 );
 
+/*---------------------------------------------------------------------------*/
+// zero-copy reading of 'size' bytes that must stay valid until the reader is closed
+LASZIP_API laszip_I32
+laszip_open_reader_array(
+    laszip_POINTER                     pointer
+    , const laszip_U8*                 data
+    , laszip_I64                       size
+    , laszip_BOOL*                     is_compressed
+);
+
+/*---------------------------------------------------------------------------*/
+// reading of 'size' bytes that are fetched in blocks via the read callback
+LASZIP_API laszip_I32
+laszip_open_reader_callback(
+    laszip_POINTER                     pointer
+    , laszip_read_callback             callback
+    , void*                            user_data
+    , laszip_I64                       size
+    , laszip_BOOL*                     is_compressed
+);
+
 /*---------------------------------------------------------------------------*/
 LASZIP_API laszip_I32
 laszip_has_spatial_index(
@@ -590,6 +680,25 @@ laszip_read_inside_point(
     , laszip_BOOL*                     is_done
 );
 
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_read_points(
+    laszip_POINTER                     pointer
+    , laszip_point_struct*             points
+    , laszip_U8*                       extra_bytes
+    , const laszip_U32                 max_count
+    , laszip_U32*                      count
+);
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_read_points_columns(
+    laszip_POINTER                     pointer
+    , laszip_columns_struct*           columns
+    , const laszip_U32                 max_count
+    , laszip_U32*                      count
+);
+
 /*---------------------------------------------------------------------------*/
 LASZIP_API laszip_I32
 laszip_close_reader(
@@ -105,6 +105,11 @@ ArithmeticDecoder::ArithmeticDecoder()
   instream = 0;
   length = 0;
   value = 0;
+  model_blocks = 0;
+  num_model_blocks = 0;
+  model_block_size = 0;
+  model_block_used = 0;
+  num_initial_models = 0;
 }
 
 BOOL ArithmeticDecoder::init(ByteStreamIn* instream, BOOL really_init)
@@ -146,14 +151,72 @@ void ArithmeticDecoder::destroyBitModel(ArithmeticBitModel* m)
 ArithmeticModel* ArithmeticDecoder::createSymbolModel(U32 n)
 {
   ArithmeticModel* m = new ArithmeticModel(n, FALSE);
+  if ((n >= 2) && (n <= (1 << 11)))
+  {
+    m->set_memory(allocate_model_memory(m->get_memory_size()));
+  }
   return m;
 }
 
 void ArithmeticDecoder::initSymbolModel(ArithmeticModel* m, U32 *table)
 {
+  if (table == 0)
+  {
+    const ArithmeticModel* initial = get_initial_model(m->symbols);
+    if (initial)
+    {
+      m->reset(initial);
+      return;
+    }
+  }
   m->init(table);
 }
 
+U32* ArithmeticDecoder::allocate_model_memory(U32 size)
+{
+  if ((model_block_used + size) > model_block_size)
+  {
+    // start small and double the blocks up to 64K entries
+    if (model_block_size == 0)
+    {
+      model_block_size = 4096;
+    }
+    else if (model_block_size < 65536)
+    {
+      model_block_size *= 2;
+    }
+    if (model_block_size < size)
+    {
+      model_block_size = size;
+    }
+    model_blocks = (U32**)realloc(model_blocks, sizeof(U32*)*(num_model_blocks+1));
+    model_blocks[num_model_blocks] = new U32[model_block_size];
+    num_model_blocks++;
+    model_block_used = 0;
+  }
+  U32* memory = model_blocks[num_model_blocks-1] + model_block_used;
+  model_block_used += size;
+  return memory;
+}
+
+const ArithmeticModel* ArithmeticDecoder::get_initial_model(U32 symbols)
+{
+  U32 i;
+  for (i = 0; i < num_initial_models; i++)
+  {
+    if (initial_models[i]->symbols == symbols) return initial_models[i];
+  }
+  if ((num_initial_models == AC_NUMBER_INITIAL_MODELS) || (symbols < 2) || (symbols > (1 << 11)))
+  {
+    return 0;
+  }
+  ArithmeticModel* initial = new ArithmeticModel(symbols, FALSE);
+  initial->init();
+  initial_models[num_initial_models] = initial;
+  num_initial_models++;
+  return initial;
+}
+
 void ArithmeticDecoder::destroySymbolModel(ArithmeticModel* m)
 {
   delete m;
@@ -334,6 +397,16 @@ F64 ArithmeticDecoder::readDouble() /* danger in float reinterpretation */
 
 ArithmeticDecoder::~ArithmeticDecoder()
 {
+  U32 i;
+  for (i = 0; i < num_initial_models; i++)
+  {
+    delete initial_models[i];
+  }
+  for (i = 0; i < num_model_blocks; i++)
+  {
+    delete [] model_blocks[i];
+  }
+  if (model_blocks) free(model_blocks);
 }
 
 inline void ArithmeticDecoder::renorm_dec_interval()
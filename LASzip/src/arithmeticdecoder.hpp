@@ -25,6 +25,7 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- symbol models live in one arena and are reset by copying
     22 August 2016 -- can be used as init dummy by "native LAS 1.4 compressor"
     13 November 2014 -- integrity check in readBits(), readByte(), readShort()
      6 September 2014 -- removed the (unused) inheritance from EntropyDecoder
@@ -43,6 +44,8 @@
 class ArithmeticModel;
 class ArithmeticBitModel;
 
+#define AC_NUMBER_INITIAL_MODELS 32
+
 class ArithmeticDecoder
 {
 public:
@@ -104,6 +107,17 @@ private:
 
   void renorm_dec_interval();
   U32 value, length;
+
+  // the distributions of all symbol models are carved from a few large
+  // blocks and every chunk resets them from one initial model per size
+  U32** model_blocks;
+  U32 num_model_blocks;
+  U32 model_block_size;
+  U32 model_block_used;
+  U32 num_initial_models;
+  ArithmeticModel* initial_models[AC_NUMBER_INITIAL_MODELS];
+  U32* allocate_model_memory(U32 size);
+  const ArithmeticModel* get_initial_model(U32 symbols);
 };
 
 #endif
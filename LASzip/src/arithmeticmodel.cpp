@@ -71,11 +71,13 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 ArithmeticModel::ArithmeticModel(U32 symbols, BOOL compress)
 {
   this->symbols = symbols;
   this->compress = compress;
+  own_memory = FALSE;
   distribution = 0;
   decoder_table = 0;
   last_symbol = 0;
@@ -89,7 +91,38 @@ ArithmeticModel::ArithmeticModel(U32 symbols, BOOL compress)
 
 ArithmeticModel::~ArithmeticModel()
 {
-  if (distribution) delete [] distribution;
+  if (own_memory) delete [] distribution;
+}
+
+U32 ArithmeticModel::get_memory_size() const
+{
+  if ((!compress) && (symbols > 16))
+  {
+    U32 table_bits = 3;
+    while (symbols > (1U << (table_bits + 2))) ++table_bits;
+    return 2*symbols+(1 << table_bits)+2;
+  }
+  return 2*symbols; // small alphabet: no table needed
+}
+
+void ArithmeticModel::set_memory(U32* memory)
+{
+  last_symbol = symbols - 1;
+  if ((!compress) && (symbols > 16))
+  {
+    U32 table_bits = 3;
+    while (symbols > (1U << (table_bits + 2))) ++table_bits;
+    table_size  = 1 << table_bits;
+    table_shift = DM__LengthShift - table_bits;
+    decoder_table = memory + 2 * symbols;
+  }
+  else // small alphabet: no table needed
+  {
+    decoder_table = 0;
+    table_size = table_shift = 0;
+  }
+  distribution = memory;
+  symbol_count = distribution + symbols;
 }
 
 I32 ArithmeticModel::init(U32* table)
@@ -100,27 +133,13 @@ I32 ArithmeticModel::init(U32* table)
     {
       return -1; // invalid number of symbols
     }
-    last_symbol = symbols - 1;
-    if ((!compress) && (symbols > 16))
-    {
-      U32 table_bits = 3;
-      while (symbols > (1U << (table_bits + 2))) ++table_bits;
-      table_size  = 1 << table_bits;
-      table_shift = DM__LengthShift - table_bits;
-      distribution = new U32[2*symbols+table_size+2];
-      decoder_table = distribution + 2 * symbols;
-    }
-    else // small alphabet: no table needed
-    {                                  
-      decoder_table = 0;
-      table_size = table_shift = 0;
-      distribution = new U32[2*symbols];
-    }
-    if (distribution == 0)
+    U32* memory = new U32[get_memory_size()];
+    if (memory == 0)
     {
       return -1; // "cannot allocate model memory");
     }
-    symbol_count = distribution + symbols;
+    set_memory(memory);
+    own_memory = TRUE;
   }
 
   total_count = 0;
@@ -136,6 +155,15 @@ I32 ArithmeticModel::init(U32* table)
   return 0;
 }
 
+void ArithmeticModel::reset(const ArithmeticModel* initial)
+{
+  // distribution, symbol counts and decoder table are contiguous
+  memcpy(distribution, initial->distribution, sizeof(U32)*get_memory_size());
+  total_count = initial->total_count;
+  update_cycle = initial->update_cycle;
+  symbols_until_update = initial->symbols_until_update;
+}
+
 void ArithmeticModel::update()
 {
   // halve counts when a threshold is reached
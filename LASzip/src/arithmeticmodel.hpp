@@ -25,6 +25,7 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- models can use memory of the coder and be reset by copying
     11 April 2019 -- 1024 AC_BUFFER_SIZE to 4096 for propagate_carry() overflow
     10 January 2011 -- licensing change for LGPL release and liblas integration
     8 December 2010 -- unified framework for all entropy coders
@@ -63,8 +64,16 @@ public:
 
   I32 init(U32* table=0);
 
+  // how many U32 the distribution (and decoder table) need
+  U32 get_memory_size() const;
+  // use this memory for the distribution instead of allocating it
+  void set_memory(U32* memory);
+  // copy the state of a model with the same symbols after init() without table
+  void reset(const ArithmeticModel* initial);
+
 private:
   void update();
+  BOOL own_memory;
   U32 * distribution, * symbol_count, * decoder_table;
   U32 total_count, update_cycle, symbols_until_update;
   U32 symbols, last_symbol, table_size, table_shift;
@@ -0,0 +1,313 @@
+/*
+===============================================================================
+
+  FILE:  bytestreamin_callback.hpp
+
+  CONTENTS:
+
+    Reads bytes through a caller-supplied positional read callback (e.g. an
+    HTTP range request or an object store cache) without any temporary file.
+    The bytes are fetched in blocks of 'block_size' so that the many small
+    reads of the header and the decoders only rarely reach the callback.
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- created for decoding LAZ bytes held by a server
+
+===============================================================================
+*/
+#ifndef BYTE_STREAM_IN_CALLBACK_H
+#define BYTE_STREAM_IN_CALLBACK_H
+
+#include "bytestreamin.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// reads up to 'num_bytes' starting at 'offset' into 'buffer' and returns the
+// number of bytes read (fewer only at the end of the data, negative on error)
+typedef I64 (*ByteStreamInReadCallback)(void* user_data, U8* buffer, I64 offset, I64 num_bytes);
+
+class ByteStreamInCallback : public ByteStreamIn
+{
+public:
+  ByteStreamInCallback(ByteStreamInReadCallback callback, void* user_data, I64 size=-1, I64 block_size=65536);
+/* read a single byte                                        */
+  U32 getByte();
+/* read an array of bytes                                    */
+  void getBytes(U8* bytes, const I64 num_bytes);
+/* is the stream seekable (e.g. stdin is not)                */
+  BOOL isSeekable() const;
+/* get current position of stream                            */
+  I64 tell() const;
+/* seek to this position in the stream                       */
+  BOOL seek(const I64 position);
+/* seek to the end of the stream (needs a known size)        */
+  BOOL seekEnd(const I64 distance=0);
+/* destructor                                                */
+  ~ByteStreamInCallback() { if (block) free(block); };
+protected:
+  ByteStreamInReadCallback callback;
+  void* user_data;
+  I64 size;
+  I64 curr;
+  U8* block;
+  I64 block_size;
+  I64 block_start;
+  I64 block_avail;
+  BOOL fill();
+};
+
+class ByteStreamInCallbackLE : public ByteStreamInCallback
+{
+public:
+  ByteStreamInCallbackLE(ByteStreamInReadCallback callback, void* user_data, I64 size=-1, I64 block_size=65536);
+/* read 16 bit low-endian field                              */
+  void get16bitsLE(U8* bytes);
+/* read 32 bit low-endian field                              */
+  void get32bitsLE(U8* bytes);
+/* read 64 bit low-endian field                              */
+  void get64bitsLE(U8* bytes);
+/* read 16 bit big-endian field                              */
+  void get16bitsBE(U8* bytes);
+/* read 32 bit big-endian field                              */
+  void get32bitsBE(U8* bytes);
+/* read 64 bit big-endian field                              */
+  void get64bitsBE(U8* bytes);
+private:
+  U8 swapped[8] = {0};
+};
+
+class ByteStreamInCallbackBE : public ByteStreamInCallback
+{
+public:
+  ByteStreamInCallbackBE(ByteStreamInReadCallback callback, void* user_data, I64 size=-1, I64 block_size=65536);
+/* read 16 bit low-endian field                              */
+  void get16bitsLE(U8* bytes);
+/* read 32 bit low-endian field                              */
+  void get32bitsLE(U8* bytes);
+/* read 64 bit low-endian field                              */
+  void get64bitsLE(U8* bytes);
+/* read 16 bit big-endian field                              */
+  void get16bitsBE(U8* bytes);
+/* read 32 bit big-endian field                              */
+  void get32bitsBE(U8* bytes);
+/* read 64 bit big-endian field                              */
+  void get64bitsBE(U8* bytes);
+private:
+  U8 swapped[8] = {0};
+};
+
+inline ByteStreamInCallback::ByteStreamInCallback(ByteStreamInReadCallback callback, void* user_data, I64 size, I64 block_size)
+{
+  this->callback = callback;
+  this->user_data = user_data;
+  this->size = size;
+  this->curr = 0;
+  this->block_size = (block_size > 0 ? block_size : 65536);
+  this->block = (U8*)malloc((size_t)this->block_size);
+  this->block_start = 0;
+  this->block_avail = 0;
+}
+
+inline BOOL ByteStreamInCallback::fill()
+{
+  if (block == 0) return FALSE;
+  I64 num_bytes = block_size;
+  if ((size >= 0) && ((curr + num_bytes) > size)) num_bytes = size - curr;
+  if (num_bytes <= 0) return FALSE;
+  I64 read = (*callback)(user_data, block, curr, num_bytes);
+  if (read <= 0) return FALSE;
+  block_start = curr;
+  block_avail = read;
+  return TRUE;
+}
+
+inline U32 ByteStreamInCallback::getByte()
+{
+  if ((curr < block_start) || (curr >= (block_start + block_avail)))
+  {
+    if (!fill())
+    {
+      throw EOF;
+    }
+  }
+  U32 byte = block[curr - block_start];
+  curr++;
+  return byte;
+}
+
+inline void ByteStreamInCallback::getBytes(U8* bytes, const I64 num_bytes)
+{
+  I64 done = 0;
+  while (done < num_bytes)
+  {
+    if ((curr >= block_start) && (curr < (block_start + block_avail)))
+    {
+      I64 num = block_start + block_avail - curr;
+      if (num > (num_bytes - done)) num = num_bytes - done;
+      memcpy((void*)(bytes + done), (const void*)(block + (curr - block_start)), (size_t)num);
+      curr += num;
+      done += num;
+    }
+    else if ((num_bytes - done) >= block_size)
+    {
+      // large requests (e.g. whole compressed layers) bypass the block
+      I64 read = (*callback)(user_data, bytes + done, curr, num_bytes - done);
+      if (read <= 0)
+      {
+        throw EOF;
+      }
+      curr += read;
+      done += read;
+    }
+    else if (!fill())
+    {
+      throw EOF;
+    }
+  }
+}
+
+inline BOOL ByteStreamInCallback::isSeekable() const
+{
+  return TRUE;
+}
+
+inline I64 ByteStreamInCallback::tell() const
+{
+  return curr;
+}
+
+inline BOOL ByteStreamInCallback::seek(const I64 position)
+{
+  if ((0 <= position) && ((size < 0) || (position <= size)))
+  {
+    curr = position;
+    return TRUE;
+  }
+  return FALSE;
+}
+
+inline BOOL ByteStreamInCallback::seekEnd(const I64 distance)
+{
+  if ((0 <= distance) && (distance <= size))
+  {
+    curr = size - distance;
+    return TRUE;
+  }
+  return FALSE;
+}
+
+inline ByteStreamInCallbackLE::ByteStreamInCallbackLE(ByteStreamInReadCallback callback, void* user_data, I64 size, I64 block_size) : ByteStreamInCallback(callback, user_data, size, block_size)
+{
+}
+
+inline void ByteStreamInCallbackLE::get16bitsLE(U8* bytes)
+{
+  getBytes(bytes, 2);
+}
+
+inline void ByteStreamInCallbackLE::get32bitsLE(U8* bytes)
+{
+  getBytes(bytes, 4);
+}
+
+inline void ByteStreamInCallbackLE::get64bitsLE(U8* bytes)
+{
+  getBytes(bytes, 8);
+}
+
+inline void ByteStreamInCallbackLE::get16bitsBE(U8* bytes)
+{
+  getBytes(swapped, 2);
+  bytes[0] = swapped[1];
+  bytes[1] = swapped[0];
+}
+
+inline void ByteStreamInCallbackLE::get32bitsBE(U8* bytes)
+{
+  getBytes(swapped, 4);
+  bytes[0] = swapped[3];
+  bytes[1] = swapped[2];
+  bytes[2] = swapped[1];
+  bytes[3] = swapped[0];
+}
+
+inline void ByteStreamInCallbackLE::get64bitsBE(U8* bytes)
+{
+  getBytes(swapped, 8);
+  bytes[0] = swapped[7];
+  bytes[1] = swapped[6];
+  bytes[2] = swapped[5];
+  bytes[3] = swapped[4];
+  bytes[4] = swapped[3];
+  bytes[5] = swapped[2];
+  bytes[6] = swapped[1];
+  bytes[7] = swapped[0];
+}
+
+inline ByteStreamInCallbackBE::ByteStreamInCallbackBE(ByteStreamInReadCallback callback, void* user_data, I64 size, I64 block_size) : ByteStreamInCallback(callback, user_data, size, block_size)
+{
+}
+
+inline void ByteStreamInCallbackBE::get16bitsLE(U8* bytes)
+{
+  getBytes(swapped, 2);
+  bytes[0] = swapped[1];
+  bytes[1] = swapped[0];
+}
+
+inline void ByteStreamInCallbackBE::get32bitsLE(U8* bytes)
+{
+  getBytes(swapped, 4);
+  bytes[0] = swapped[3];
+  bytes[1] = swapped[2];
+  bytes[2] = swapped[1];
+  bytes[3] = swapped[0];
+}
+
+inline void ByteStreamInCallbackBE::get64bitsLE(U8* bytes)
+{
+  getBytes(swapped, 8);
+  bytes[0] = swapped[7];
+  bytes[1] = swapped[6];
+  bytes[2] = swapped[5];
+  bytes[3] = swapped[4];
+  bytes[4] = swapped[3];
+  bytes[5] = swapped[2];
+  bytes[6] = swapped[1];
+  bytes[7] = swapped[0];
+}
+
+inline void ByteStreamInCallbackBE::get16bitsBE(U8* bytes)
+{
+  getBytes(bytes, 2);
+}
+
+inline void ByteStreamInCallbackBE::get32bitsBE(U8* bytes)
+{
+  getBytes(bytes, 4);
+}
+
+inline void ByteStreamInCallbackBE::get64bitsBE(U8* bytes)
+{
+  getBytes(bytes, 8);
+}
+
+#endif
@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- flush() for streams that buffer bytes before writing them
      2 January 2013 -- new functions for writing a stream of groups of bits  
      1 October 2011 -- added 64 bit file support in MSVC 6.0 at McCafe at Hbf Linz
     10 January 2011 -- licensing change for LGPL release and liblas integration
@@ -91,6 +92,8 @@ public:
   virtual BOOL seek(const I64 position) = 0;
 /* seek to the end of the file                               */
   virtual BOOL seekEnd() = 0;
+/* hand on buffered bytes (only buffering streams have any)  */
+  virtual BOOL flush() { return TRUE; };
 /* constructor                                               */
   inline ByteStreamOut() { bit_buffer = 0; num_buffer = 0; };
 /* destructor                                                */
@@ -0,0 +1,299 @@
+/*
+===============================================================================
+
+  FILE:  bytestreamout_callback.hpp
+
+  CONTENTS:
+
+    Writes bytes through a caller-supplied positional write callback (e.g. to
+    a memory buffer or an object store upload) without any temporary file. The
+    bytes are collected in blocks of 'block_size' and handed to the callback
+    together with their offset so the header can be patched on closing.
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    18 October 2026 -- created for encoding LAZ bytes held by a server
+
+===============================================================================
+*/
+#ifndef BYTE_STREAM_OUT_CALLBACK_H
+#define BYTE_STREAM_OUT_CALLBACK_H
+
+#include "bytestreamout.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+// writes 'num_bytes' from 'buffer' starting at 'offset' and returns TRUE on success
+typedef BOOL (*ByteStreamOutWriteCallback)(void* user_data, const U8* buffer, I64 offset, I64 num_bytes);
+
+class ByteStreamOutCallback : public ByteStreamOut
+{
+public:
+  ByteStreamOutCallback(ByteStreamOutWriteCallback callback, void* user_data, I64 block_size=65536);
+/* write a single byte                                       */
+  BOOL putByte(U8 byte);
+/* write an array of bytes                                   */
+  BOOL putBytes(const U8* bytes, U32 num_bytes);
+/* is the stream seekable (e.g. standard out is not)         */
+  BOOL isSeekable() const;
+/* get current position of stream                            */
+  I64 tell() const;
+/* seek to this position in the stream                       */
+  BOOL seek(const I64 position);
+/* seek to the end of the file                               */
+  BOOL seekEnd();
+/* hand all buffered bytes to the callback                   */
+  BOOL flush();
+/* destructor (call flush() first to learn whether it fails) */
+  ~ByteStreamOutCallback() { flush(); if (block) free(block); };
+protected:
+  ByteStreamOutWriteCallback callback;
+  void* user_data;
+  I64 size;
+  U8* block;
+  I64 block_size;
+  I64 block_start;
+  I64 block_used;
+};
+
+class ByteStreamOutCallbackLE : public ByteStreamOutCallback
+{
+public:
+  ByteStreamOutCallbackLE(ByteStreamOutWriteCallback callback, void* user_data, I64 block_size=65536);
+/* write 16 bit low-endian field                             */
+  BOOL put16bitsLE(const U8* bytes);
+/* write 32 bit low-endian field                             */
+  BOOL put32bitsLE(const U8* bytes);
+/* write 64 bit low-endian field                             */
+  BOOL put64bitsLE(const U8* bytes);
+/* write 16 bit big-endian field                             */
+  BOOL put16bitsBE(const U8* bytes);
+/* write 32 bit big-endian field                             */
+  BOOL put32bitsBE(const U8* bytes);
+/* write 64 bit big-endian field                             */
+  BOOL put64bitsBE(const U8* bytes);
+private:
+  U8 swapped[8] = {0};
+};
+
+class ByteStreamOutCallbackBE : public ByteStreamOutCallback
+{
+public:
+  ByteStreamOutCallbackBE(ByteStreamOutWriteCallback callback, void* user_data, I64 block_size=65536);
+/* write 16 bit low-endian field                             */
+  BOOL put16bitsLE(const U8* bytes);
+/* write 32 bit low-endian field                             */
+  BOOL put32bitsLE(const U8* bytes);
+/* write 64 bit low-endian field                             */
+  BOOL put64bitsLE(const U8* bytes);
+/* write 16 bit big-endian field                             */
+  BOOL put16bitsBE(const U8* bytes);
+/* write 32 bit big-endian field                             */
+  BOOL put32bitsBE(const U8* bytes);
+/* write 64 bit big-endian field                             */
+  BOOL put64bitsBE(const U8* bytes);
+private:
+  U8 swapped[8] = {0};
+};
+
+inline ByteStreamOutCallback::ByteStreamOutCallback(ByteStreamOutWriteCallback callback, void* user_data, I64 block_size)
+{
+  this->callback = callback;
+  this->user_data = user_data;
+  this->size = 0;
+  this->block_size = (block_size > 0 ? block_size : 65536);
+  this->block = (U8*)malloc((size_t)this->block_size);
+  this->block_start = 0;
+  this->block_used = 0;
+}
+
+inline BOOL ByteStreamOutCallback::flush()
+{
+  if (block_used)
+  {
+    if (!(*callback)(user_data, block, block_start, block_used))
+    {
+      return FALSE;
+    }
+    block_start += block_used;
+    block_used = 0;
+  }
+  return TRUE;
+}
+
+inline BOOL ByteStreamOutCallback::putByte(U8 byte)
+{
+  if (block_used == block_size)
+  {
+    if (!flush()) return FALSE;
+  }
+  if (block == 0) return FALSE;
+  block[block_used] = byte;
+  block_used++;
+  if ((block_start + block_used) > size) size = block_start + block_used;
+  return TRUE;
+}
+
+inline BOOL ByteStreamOutCallback::putBytes(const U8* bytes, U32 num_bytes)
+{
+  if ((block_used + num_bytes) > block_size)
+  {
+    if (!flush()) return FALSE;
+    if (num_bytes >= block_size)
+    {
+      // large writes bypass the block
+      if (!(*callback)(user_data, bytes, block_start, num_bytes))
+      {
+        return FALSE;
+      }
+      block_start += num_bytes;
+      if (block_start > size) size = block_start;
+      return TRUE;
+    }
+  }
+  if (block == 0) return FALSE;
+  memcpy((void*)(block + block_used), bytes, num_bytes);
+  block_used += num_bytes;
+  if ((block_start + block_used) > size) size = block_start + block_used;
+  return TRUE;
+}
+
+inline BOOL ByteStreamOutCallback::isSeekable() const
+{
+  return TRUE;
+}
+
+inline I64 ByteStreamOutCallback::tell() const
+{
+  return block_start + block_used;
+}
+
+inline BOOL ByteStreamOutCallback::seek(I64 position)
+{
+  if ((0 <= position) && (position <= size))
+  {
+    if (!flush()) return FALSE;
+    block_start = position;
+    return TRUE;
+  }
+  return FALSE;
+}
+
+inline BOOL ByteStreamOutCallback::seekEnd()
+{
+  return seek(size);
+}
+
+inline ByteStreamOutCallbackLE::ByteStreamOutCallbackLE(ByteStreamOutWriteCallback callback, void* user_data, I64 block_size) : ByteStreamOutCallback(callback, user_data, block_size)
+{
+}
+
+inline BOOL ByteStreamOutCallbackLE::put16bitsLE(const U8* bytes)
+{
+  return putBytes(bytes, 2);
+}
+
+inline BOOL ByteStreamOutCallbackLE::put32bitsLE(const U8* bytes)
+{
+  return putBytes(bytes, 4);
+}
+
+inline BOOL ByteStreamOutCallbackLE::put64bitsLE(const U8* bytes)
+{
+  return putBytes(bytes, 8);
+}
+
+inline BOOL ByteStreamOutCallbackLE::put16bitsBE(const U8* bytes)
+{
+  swapped[0] = bytes[1];
+  swapped[1] = bytes[0];
+  return putBytes(swapped, 2);
+}
+
+inline BOOL ByteStreamOutCallbackLE::put32bitsBE(const U8* bytes)
+{
+  swapped[0] = bytes[3];
+  swapped[1] = bytes[2];
+  swapped[2] = bytes[1];
+  swapped[3] = bytes[0];
+  return putBytes(swapped, 4);
+}
+
+inline BOOL ByteStreamOutCallbackLE::put64bitsBE(const U8* bytes)
+{
+  swapped[0] = bytes[7];
+  swapped[1] = bytes[6];
+  swapped[2] = bytes[5];
+  swapped[3] = bytes[4];
+  swapped[4] = bytes[3];
+  swapped[5] = bytes[2];
+  swapped[6] = bytes[1];
+  swapped[7] = bytes[0];
+  return putBytes(swapped, 8);
+}
+
+inline ByteStreamOutCallbackBE::ByteStreamOutCallbackBE(ByteStreamOutWriteCallback callback, void* user_data, I64 block_size) : ByteStreamOutCallback(callback, user_data, block_size)
+{
+}
+
+inline BOOL ByteStreamOutCallbackBE::put16bitsLE(const U8* bytes)
+{
+  swapped[0] = bytes[1];
+  swapped[1] = bytes[0];
+  return putBytes(swapped, 2);
+}
+
+inline BOOL ByteStreamOutCallbackBE::put32bitsLE(const U8* bytes)
+{
+  swapped[0] = bytes[3];
+  swapped[1] = bytes[2];
+  swapped[2] = bytes[1];
+  swapped[3] = bytes[0];
+  return putBytes(swapped, 4);
+}
+
+inline BOOL ByteStreamOutCallbackBE::put64bitsLE(const U8* bytes)
+{
+  swapped[0] = bytes[7];
+  swapped[1] = bytes[6];
+  swapped[2] = bytes[5];
+  swapped[3] = bytes[4];
+  swapped[4] = bytes[3];
+  swapped[5] = bytes[2];
+  swapped[6] = bytes[1];
+  swapped[7] = bytes[0];
+  return putBytes(swapped, 8);
+}
+
+inline BOOL ByteStreamOutCallbackBE::put16bitsBE(const U8* bytes)
+{
+  return putBytes(bytes, 2);
+}
+
+inline BOOL ByteStreamOutCallbackBE::put32bitsBE(const U8* bytes)
+{
+  return putBytes(bytes, 4);
+}
+
+inline BOOL ByteStreamOutCallbackBE::put64bitsBE(const U8* bytes)
+{
+  return putBytes(bytes, 8);
+}
+
+#endif
@@ -34,8 +34,9 @@
 #include <stdarg.h>
 #include <stdio.h>
 #include <string>
+#include <string.h>
 
-long lasmessage_cnt[LAS_QUIET];
+std::atomic<long> lasmessage_cnt[LAS_QUIET];
 
 void las_default_message_handler(LAS_MESSAGE_TYPE type, const char* msg, void* user_data);
 
@@ -43,6 +44,12 @@ static LASMessageHandler message_handler = &las_default_message_handler;
 static void* message_user_data = 0;
 static LAS_MESSAGE_TYPE las_message_level = LAS_INFO;
 
+// per-thread overrides of the above and the last error raised by the thread
+static thread_local LASMessageHandler thread_message_handler = 0;
+static thread_local void* thread_message_user_data = 0;
+static thread_local LAS_MESSAGE_TYPE thread_message_level = LAS_INFO;
+static thread_local char thread_last_error[LAS_MAX_MESSAGE_LENGTH] = "";
+
 std::string las_message_type_string(LAS_MESSAGE_TYPE in) {
   switch (in) {
     case LAS_DEBUG:
@@ -71,9 +78,10 @@ std::string las_message_type_string(LAS_MESSAGE_TYPE in) {
 void LASMessage(LAS_MESSAGE_TYPE type, LAS_FORMAT_STRING(const char*) fmt, ...) {
   assert(type <= LAS_FATAL_ERROR);  // message type must be less than or equal to LAS_FATAL_ERROR (LAS_QUIET must not be used in LASMessage calls)
 
-  lasmessage_cnt[type]++;
+  lasmessage_cnt[type].fetch_add(1, std::memory_order_relaxed);
 
-  if (type < las_message_level) return;
+  BOOL is_error = (type >= LAS_ERROR);
+  if ((type < (thread_message_handler ? thread_message_level : las_message_level)) && !is_error) return;
 
   char buffer[LAS_MAX_MESSAGE_LENGTH];
   va_list args;
@@ -91,7 +99,16 @@ void LASMessage(LAS_MESSAGE_TYPE type, LAS_FORMAT_STRING(const char*) fmt, ...)
     --len;
   }
 
-  (*message_handler)(type, buffer, message_user_data);
+  if (is_error) {
+    memcpy(thread_last_error, buffer, LAS_MAX_MESSAGE_LENGTH);
+    if (type < (thread_message_handler ? thread_message_level : las_message_level)) return;
+  }
+
+  if (thread_message_handler) {
+    (*thread_message_handler)(type, buffer, thread_message_user_data);
+  } else {
+    (*message_handler)(type, buffer, message_user_data);
+  }
 }
 
 void LASLIB_DLL set_message_log_level(LAS_MESSAGE_TYPE loglevel) {
@@ -115,6 +132,26 @@ void LASLIB_DLL unset_las_message_handler() {
   message_user_data = 0;
 }
 
+void LASLIB_DLL set_las_thread_message_handler(LASMessageHandler callback, void* user_data /*= 0*/, LAS_MESSAGE_TYPE loglevel /*= LAS_INFO*/) {
+  thread_message_handler = callback;
+  thread_message_user_data = user_data;
+  thread_message_level = loglevel;
+}
+
+void LASLIB_DLL unset_las_thread_message_handler() {
+  thread_message_handler = 0;
+  thread_message_user_data = 0;
+  thread_message_level = LAS_INFO;
+}
+
+const char* LASLIB_DLL get_las_last_error() {
+  return thread_last_error;
+}
+
+void LASLIB_DLL clear_las_last_error() {
+  thread_last_error[0] = '\0';
+}
+
 void format_message(std::string& messsage, unsigned multiline_ident, bool append_trailing_lf = true) {
   size_t lines = messsage.find('\n');
   if (lines == std::string::npos) {
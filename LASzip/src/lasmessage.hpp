@@ -24,6 +24,8 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- message counters are process-wide so worker threads set the exit code
+    18 October 2026 -- per-thread message handler, log level and last error for use in servers
     07 Februar 2024 -- initial version
 
 ===============================================================================
@@ -31,13 +33,15 @@
 #ifndef LAS_MESSAGE_HPP
 #define LAS_MESSAGE_HPP
 
+#include <atomic>
 #include <sstream>
 #include <string>
 #include <iomanip>
 #include "mydefs.hpp"
 #include "laszip_common.h"
 
-extern long lasmessage_cnt[LAS_QUIET];
+// message counters are shared by all threads (only handler and log level are per thread)
+extern std::atomic<long> lasmessage_cnt[LAS_QUIET];
 
 // central las message function
 #if defined(__GNUC__)
@@ -69,6 +73,12 @@ void LASLIB_DLL set_las_message_handler(LASMessageHandler callback, void* user_d
 // restore the default laslib message handler
 void LASLIB_DLL unset_las_message_handler();
 
+// set a message handler and log level for the calling thread only. they take precedence over the global
+// ones so that concurrent jobs (e.g. in a server) can route their messages to separate contexts
+void LASLIB_DLL set_las_thread_message_handler(LASMessageHandler callback, void* user_data = 0, LAS_MESSAGE_TYPE loglevel = LAS_INFO);
+// fall back to the global message handler and log level for the calling thread
+void LASLIB_DLL unset_las_thread_message_handler();
+
 // @brief Logger-Wrapper that allows to stream to the logger.
 // @usage LASMessageStream(LAS_FATAL_ERROR) << "Pi is approximately: " << LASMessageStream().precision(2) << 3.14159 << std::endl;
 class LASMessageStream
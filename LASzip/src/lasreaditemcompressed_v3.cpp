@@ -152,6 +152,25 @@ LASreadItemCompressed_POINT14_v3::LASreadItemCompressed_POINT14_v3(ArithmeticDec
 
   bytes = 0;
   num_bytes_allocated = 0;
+
+  /* no batches decoded layer by layer yet */
+
+  batch_count = 0;
+  batch_allocated = 0;
+  batch_items = 0;
+  batch_contexts = 0;
+  batch_item_contexts = 0;
+  batch_changed_values = 0;
+  batch_k_bits = 0;
+  batch_Z = 0;
+  batch_classification = 0;
+  batch_flags = 0;
+  batch_intensity = 0;
+  batch_scan_angle = 0;
+  batch_legacy_scan_angle_rank = 0;
+  batch_user_data = 0;
+  batch_point_source_ID = 0;
+  batch_gps_time = 0;
 }
 
 LASreadItemCompressed_POINT14_v3::~LASreadItemCompressed_POINT14_v3()
@@ -223,6 +242,24 @@ LASreadItemCompressed_POINT14_v3::~LASreadItemCompressed_POINT14_v3()
   }
 
   if (bytes) delete [] bytes;
+
+  if (batch_items)
+  {
+    delete [] batch_items;
+    delete [] batch_contexts;
+    delete [] batch_item_contexts;
+    delete [] batch_changed_values;
+    delete [] batch_k_bits;
+    delete [] batch_Z;
+    delete [] batch_classification;
+    delete [] batch_flags;
+    delete [] batch_intensity;
+    delete [] batch_scan_angle;
+    delete [] batch_legacy_scan_angle_rank;
+    delete [] batch_user_data;
+    delete [] batch_point_source_ID;
+    delete [] batch_gps_time;
+  }
 }
 
 inline BOOL LASreadItemCompressed_POINT14_v3::createAndInitModelsAndDecompressors(U32 context, const U8* item)
@@ -703,10 +740,30 @@ BOOL LASreadItemCompressed_POINT14_v3::init(const U8* item, U32& context)
 
   createAndInitModelsAndDecompressors(current_context, item);
 
+  /* in case the chunk is decoded layer by layer all layers start with the current context */
+
+  U32 l;
+  for (l = 0; l < 8; l++)
+  {
+    layer_context[l] = current_context;
+    for (c = 0; c < 4; c++)
+    {
+      layer_unused[l][c] = (c != current_context);
+    }
+  }
+  layer_Z[current_context] = ((const LASpoint14*)item)->Z;
+  layer_classification[current_context] = ((const LASpoint14*)item)->classification;
+  layer_flags[current_context] = (((const LASpoint14*)item)->edge_of_flight_line << 5) | (((const LASpoint14*)item)->scan_direction_flag << 4) | ((const LASpoint14*)item)->classification_flags;
+  layer_intensity[current_context] = ((const LASpoint14*)item)->intensity;
+  layer_scan_angle[current_context] = ((const LASpoint14*)item)->scan_angle;
+  layer_legacy_scan_angle_rank[current_context] = ((const LASpoint14*)item)->legacy_scan_angle_rank;
+  layer_user_data[current_context] = ((const LASpoint14*)item)->user_data;
+  layer_point_source_ID[current_context] = ((const LASpoint14*)item)->point_source_ID;
+
   return TRUE;
 }
 
-inline void LASreadItemCompressed_POINT14_v3::read(U8* item, U32& context)
+inline I32 LASreadItemCompressed_POINT14_v3::read_channel_returns_XY(U32& context)
 {
   // get last
 
@@ -752,9 +809,7 @@ inline void LASreadItemCompressed_POINT14_v3::read(U8* item, U32& context)
 
   // determine changed attributes
 
-  BOOL point_source_change = (changed_values & (1 << 5) ? TRUE : FALSE);
   BOOL gps_time_change = (changed_values & (1 << 4) ? TRUE : FALSE);
-  BOOL scan_angle_change = (changed_values & (1 << 3) ? TRUE : FALSE);
 
   // get last return counts
 
@@ -844,15 +899,9 @@ inline void LASreadItemCompressed_POINT14_v3::read(U8* item, U32& context)
     ((LASpoint14*)last_item)->legacy_number_of_returns = n;
   }
 
-  // get return map m and return level l context for current point
+  // get return map m for current point
 
   U32 m = number_return_map_6ctx[n][r];
-  U32 l = number_return_level_8ctx[n][r];
-
-  // create single (3) / first (1) / last (2) / intermediate (0) return context for current point
-
-  I32 cpr = (r == 1 ? 2 : 0); // first ?
-  cpr += (r >= n ? 1 : 0); // last ?
 
   U32 k_bits;
   I32 median, diff;
@@ -870,13 +919,41 @@ inline void LASreadItemCompressed_POINT14_v3::read(U8* item, U32& context)
   ((LASpoint14*)last_item)->Y += diff;
   contexts[current_context].last_Y_diff_median5[(m<<1) | gps_time_change].add(diff);
 
+  return changed_values;
+}
+
+inline void LASreadItemCompressed_POINT14_v3::read(U8* item, U32& context)
+{
+  // decompress returns_XY layer (may switch the current context)
+
+  I32 changed_values = read_channel_returns_XY(context);
+
+  // get last
+
+  U8* last_item = contexts[current_context].last_item;
+
+  // determine changed attributes
+
+  BOOL point_source_change = (changed_values & (1 << 5) ? TRUE : FALSE);
+  BOOL gps_time_change = (changed_values & (1 << 4) ? TRUE : FALSE);
+  BOOL scan_angle_change = (changed_values & (1 << 3) ? TRUE : FALSE);
+
+  // get return counts, return level l and return context cpr for current point
+
+  U32 n = ((LASpoint14*)last_item)->number_of_returns;
+  U32 r = ((LASpoint14*)last_item)->return_number;
+  U32 l = number_return_level_8ctx[n][r];
+
+  I32 cpr = (r == 1 ? 2 : 0); // first ?
+  cpr += (r >= n ? 1 : 0); // last ?
+
   ////////////////////////////////////////
   // decompress Z layer (if changed and requested)
   ////////////////////////////////////////
 
   if (changed_Z) // if the Z coordinate should be decompressed and changes within this chunk
   {
-    k_bits = (contexts[current_context].ic_dX->getK() + contexts[current_context].ic_dY->getK()) / 2;
+    U32 k_bits = (contexts[current_context].ic_dX->getK() + contexts[current_context].ic_dY->getK()) / 2;
     ((LASpoint14*)last_item)->Z = contexts[current_context].ic_Z->decompress(contexts[current_context].last_Z[l], (n==1) + (k_bits < 18 ? U32_ZERO_BIT_0(k_bits) : 18));
     contexts[current_context].last_Z[l] = ((LASpoint14*)last_item)->Z;
   }
@@ -986,7 +1063,7 @@ inline void LASreadItemCompressed_POINT14_v3::read(U8* item, U32& context)
   {
     if (gps_time_change) // if the GPS time has actually changed
     {
-      read_gps_time();
+      read_gps_time(current_context);
       ((LASpoint14*)last_item)->gps_time = contexts[current_context].last_gpstime[contexts[current_context].last].f64;
     }
   }
@@ -997,70 +1074,430 @@ inline void LASreadItemCompressed_POINT14_v3::read(U8* item, U32& context)
   ((LASpoint14*)last_item)->gps_time_change = gps_time_change;
 }
 
-void LASreadItemCompressed_POINT14_v3::read_gps_time()
+BOOL LASreadItemCompressed_POINT14_v3::read_batch_returns_XY(const U32 count)
+{
+  // make sure the batch is sufficiently large
+
+  if (count > batch_allocated)
+  {
+    if (batch_items)
+    {
+      delete [] batch_items;
+      delete [] batch_contexts;
+    delete [] batch_item_contexts;
+      delete [] batch_changed_values;
+      delete [] batch_k_bits;
+      delete [] batch_Z;
+      delete [] batch_classification;
+      delete [] batch_flags;
+      delete [] batch_intensity;
+      delete [] batch_scan_angle;
+      delete [] batch_legacy_scan_angle_rank;
+      delete [] batch_user_data;
+      delete [] batch_point_source_ID;
+      delete [] batch_gps_time;
+    }
+    batch_items = new U8[count*sizeof(LASpoint14)];
+    batch_contexts = new U32[count];
+    batch_item_contexts = new U32[count];
+    batch_changed_values = new U8[count];
+    batch_k_bits = new U8[count];
+    batch_Z = new I32[count];
+    batch_classification = new U8[count];
+    batch_flags = new U8[count];
+    batch_intensity = new U16[count];
+    batch_scan_angle = new I16[count];
+    batch_legacy_scan_angle_rank = new I8[count];
+    batch_user_data = new U8[count];
+    batch_point_source_ID = new U16[count];
+    batch_gps_time = new F64[count];
+    if (batch_gps_time == 0) return FALSE;
+    batch_allocated = count;
+  }
+
+  // decompress the returns_XY layer for all points of the batch
+
+  U32 i;
+  for (i = 0; i < count; i++)
+  {
+    batch_item_contexts[i] = 0;
+    I32 changed_values = read_channel_returns_XY(batch_item_contexts[i]);
+    U8* last_item = contexts[current_context].last_item;
+    batch_contexts[i] = current_context;
+    batch_changed_values[i] = (U8)changed_values;
+    batch_k_bits[i] = (U8)((contexts[current_context].ic_dX->getK() + contexts[current_context].ic_dY->getK()) / 2);
+    // the other layers have not been decompressed so only the returns_XY layer of this copy is current
+    memcpy(&(batch_items[i*sizeof(LASpoint14)]), last_item, sizeof(LASpoint14));
+    ((LASpoint14*)last_item)->gps_time_change = (changed_values & (1 << 4) ? TRUE : FALSE);
+  }
+  batch_count = count;
+
+  return TRUE;
+}
+
+void LASreadItemCompressed_POINT14_v3::read_batch_layer(const U32 layer)
+{
+  switch (layer)
+  {
+  case 0:
+    if (changed_Z) read_batch_Z();
+    break;
+  case 1:
+    if (changed_classification) read_batch_classification();
+    break;
+  case 2:
+    if (changed_flags) read_batch_flags();
+    break;
+  case 3:
+    if (changed_intensity) read_batch_intensity();
+    break;
+  case 4:
+    if (changed_scan_angle) read_batch_scan_angle();
+    break;
+  case 5:
+    if (changed_user_data) read_batch_user_data();
+    break;
+  case 6:
+    if (changed_point_source) read_batch_point_source();
+    break;
+  case 7:
+    if (changed_gps_time) read_batch_gps_time();
+    break;
+  }
+}
+
+void LASreadItemCompressed_POINT14_v3::get_batch_item(U8* item, const U32 index) const
+{
+  // the returns_XY layer and all unchanged attributes
+
+  memcpy(item, &(batch_items[index*sizeof(LASpoint14)]), sizeof(LASpoint14));
+
+  // overwritten by the columns of the changed layers
+
+  if (changed_Z)
+  {
+    ((LASpoint14*)item)->Z = batch_Z[index];
+  }
+  if (changed_classification)
+  {
+    ((LASpoint14*)item)->classification = batch_classification[index];
+    ((LASpoint14*)item)->legacy_classification = (batch_classification[index] < 32 ? batch_classification[index] : 0);
+  }
+  if (changed_flags)
+  {
+    ((LASpoint14*)item)->edge_of_flight_line = !!(batch_flags[index] & (1 << 5));
+    ((LASpoint14*)item)->scan_direction_flag = !!(batch_flags[index] & (1 << 4));
+    ((LASpoint14*)item)->classification_flags = (batch_flags[index] & 0x0F);
+    ((LASpoint14*)item)->legacy_flags = (batch_flags[index] & 0x07);
+  }
+  if (changed_intensity)
+  {
+    ((LASpoint14*)item)->intensity = batch_intensity[index];
+  }
+  if (changed_scan_angle)
+  {
+    ((LASpoint14*)item)->scan_angle = batch_scan_angle[index];
+    ((LASpoint14*)item)->legacy_scan_angle_rank = batch_legacy_scan_angle_rank[index];
+  }
+  if (changed_user_data)
+  {
+    ((LASpoint14*)item)->user_data = batch_user_data[index];
+  }
+  if (changed_point_source)
+  {
+    ((LASpoint14*)item)->point_source_ID = batch_point_source_ID[index];
+  }
+  if (changed_gps_time)
+  {
+    ((LASpoint14*)item)->gps_time = batch_gps_time[index];
+  }
+}
+
+// each layer keeps its own current context. a context that is first used
+// in this chunk starts with the last values of the context used before it
+// just like a new context starts with the last item in read()
+
+void LASreadItemCompressed_POINT14_v3::read_batch_Z()
+{
+  U32 c = layer_context[0];
+  U32 i, j;
+  for (i = 0; i < batch_count; i++)
+  {
+    if (batch_contexts[i] != c)
+    {
+      if (layer_unused[0][batch_contexts[i]])
+      {
+        for (j = 0; j < 8; j++)
+        {
+          contexts[batch_contexts[i]].last_Z[j] = layer_Z[c];
+        }
+        layer_Z[batch_contexts[i]] = layer_Z[c];
+        layer_unused[0][batch_contexts[i]] = FALSE;
+      }
+      c = batch_contexts[i];
+    }
+    const LASpoint14* point = (const LASpoint14*)&(batch_items[i*sizeof(LASpoint14)]);
+    U32 n = point->number_of_returns;
+    U32 l = number_return_level_8ctx[n][point->return_number];
+    U32 k_bits = batch_k_bits[i];
+    layer_Z[c] = contexts[c].ic_Z->decompress(contexts[c].last_Z[l], (n==1) + (k_bits < 18 ? U32_ZERO_BIT_0(k_bits) : 18));
+    contexts[c].last_Z[l] = layer_Z[c];
+    batch_Z[i] = layer_Z[c];
+  }
+  layer_context[0] = c;
+}
+
+void LASreadItemCompressed_POINT14_v3::read_batch_classification()
+{
+  U32 c = layer_context[1];
+  U32 i;
+  for (i = 0; i < batch_count; i++)
+  {
+    if (batch_contexts[i] != c)
+    {
+      if (layer_unused[1][batch_contexts[i]])
+      {
+        layer_classification[batch_contexts[i]] = layer_classification[c];
+        layer_unused[1][batch_contexts[i]] = FALSE;
+      }
+      c = batch_contexts[i];
+    }
+    const LASpoint14* point = (const LASpoint14*)&(batch_items[i*sizeof(LASpoint14)]);
+    I32 cpr = (point->return_number == 1 ? 2 : 0); // first ?
+    cpr += (point->return_number >= point->number_of_returns ? 1 : 0); // last ?
+    I32 ccc = ((layer_classification[c] & 0x1F) << 1) + (cpr == 3 ? 1 : 0);
+    if (contexts[c].m_classification[ccc] == 0)
+    {
+      contexts[c].m_classification[ccc] = dec_classification->createSymbolModel(256);
+      dec_classification->initSymbolModel(contexts[c].m_classification[ccc]);
+    }
+    layer_classification[c] = dec_classification->decodeSymbol(contexts[c].m_classification[ccc]);
+    batch_classification[i] = layer_classification[c];
+  }
+  layer_context[1] = c;
+}
+
+void LASreadItemCompressed_POINT14_v3::read_batch_flags()
+{
+  U32 c = layer_context[2];
+  U32 i;
+  for (i = 0; i < batch_count; i++)
+  {
+    if (batch_contexts[i] != c)
+    {
+      if (layer_unused[2][batch_contexts[i]])
+      {
+        layer_flags[batch_contexts[i]] = layer_flags[c];
+        layer_unused[2][batch_contexts[i]] = FALSE;
+      }
+      c = batch_contexts[i];
+    }
+    if (contexts[c].m_flags[layer_flags[c]] == 0)
+    {
+      contexts[c].m_flags[layer_flags[c]] = dec_flags->createSymbolModel(64);
+      dec_flags->initSymbolModel(contexts[c].m_flags[layer_flags[c]]);
+    }
+    layer_flags[c] = dec_flags->decodeSymbol(contexts[c].m_flags[layer_flags[c]]);
+    batch_flags[i] = layer_flags[c];
+  }
+  layer_context[2] = c;
+}
+
+void LASreadItemCompressed_POINT14_v3::read_batch_intensity()
+{
+  U32 c = layer_context[3];
+  U32 i, j;
+  for (i = 0; i < batch_count; i++)
+  {
+    if (batch_contexts[i] != c)
+    {
+      if (layer_unused[3][batch_contexts[i]])
+      {
+        for (j = 0; j < 8; j++)
+        {
+          contexts[batch_contexts[i]].last_intensity[j] = layer_intensity[c];
+        }
+        layer_intensity[batch_contexts[i]] = layer_intensity[c];
+        layer_unused[3][batch_contexts[i]] = FALSE;
+      }
+      c = batch_contexts[i];
+    }
+    const LASpoint14* point = (const LASpoint14*)&(batch_items[i*sizeof(LASpoint14)]);
+    I32 cpr = (point->return_number == 1 ? 2 : 0); // first ?
+    cpr += (point->return_number >= point->number_of_returns ? 1 : 0); // last ?
+    U32 gps_time_change = (batch_changed_values[i] & (1 << 4) ? 1 : 0);
+    layer_intensity[c] = contexts[c].ic_intensity->decompress(contexts[c].last_intensity[(cpr<<1) | gps_time_change], cpr);
+    contexts[c].last_intensity[(cpr<<1) | gps_time_change] = layer_intensity[c];
+    batch_intensity[i] = layer_intensity[c];
+  }
+  layer_context[3] = c;
+}
+
+void LASreadItemCompressed_POINT14_v3::read_batch_scan_angle()
+{
+  U32 c = layer_context[4];
+  U32 i;
+  for (i = 0; i < batch_count; i++)
+  {
+    if (batch_contexts[i] != c)
+    {
+      if (layer_unused[4][batch_contexts[i]])
+      {
+        layer_scan_angle[batch_contexts[i]] = layer_scan_angle[c];
+        layer_legacy_scan_angle_rank[batch_contexts[i]] = layer_legacy_scan_angle_rank[c];
+        layer_unused[4][batch_contexts[i]] = FALSE;
+      }
+      c = batch_contexts[i];
+    }
+    if (batch_changed_values[i] & (1 << 3)) // if the scan angle has actually changed
+    {
+      layer_scan_angle[c] = contexts[c].ic_scan_angle->decompress(layer_scan_angle[c], (batch_changed_values[i] & (1 << 4) ? 1 : 0)); // if the GPS time has changed
+      layer_legacy_scan_angle_rank[c] = I8_CLAMP(I16_QUANTIZE(0.006f*layer_scan_angle[c]));
+    }
+    batch_scan_angle[i] = layer_scan_angle[c];
+    batch_legacy_scan_angle_rank[i] = layer_legacy_scan_angle_rank[c];
+  }
+  layer_context[4] = c;
+}
+
+void LASreadItemCompressed_POINT14_v3::read_batch_user_data()
+{
+  U32 c = layer_context[5];
+  U32 i;
+  for (i = 0; i < batch_count; i++)
+  {
+    if (batch_contexts[i] != c)
+    {
+      if (layer_unused[5][batch_contexts[i]])
+      {
+        layer_user_data[batch_contexts[i]] = layer_user_data[c];
+        layer_unused[5][batch_contexts[i]] = FALSE;
+      }
+      c = batch_contexts[i];
+    }
+    if (contexts[c].m_user_data[layer_user_data[c]/4] == 0)
+    {
+      contexts[c].m_user_data[layer_user_data[c]/4] = dec_user_data->createSymbolModel(256);
+      dec_user_data->initSymbolModel(contexts[c].m_user_data[layer_user_data[c]/4]);
+    }
+    layer_user_data[c] = dec_user_data->decodeSymbol(contexts[c].m_user_data[layer_user_data[c]/4]);
+    batch_user_data[i] = layer_user_data[c];
+  }
+  layer_context[5] = c;
+}
+
+void LASreadItemCompressed_POINT14_v3::read_batch_point_source()
+{
+  U32 c = layer_context[6];
+  U32 i;
+  for (i = 0; i < batch_count; i++)
+  {
+    if (batch_contexts[i] != c)
+    {
+      if (layer_unused[6][batch_contexts[i]])
+      {
+        layer_point_source_ID[batch_contexts[i]] = layer_point_source_ID[c];
+        layer_unused[6][batch_contexts[i]] = FALSE;
+      }
+      c = batch_contexts[i];
+    }
+    if (batch_changed_values[i] & (1 << 5)) // if the point source ID has actually changed
+    {
+      layer_point_source_ID[c] = contexts[c].ic_point_source_ID->decompress(layer_point_source_ID[c]);
+    }
+    batch_point_source_ID[i] = layer_point_source_ID[c];
+  }
+  layer_context[6] = c;
+}
+
+void LASreadItemCompressed_POINT14_v3::read_batch_gps_time()
+{
+  U32 c = layer_context[7];
+  U32 i;
+  for (i = 0; i < batch_count; i++)
+  {
+    if (batch_contexts[i] != c)
+    {
+      if (layer_unused[7][batch_contexts[i]])
+      {
+        contexts[batch_contexts[i]].last_gpstime[0].f64 = contexts[c].last_gpstime[contexts[c].last].f64;
+        layer_unused[7][batch_contexts[i]] = FALSE;
+      }
+      c = batch_contexts[i];
+    }
+    if (batch_changed_values[i] & (1 << 4)) // if the GPS time has actually changed
+    {
+      read_gps_time(c);
+    }
+    batch_gps_time[i] = contexts[c].last_gpstime[contexts[c].last].f64;
+  }
+  layer_context[7] = c;
+}
+
+void LASreadItemCompressed_POINT14_v3::read_gps_time(const U32 context)
 {
   I32 multi;
-  if (contexts[current_context].last_gpstime_diff[contexts[current_context].last] == 0) // if the last integer difference was zero
+  if (contexts[context].last_gpstime_diff[contexts[context].last] == 0) // if the last integer difference was zero
   {
-    multi = dec_gps_time->decodeSymbol(contexts[current_context].m_gpstime_0diff);
+    multi = dec_gps_time->decodeSymbol(contexts[context].m_gpstime_0diff);
     if (multi == 0) // the difference can be represented with 32 bits
     {
-      contexts[current_context].last_gpstime_diff[contexts[current_context].last] = contexts[current_context].ic_gpstime->decompress(0, 0);
-      contexts[current_context].last_gpstime[contexts[current_context].last].i64 += contexts[current_context].last_gpstime_diff[contexts[current_context].last];
-      contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0; 
+      contexts[context].last_gpstime_diff[contexts[context].last] = contexts[context].ic_gpstime->decompress(0, 0);
+      contexts[context].last_gpstime[contexts[context].last].i64 += contexts[context].last_gpstime_diff[contexts[context].last];
+      contexts[context].multi_extreme_counter[contexts[context].last] = 0; 
     }
     else if (multi == 1) // the difference is huge
     {
-      contexts[current_context].next = (contexts[current_context].next+1)&3;
-      contexts[current_context].last_gpstime[contexts[current_context].next].u64 = contexts[current_context].ic_gpstime->decompress((I32)(contexts[current_context].last_gpstime[contexts[current_context].last].u64 >> 32), 8);
-      contexts[current_context].last_gpstime[contexts[current_context].next].u64 = contexts[current_context].last_gpstime[contexts[current_context].next].u64 << 32;
-      contexts[current_context].last_gpstime[contexts[current_context].next].u64 |= dec_gps_time->readInt();
-      contexts[current_context].last = contexts[current_context].next;
-      contexts[current_context].last_gpstime_diff[contexts[current_context].last] = 0;
-      contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0; 
+      contexts[context].next = (contexts[context].next+1)&3;
+      contexts[context].last_gpstime[contexts[context].next].u64 = contexts[context].ic_gpstime->decompress((I32)(contexts[context].last_gpstime[contexts[context].last].u64 >> 32), 8);
+      contexts[context].last_gpstime[contexts[context].next].u64 = contexts[context].last_gpstime[contexts[context].next].u64 << 32;
+      contexts[context].last_gpstime[contexts[context].next].u64 |= dec_gps_time->readInt();
+      contexts[context].last = contexts[context].next;
+      contexts[context].last_gpstime_diff[contexts[context].last] = 0;
+      contexts[context].multi_extreme_counter[contexts[context].last] = 0; 
     }
     else // we switch to another sequence
     {
-      contexts[current_context].last = (contexts[current_context].last+multi-1)&3;
-      read_gps_time();
+      contexts[context].last = (contexts[context].last+multi-1)&3;
+      read_gps_time(context);
     }
   }
   else
   {
-    multi = dec_gps_time->decodeSymbol(contexts[current_context].m_gpstime_multi);
+    multi = dec_gps_time->decodeSymbol(contexts[context].m_gpstime_multi);
     if (multi == 1)
     {
-      contexts[current_context].last_gpstime[contexts[current_context].last].i64 += contexts[current_context].ic_gpstime->decompress(contexts[current_context].last_gpstime_diff[contexts[current_context].last], 1);;
-      contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0;
+      contexts[context].last_gpstime[contexts[context].last].i64 += contexts[context].ic_gpstime->decompress(contexts[context].last_gpstime_diff[contexts[context].last], 1);;
+      contexts[context].multi_extreme_counter[contexts[context].last] = 0;
     }
     else if (multi < LASZIP_GPSTIME_MULTI_CODE_FULL)
     {
       I32 gpstime_diff;
       if (multi == 0)
       {
-        gpstime_diff = contexts[current_context].ic_gpstime->decompress(0, 7);
-        contexts[current_context].multi_extreme_counter[contexts[current_context].last]++;
-        if (contexts[current_context].multi_extreme_counter[contexts[current_context].last] > 3)
+        gpstime_diff = contexts[context].ic_gpstime->decompress(0, 7);
+        contexts[context].multi_extreme_counter[contexts[context].last]++;
+        if (contexts[context].multi_extreme_counter[contexts[context].last] > 3)
         {
-          contexts[current_context].last_gpstime_diff[contexts[current_context].last] = gpstime_diff;
-          contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0;
+          contexts[context].last_gpstime_diff[contexts[context].last] = gpstime_diff;
+          contexts[context].multi_extreme_counter[contexts[context].last] = 0;
         }
       }
       else if (multi < LASZIP_GPSTIME_MULTI)
       {
         if (multi < 10)
-          gpstime_diff = contexts[current_context].ic_gpstime->decompress(multi*contexts[current_context].last_gpstime_diff[contexts[current_context].last], 2);
+          gpstime_diff = contexts[context].ic_gpstime->decompress(multi*contexts[context].last_gpstime_diff[contexts[context].last], 2);
         else
-          gpstime_diff = contexts[current_context].ic_gpstime->decompress(multi*contexts[current_context].last_gpstime_diff[contexts[current_context].last], 3);
+          gpstime_diff = contexts[context].ic_gpstime->decompress(multi*contexts[context].last_gpstime_diff[contexts[context].last], 3);
       }
       else if (multi == LASZIP_GPSTIME_MULTI)
       {
-        gpstime_diff = contexts[current_context].ic_gpstime->decompress(LASZIP_GPSTIME_MULTI*contexts[current_context].last_gpstime_diff[contexts[current_context].last], 4);
-        contexts[current_context].multi_extreme_counter[contexts[current_context].last]++;
-        if (contexts[current_context].multi_extreme_counter[contexts[current_context].last] > 3)
+        gpstime_diff = contexts[context].ic_gpstime->decompress(LASZIP_GPSTIME_MULTI*contexts[context].last_gpstime_diff[contexts[context].last], 4);
+        contexts[context].multi_extreme_counter[contexts[context].last]++;
+        if (contexts[context].multi_extreme_counter[contexts[context].last] > 3)
         {
-          contexts[current_context].last_gpstime_diff[contexts[current_context].last] = gpstime_diff;
-          contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0;
+          contexts[context].last_gpstime_diff[contexts[context].last] = gpstime_diff;
+          contexts[context].multi_extreme_counter[contexts[context].last] = 0;
         }
       }
       else
@@ -1068,35 +1505,35 @@ void LASreadItemCompressed_POINT14_v3::read_gps_time()
         multi = LASZIP_GPSTIME_MULTI - multi;
         if (multi > LASZIP_GPSTIME_MULTI_MINUS)
         {
-          gpstime_diff = contexts[current_context].ic_gpstime->decompress(multi*contexts[current_context].last_gpstime_diff[contexts[current_context].last], 5);
+          gpstime_diff = contexts[context].ic_gpstime->decompress(multi*contexts[context].last_gpstime_diff[contexts[context].last], 5);
         }
         else
         {
-          gpstime_diff = contexts[current_context].ic_gpstime->decompress(LASZIP_GPSTIME_MULTI_MINUS*contexts[current_context].last_gpstime_diff[contexts[current_context].last], 6);
-          contexts[current_context].multi_extreme_counter[contexts[current_context].last]++;
-          if (contexts[current_context].multi_extreme_counter[contexts[current_context].last] > 3)
+          gpstime_diff = contexts[context].ic_gpstime->decompress(LASZIP_GPSTIME_MULTI_MINUS*contexts[context].last_gpstime_diff[contexts[context].last], 6);
+          contexts[context].multi_extreme_counter[contexts[context].last]++;
+          if (contexts[context].multi_extreme_counter[contexts[context].last] > 3)
           {
-            contexts[current_context].last_gpstime_diff[contexts[current_context].last] = gpstime_diff;
-            contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0;
+            contexts[context].last_gpstime_diff[contexts[context].last] = gpstime_diff;
+            contexts[context].multi_extreme_counter[contexts[context].last] = 0;
           }
         }
       }
-      contexts[current_context].last_gpstime[contexts[current_context].last].i64 += gpstime_diff;
+      contexts[context].last_gpstime[contexts[context].last].i64 += gpstime_diff;
     }
     else if (multi ==  LASZIP_GPSTIME_MULTI_CODE_FULL)
     {
-      contexts[current_context].next = (contexts[current_context].next+1)&3;
-      contexts[current_context].last_gpstime[contexts[current_context].next].u64 = contexts[current_context].ic_gpstime->decompress((I32)(contexts[current_context].last_gpstime[contexts[current_context].last].u64 >> 32), 8);
-      contexts[current_context].last_gpstime[contexts[current_context].next].u64 = contexts[current_context].last_gpstime[contexts[current_context].next].u64 << 32;
-      contexts[current_context].last_gpstime[contexts[current_context].next].u64 |= dec_gps_time->readInt();
-      contexts[current_context].last = contexts[current_context].next;
-      contexts[current_context].last_gpstime_diff[contexts[current_context].last] = 0;
-      contexts[current_context].multi_extreme_counter[contexts[current_context].last] = 0; 
+      contexts[context].next = (contexts[context].next+1)&3;
+      contexts[context].last_gpstime[contexts[context].next].u64 = contexts[context].ic_gpstime->decompress((I32)(contexts[context].last_gpstime[contexts[context].last].u64 >> 32), 8);
+      contexts[context].last_gpstime[contexts[context].next].u64 = contexts[context].last_gpstime[contexts[context].next].u64 << 32;
+      contexts[context].last_gpstime[contexts[context].next].u64 |= dec_gps_time->readInt();
+      contexts[context].last = contexts[context].next;
+      contexts[context].last_gpstime_diff[contexts[context].last] = 0;
+      contexts[context].multi_extreme_counter[contexts[context].last] = 0; 
     }
     else if (multi >=  LASZIP_GPSTIME_MULTI_CODE_FULL)
     {
-      contexts[current_context].last = (contexts[current_context].last+multi-LASZIP_GPSTIME_MULTI_CODE_FULL)&3;
-      read_gps_time();
+      contexts[context].last = (contexts[context].last+multi-LASZIP_GPSTIME_MULTI_CODE_FULL)&3;
+      read_gps_time(context);
     }
   }
 }
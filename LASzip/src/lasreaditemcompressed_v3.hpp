@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- decoding of point batches layer by layer into columns
     30 December 2021 -- fix small memory leak
     19 March 2019 -- set "legacy classification" to zero if "classification > 31"  
     28 August 2017 -- moving 'context' from global development hack to interface  
@@ -53,6 +54,17 @@ public:
   BOOL init(const U8* item, U32& context); // context is set
   void read(U8* item, U32& context);       // context is set
 
+  // decodes the next 'count' points of the chunk layer by layer. first the
+  // channel_returns_XY layer of all points is decoded and their contexts
+  // are set. then each of the other layers 0 to 7 (Z, classification, flags,
+  // intensity, scan_angle, user_data, point_source, gps_time) is decoded into
+  // its own column. the layers are independent and may run concurrently.
+  // the contexts for the other items are those that read() would have set
+  BOOL read_batch_returns_XY(const U32 count);
+  void read_batch_layer(const U32 layer);
+  const U32* get_batch_contexts() const { return batch_item_contexts; };
+  void get_batch_item(U8* item, const U32 index) const;
+
   ~LASreadItemCompressed_POINT14_v3();
 
 private:
@@ -115,8 +127,49 @@ private:
   U32 current_context;
   LAScontextPOINT14 contexts[4];
 
+  // the points of a batch after the channel_returns_XY layer
+  U32 batch_count;
+  U32 batch_allocated;
+  U8* batch_items;
+  U32* batch_contexts;
+  U32* batch_item_contexts;
+  U8* batch_changed_values;
+  U8* batch_k_bits;
+
+  // one column per layer
+  I32* batch_Z;
+  U8* batch_classification;
+  U8* batch_flags;
+  U16* batch_intensity;
+  I16* batch_scan_angle;
+  I8* batch_legacy_scan_angle_rank;
+  U8* batch_user_data;
+  U16* batch_point_source_ID;
+  F64* batch_gps_time;
+
+  // the context of each layer and its last values per context
+  U32 layer_context[8];
+  BOOL layer_unused[8][4];
+  I32 layer_Z[4];
+  U8 layer_classification[4];
+  U8 layer_flags[4];
+  U16 layer_intensity[4];
+  I16 layer_scan_angle[4];
+  I8 layer_legacy_scan_angle_rank[4];
+  U8 layer_user_data[4];
+  U16 layer_point_source_ID[4];
+
   BOOL createAndInitModelsAndDecompressors(U32 context, const U8* item);
-  void read_gps_time();
+  I32 read_channel_returns_XY(U32& context);
+  void read_gps_time(const U32 context);
+  void read_batch_Z();
+  void read_batch_classification();
+  void read_batch_flags();
+  void read_batch_intensity();
+  void read_batch_scan_angle();
+  void read_batch_user_data();
+  void read_batch_point_source();
+  void read_batch_gps_time();
 };
 
 class LASreadItemCompressed_RGB14_v3 : public LASreadItemCompressed
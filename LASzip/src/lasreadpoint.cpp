@@ -42,6 +42,12 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <thread>
+#include <vector>
+
+// number of points of a layered chunk that are decoded together
+#define LAS_READ_POINT_LAYER_BATCH 50000
+
 LASreadPoint::LASreadPoint(U32 decompress_selective)
 {
   point_size = 0;
@@ -60,11 +66,27 @@ LASreadPoint::LASreadPoint(U32 decompress_selective)
   tabled_chunks = 0;
   chunk_totals = 0;
   chunk_starts = 0;
+  // used for copying chunks
+  peek_bytes = 0;
+  alloced_peek_bytes = 0;
+  peek_chunk_index = U32_MAX;
   // used for selective decompression (new LAS 1.4 point types only)
   this->decompress_selective = decompress_selective;
   // used for seeking
   point_start = 0;
   seek_point = 0;
+  // used for decoding layered LAS 1.4 chunks batch by batch
+  layer_threads = 0;
+  layer_point14 = 0;
+  layer_buffers = 0;
+  layer_sizes = 0;
+  layer_left = 0;
+  layer_count = 0;
+  layer_next = 0;
+  layer_tasks = 0;
+  layer_task = 0;
+  layer_failed = FALSE;
+  layer_exception = nullptr;
   // used for error and warning reporting
   last_error = 0;
   last_warning = 0;
@@ -290,6 +312,26 @@ BOOL LASreadPoint::setup(U32 num_items, const LASitem* items, const LASzip* lasz
         }
       }
     }
+    // the new LAS 1.4 point can be decoded layer by layer
+    if (layered_las14_compression && (items[0].type == LASitem::POINT14) && ((items[0].version == 3) || (items[0].version == 2)))
+    {
+      layer_point14 = (LASreadItemCompressed_POINT14_v3*)readers_compressed[0];
+      layer_buffers = new U8*[num_readers];
+      layer_sizes = new U32[num_readers];
+      for (i = 0; i < num_readers; i++)
+      {
+        layer_buffers[i] = 0;
+        layer_sizes[i] = 0;
+        // other items whose layers only depend on the context are decoded into buffers
+        if (i && ((items[i].version == 3) || (items[i].version == 2)))
+        {
+          if ((items[i].type == LASitem::RGB14) || (items[i].type == LASitem::RGBNIR14) || (items[i].type == LASitem::BYTE14))
+          {
+            layer_sizes[i] = items[i].size;
+          }
+        }
+      }
+    }
     if (laszip->compressor != LASZIP_COMPRESSOR_POINTWISE)
     {
       if (laszip->chunk_size) chunk_size = laszip->chunk_size;
@@ -299,6 +341,11 @@ BOOL LASreadPoint::setup(U32 num_items, const LASitem* items, const LASzip* lasz
   return TRUE;
 }
 
+void LASreadPoint::set_layer_threads(const U32 layer_threads)
+{
+  this->layer_threads = layer_threads;
+}
+
 BOOL LASreadPoint::init(ByteStreamIn* instream)
 {
   if (!instream) return FALSE;
@@ -453,9 +500,39 @@ BOOL LASreadPoint::read(U8* const * point)
 
       if (readers)
       {
-        for (i = 0; i < num_readers; i++)
+        if (layer_left && (layer_next == layer_count))
         {
-          readers[i]->read(point[i], context);
+          if (!read_layer_batch())
+          {
+            if (last_error == 0) last_error = new CHAR[128];
+            snprintf(last_error, 128, "cannot allocate batch of %u points", LAS_READ_POINT_LAYER_BATCH);
+            return FALSE;
+          }
+        }
+        if (layer_next < layer_count)
+        {
+          // the point was already decoded with its batch
+          context = layer_point14->get_batch_contexts()[layer_next];
+          layer_point14->get_batch_item(point[0], layer_next);
+          for (i = 1; i < num_readers; i++)
+          {
+            if (layer_sizes[i])
+            {
+              memcpy(point[i], &(layer_buffers[i][layer_next*layer_sizes[i]]), layer_sizes[i]);
+            }
+            else
+            {
+              readers[i]->read(point[i], context);
+            }
+          }
+          layer_next++;
+        }
+        else
+        {
+          for (i = 0; i < num_readers; i++)
+          {
+            readers[i]->read(point[i], context);
+          }
         }
       }
       else
@@ -480,6 +557,11 @@ BOOL LASreadPoint::read(U8* const * point)
           {
             ((LASreadItemCompressed*)(readers_compressed[i]))->init(point[i], context);
           }
+          // maybe decode the remaining points of the chunk batch by batch with several threads
+          if (layer_point14 && (layer_threads > 1) && (count > 1) && (count <= chunk_size))
+          {
+            layer_left = count - 1;
+          }
           if (DEBUG_OUTPUT_NUM_BYTES_DETAILS) fprintf(stderr, "\n");
         }
         else
@@ -562,6 +644,94 @@ BOOL LASreadPoint::check_end()
   return TRUE;
 }
 
+BOOL LASreadPoint::peek_chunk(const U8** bytes, U32* num_bytes, U32* num_points)
+{
+  peek_chunk_index = U32_MAX;
+  if (!dec || !layered_las14_compression || !instream->isSeekable()) return FALSE;
+
+  // only between two chunks
+  if (chunk_count != chunk_size) return FALSE;
+
+  U32 next_chunk;
+  if (point_start == 0)
+  {
+    // nothing was read yet
+    if (number_chunks == U32_MAX)
+    {
+      if (!read_chunk_table())
+      {
+        return FALSE;
+      }
+      current_chunk = 0;
+      if (chunk_totals) chunk_size = chunk_totals[1];
+      chunk_count = chunk_size;
+    }
+    next_chunk = 0;
+  }
+  else
+  {
+    next_chunk = current_chunk + 1;
+  }
+
+  // the chunk table must be complete to know where the chunk ends
+  if ((chunk_starts == 0) || (tabled_chunks != (number_chunks + 1)) || (next_chunk >= number_chunks)) return FALSE;
+
+  I64 start = chunk_starts[next_chunk];
+  I64 size = chunk_starts[next_chunk+1] - start;
+  if ((size <= (I64)(point_size + 4)) || (size > U32_MAX)) return FALSE;
+  if (instream->tell() != start) return FALSE;
+
+  if (size > alloced_peek_bytes)
+  {
+    if (peek_bytes) free(peek_bytes);
+    alloced_peek_bytes = (U32)size;
+    peek_bytes = (U8*)malloc(alloced_peek_bytes);
+    if (peek_bytes == 0)
+    {
+      alloced_peek_bytes = 0;
+      return FALSE;
+    }
+  }
+  try { instream->getBytes(peek_bytes, (U32)size); } catch(...)
+  {
+    instream->seek(start);
+    return FALSE;
+  }
+  if (!instream->seek(start)) return FALSE;
+
+  // the number of points follows the first point
+  U32 count;
+  memcpy(&count, peek_bytes + point_size, 4);
+  if (count == 0) return FALSE;
+  if (chunk_totals)
+  {
+    if (count != (chunk_totals[next_chunk+1] - chunk_totals[next_chunk])) return FALSE;
+  }
+  else if (count > chunk_size)
+  {
+    return FALSE;
+  }
+
+  *bytes = peek_bytes;
+  *num_bytes = (U32)size;
+  *num_points = count;
+  peek_chunk_index = next_chunk;
+  return TRUE;
+}
+
+BOOL LASreadPoint::skip_chunk()
+{
+  if (peek_chunk_index == U32_MAX) return FALSE;
+  if (!instream->seek(chunk_starts[peek_chunk_index+1])) return FALSE;
+  // as if the chunk was read
+  current_chunk = peek_chunk_index;
+  point_start = chunk_starts[peek_chunk_index];
+  if (chunk_totals) chunk_size = chunk_totals[current_chunk+1] - chunk_totals[current_chunk];
+  chunk_count = chunk_size;
+  peek_chunk_index = U32_MAX;
+  return TRUE;
+}
+
 BOOL LASreadPoint::done()
 {
   instream = 0;
@@ -585,9 +755,104 @@ BOOL LASreadPoint::init_dec()
   point_start = instream->tell();
   readers = 0;
 
+  // no batch of the new chunk is decoded yet
+  layer_left = 0;
+  layer_count = 0;
+  layer_next = 0;
+
   return TRUE;
 }
 
+BOOL LASreadPoint::read_layer_batch()
+{
+  U32 i;
+  U32 count = (layer_left < LAS_READ_POINT_LAYER_BATCH ? layer_left : LAS_READ_POINT_LAYER_BATCH);
+
+  // the channel_returns_XY layer sets the contexts all other layers depend on
+
+  if (!layer_point14->read_batch_returns_XY(count)) return FALSE;
+  layer_count = count;
+  layer_next = 0;
+  layer_left -= count;
+
+  // then the other layers of the point and the layers of the other items are independent
+
+  for (i = 1; i < num_readers; i++)
+  {
+    if (layer_sizes[i] && (layer_buffers[i] == 0))
+    {
+      layer_buffers[i] = new U8[LAS_READ_POINT_LAYER_BATCH*layer_sizes[i]];
+      if (layer_buffers[i] == 0) return FALSE;
+    }
+  }
+  layer_tasks = 8 + num_readers - 1;
+  layer_task = 0;
+  layer_failed = FALSE;
+
+  std::vector<std::thread> workers;
+  for (i = 1; (i < layer_threads) && (i < layer_tasks); i++)
+  {
+    workers.push_back(std::thread(&LASreadPoint::read_layer_tasks, this));
+  }
+  read_layer_tasks();
+  for (i = 0; i < workers.size(); i++)
+  {
+    workers[i].join();
+  }
+
+  if (layer_failed)
+  {
+    std::exception_ptr exception = layer_exception;
+    layer_exception = nullptr;
+    std::rethrow_exception(exception);
+  }
+  return TRUE;
+}
+
+void LASreadPoint::read_layer_tasks()
+{
+  // the usually most expensive layers are started first
+  static const U32 layer_order[8] = {7, 0, 3, 1, 2, 4, 5, 6};
+  U32 task, i, j;
+  while ((task = layer_task.fetch_add(1)) < layer_tasks)
+  {
+    try
+    {
+      if (task < 3)
+      {
+        layer_point14->read_batch_layer(layer_order[task]);
+      }
+      else if (task < (num_readers + 2))
+      {
+        i = task - 2;
+        if (layer_sizes[i])
+        {
+          const U32* contexts = layer_point14->get_batch_contexts();
+          for (j = 0; j < layer_count; j++)
+          {
+            U32 context = contexts[j];
+            readers_compressed[i]->read(&(layer_buffers[i][j*layer_sizes[i]]), context);
+          }
+        }
+      }
+      else
+      {
+        layer_point14->read_batch_layer(layer_order[task - (num_readers - 1)]);
+      }
+    }
+    catch (...)
+    {
+      // any exception (e.g. the I32 of a truncated stream or std::bad_alloc)
+      // must not escape the worker thread
+      BOOL expected = FALSE;
+      if (layer_failed.compare_exchange_strong(expected, TRUE))
+      {
+        layer_exception = std::current_exception();
+      }
+    }
+  }
+}
+
 BOOL LASreadPoint::read_chunk_table()
 {
   // read the 8 bytes that store the location of the chunk table
@@ -824,6 +1089,7 @@ LASreadPoint::~LASreadPoint()
 
   if (chunk_totals) delete [] chunk_totals;
   if (chunk_starts) free(chunk_starts);
+  if (peek_bytes) free(peek_bytes);
 
   if (seek_point)
   {
@@ -831,6 +1097,16 @@ LASreadPoint::~LASreadPoint()
     delete [] seek_point;
   }
 
+  if (layer_buffers)
+  {
+    for (i = 0; i < num_readers; i++)
+    {
+      if (layer_buffers[i]) delete [] layer_buffers[i];
+    }
+    delete [] layer_buffers;
+    delete [] layer_sizes;
+  }
+
   if (last_error) delete [] last_error;
   if (last_warning) delete [] last_warning;
 }
@@ -24,6 +24,8 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- hand out entire compressed chunks for copying them as-is
+    18 October 2026 -- decode layered LAS 1.4 chunks in batches with several threads
     23 September 2020 -- rare fix for bit-corrupted LAZ files where chunk table is zeroed
     28 August 2017 -- moving 'context' from global development hack to interface  
     18 July 2017 -- bug fix for spatial-indexed reading of native compressed LAS 1.4 
@@ -50,7 +52,11 @@
 #include "laszip_decompress_selective_v3.hpp"
 #include "bytestreamin.hpp"
 
+#include <atomic>
+#include <exception>
+
 class LASreadItem;
+class LASreadItemCompressed_POINT14_v3;
 class ArithmeticDecoder;
 
 class LASreadPoint
@@ -62,12 +68,20 @@ public:
   // should only be called *once*
   BOOL setup(const U32 num_items, const LASitem* items, const LASzip* laszip=0);
 
+  // decode the layers of new LAS 1.4 points with up to this many threads
+  void set_layer_threads(const U32 layer_threads);
+
   BOOL init(ByteStreamIn* instream);
   BOOL seek(const U32 current, const U32 target);
   BOOL read(U8* const * point);
   BOOL check_end();
   BOOL done();
 
+  // between two chunks of layered LAS 1.4 points (and with a chunk table) the
+  // bytes of the next chunk can be looked at and then be read or skipped
+  BOOL peek_chunk(const U8** bytes, U32* num_bytes, U32* num_points);
+  BOOL skip_chunk();
+
   inline const CHAR* error() const { return last_error; };
   inline const CHAR* warning() const { return last_warning; };
 
@@ -90,12 +104,30 @@ private:
   BOOL init_dec();
   BOOL read_chunk_table();
   U32 search_chunk_table(const U32 index, const U32 lower, const U32 upper);
+  // used for copying chunks
+  U8* peek_bytes;
+  U32 alloced_peek_bytes;
+  U32 peek_chunk_index;
   // used for selective decompression (new LAS 1.4 point types only)
   U32 decompress_selective;
   // used for seeking
   I64 point_start;
   U32 point_size;
   U8** seek_point;
+  // used for decoding layered LAS 1.4 chunks batch by batch
+  U32 layer_threads;
+  LASreadItemCompressed_POINT14_v3* layer_point14;
+  U8** layer_buffers;
+  U32* layer_sizes;
+  U32 layer_left;
+  U32 layer_count;
+  U32 layer_next;
+  U32 layer_tasks;
+  std::atomic<U32> layer_task;
+  std::atomic<BOOL> layer_failed;
+  std::exception_ptr layer_exception; // of the first failed task, thrown again on the calling thread
+  BOOL read_layer_batch();
+  void read_layer_tasks();
   // used for error and warning reporting
   CHAR* last_error;
   CHAR* last_warning;
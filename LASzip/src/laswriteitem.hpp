@@ -24,6 +24,8 @@
   
   CHANGE HISTORY:
   
+    18 October 2026 -- set_compress_selective() to encode only some layers
+    18 October 2026 -- pending_bytes() of a layered item for sizing chunks
     28 August 2017 -- moving 'context' from global development hack to interface  
     23 August 2016 -- layering of items for selective decompression in LAS 1.4 
     10 January 2011 -- licensing change for LGPL release and liblas integration
@@ -70,6 +72,10 @@ public:
   virtual BOOL init(const U8* item, U32& context)=0;
   virtual BOOL chunk_sizes() { return FALSE; };
   virtual BOOL chunk_bytes() { return FALSE; };
+  // bytes compressed so far into the layers of the current chunk
+  virtual U32 pending_bytes() const { return 0; };
+  // layers not selected are copied by the caller instead of being encoded
+  virtual void set_compress_selective(U32 compress_selective) { };
 
   virtual ~LASwriteItemCompressed(){};
 };
@@ -37,6 +37,7 @@
 #include "arithmeticencoder.hpp"
 #include "integercompressor.hpp"
 #include "bytestreamout_array.hpp"
+#include "laszip_decompress_selective_v3.hpp"
 
 #include "laszip_common_v3.hpp"
 
@@ -50,6 +51,8 @@ public:
   BOOL write(const U8* item, U32& context);
   BOOL chunk_sizes();
   BOOL chunk_bytes();
+  U32 pending_bytes() const;
+  void set_compress_selective(U32 compress_selective);
 
   ~LASwriteItemCompressed_POINT14_v3();
 
@@ -100,6 +103,11 @@ private:
   U32 current_context;
   LAScontextPOINT14 contexts[4];
 
+  /* the layers that are actually encoded */
+
+  U32 compress_selective;
+  BOOL compress_XY;
+
   BOOL createAndInitModelsAndCompressors(U32 context, const U8* item);
   void write_gps_time(const U64I64F64 gps_time);
 };
@@ -114,6 +122,7 @@ public:
   BOOL write(const U8* item, U32& context);
   BOOL chunk_sizes();
   BOOL chunk_bytes();
+  U32 pending_bytes() const;
 
   ~LASwriteItemCompressed_RGB14_v3();
 
@@ -147,6 +156,7 @@ public:
   BOOL write(const U8* item, U32& context);
   BOOL chunk_sizes();
   BOOL chunk_bytes();
+  U32 pending_bytes() const;
 
   ~LASwriteItemCompressed_RGBNIR14_v3();
 
@@ -184,6 +194,7 @@ public:
   BOOL write(const U8* item, U32& context);
   BOOL chunk_sizes();
   BOOL chunk_bytes();
+  U32 pending_bytes() const;
 
   ~LASwriteItemCompressed_WAVEPACKET14_v3();
 
@@ -217,6 +228,7 @@ public:
   BOOL write(const U8* item, U32& context);
   BOOL chunk_sizes();
   BOOL chunk_bytes();
+  U32 pending_bytes() const;
 
   ~LASwriteItemCompressed_BYTE14_v3();
 
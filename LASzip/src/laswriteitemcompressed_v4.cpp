@@ -143,6 +143,11 @@ LASwriteItemCompressed_POINT14_v4::LASwriteItemCompressed_POINT14_v4(ArithmeticE
   num_bytes_user_data = 0;
   num_bytes_point_source = 0;
   num_bytes_gps_time = 0;
+
+  /* all layers are encoded */
+
+  compress_selective = LASZIP_DECOMPRESS_SELECTIVE_ALL;
+  compress_XY = TRUE;
 }
 
 LASwriteItemCompressed_POINT14_v4::~LASwriteItemCompressed_POINT14_v4()
@@ -472,6 +477,16 @@ BOOL LASwriteItemCompressed_POINT14_v4::init(const U8* item, U32& context)
   return TRUE;
 }
 
+// only the selected layers are encoded (e.g. when the others are copied from
+// the same chunk of another file). the contexts still follow every point. the
+// Z layer depends on the state of the X and Y compressors
+
+void LASwriteItemCompressed_POINT14_v4::set_compress_selective(U32 compress_selective)
+{
+  this->compress_selective = compress_selective;
+  compress_XY = ((compress_selective & LASZIP_DECOMPRESS_SELECTIVE_Z) ? TRUE : FALSE);
+}
+
 inline BOOL LASwriteItemCompressed_POINT14_v4::write(const U8* item, U32& context)
 {
   // get last
@@ -547,14 +562,21 @@ inline BOOL LASwriteItemCompressed_POINT14_v4::write(const U8* item, U32& contex
 
   // compress the 7 bit mask that encodes changes with last point return context
 
-  enc_channel_returns_XY->encodeSymbol(contexts[current_context].m_changed_values[lpr], changed_values);
+  if (compress_XY)
+  {
+    enc_channel_returns_XY->encodeSymbol(contexts[current_context].m_changed_values[lpr], changed_values);
+  }
 
   // if scanner channel has changed, record change
 
   if (changed_values & (1 << 6))
   {
     I32 diff = scanner_channel - current_context;
-    if (diff > 0)
+    if (!compress_XY)
+    {
+      // not encoded
+    }
+    else if (diff > 0)
     {
       enc_channel_returns_XY->encodeSymbol(contexts[current_context].m_scanner_channel, diff - 1); // curr = last + (sym + 1)
     }
@@ -577,7 +599,7 @@ inline BOOL LASwriteItemCompressed_POINT14_v4::write(const U8* item, U32& contex
 
   // if number of returns is different we compress it
 
-  if (changed_values & (1 << 2))
+  if (compress_XY && (changed_values & (1 << 2)))
   {
     if (contexts[current_context].m_number_of_returns[last_n] == 0)
     {
@@ -589,7 +611,7 @@ inline BOOL LASwriteItemCompressed_POINT14_v4::write(const U8* item, U32& contex
 
   // if return number is different and difference is bigger than +1 / -1 we compress how it is different
 
-  if ((changed_values & 3) == 3)
+  if (compress_XY && ((changed_values & 3) == 3))
   {
     if (gps_time_change) // if the GPS time has changed
     {
@@ -627,82 +649,97 @@ inline BOOL LASwriteItemCompressed_POINT14_v4::write(const U8* item, U32& contex
   U32 k_bits;
   I32 median, diff;
 
-  // compress X coordinate
-  median = contexts[current_context].last_X_diff_median5[(m<<1) | gps_time_change].get();
-  diff = ((const LASpoint14*)item)->X - ((LASpoint14*)last_item)->X;
-  contexts[current_context].ic_dX->compress(median, diff, n==1);
-  contexts[current_context].last_X_diff_median5[(m<<1) | gps_time_change].add(diff);
+  if (compress_XY)
+  {
+    // compress X coordinate
+    median = contexts[current_context].last_X_diff_median5[(m<<1) | gps_time_change].get();
+    diff = ((const LASpoint14*)item)->X - ((LASpoint14*)last_item)->X;
+    contexts[current_context].ic_dX->compress(median, diff, n==1);
+    contexts[current_context].last_X_diff_median5[(m<<1) | gps_time_change].add(diff);
 
-  // compress Y coordinate
-  k_bits = contexts[current_context].ic_dX->getK();
-  median = contexts[current_context].last_Y_diff_median5[(m<<1) | gps_time_change].get();
-  diff = ((const LASpoint14*)item)->Y - ((LASpoint14*)last_item)->Y;
-  contexts[current_context].ic_dY->compress(median, diff, (n==1) + ( k_bits < 20 ? U32_ZERO_BIT_0(k_bits) : 20 ));
-  contexts[current_context].last_Y_diff_median5[(m<<1) | gps_time_change].add(diff);
+    // compress Y coordinate
+    k_bits = contexts[current_context].ic_dX->getK();
+    median = contexts[current_context].last_Y_diff_median5[(m<<1) | gps_time_change].get();
+    diff = ((const LASpoint14*)item)->Y - ((LASpoint14*)last_item)->Y;
+    contexts[current_context].ic_dY->compress(median, diff, (n==1) + ( k_bits < 20 ? U32_ZERO_BIT_0(k_bits) : 20 ));
+    contexts[current_context].last_Y_diff_median5[(m<<1) | gps_time_change].add(diff);
+  }
 
   ////////////////////////////////////////
   // compress Z layer 
   ////////////////////////////////////////
 
-  k_bits = (contexts[current_context].ic_dX->getK() + contexts[current_context].ic_dY->getK()) / 2;
-  contexts[current_context].ic_Z->compress(contexts[current_context].last_Z[l], ((const LASpoint14*)item)->Z, (n==1) + (k_bits < 18 ? U32_ZERO_BIT_0(k_bits) : 18));
-  contexts[current_context].last_Z[l] = ((const LASpoint14*)item)->Z;
+  if (compress_selective & LASZIP_DECOMPRESS_SELECTIVE_Z)
+  {
+    k_bits = (contexts[current_context].ic_dX->getK() + contexts[current_context].ic_dY->getK()) / 2;
+    contexts[current_context].ic_Z->compress(contexts[current_context].last_Z[l], ((const LASpoint14*)item)->Z, (n==1) + (k_bits < 18 ? U32_ZERO_BIT_0(k_bits) : 18));
+    contexts[current_context].last_Z[l] = ((const LASpoint14*)item)->Z;
+  }
 
   ////////////////////////////////////////
   // compress classifications layer 
   ////////////////////////////////////////
 
-  U32 last_classification = ((LASpoint14*)last_item)->classification;
-  U32 classification = ((const LASpoint14*)item)->classification;
-
-  if (classification != last_classification)
+  if (compress_selective & LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION)
   {
-    changed_classification = TRUE;
-  }
+    U32 last_classification = ((LASpoint14*)last_item)->classification;
+    U32 classification = ((const LASpoint14*)item)->classification;
 
-  I32 ccc = ((last_classification & 0x1F) << 1) + (cpr == 3 ? 1 : 0);
-  if (contexts[current_context].m_classification[ccc] == 0)
-  {
-    contexts[current_context].m_classification[ccc] = enc_classification->createSymbolModel(256);
-    enc_classification->initSymbolModel(contexts[current_context].m_classification[ccc]);
+    if (classification != last_classification)
+    {
+      changed_classification = TRUE;
+    }
+
+    I32 ccc = ((last_classification & 0x1F) << 1) + (cpr == 3 ? 1 : 0);
+    if (contexts[current_context].m_classification[ccc] == 0)
+    {
+      contexts[current_context].m_classification[ccc] = enc_classification->createSymbolModel(256);
+      enc_classification->initSymbolModel(contexts[current_context].m_classification[ccc]);
+    }
+    enc_classification->encodeSymbol(contexts[current_context].m_classification[ccc], classification);
   }
-  enc_classification->encodeSymbol(contexts[current_context].m_classification[ccc], classification);
 
   ////////////////////////////////////////
   // compress flags layer 
   ////////////////////////////////////////
 
-  U32 last_flags = (((LASpoint14*)last_item)->edge_of_flight_line << 5) | (((LASpoint14*)last_item)->scan_direction_flag << 4) | ((LASpoint14*)last_item)->classification_flags;
-  U32 flags = (((const LASpoint14*)item)->edge_of_flight_line << 5) | (((const LASpoint14*)item)->scan_direction_flag << 4) | ((const LASpoint14*)item)->classification_flags;
-
-  if (flags != last_flags)
+  if (compress_selective & LASZIP_DECOMPRESS_SELECTIVE_FLAGS)
   {
-    changed_flags = TRUE;
-  }
+    U32 last_flags = (((LASpoint14*)last_item)->edge_of_flight_line << 5) | (((LASpoint14*)last_item)->scan_direction_flag << 4) | ((LASpoint14*)last_item)->classification_flags;
+    U32 flags = (((const LASpoint14*)item)->edge_of_flight_line << 5) | (((const LASpoint14*)item)->scan_direction_flag << 4) | ((const LASpoint14*)item)->classification_flags;
 
-  if (contexts[current_context].m_flags[last_flags] == 0)
-  {
-    contexts[current_context].m_flags[last_flags] = enc_flags->createSymbolModel(64);
-    enc_flags->initSymbolModel(contexts[current_context].m_flags[last_flags]);
+    if (flags != last_flags)
+    {
+      changed_flags = TRUE;
+    }
+
+    if (contexts[current_context].m_flags[last_flags] == 0)
+    {
+      contexts[current_context].m_flags[last_flags] = enc_flags->createSymbolModel(64);
+      enc_flags->initSymbolModel(contexts[current_context].m_flags[last_flags]);
+    }
+    enc_flags->encodeSymbol(contexts[current_context].m_flags[last_flags], flags);
   }
-  enc_flags->encodeSymbol(contexts[current_context].m_flags[last_flags], flags);
 
   ////////////////////////////////////////
   // compress intensity layer 
   ////////////////////////////////////////
 
-  if (((const LASpoint14*)item)->intensity != ((LASpoint14*)last_item)->intensity)
+  if (compress_selective & LASZIP_DECOMPRESS_SELECTIVE_INTENSITY)
   {
-    changed_intensity = TRUE;
+    if (((const LASpoint14*)item)->intensity != ((LASpoint14*)last_item)->intensity)
+    {
+      changed_intensity = TRUE;
+    }
+    contexts[current_context].ic_intensity->compress(contexts[current_context].last_intensity[(cpr<<1) | gps_time_change], ((const LASpoint14*)item)->intensity, cpr);
+    contexts[current_context].last_intensity[(cpr<<1) | gps_time_change] = ((const LASpoint14*)item)->intensity;
   }
-  contexts[current_context].ic_intensity->compress(contexts[current_context].last_intensity[(cpr<<1) | gps_time_change], ((const LASpoint14*)item)->intensity, cpr);
-  contexts[current_context].last_intensity[(cpr<<1) | gps_time_change] = ((const LASpoint14*)item)->intensity;
   
   ////////////////////////////////////////
   // compress scan_angle layer 
   ////////////////////////////////////////
 
-  if (scan_angle_change)
+  if (scan_angle_change && (compress_selective & LASZIP_DECOMPRESS_SELECTIVE_SCAN_ANGLE))
   {
     changed_scan_angle = TRUE;
     contexts[current_context].ic_scan_angle->compress(((LASpoint14*)last_item)->scan_angle, ((const LASpoint14*)item)->scan_angle, gps_time_change); // if the GPS time has changed
@@ -712,22 +749,25 @@ inline BOOL LASwriteItemCompressed_POINT14_v4::write(const U8* item, U32& contex
   // compress user_data layer 
   ////////////////////////////////////////
 
-  if (((const LASpoint14*)item)->user_data != ((LASpoint14*)last_item)->user_data)
+  if (compress_selective & LASZIP_DECOMPRESS_SELECTIVE_USER_DATA)
   {
-    changed_user_data = TRUE;
-  }
-  if (contexts[current_context].m_user_data[((LASpoint14*)last_item)->user_data/4] == 0)
-  {
-    contexts[current_context].m_user_data[((LASpoint14*)last_item)->user_data/4] = enc_user_data->createSymbolModel(256);
-    enc_user_data->initSymbolModel(contexts[current_context].m_user_data[((LASpoint14*)last_item)->user_data/4]);
+    if (((const LASpoint14*)item)->user_data != ((LASpoint14*)last_item)->user_data)
+    {
+      changed_user_data = TRUE;
+    }
+    if (contexts[current_context].m_user_data[((LASpoint14*)last_item)->user_data/4] == 0)
+    {
+      contexts[current_context].m_user_data[((LASpoint14*)last_item)->user_data/4] = enc_user_data->createSymbolModel(256);
+      enc_user_data->initSymbolModel(contexts[current_context].m_user_data[((LASpoint14*)last_item)->user_data/4]);
+    }
+    enc_user_data->encodeSymbol(contexts[current_context].m_user_data[((LASpoint14*)last_item)->user_data/4], ((const LASpoint14*)item)->user_data);
   }
-  enc_user_data->encodeSymbol(contexts[current_context].m_user_data[((LASpoint14*)last_item)->user_data/4], ((const LASpoint14*)item)->user_data);
 
   ////////////////////////////////////////
   // compress point_source layer 
   ////////////////////////////////////////
 
-  if (point_source_change)
+  if (point_source_change && (compress_selective & LASZIP_DECOMPRESS_SELECTIVE_POINT_SOURCE))
   {
     changed_point_source = TRUE;
     contexts[current_context].ic_point_source_ID->compress(((LASpoint14*)last_item)->point_source_ID, ((const LASpoint14*)item)->point_source_ID);
@@ -737,7 +777,7 @@ inline BOOL LASwriteItemCompressed_POINT14_v4::write(const U8* item, U32& contex
   // compress gps_time layer 
   ////////////////////////////////////////
 
-  if (gps_time_change) // if the GPS time has changed
+  if (gps_time_change && (compress_selective & LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME)) // if the GPS time has changed
   {
     changed_gps_time = TRUE;
 
@@ -755,6 +795,12 @@ inline BOOL LASwriteItemCompressed_POINT14_v4::write(const U8* item, U32& contex
   return TRUE;
 }
 
+inline U32 LASwriteItemCompressed_POINT14_v4::pending_bytes() const
+{
+  if (outstream_channel_returns_XY == 0) return 0;
+  return (U32)(outstream_channel_returns_XY->getCurr() + outstream_Z->getCurr() + outstream_classification->getCurr() + outstream_flags->getCurr() + outstream_intensity->getCurr() + outstream_scan_angle->getCurr() + outstream_user_data->getCurr() + outstream_point_source->getCurr() + outstream_gps_time->getCurr());
+}
+
 inline BOOL LASwriteItemCompressed_POINT14_v4::chunk_sizes()
 {
   U32 num_bytes = 0;
@@ -1346,6 +1392,12 @@ inline BOOL LASwriteItemCompressed_RGB14_v4::write(const U8* item, U32& context)
   return TRUE;
 }
 
+inline U32 LASwriteItemCompressed_RGB14_v4::pending_bytes() const
+{
+  if (outstream_RGB == 0) return 0;
+  return (U32)outstream_RGB->getCurr();
+}
+
 inline BOOL LASwriteItemCompressed_RGB14_v4::chunk_sizes()
 {
   U32 num_bytes = 0;
@@ -1661,6 +1713,12 @@ inline BOOL LASwriteItemCompressed_RGBNIR14_v4::write(const U8* item, U32& conte
   return TRUE;
 }
 
+inline U32 LASwriteItemCompressed_RGBNIR14_v4::pending_bytes() const
+{
+  if (outstream_RGB == 0) return 0;
+  return (U32)(outstream_RGB->getCurr() + outstream_NIR->getCurr());
+}
+
 inline BOOL LASwriteItemCompressed_RGBNIR14_v4::chunk_sizes()
 {
   U32 num_bytes = 0;
@@ -1966,6 +2024,12 @@ inline BOOL LASwriteItemCompressed_WAVEPACKET14_v4::write(const U8* item, U32& c
   return TRUE;
 }
 
+inline U32 LASwriteItemCompressed_WAVEPACKET14_v4::pending_bytes() const
+{
+  if (outstream_wavepacket == 0) return 0;
+  return (U32)outstream_wavepacket->getCurr();
+}
+
 inline BOOL LASwriteItemCompressed_WAVEPACKET14_v4::chunk_sizes()
 {
   U32 num_bytes = 0;
@@ -2254,6 +2318,17 @@ inline BOOL LASwriteItemCompressed_BYTE14_v4::write(const U8* item, U32& context
   return TRUE;
 }
 
+inline U32 LASwriteItemCompressed_BYTE14_v4::pending_bytes() const
+{
+  if (outstream_Bytes == 0) return 0;
+  I64 num_bytes = 0;
+  for (U32 i = 0; i < number; i++)
+  {
+    num_bytes += outstream_Bytes[i]->getCurr();
+  }
+  return (U32)num_bytes;
+}
+
 inline BOOL LASwriteItemCompressed_BYTE14_v4::chunk_sizes()
 {
   U32 i;
@@ -38,6 +38,7 @@
 #include "arithmeticencoder.hpp"
 #include "integercompressor.hpp"
 #include "bytestreamout_array.hpp"
+#include "laszip_decompress_selective_v3.hpp"
 
 #include "laszip_common_v3.hpp"
 
@@ -51,6 +52,8 @@ public:
   BOOL write(const U8* item, U32& context);
   BOOL chunk_sizes();
   BOOL chunk_bytes();
+  U32 pending_bytes() const;
+  void set_compress_selective(U32 compress_selective);
 
   ~LASwriteItemCompressed_POINT14_v4();
 
@@ -101,6 +104,11 @@ private:
   U32 current_context;
   LAScontextPOINT14 contexts[4];
 
+  /* the layers that are actually encoded */
+
+  U32 compress_selective;
+  BOOL compress_XY;
+
   BOOL createAndInitModelsAndCompressors(U32 context, const U8* item);
   void write_gps_time(const U64I64F64 gps_time);
 };
@@ -115,6 +123,7 @@ public:
   BOOL write(const U8* item, U32& context);
   BOOL chunk_sizes();
   BOOL chunk_bytes();
+  U32 pending_bytes() const;
 
   ~LASwriteItemCompressed_RGB14_v4();
 
@@ -148,6 +157,7 @@ public:
   BOOL write(const U8* item, U32& context);
   BOOL chunk_sizes();
   BOOL chunk_bytes();
+  U32 pending_bytes() const;
 
   ~LASwriteItemCompressed_RGBNIR14_v4();
 
@@ -185,6 +195,7 @@ public:
   BOOL write(const U8* item, U32& context);
   BOOL chunk_sizes();
   BOOL chunk_bytes();
+  U32 pending_bytes() const;
 
   ~LASwriteItemCompressed_WAVEPACKET14_v4();
 
@@ -218,6 +229,7 @@ public:
   BOOL write(const U8* item, U32& context);
   BOOL chunk_sizes();
   BOOL chunk_bytes();
+  U32 pending_bytes() const;
 
   ~LASwriteItemCompressed_BYTE14_v4();
 
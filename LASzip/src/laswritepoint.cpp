@@ -37,6 +37,8 @@
 #include "laswriteitemcompressed_v2.hpp"
 #include "laswriteitemcompressed_v3.hpp"
 #include "laswriteitemcompressed_v4.hpp"
+#include "laszip_decompress_selective_v3.hpp"
+#include "bytestreamout_array.hpp"
 
 #include <string.h>
 #include <stdlib.h>
@@ -60,6 +62,18 @@ LASwritePoint::LASwritePoint()
   chunk_bytes = 0;
   chunk_table_start_position = 0;
   chunk_start_position = 0;
+  // used for copying chunks and layers
+  compressor = LASZIP_COMPRESSOR_NONE;
+  items = 0;
+  point_size = 0;
+  num_layers = 0;
+  layer_selective = 0;
+  item_selective = 0;
+  compress_selective = LASZIP_DECOMPRESS_SELECTIVE_ALL;
+  copy_bytes = 0;
+  copy_num_bytes = 0;
+  alloced_copy_bytes = 0;
+  layer_stream = 0;
 }
 
 BOOL LASwritePoint::setup(const U32 num_items, const LASitem* items, const LASzip* laszip)
@@ -251,6 +265,82 @@ BOOL LASwritePoint::setup(const U32 num_items, const LASitem* items, const LASzi
       number_chunks = U32_MAX;
     }
   }
+
+  // the layers of a LAS 1.4 chunk in the order they are written together
+  // with the selective decompression flag of each of them
+  if (enc) compressor = laszip->compressor;
+  this->items = new LASitem[num_writers];
+  point_size = 0;
+  for (i = 0; i < num_writers; i++)
+  {
+    this->items[i] = items[i];
+    point_size += items[i].size;
+  }
+  if (layered_las14_compression)
+  {
+    U32 j;
+    num_layers = 0;
+    for (i = 0; i < num_writers; i++)
+    {
+      switch (items[i].type)
+      {
+      case LASitem::POINT14:
+        num_layers += 9;
+        break;
+      case LASitem::RGBNIR14:
+        num_layers += 2;
+        break;
+      case LASitem::BYTE14:
+        num_layers += items[i].size;
+        break;
+      default:
+        num_layers += 1;
+      }
+    }
+    layer_selective = new U32[num_layers];
+    item_selective = new U32[num_writers];
+    num_layers = 0;
+    for (i = 0; i < num_writers; i++)
+    {
+      switch (items[i].type)
+      {
+      case LASitem::POINT14:
+        layer_selective[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_CHANNEL_RETURNS_XY;
+        layer_selective[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_Z;
+        layer_selective[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION;
+        layer_selective[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_FLAGS;
+        layer_selective[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_INTENSITY;
+        layer_selective[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_SCAN_ANGLE;
+        layer_selective[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_USER_DATA;
+        layer_selective[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_POINT_SOURCE;
+        layer_selective[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME;
+        item_selective[i] = LASZIP_DECOMPRESS_SELECTIVE_ALL;
+        break;
+      case LASitem::RGB14:
+        layer_selective[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_RGB;
+        item_selective[i] = LASZIP_DECOMPRESS_SELECTIVE_RGB;
+        break;
+      case LASitem::RGBNIR14:
+        layer_selective[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_RGB;
+        layer_selective[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_NIR;
+        item_selective[i] = LASZIP_DECOMPRESS_SELECTIVE_RGB | LASZIP_DECOMPRESS_SELECTIVE_NIR;
+        break;
+      case LASitem::BYTE14:
+        item_selective[i] = 0;
+        for (j = 0; j < items[i].size; j++)
+        {
+          // only the first 16 extra bytes have their own flag
+          layer_selective[num_layers] = (j < 16 ? (LASZIP_DECOMPRESS_SELECTIVE_BYTE0 << j) : LASZIP_DECOMPRESS_SELECTIVE_EXTRA_BYTES);
+          item_selective[i] |= layer_selective[num_layers++];
+        }
+        break;
+      default:
+        layer_selective[num_layers++] = LASZIP_DECOMPRESS_SELECTIVE_WAVEPACKET;
+        item_selective[i] = LASZIP_DECOMPRESS_SELECTIVE_WAVEPACKET;
+      }
+    }
+    layer_stream = new ByteStreamOutArrayLE();
+  }
   return TRUE;
 }
 
@@ -302,26 +392,10 @@ BOOL LASwritePoint::write(const U8 * const * point)
   {
     if (enc)
     {
-      if (layered_las14_compression)
+      if (!finish_chunk())
       {
-        // write how many points are in the chunk
-        outstream->put32bitsLE((U8*)&chunk_count);
-        // write all layers 
-        for (i = 0; i < num_writers; i++)
-        {
-          ((LASwriteItemCompressed*)writers[i])->chunk_sizes();
-        }
-        for (i = 0; i < num_writers; i++)
-        {
-          ((LASwriteItemCompressed*)writers[i])->chunk_bytes();
-        }
-      }
-      else
-      {
-        enc->done();
+        return FALSE;
       }
-      add_chunk_to_table();
-      init(outstream);
     }
     else
     {
@@ -336,6 +410,11 @@ BOOL LASwritePoint::write(const U8 * const * point)
   {
     for (i = 0; i < num_writers; i++)
     {
+      // the first item (with the point) decides the context of the others
+      if (i && item_selective && ((compress_selective & item_selective[i]) == 0))
+      {
+        continue; // all layers of this item are copied
+      }
       if (!writers[i]->write(point[i], context))
       {
         return FALSE;
@@ -364,9 +443,37 @@ BOOL LASwritePoint::chunk()
   {
     return FALSE;
   }
+  return finish_chunk();
+}
+
+BOOL LASwritePoint::finish_chunk()
+{
   if (layered_las14_compression)
   {
-    U32 i;
+    if (!write_layers())
+    {
+      return FALSE;
+    }
+  }
+  else
+  {
+    enc->done();
+  }
+  add_chunk_to_table();
+  init(outstream);
+  chunk_count = 0;
+  return TRUE;
+}
+
+// when layers are copied only the selected ones are taken from the items and
+// all others from the same chunk of the other file
+
+BOOL LASwritePoint::write_layers()
+{
+  U32 i;
+
+  if (copy_num_bytes == 0)
+  {
     // write how many points are in the chunk
     outstream->put32bitsLE((U8*)&chunk_count);
     // write all layers 
@@ -378,34 +485,198 @@ BOOL LASwritePoint::chunk()
     {
       ((LASwriteItemCompressed*)writers[i])->chunk_bytes();
     }
+    return TRUE;
   }
-  else
+
+  // the copied chunk starts with its first point and its number of points
+  // followed by the sizes of all layers and then the layers themselves
+
+  U32 num_bytes;
+  U32 header_bytes = point_size + 4 + 4 * num_layers;
+  if (copy_num_bytes < header_bytes)
   {
-    enc->done();
+    return FALSE;
+  }
+  memcpy(&num_bytes, copy_bytes + point_size, 4);
+  if (num_bytes != chunk_count)
+  {
+    return FALSE;
+  }
+  const U8* copied_sizes = copy_bytes + point_size + 4;
+  U32 copied_layer_bytes = 0;
+  for (i = 0; i < num_layers; i++)
+  {
+    memcpy(&num_bytes, copied_sizes + 4 * i, 4);
+    copied_layer_bytes += num_bytes;
+  }
+  if (copied_layer_bytes > (copy_num_bytes - header_bytes))
+  {
+    return FALSE;
+  }
+
+  // let the items write their sizes and layers into a buffer
+
+  layer_stream->seek(0);
+  enc->init(layer_stream);
+  for (i = 0; i < num_writers; i++)
+  {
+    ((LASwriteItemCompressed*)writers[i])->chunk_sizes();
+  }
+  for (i = 0; i < num_writers; i++)
+  {
+    ((LASwriteItemCompressed*)writers[i])->chunk_bytes();
+  }
+  const U8* encoded_sizes = layer_stream->getData();
+
+  // and take each layer either from there or from the copied chunk
+
+  outstream->put32bitsLE((U8*)&chunk_count);
+  for (i = 0; i < num_layers; i++)
+  {
+    memcpy(&num_bytes, ((compress_selective & layer_selective[i]) ? encoded_sizes : copied_sizes) + 4 * i, 4);
+    outstream->put32bitsLE((U8*)&num_bytes);
+  }
+  const U8* encoded_layer = encoded_sizes + 4 * num_layers;
+  const U8* copied_layer = copied_sizes + 4 * num_layers;
+  U32 encoded_bytes;
+  U32 copied_bytes;
+  for (i = 0; i < num_layers; i++)
+  {
+    memcpy(&encoded_bytes, encoded_sizes + 4 * i, 4);
+    memcpy(&copied_bytes, copied_sizes + 4 * i, 4);
+    if (compress_selective & layer_selective[i])
+    {
+      if (encoded_bytes) outstream->putBytes(encoded_layer, encoded_bytes);
+    }
+    else
+    {
+      if (copied_bytes) outstream->putBytes(copied_layer, copied_bytes);
+    }
+    encoded_layer += encoded_bytes;
+    copied_layer += copied_bytes;
+  }
+
+  // the next chunk is encoded entirely unless told otherwise
+
+  copy_num_bytes = 0;
+  compress_selective = LASZIP_DECOMPRESS_SELECTIVE_ALL;
+  for (i = 0; i < num_writers; i++)
+  {
+    ((LASwriteItemCompressed*)writers_compressed[i])->set_compress_selective(compress_selective);
+  }
+  return TRUE;
+}
+
+BOOL LASwritePoint::is_compatible(const LASzip* laszip) const
+{
+  if ((enc == 0) || (chunk_start_position == 0) || (laszip == 0)) return FALSE;
+  if ((laszip->compressor != compressor) || (laszip->coder != LASZIP_CODER_ARITHMETIC)) return FALSE;
+  // variable chunks can take chunks of any size
+  if ((chunk_size != U32_MAX) && (laszip->chunk_size != chunk_size)) return FALSE;
+  if (laszip->num_items != num_writers) return FALSE;
+  U32 i;
+  for (i = 0; i < num_writers; i++)
+  {
+    if ((laszip->items[i].type != items[i].type) || (laszip->items[i].size != items[i].size) || (laszip->items[i].version != items[i].version)) return FALSE;
+  }
+  return TRUE;
+}
+
+BOOL LASwritePoint::write_chunk(const U8* bytes, U32 num_bytes, U32 num_points)
+{
+  if (chunk_start_position == 0 || num_points == 0)
+  {
+    return FALSE;
+  }
+  // finish the chunk that is still open
+  if ((writers == writers_compressed) && chunk_count)
+  {
+    if (!finish_chunk())
+    {
+      return FALSE;
+    }
+  }
+  if (!outstream->putBytes(bytes, num_bytes))
+  {
+    return FALSE;
+  }
+  chunk_count = num_points;
+  if (!add_chunk_to_table())
+  {
+    return FALSE;
   }
-  add_chunk_to_table();
   init(outstream);
   chunk_count = 0;
   return TRUE;
 }
 
+BOOL LASwritePoint::copy_layers(const U8* bytes, U32 num_bytes, U32 compress_selective)
+{
+  if (!layered_las14_compression || chunk_start_position == 0)
+  {
+    return FALSE;
+  }
+  // finish the chunk that is still open with the layers given for it
+  if ((writers == writers_compressed) && chunk_count)
+  {
+    if (!finish_chunk())
+    {
+      return FALSE;
+    }
+  }
+  if (num_bytes > alloced_copy_bytes)
+  {
+    if (copy_bytes) free(copy_bytes);
+    alloced_copy_bytes = num_bytes;
+    copy_bytes = (U8*)malloc(alloced_copy_bytes);
+    if (copy_bytes == 0)
+    {
+      alloced_copy_bytes = 0;
+      return FALSE;
+    }
+  }
+  memcpy(copy_bytes, bytes, num_bytes);
+  copy_num_bytes = num_bytes;
+  this->compress_selective = compress_selective;
+  U32 i;
+  for (i = 0; i < num_writers; i++)
+  {
+    ((LASwriteItemCompressed*)writers_compressed[i])->set_compress_selective(compress_selective);
+  }
+  return TRUE;
+}
+
+// the layers of LAS 1.4 points are only written when the chunk is complete
+// so their size is taken from the items. otherwise it is what the encoder has
+// passed on to the stream (minus the few bytes it still buffers)
+
+I64 LASwritePoint::get_chunk_bytes() const
+{
+  if ((chunk_start_position == 0) || (chunk_count == 0))
+  {
+    return 0;
+  }
+  if (layered_las14_compression)
+  {
+    I64 num_bytes = 0;
+    for (U32 i = 0; i < num_writers; i++)
+    {
+      num_bytes += ((LASwriteItemCompressed*)writers_compressed[i])->pending_bytes();
+    }
+    return num_bytes;
+  }
+  return outstream->tell() - chunk_start_position;
+}
+
 BOOL LASwritePoint::done()
 {
   if (writers == writers_compressed)
   {
     if (layered_las14_compression)
     {
-      U32 i;
-      // write how many points are in the chunk
-      outstream->put32bitsLE((U8*)&chunk_count);
-      // write all layers 
-      for (i = 0; i < num_writers; i++)
-      {
-        ((LASwriteItemCompressed*)writers[i])->chunk_sizes();
-      }
-      for (i = 0; i < num_writers; i++)
+      if (!write_layers())
       {
-        ((LASwriteItemCompressed*)writers[i])->chunk_bytes();
+        return FALSE;
       }
     }
     else
@@ -532,4 +803,10 @@ LASwritePoint::~LASwritePoint()
   }
 
   if (chunk_bytes) free(chunk_bytes);
+
+  if (items) delete [] items;
+  if (layer_selective) delete [] layer_selective;
+  if (item_selective) delete [] item_selective;
+  if (copy_bytes) free(copy_bytes);
+  if (layer_stream) delete layer_stream;
 }
@@ -24,6 +24,8 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- copy compressed chunks or layers of a LAS 1.4 chunk as-is
+    18 October 2026 -- report the size of the current chunk for adaptive chunking
     21 February 2019 -- fix for writing 4294967295+ points uncompressed to LAS
     28 August 2017 -- moving 'context' from global development hack to interface  
     23 August 2016 -- layering of items for selective decompression in LAS 1.4 
@@ -48,6 +50,7 @@
 
 class LASwriteItem;
 class ArithmeticEncoder;
+class ByteStreamOutArray;
 
 class LASwritePoint
 {
@@ -63,6 +66,22 @@ public:
   BOOL chunk();
   BOOL done();
 
+  // points and (roughly) compressed bytes of the current chunk
+  U32 get_chunk_count() const { return chunk_count; };
+  I64 get_chunk_bytes() const;
+
+  // whether chunks compressed with 'laszip' can be copied into this stream
+  BOOL is_compatible(const LASzip* laszip) const;
+
+  // appends an entire compressed chunk with 'num_points' points (e.g. from
+  // another file with identical point format and LASzip items) as it is
+  BOOL write_chunk(const U8* bytes, U32 num_bytes, U32 num_points);
+
+  // the layers of the next chunk of LAS 1.4 points that are not selected in
+  // 'compress_selective' are copied from 'bytes' (the same chunk in another
+  // file) instead of being encoded. all its points must still be written
+  BOOL copy_layers(const U8* bytes, U32 num_bytes, U32 compress_selective);
+
 private:
   ByteStreamOut* outstream;
   U32 num_writers;
@@ -82,6 +101,20 @@ private:
   I64 chunk_table_start_position;
   BOOL add_chunk_to_table();
   BOOL write_chunk_table();
+  // used for copying chunks and layers
+  U32 compressor;
+  LASitem* items;
+  U32 point_size;
+  U32 num_layers;
+  U32* layer_selective;
+  U32* item_selective;
+  U32 compress_selective;
+  U8* copy_bytes;
+  U32 copy_num_bytes;
+  U32 alloced_copy_bytes;
+  ByteStreamOutArray* layer_stream;
+  BOOL write_layers();
+  BOOL finish_chunk();
 };
 
 #endif
@@ -24,6 +24,8 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- reading from memory or a read callback and writing to a write callback
+    18 October 2026 -- bulk point reading and writing into arrays or columns
     24 March 2021 -- fix small memory leak
     15 October 2019 -- support reading from and writing to unicode file names under Windows
     20 March 2019 -- check consistent legacy and extended classification in laszip_write_point()
@@ -66,6 +68,8 @@
 #include "bytestreamin_array.hpp"
 #include "bytestreamin_istream.hpp"
 #include "bytestreamout_ostream.hpp"
+#include "bytestreamin_callback.hpp"
+#include "bytestreamout_callback.hpp"
 #include "laswritepoint.hpp"
 #include "lasreadpoint.hpp"
 #include "lasquadtree.hpp"
@@ -173,6 +177,9 @@ typedef struct laszip_dll
   laszip_dll_inventory* inventory;
   std::vector<void *> buffers;
   laszip_message_callback_data_struct* message_callback_data;
+  laszip_read_callback read_callback;
+  laszip_write_callback write_callback;
+  void* callback_user_data;
 
   // Constructor to initialise the structure
   laszip_dll()
@@ -217,6 +224,9 @@ typedef struct laszip_dll
     start_NIR_band = 0;
     inventory = NULL;
     message_callback_data = NULL;
+    read_callback = NULL;
+    write_callback = NULL;
+    callback_user_data = NULL;
   };
 } laszip_dll_struct;
 
@@ -3308,6 +3318,136 @@ laszip_write_point(
   return 0;
 }
 
+/*---------------------------------------------------------------------------*/
+static void
+laszip_set_point_from_columns(
+    laszip_dll_struct*                 laszip_dll
+    , const laszip_columns_struct*     columns
+    , const U32                        i
+)
+{
+  laszip_header_struct* header = &(laszip_dll->header);
+  laszip_point_struct* point = &(laszip_dll->point);
+  BOOL extended = point->extended_point_type;
+
+  if (columns->xyz)
+  {
+    point->X = I32_QUANTIZE((columns->xyz[3*i+0]-header->x_offset)/header->x_scale_factor);
+    point->Y = I32_QUANTIZE((columns->xyz[3*i+1]-header->y_offset)/header->y_scale_factor);
+    point->Z = I32_QUANTIZE((columns->xyz[3*i+2]-header->z_offset)/header->z_scale_factor);
+  }
+  else if (columns->XYZ)
+  {
+    point->X = columns->XYZ[3*i+0];
+    point->Y = columns->XYZ[3*i+1];
+    point->Z = columns->XYZ[3*i+2];
+  }
+  if (columns->intensity) point->intensity = columns->intensity[i];
+  if (columns->return_number)
+  {
+    if (extended) point->extended_return_number = columns->return_number[i];
+    point->return_number = (columns->return_number[i] < 7 ? columns->return_number[i] : 7);
+  }
+  if (columns->number_of_returns)
+  {
+    if (extended) point->extended_number_of_returns = columns->number_of_returns[i];
+    point->number_of_returns = (columns->number_of_returns[i] < 7 ? columns->number_of_returns[i] : 7);
+  }
+  if (columns->classification)
+  {
+    if (extended) point->extended_classification = columns->classification[i];
+    point->classification = (columns->classification[i] < 32 ? columns->classification[i] : 0);
+  }
+  if (columns->classification_flags)
+  {
+    // legacy and extended flags must be identical
+    if (extended) point->extended_classification_flags = columns->classification_flags[i];
+    point->synthetic_flag = (columns->classification_flags[i] & 1);
+    point->keypoint_flag = ((columns->classification_flags[i] >> 1) & 1);
+    point->withheld_flag = ((columns->classification_flags[i] >> 2) & 1);
+  }
+  if (columns->scanner_channel && extended) point->extended_scanner_channel = columns->scanner_channel[i];
+  if (columns->scan_direction_flag) point->scan_direction_flag = columns->scan_direction_flag[i];
+  if (columns->edge_of_flight_line) point->edge_of_flight_line = columns->edge_of_flight_line[i];
+  if (columns->scan_angle)
+  {
+    if (extended)
+    {
+      point->extended_scan_angle = columns->scan_angle[i];
+      point->scan_angle_rank = I8_CLAMP(I16_QUANTIZE(0.006f*columns->scan_angle[i]));
+    }
+    else
+    {
+      point->scan_angle_rank = I8_CLAMP(columns->scan_angle[i]);
+    }
+  }
+  if (columns->user_data) point->user_data = columns->user_data[i];
+  if (columns->point_source_ID) point->point_source_ID = columns->point_source_ID[i];
+  if (columns->gps_time) point->gps_time = columns->gps_time[i];
+  if (columns->rgb) memcpy(point->rgb, columns->rgb + 4*i, 4*sizeof(U16));
+  if (columns->extra_bytes && point->num_extra_bytes) memcpy(point->extra_bytes, columns->extra_bytes + (size_t)i*point->num_extra_bytes, point->num_extra_bytes);
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_write_points(
+    laszip_POINTER                     pointer
+    , const laszip_point_struct*       points
+    , const laszip_U32                 count
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  if ((points == 0) && count)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_point_struct pointer 'points' is zero");
+    return 1;
+  }
+
+  for (U32 i = 0; i < count; i++)
+  {
+    if (laszip_set_point(pointer, &(points[i]))) return 1;
+    if (laszip_write_point(pointer)) return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_write_points_columns(
+    laszip_POINTER                     pointer
+    , const laszip_columns_struct*     columns
+    , const laszip_U32                 count
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  if (columns == 0)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_columns_struct pointer 'columns' is zero");
+    return 1;
+  }
+
+  if (laszip_dll->writer == 0)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "writing points before writer was opened");
+    return 1;
+  }
+
+  for (U32 i = 0; i < count; i++)
+  {
+    laszip_set_point_from_columns(laszip_dll, columns, i);
+    if (laszip_write_point(pointer)) return 1;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
 /*---------------------------------------------------------------------------*/
 LASZIP_API laszip_I32
 laszip_write_indexed_point(
@@ -3500,6 +3640,9 @@ laszip_close_writer(
       laszip_dll->lax_index = 0;
     }
 
+    // a buffering stream (e.g. to a write callback) still holds the last bytes
+    BOOL flushed = laszip_dll->streamout->flush();
+
     delete laszip_dll->streamout;
     laszip_dll->streamout = 0;
 
@@ -3508,6 +3651,12 @@ laszip_close_writer(
       fclose(laszip_dll->file);
       laszip_dll->file = 0;
     }
+
+    if (!flushed)
+    {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "flushing the last bytes of the output failed");
+      return 1;
+    }
   }
   catch (...)
   {
@@ -4833,6 +4982,143 @@ laszip_read_inside_point(
   return 0;
 }
 
+/*---------------------------------------------------------------------------*/
+static void
+laszip_get_columns_from_point(
+    const laszip_dll_struct*           laszip_dll
+    , laszip_columns_struct*           columns
+    , const U32                        i
+)
+{
+  const laszip_header_struct* header = &(laszip_dll->header);
+  const laszip_point_struct* point = &(laszip_dll->point);
+  BOOL extended = point->extended_point_type;
+
+  if (columns->xyz)
+  {
+    columns->xyz[3*i+0] = header->x_scale_factor*point->X+header->x_offset;
+    columns->xyz[3*i+1] = header->y_scale_factor*point->Y+header->y_offset;
+    columns->xyz[3*i+2] = header->z_scale_factor*point->Z+header->z_offset;
+  }
+  if (columns->XYZ)
+  {
+    columns->XYZ[3*i+0] = point->X;
+    columns->XYZ[3*i+1] = point->Y;
+    columns->XYZ[3*i+2] = point->Z;
+  }
+  if (columns->intensity) columns->intensity[i] = point->intensity;
+  if (columns->return_number) columns->return_number[i] = (extended ? point->extended_return_number : point->return_number);
+  if (columns->number_of_returns) columns->number_of_returns[i] = (extended ? point->extended_number_of_returns : point->number_of_returns);
+  if (columns->classification) columns->classification[i] = (extended ? point->extended_classification : point->classification);
+  if (columns->classification_flags) columns->classification_flags[i] = (extended ? point->extended_classification_flags : ((point->withheld_flag << 2) | (point->keypoint_flag << 1) | point->synthetic_flag));
+  if (columns->scanner_channel) columns->scanner_channel[i] = (extended ? point->extended_scanner_channel : 0);
+  if (columns->scan_direction_flag) columns->scan_direction_flag[i] = point->scan_direction_flag;
+  if (columns->edge_of_flight_line) columns->edge_of_flight_line[i] = point->edge_of_flight_line;
+  if (columns->scan_angle) columns->scan_angle[i] = (extended ? point->extended_scan_angle : point->scan_angle_rank);
+  if (columns->user_data) columns->user_data[i] = point->user_data;
+  if (columns->point_source_ID) columns->point_source_ID[i] = point->point_source_ID;
+  if (columns->gps_time) columns->gps_time[i] = point->gps_time;
+  if (columns->rgb) memcpy(columns->rgb + 4*i, point->rgb, 4*sizeof(U16));
+  if (columns->extra_bytes && point->num_extra_bytes) memcpy(columns->extra_bytes + (size_t)i*point->num_extra_bytes, point->extra_bytes, point->num_extra_bytes);
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_read_points(
+    laszip_POINTER                     pointer
+    , laszip_point_struct*             points
+    , laszip_U8*                       extra_bytes
+    , const laszip_U32                 max_count
+    , laszip_U32*                      count
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  if (count == 0)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_U32 pointer 'count' is zero");
+    return 1;
+  }
+
+  *count = 0;
+
+  if ((points == 0) && max_count)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_point_struct pointer 'points' is zero");
+    return 1;
+  }
+
+  if (laszip_dll->reader == 0)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading points before reader was opened");
+    return 1;
+  }
+
+  const laszip_point_struct* point = &(laszip_dll->point);
+
+  // stops early at the end of the file
+
+  while ((*count < max_count) && (laszip_dll->p_count < laszip_dll->npoints))
+  {
+    if (laszip_read_point(pointer)) return 1;
+    laszip_point_struct* target = &(points[*count]);
+    memcpy(target, point, ((const U8*)&(point->extra_bytes)) - ((const U8*)&(point->X)));
+    if (extra_bytes && point->num_extra_bytes)
+    {
+      target->extra_bytes = extra_bytes + (size_t)(*count)*point->num_extra_bytes;
+      memcpy(target->extra_bytes, point->extra_bytes, point->num_extra_bytes);
+    }
+    else
+    {
+      target->extra_bytes = 0;
+    }
+    (*count)++;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_read_points_columns(
+    laszip_POINTER                     pointer
+    , laszip_columns_struct*           columns
+    , const laszip_U32                 max_count
+    , laszip_U32*                      count
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  if ((columns == 0) || (count == 0))
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "pointer 'columns' or 'count' is zero");
+    return 1;
+  }
+
+  *count = 0;
+
+  if (laszip_dll->reader == 0)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reading points before reader was opened");
+    return 1;
+  }
+
+  // stops early at the end of the file
+
+  while ((*count < max_count) && (laszip_dll->p_count < laszip_dll->npoints))
+  {
+    if (laszip_read_point(pointer)) return 1;
+    laszip_get_columns_from_point(laszip_dll, columns, *count);
+    (*count)++;
+  }
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
 /*---------------------------------------------------------------------------*/
 LASZIP_API laszip_I32
 laszip_close_reader(
@@ -4886,72 +5172,183 @@ laszip_close_reader(
   return 0;
 }
 
-#ifdef __cplusplus
-
 /*---------------------------------------------------------------------------*/
-LASZIP_API laszip_I32
-laszip_open_reader_stream(
-    laszip_POINTER                     pointer
-    , std::istream&                    stream
+// shared by all readers that do not open a file themselves. takes ownership of 'streamin'
+static laszip_I32
+laszip_open_reader_streamin(
+    laszip_dll_struct*                 laszip_dll
+    , ByteStreamIn*                    streamin
     , laszip_BOOL*                     is_compressed
 )
 {
-  if (pointer == 0) return 1;
-  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+  if (is_compressed == 0)
+  {
+    delete streamin;
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_BOOL pointer 'is_compressed' is zero");
+    return 1;
+  }
 
-  try
+  if (laszip_dll->writer)
   {
-    if (is_compressed == 0)
+    delete streamin;
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "writer is already open");
+    return 1;
+  }
+
+  if (laszip_dll->reader)
+  {
+    delete streamin;
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is already open");
+    return 1;
+  }
+
+  laszip_dll->streamin = streamin;
+
+  return laszip_read_header(laszip_dll, is_compressed);
+}
+
+/*---------------------------------------------------------------------------*/
+// shared by all writers that do not open a file themselves. takes ownership of 'streamout'
+static laszip_I32
+laszip_open_writer_streamout(
+    laszip_dll_struct*                 laszip_dll
+    , ByteStreamOut*                   streamout
+    , laszip_BOOL                      compress
+    , laszip_BOOL                      do_not_write_header
+)
+{
+  if (laszip_dll->writer)
+  {
+    delete streamout;
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "writer is already open");
+    return 1;
+  }
+
+  if (laszip_dll->reader)
+  {
+    delete streamout;
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is already open");
+    return 1;
+  }
+
+  laszip_dll->streamout = streamout;
+
+  // setup the items that make up the point
+
+  LASzip laszip;
+  if (setup_laszip_items(laszip_dll, &laszip, compress))
+  {
+    return 1;
+  }
+
+  // this supports software that writes the LAS header on its own
+
+  if (do_not_write_header == FALSE)
+  {
+    // prepare header
+
+    if (laszip_prepare_header_for_write(laszip_dll))
     {
-      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_BOOL pointer 'is_compressed' is zero");
       return 1;
     }
 
-    if (laszip_dll->writer)
+    // prepare point
+
+    if (laszip_prepare_point_for_write(laszip_dll, compress))
     {
-      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "writer is already open");
       return 1;
     }
 
-    if (laszip_dll->reader)
+    // prepare VLRs
+
+    if (laszip_prepare_vlrs_for_write(laszip_dll))
     {
-      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is already open");
       return 1;
     }
 
-    // open the file
+    // write header variable after variable
 
-    if (IS_LITTLE_ENDIAN())
-      laszip_dll->streamin = new ByteStreamInIstreamLE(stream);
-    else
-      laszip_dll->streamin = new ByteStreamInIstreamBE(stream);
+    if (laszip_write_header(laszip_dll, &laszip, compress))
+    {
+      return 1;
+    }
+  }
 
-    if (laszip_dll->streamin == 0)
+  // create the point writer
+
+  if (create_point_writer(laszip_dll, &laszip))
+  {
+    return 1;
+  }
+
+  // set the point number and point count
+
+  laszip_dll->npoints = (laszip_dll->header.number_of_point_records ? laszip_dll->header.number_of_point_records : laszip_dll->header.extended_number_of_point_records);
+  laszip_dll->p_count = 0;
+
+  laszip_dll->error[0] = '\0';
+  return 0;
+}
+
+/*---------------------------------------------------------------------------*/
+static I64
+laszip_read_callback_trampoline(void* user_data, U8* buffer, I64 offset, I64 num_bytes)
+{
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)user_data;
+  return (I64)(*laszip_dll->read_callback)(laszip_dll->callback_user_data, (laszip_U8*)buffer, (laszip_I64)offset, (laszip_I64)num_bytes);
+}
+
+/*---------------------------------------------------------------------------*/
+static BOOL
+laszip_write_callback_trampoline(void* user_data, const U8* buffer, I64 offset, I64 num_bytes)
+{
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)user_data;
+  return (*laszip_dll->write_callback)(laszip_dll->callback_user_data, (const laszip_U8*)buffer, (laszip_I64)offset, (laszip_I64)num_bytes);
+}
+
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_open_reader_array(
+    laszip_POINTER                     pointer
+    , const laszip_U8*                 data
+    , laszip_I64                       size
+    , laszip_BOOL*                     is_compressed
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
+
+  try
+  {
+    if (data == 0)
     {
-      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "could not alloc ByteStreamInIstream");
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_U8 pointer 'data' is zero");
       return 1;
     }
 
-    return laszip_read_header(laszip_dll, is_compressed);
+    ByteStreamIn* streamin;
+    if (IS_LITTLE_ENDIAN())
+      streamin = new ByteStreamInArrayLE((const U8*)data, (I64)size);
+    else
+      streamin = new ByteStreamInArrayBE((const U8*)data, (I64)size);
+
+    return laszip_open_reader_streamin(laszip_dll, streamin, is_compressed);
   }
   catch (...)
   {
-    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_open_reader");
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_open_reader_array");
     return 1;
   }
 }
 
 /*---------------------------------------------------------------------------*/
-// The stream writer also supports software that writes the LAS header on its
-// own simply by setting the BOOL 'do_not_write_header' to TRUE. This function
-// should then be called just prior to writing points as data is then written
-// to the current stream position
 LASZIP_API laszip_I32
-laszip_open_writer_stream(
+laszip_open_reader_callback(
     laszip_POINTER                     pointer
-    , std::ostream&                    stream
-    , laszip_BOOL                      compress
-    , laszip_BOOL                      do_not_write_header
+    , laszip_read_callback             callback
+    , void*                            user_data
+    , laszip_I64                       size
+    , laszip_BOOL*                     is_compressed
 )
 {
   if (pointer == 0) return 1;
@@ -4959,91 +5356,138 @@ laszip_open_writer_stream(
 
   try
   {
-    if (laszip_dll->writer)
+    if (callback == 0)
     {
-      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "writer is already open");
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_read_callback 'callback' is zero");
       return 1;
     }
 
-    if (laszip_dll->reader)
+    if (laszip_dll->reader == 0)
     {
-      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "reader is already open");
-      return 1;
+      laszip_dll->read_callback = callback;
+      laszip_dll->callback_user_data = user_data;
     }
 
-    // create the outstream
-
+    ByteStreamIn* streamin;
     if (IS_LITTLE_ENDIAN())
-      laszip_dll->streamout = new ByteStreamOutOstreamLE(stream);
+      streamin = new ByteStreamInCallbackLE(laszip_read_callback_trampoline, laszip_dll, (I64)size);
     else
-      laszip_dll->streamout = new ByteStreamOutOstreamBE(stream);
+      streamin = new ByteStreamInCallbackBE(laszip_read_callback_trampoline, laszip_dll, (I64)size);
 
-    if (laszip_dll->streamout == 0)
-    {
-      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "could not alloc ByteStreamOutOstream");
-      return 1;
-    }
+    return laszip_open_reader_streamin(laszip_dll, streamin, is_compressed);
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_open_reader_callback");
+    return 1;
+  }
+}
 
-    // setup the items that make up the point
+/*---------------------------------------------------------------------------*/
+// like laszip_open_writer_stream() but hands blocks of bytes and their offset
+// to the write callback. the last block is passed on in laszip_close_writer()
+LASZIP_API laszip_I32
+laszip_open_writer_callback(
+    laszip_POINTER                     pointer
+    , laszip_write_callback            callback
+    , void*                            user_data
+    , laszip_BOOL                      compress
+    , laszip_BOOL                      do_not_write_header
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
 
-    LASzip laszip;
-    if (setup_laszip_items(laszip_dll, &laszip, compress))
+  try
+  {
+    if (callback == 0)
     {
+      snprintf(laszip_dll->error, sizeof(laszip_dll->error), "laszip_write_callback 'callback' is zero");
       return 1;
     }
 
-    // this supports software that writes the LAS header on its own
-
-    if (do_not_write_header == FALSE)
+    if (laszip_dll->writer == 0)
     {
-      // prepare header
-
-      if (laszip_prepare_header_for_write(laszip_dll))
-      {
-        return 1;
-      }
-
-      // prepare point
+      laszip_dll->write_callback = callback;
+      laszip_dll->callback_user_data = user_data;
+    }
 
-      if (laszip_prepare_point_for_write(laszip_dll, compress))
-      {
-        return 1;
-      }
+    ByteStreamOut* streamout;
+    if (IS_LITTLE_ENDIAN())
+      streamout = new ByteStreamOutCallbackLE(laszip_write_callback_trampoline, laszip_dll);
+    else
+      streamout = new ByteStreamOutCallbackBE(laszip_write_callback_trampoline, laszip_dll);
 
-      // prepare VLRs
+    return laszip_open_writer_streamout(laszip_dll, streamout, compress, do_not_write_header);
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_open_writer_callback");
+    return 1;
+  }
+}
 
-      if (laszip_prepare_vlrs_for_write(laszip_dll))
-      {
-        return 1;
-      }
+#ifdef __cplusplus
 
-      // write header variable after variable
+/*---------------------------------------------------------------------------*/
+LASZIP_API laszip_I32
+laszip_open_reader_stream(
+    laszip_POINTER                     pointer
+    , std::istream&                    stream
+    , laszip_BOOL*                     is_compressed
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
 
-      if (laszip_write_header(laszip_dll, &laszip, compress))
-      {
-        return 1;
-      }
-    }
+  try
+  {
+    ByteStreamIn* streamin;
+    if (IS_LITTLE_ENDIAN())
+      streamin = new ByteStreamInIstreamLE(stream);
+    else
+      streamin = new ByteStreamInIstreamBE(stream);
 
-    // create the point writer
+    return laszip_open_reader_streamin(laszip_dll, streamin, is_compressed);
+  }
+  catch (...)
+  {
+    snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_open_reader");
+    return 1;
+  }
+}
 
-    if (create_point_writer(laszip_dll, &laszip))
-    {
-      return 1;
-    }
+/*---------------------------------------------------------------------------*/
+// The stream writer also supports software that writes the LAS header on its
+// own simply by setting the BOOL 'do_not_write_header' to TRUE. This function
+// should then be called just prior to writing points as data is then written
+// to the current stream position
+LASZIP_API laszip_I32
+laszip_open_writer_stream(
+    laszip_POINTER                     pointer
+    , std::ostream&                    stream
+    , laszip_BOOL                      compress
+    , laszip_BOOL                      do_not_write_header
+)
+{
+  if (pointer == 0) return 1;
+  laszip_dll_struct* laszip_dll = (laszip_dll_struct*)pointer;
 
-    // set the point number and point count
+  try
+  {
+    ByteStreamOut* streamout;
+    if (IS_LITTLE_ENDIAN())
+      streamout = new ByteStreamOutOstreamLE(stream);
+    else
+      streamout = new ByteStreamOutOstreamBE(stream);
 
-    laszip_dll->npoints = (laszip_dll->header.number_of_point_records ? laszip_dll->header.number_of_point_records : laszip_dll->header.extended_number_of_point_records);
-    laszip_dll->p_count = 0;
+    return laszip_open_writer_streamout(laszip_dll, streamout, compress, do_not_write_header);
   }
   catch (...)
   {
     snprintf(laszip_dll->error, sizeof(laszip_dll->error), "internal error in laszip_open_writer_stream.");
     return 1;
   }
-  laszip_dll->error[0] = '\0';
-  return 0;
 }
 
 /*---------------------------------------------------------------------------*/
@@ -76,6 +76,8 @@ wchar_t* ANSItoUTF16(const char* ansi) {
 static bool wait_on_exit_ = false;
 static bool print_log_stats_ = false;
 static bool halt_on_error_ = true;
+static thread_local bool throw_on_error_ = false;
+static thread_local int no_throw_depth_ = 0;
 
 extern void LASLIB_DLL wait_on_exit(bool woe) {
   wait_on_exit_ = woe;
@@ -93,6 +95,22 @@ extern bool LASLIB_DLL do_halt_on_error() {
   return halt_on_error_;
 }
 
+extern void LASLIB_DLL throw_on_error(bool toe) {
+  throw_on_error_ = toe;
+}
+
+extern bool LASLIB_DLL do_throw_on_error() {
+  return throw_on_error_ && (no_throw_depth_ == 0);
+}
+
+LASnoThrowScope::LASnoThrowScope() {
+  no_throw_depth_++;
+}
+
+LASnoThrowScope::~LASnoThrowScope() {
+  no_throw_depth_--;
+}
+
 LAS_EXIT_CODE las_exit_code(bool error) {
   return (error ? LAS_EXIT_ERROR : LAS_EXIT_OK);
 }
@@ -101,8 +119,8 @@ extern void LASLIB_DLL byebye() {
   // optional: print stats
   if (print_log_stats_) {
     LASMessage(
-        LAS_INFO, "Log stats: FE=%lu,E=%lu,SW=%lu,W=%lu,I=%lu", lasmessage_cnt[LAS_FATAL_ERROR], lasmessage_cnt[LAS_ERROR],
-        lasmessage_cnt[LAS_SERIOUS_WARNING], lasmessage_cnt[LAS_WARNING], lasmessage_cnt[LAS_INFO]);
+        LAS_INFO, "Log stats: FE=%lu,E=%lu,SW=%lu,W=%lu,I=%lu", lasmessage_cnt[LAS_FATAL_ERROR].load(), lasmessage_cnt[LAS_ERROR].load(),
+        lasmessage_cnt[LAS_SERIOUS_WARNING].load(), lasmessage_cnt[LAS_WARNING].load(), lasmessage_cnt[LAS_INFO].load());
   }
   if (wait_on_exit_) {
     std::fprintf(stderr, "<press ENTER>\n");
@@ -207,6 +225,28 @@ FILE* LASfopen(const char* const filename, const char* const mode) {
   return file;
 }
 
+bool LASfseek(FILE* file, const I64 position, const int origin) {
+  if (file == nullptr) return false;
+#if defined _WIN32 && !defined(__MINGW32__)
+  return _fseeki64(file, position, origin) == 0;
+#elif defined(__MINGW32__)
+  return fseeko64(file, (off64_t)position, origin) == 0;
+#else
+  return fseeko(file, (off_t)position, origin) == 0;
+#endif
+}
+
+I64 LASftell(FILE* file) {
+  if (file == nullptr) return -1;
+#if defined _WIN32 && !defined(__MINGW32__)
+  return _ftelli64(file);
+#elif defined(__MINGW32__)
+  return (I64)ftello64(file);
+#else
+  return (I64)ftello(file);
+#endif
+}
+
 /// !!The caller is responsible for managing the memory of the returned const char*
 /// using 'delete[]' when done!!
 /// Indents each line of content by the given 'indent'
@@ -24,6 +24,7 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- per-thread 'throw_on_error()' mode so LASlib can run inside a server
     28 October 2015 -- adding DLL bindings via 'COMPILE_AS_DLL' and 'USE_AS_DLL'
     10 January 2011 -- licensing change for LGPL release and libLAS integration
     13 July 2005 -- created after returning with many mosquito bites from OBX
@@ -323,10 +324,33 @@ class pnt_cnt_error : public exception_file_loop {
   explicit pnt_cnt_error() noexcept : exception_file_loop("too less points"){};
 };
 
+/// <summary>
+/// error raised by laserror() instead of halting the program if throw_on_error(true) was set for the calling thread
+/// </summary>
+class las_error : public std::runtime_error {
+ public:
+  explicit las_error(char const* const _Message) noexcept : std::runtime_error(_Message){};
+};
+
 extern void LASLIB_DLL wait_on_exit(bool woe = true);
 extern void LASLIB_DLL print_log_stats(bool pls = true);
 extern void LASLIB_DLL halt_on_error(bool hoe);
 extern bool LASLIB_DLL do_halt_on_error();
+// per-thread: errors of the calling thread throw a las_error instead of halting (takes precedence over halt_on_error)
+extern void LASLIB_DLL throw_on_error(bool toe);
+extern bool LASLIB_DLL do_throw_on_error();
+// last error message raised by the calling thread (empty if none, see lasmessage.cpp)
+extern const char* LASLIB_DLL get_las_last_error();
+extern void LASLIB_DLL clear_las_last_error();
+
+/// <summary>
+/// suppresses throw_on_error() for the calling thread while in scope (e.g. in destructors that close files)
+/// </summary>
+class LASLIB_DLL LASnoThrowScope {
+ public:
+  LASnoThrowScope();
+  ~LASnoThrowScope();
+};
 
 enum LAS_EXIT_CODE { LAS_EXIT_OK = 0, LAS_EXIT_ERROR, LAS_EXIT_WARNING };
 
@@ -343,12 +367,20 @@ extern void LASLIB_DLL byebye();
 bool validate_utf8(const char* utf8) noexcept;
 // Opens a file with the specified filename and mode, converting filename and mode to UTF-16 on Windows.
 FILE* LASfopen(const char* const filename, const char* const mode);
+// Seeks to a 64 bit file position, returns true on success.
+bool LASfseek(FILE* file, const I64 position, const int origin);
+// Returns the 64 bit file position or -1 on failure.
+I64 LASftell(FILE* file);
 const char* indent_text(const char* text, const char* indent);
 
-// las error message function which leads to an immediate program stop by default
+// las error message function which leads to an immediate program stop by default (or throws a las_error
+// if throw_on_error(true) was set for the calling thread)
 template <typename... Args>
 void laserror(LAS_FORMAT_STRING(const char*) fmt, Args... args) {
   LASMessage(LAS_ERROR, fmt, args...);
+  if (do_throw_on_error()) {
+    throw las_error(get_las_last_error());
+  }
   if (do_halt_on_error()) {
     byebye();
   }
@@ -360,6 +392,9 @@ template <typename... Args>
 void laserrorm(LAS_FORMAT_STRING(const char*) fmt, Args... args) {
   LASMessage(LAS_ERROR, fmt, args...);
   LASMessage(LAS_INFO, "\tcontact info@rapidlasso.de for support\n");
+  if (do_throw_on_error()) {
+    throw las_error(get_las_last_error());
+  }
   if (do_halt_on_error()) {
     byebye();
   }
@@ -6789,6 +6789,11 @@ GeoProjectionConverter::GeoProjectionConverter() {
   target_precision = 0;
   target_elevation_precision = 0;
 
+  target_max_error_in_millimeter = 0;
+  approximation_tile_size = 0;
+  approximation_max_error = 0;
+  approximation_tiles = 0;
+
   elevation_offset_in_meter = 0.0f;
 
   check_header_for_crs = false;
@@ -6803,6 +6808,7 @@ GeoProjectionConverter::~GeoProjectionConverter() {
   delete ellipsoid;
   if (source_projection) delete source_projection;
   if (target_projection) delete target_projection;
+  if (approximation_tiles) delete[] approximation_tiles;
 }
 
 void GeoProjectionConverter::parse(int argc, char* argv[]) {
@@ -7444,6 +7450,18 @@ void GeoProjectionConverter::parse(int argc, char* argv[]) {
       *argv[i] = '\0';
       *argv[i + 1] = '\0';
       i += 1;
+    } else if (strcmp(argv[i], "-target_max_error_mm") == 0) {
+      if ((i + 1) >= argc) {
+        laserror("'%s' needs 1 argument: max_error_in_millimeter", argv[i]);
+      }
+      double max_error_in_millimeter = atof(argv[i + 1]);
+      if (max_error_in_millimeter <= 0.0) {
+        laserror("'%s' needs a positive max_error_in_millimeter but '%s' is not", argv[i], argv[i + 1]);
+      }
+      set_target_max_error(max_error_in_millimeter);
+      *argv[i] = '\0';
+      *argv[i + 1] = '\0';
+      i += 1;
     }
   }
   return;
@@ -7622,6 +7640,9 @@ int GeoProjectionConverter::unparse(char* string) const {
   if (target_elevation_precision != 0.0) {
     n += sprintf(&string[n], "-target_elevation_precision %lf ", target_elevation_precision);
   }
+  if (target_max_error_in_millimeter != 0.0) {
+    n += sprintf(&string[n], "-target_max_error_mm %lf ", target_max_error_in_millimeter);
+  }
 
   return n;
 }
@@ -7814,6 +7835,307 @@ bool GeoProjectionConverter::to_target(double* point) const {
 }
 
 bool GeoProjectionConverter::to_target(const double* point, double& x, double& y, double& elevation) const {
+  if (approximation_tiles && can_approximate_target()) {
+    if (to_target_approximated(point, x, y, elevation)) {
+      return true;
+    }
+  }
+  return to_target_exact(point, x, y, elevation);
+}
+
+bool GeoProjectionConverter::to_target(double* points, const unsigned int number_of_points, const unsigned int stride) const {
+  unsigned int i;
+  double* point;
+  double longitude;
+  double latitude;
+
+  if (number_of_points == 0) {
+    return (target_projection || projParameters.proj_target_crs);
+  }
+
+  if (source_projection && target_projection) {
+    // approximated or geocentric reprojections convert point by point
+
+    if ((approximation_tiles && can_approximate_target()) || (source_projection->type == GEO_PROJECTION_ECEF) ||
+        (target_projection->type == GEO_PROJECTION_ECEF)) {
+      for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+        to_target(point, point[0], point[1], point[2]);
+      }
+      return true;
+    }
+
+    // first pass: from source projection to longitude (in x) and latitude (in y)
+
+    switch (source_projection->type) {
+      case GEO_PROJECTION_UTM:
+        for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+          UTMtoLL(
+              coordinates2meter * point[0], coordinates2meter * point[1], point[1], point[0], ellipsoid,
+              (const GeoProjectionParametersUTM*)source_projection);
+        }
+        break;
+      case GEO_PROJECTION_LCC:
+        for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+          LCCtoLL(
+              coordinates2meter * point[0], coordinates2meter * point[1], point[1], point[0], ellipsoid,
+              (const GeoProjectionParametersLCC*)source_projection);
+        }
+        break;
+      case GEO_PROJECTION_TM:
+        for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+          TMtoLL(
+              coordinates2meter * point[0], coordinates2meter * point[1], point[1], point[0], ellipsoid,
+              (const GeoProjectionParametersTM*)source_projection);
+        }
+        break;
+      case GEO_PROJECTION_LONG_LAT:
+        break;
+      case GEO_PROJECTION_LAT_LONG:
+        for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+          latitude = point[0];
+          point[0] = point[1];
+          point[1] = latitude;
+        }
+        break;
+      case GEO_PROJECTION_AEAC:
+        for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+          AEACtoLL(
+              coordinates2meter * point[0], coordinates2meter * point[1], point[1], point[0], ellipsoid,
+              (const GeoProjectionParametersAEAC*)source_projection);
+        }
+        break;
+      case GEO_PROJECTION_OS:
+        for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+          OStoLL(
+              coordinates2meter * point[0], coordinates2meter * point[1], point[1], point[0], ellipsoid,
+              (const GeoProjectionParametersOS*)source_projection);
+        }
+        break;
+      case GEO_PROJECTION_HOM:
+        for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+          HOMtoLL(
+              coordinates2meter * point[0], coordinates2meter * point[1], point[1], point[0], ellipsoid,
+              (const GeoProjectionParametersHOM*)source_projection);
+        }
+        break;
+      default:
+        for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+          point[0] = 0.0;
+          point[1] = 0.0;
+        }
+        break;
+    }
+
+    // second pass: from longitude and latitude to target projection
+
+    switch (target_projection->type) {
+      case GEO_PROJECTION_UTM:
+        if (((GeoProjectionParametersUTM*)target_projection)->utm_zone_number == -1)
+          compute_utm_zone(points[1], points[0], (GeoProjectionParametersUTM*)target_projection);
+        for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+          longitude = point[0];
+          latitude = point[1];
+          LLtoUTM(latitude, longitude, point[0], point[1], ellipsoid, (const GeoProjectionParametersUTM*)target_projection);
+          point[0] = meter2coordinates * point[0];
+          point[1] = meter2coordinates * point[1];
+        }
+        break;
+      case GEO_PROJECTION_LCC:
+        for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+          longitude = point[0];
+          latitude = point[1];
+          LLtoLCC(latitude, longitude, point[0], point[1], ellipsoid, (const GeoProjectionParametersLCC*)target_projection);
+          point[0] = meter2coordinates * point[0];
+          point[1] = meter2coordinates * point[1];
+        }
+        break;
+      case GEO_PROJECTION_TM:
+        for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+          longitude = point[0];
+          latitude = point[1];
+          LLtoTM(latitude, longitude, point[0], point[1], ellipsoid, (const GeoProjectionParametersTM*)target_projection);
+          point[0] = meter2coordinates * point[0];
+          point[1] = meter2coordinates * point[1];
+        }
+        break;
+      case GEO_PROJECTION_LONG_LAT:
+        break;
+      case GEO_PROJECTION_LAT_LONG:
+        for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+          longitude = point[0];
+          point[0] = point[1];
+          point[1] = longitude;
+        }
+        break;
+      case GEO_PROJECTION_AEAC:
+        for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+          longitude = point[0];
+          latitude = point[1];
+          LLtoAEAC(latitude, longitude, point[0], point[1], ellipsoid, (const GeoProjectionParametersAEAC*)target_projection);
+          point[0] = meter2coordinates * point[0];
+          point[1] = meter2coordinates * point[1];
+        }
+        break;
+      case GEO_PROJECTION_OS:
+        for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+          longitude = point[0];
+          latitude = point[1];
+          LLtoOS(latitude, longitude, point[0], point[1], ellipsoid, (const GeoProjectionParametersOS*)target_projection);
+          point[0] = meter2coordinates * point[0];
+          point[1] = meter2coordinates * point[1];
+        }
+        break;
+      case GEO_PROJECTION_HOM:
+        for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+          longitude = point[0];
+          latitude = point[1];
+          LLtoHOM(latitude, longitude, point[0], point[1], ellipsoid, (const GeoProjectionParametersHOM*)target_projection);
+          point[0] = meter2coordinates * point[0];
+          point[1] = meter2coordinates * point[1];
+        }
+        break;
+    }
+
+    // the elevation is only scaled and translated
+
+    for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+      point[2] = meter2elevation * (elevation2meter * point[2] + elevation_offset_in_meter);
+    }
+    return true;
+  } else if (projParameters.proj_target_crs) {
+    return do_proj_crs_transformation(points, number_of_points, stride);
+  }
+  return false;
+}
+
+bool GeoProjectionConverter::has_target_max_error() const {
+  return (target_max_error_in_millimeter > 0.0);
+}
+
+double GeoProjectionConverter::get_target_max_error() const {
+  return target_max_error_in_millimeter;
+}
+
+void GeoProjectionConverter::set_target_max_error(double max_error_in_millimeter) {
+  target_max_error_in_millimeter = max_error_in_millimeter;
+  // tile size and error bound in target units depend on the projections and are computed on first use
+  approximation_tile_size = 0;
+  approximation_max_error = 0;
+  if (approximation_tiles) {
+    delete[] approximation_tiles;
+    approximation_tiles = 0;
+  }
+  if (max_error_in_millimeter > 0.0) {
+    approximation_tiles = new GeoProjectionApproximationTile[GEO_APPROXIMATION_TILES];
+  }
+}
+
+bool GeoProjectionConverter::can_approximate_target() const {
+  // only the built-in projections whose x and y do not depend on the elevation
+  if (source_projection == 0 || target_projection == 0) return false;
+  if (source_projection->type == GEO_PROJECTION_ECEF || target_projection->type == GEO_PROJECTION_ECEF) return false;
+  return true;
+}
+
+bool GeoProjectionConverter::to_target_approximated(const double* point, double& x, double& y, double& elevation) const {
+  if (approximation_tile_size == 0.0) {
+    // tiles of about one kilometer in source units
+    if (source_projection->type == GEO_PROJECTION_LONG_LAT || source_projection->type == GEO_PROJECTION_LAT_LONG) {
+      approximation_tile_size = 0.01;
+    } else {
+      approximation_tile_size = 1000.0 / coordinates2meter;
+    }
+    // the maximal error in target units (degrees are bounded with the length of one degree of latitude)
+    if (target_projection->type == GEO_PROJECTION_LONG_LAT || target_projection->type == GEO_PROJECTION_LAT_LONG) {
+      approximation_max_error = target_max_error_in_millimeter / 1000.0 / 111320.0;
+    } else {
+      approximation_max_error = target_max_error_in_millimeter / 1000.0 * meter2coordinates;
+    }
+  }
+
+  long long tile_x = (long long)floor(point[0] / approximation_tile_size);
+  long long tile_y = (long long)floor(point[1] / approximation_tile_size);
+  GeoProjectionApproximationTile* tile = &approximation_tiles[(unsigned long long)(tile_x * 31 + tile_y) % GEO_APPROXIMATION_TILES];
+
+  if (!tile->valid || tile->tile_x != tile_x || tile->tile_y != tile_y) {
+    compute_approximation_tile(tile, tile_x, tile_y);
+  }
+  if (tile->exact) {
+    return false;
+  }
+
+  // bilinear interpolation within the grid cell
+
+  double cell_size = approximation_tile_size / (tile->size - 1);
+  double u = (point[0] - tile_x * approximation_tile_size) / cell_size;
+  double v = (point[1] - tile_y * approximation_tile_size) / cell_size;
+  int i = (int)u;
+  int j = (int)v;
+  if (i < 0) i = 0; else if (i > tile->size - 2) i = tile->size - 2;
+  if (j < 0) j = 0; else if (j > tile->size - 2) j = tile->size - 2;
+  u -= i;
+  v -= j;
+  const double* n00 = &tile->nodes[2 * (j * tile->size + i)];
+  const double* n10 = n00 + 2;
+  const double* n01 = n00 + 2 * tile->size;
+  const double* n11 = n01 + 2;
+  double z = point[2];
+  x = (1.0 - v) * ((1.0 - u) * n00[0] + u * n10[0]) + v * ((1.0 - u) * n01[0] + u * n11[0]);
+  y = (1.0 - v) * ((1.0 - u) * n00[1] + u * n10[1]) + v * ((1.0 - u) * n01[1] + u * n11[1]);
+  elevation = meter2elevation * (elevation2meter * z + elevation_offset_in_meter);
+  return true;
+}
+
+void GeoProjectionConverter::compute_approximation_tile(GeoProjectionApproximationTile* tile, long long tile_x, long long tile_y) const {
+  tile->tile_x = tile_x;
+  tile->tile_y = tile_y;
+  tile->valid = true;
+  tile->exact = false;
+
+  double origin_x = tile_x * approximation_tile_size;
+  double origin_y = tile_y * approximation_tile_size;
+  double in[3] = {0.0, 0.0, 0.0};
+  double ex, ey, ez;
+  int i, j, size;
+
+  // refine the grid until the interpolation error at all cell centers is small enough
+
+  for (size = 2; size <= GEO_APPROXIMATION_MAX_SIZE; size = 2 * size - 1) {
+    if (tile->nodes) delete[] tile->nodes;
+    tile->nodes = new double[2 * size * size];
+    tile->size = size;
+
+    double cell_size = approximation_tile_size / (size - 1);
+    for (j = 0; j < size; j++) {
+      in[1] = origin_y + j * cell_size;
+      for (i = 0; i < size; i++) {
+        in[0] = origin_x + i * cell_size;
+        to_target_exact(in, tile->nodes[2 * (j * size + i)], tile->nodes[2 * (j * size + i) + 1], ez);
+      }
+    }
+
+    double max_error = 0.0;
+    for (j = 0; j < size - 1; j++) {
+      in[1] = origin_y + (j + 0.5) * cell_size;
+      for (i = 0; i < size - 1; i++) {
+        in[0] = origin_x + (i + 0.5) * cell_size;
+        to_target_exact(in, ex, ey, ez);
+        const double* n00 = &tile->nodes[2 * (j * size + i)];
+        const double* n11 = n00 + 2 * size + 2;
+        double dx = ex - 0.25 * (n00[0] + n00[2] + n11[-2] + n11[0]);
+        double dy = ey - 0.25 * (n00[1] + n00[3] + n11[-1] + n11[1]);
+        double error = sqrt(dx * dx + dy * dy);
+        if (!(error <= max_error)) max_error = error;  // also catches NaN
+      }
+    }
+    if (max_error <= 0.5 * approximation_max_error) {
+      return;
+    }
+  }
+  tile->exact = true;
+}
+
+bool GeoProjectionConverter::to_target_exact(const double* point, double& x, double& y, double& elevation) const {
   if (source_projection && target_projection) {
     double longitude = 0.0;
     double latitude = 0.0;
@@ -9049,5 +9371,43 @@ bool GeoProjectionConverter::do_proj_crs_transformation(double& x, double& y, do
   y = result.xyzt.y;
   elevation = result.xyzt.z;
 
+  return true;
+}
+
+/// IMPORTANT: The Proj lib must be installed and loaded to use this functionality.
+/// Executing the CRS transformation for an array of coordinates (x,y,elevation at 'points + i * stride') using the PROJ library
+bool GeoProjectionConverter::do_proj_crs_transformation(double* points, const unsigned int number_of_points, const unsigned int stride) const {
+  if (!projParameters.proj_transform_crs) return false;
+
+  if (proj_trans_generic_ptr) {
+    // transforms all coordinates in place with a single call
+    size_t step = stride * sizeof(double);
+    size_t count = proj_trans_generic(
+        projParameters.proj_transform_crs, PJ_FWD, points, step, number_of_points, points + 1, step, number_of_points, points + 2, step,
+        number_of_points, nullptr, 0, 0);
+    // PROJ sets the coordinates it failed to transform to HUGE_VAL
+    unsigned int i, failed = 0;
+    double* point;
+    for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+      if (point[0] == HUGE_VAL || point[1] == HUGE_VAL) failed++;
+    }
+    if ((count != number_of_points) || failed) {
+      int err_no = proj_context_errno(projParameters.proj_ctx);
+      if (failed == 0) failed = number_of_points - (unsigned int)count;
+      if (err_no == 0) {
+        LASMessage(LAS_WARNING, "PROJ failed to transform %u of %u points, reason unknown", failed, number_of_points);
+      } else {
+        LASMessage(LAS_WARNING, "PROJ failed to transform %u of %u points: %s", failed, number_of_points,
+                   proj_context_errno_string(projParameters.proj_ctx, err_no));
+      }
+      return false;
+    }
+  } else {
+    unsigned int i;
+    double* point;
+    for (i = 0, point = points; i < number_of_points; i++, point += stride) {
+      do_proj_crs_transformation(point[0], point[1], point[2]);
+    }
+  }
   return true;
 }
\ No newline at end of file
@@ -51,6 +51,7 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- batched reprojection of point arrays and approximated reprojection
      1 September 2024 -- integration of the PROJ Library for CRS transformations 
      1 November 2018 -- changes requested by Kirk Waters including GEO_GCS_NAD83_CORS96
      7 September 2018 -- introduced the LASCopyString macro to replace _strdup
@@ -322,6 +323,28 @@ class ProjParameters
   void set_proj_member(char*& member, const char* value);
 };
 
+#define GEO_APPROXIMATION_TILES     16
+#define GEO_APPROXIMATION_MAX_SIZE 129
+
+/// interpolation grid for one square tile of source coordinates used by the
+/// approximated reprojection. the tile stores the exactly reprojected target
+/// x and y at size x size grid nodes and is bilinearly interpolated inside.
+class GeoProjectionApproximationTile
+{
+ public:
+  long long tile_x;
+  long long tile_y;
+  bool valid;
+  bool exact;  // interpolation not accurate enough. reproject exactly
+  int size;
+  double* nodes;
+
+  GeoProjectionApproximationTile() : tile_x(0), tile_y(0), valid(false), exact(false), size(0), nodes(0) {};
+  ~GeoProjectionApproximationTile() {
+    if (nodes) delete[] nodes;
+  };
+};
+
 class GeoProjectionConverter
 {
 public:
@@ -473,6 +496,16 @@ public:
   bool to_target(double* point) const;
   bool to_target(const double* point, double& x, double& y, double& elevation) const;
 
+  // from current projection to target projection for an array of points whose
+  // x, y, and z are found at 'points + i * stride' (stride in doubles)
+  bool to_target(double* points, const unsigned int number_of_points, const unsigned int stride = 3) const;
+
+  // approximate the reprojection with per-tile interpolation grids that are
+  // refined until the error is below the given maximum (built-in projections only)
+  bool has_target_max_error() const;
+  double get_target_max_error() const;
+  void set_target_max_error(double max_error_in_millimeter);
+
   bool has_target_precision() const;
   double get_target_precision(double header_precision = 0.0) const;
   void set_target_precision(double target_precision);
@@ -540,6 +573,12 @@ private:
   double target_precision;
   double target_elevation_precision;
 
+  // for the approximated reprojection (tiles are a cache and filled on demand)
+  double target_max_error_in_millimeter;
+  mutable double approximation_tile_size;
+  mutable double approximation_max_error;
+  mutable GeoProjectionApproximationTile* approximation_tiles;
+
   // helper functions
   FILE* open_geo_file(bool pcs = true, bool vertical = false);
   char* get_epsg_name_from_pcs_file(short value);
@@ -553,11 +592,18 @@ private:
   void compute_hom_parameters(bool source);
   void compute_os_parameters(bool source);
 
+  // helper functions for the (approximated) reprojection
+  bool to_target_exact(const double* point, double& x, double& y, double& elevation) const;
+  bool can_approximate_target() const;
+  bool to_target_approximated(const double* point, double& x, double& y, double& elevation) const;
+  void compute_approximation_tile(GeoProjectionApproximationTile* tile, long long tile_x, long long tile_y) const;
+
   // using PROJ lib 
   void set_proj_param_for_transformation_with_epsg(unsigned int& source_code, unsigned int& target_code);
   void set_proj_param_for_transformation_with_string(const char* proj_sourge_string, const char* proj_target_string);
   void set_proj_param_for_transformation_with_json(const char* source_filename, const char* target_filename);
   void set_proj_param_for_transformation_with_wkt(const char* source_filename, const char* target_filename);
   bool do_proj_crs_transformation(double& x, double& y, double& elevation) const;
+  bool do_proj_crs_transformation(double* points, const unsigned int number_of_points, const unsigned int stride) const;
 };
 #pragma warning(pop)
\ No newline at end of file
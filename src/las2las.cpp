@@ -33,6 +33,8 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- copies compressed LAS 1.4 chunks or their unchanged layers as they are
+    18 October 2026 -- option '-pipeline' overlaps reading, processing and writing on threads
     30 October 2020 -- fail / exit with error code when input file is corrupt
      9 September 2019 -- warn if modifying x or y coordinates for tiles with VLR
     30 November 2017 -- set OGC WKT with '-set_ogc_wkt "PROJCS[\"WGS84\",GEOGCS[\"GCS_ ..."
@@ -66,13 +68,17 @@
 #include <time.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include <cstdint> 
 
 #include "mydefs.hpp"
 #include "lastool.hpp"
 #include "lasreader.hpp"
 #include "laswriter.hpp"
+#include "lasreader_las.hpp"
+#include "laswriter_las.hpp"
 #include "lastransform.hpp"
+#include "laspipeline.hpp"
 #include "geoprojectionconverter.hpp"
 #include "bytestreamout_file.hpp"
 #include "bytestreamin_file.hpp"
@@ -97,12 +103,15 @@ public:
     fprintf(stderr, "las2las -i in.las -rescale 0.01 0.01 0.01 -reoffset 0 300000 0 -o out.las\n");
     fprintf(stderr, "las2las -i in.las -set_version 1.2 -keep_gpstime 46.5 47.5 -o out.las\n");
     fprintf(stderr, "las2las -i in.las -drop_intensity_below 10 -olaz -stdout > out.laz\n");
+    fprintf(stderr, "las2las -i in.laz -keep_class 2 -pipeline -o out.laz\n");
     fprintf(stderr, "las2las -i in.las -last_only -drop_gpstime_below 46.75 -otxt -oparse xyzt -stdout > out.txt\n");
     fprintf(stderr, "las2las -i in.las -remove_all_vlrs -keep_class 2 3 4 -olas -stdout > out.las\n");
     fprintf(stderr, "las2las -h\n");
   };
 };
 
+#define LAS2LAS_REPROJECTION_BLOCK 4096
+
 static double taketime()
 {
   return (double)(clock()) / CLOCKS_PER_SEC;
@@ -591,6 +600,51 @@ void get_wkt_from_proj(CHAR*& ogc_wkt_out, GeoProjectionConverter& geoprojection
   }
 }
 
+// the layers of new LAS 1.4 points whose compression does not depend on the
+// other layers and that can therefore be encoded again without the others
+#define LAS2LAS_RECOMPRESS_SELECTIVE (LASZIP_DECOMPRESS_SELECTIVE_Z | LASZIP_DECOMPRESS_SELECTIVE_CLASSIFICATION | LASZIP_DECOMPRESS_SELECTIVE_FLAGS | LASZIP_DECOMPRESS_SELECTIVE_INTENSITY | LASZIP_DECOMPRESS_SELECTIVE_USER_DATA | LASZIP_DECOMPRESS_SELECTIVE_RGB | LASZIP_DECOMPRESS_SELECTIVE_NIR | LASZIP_DECOMPRESS_SELECTIVE_WAVEPACKET | LASZIP_DECOMPRESS_SELECTIVE_EXTRA_BYTES)
+
+// copies the compressed chunks of a LAZ file with new LAS 1.4 points as they
+// are or, with a transform, all their layers except 'recompress_selective'.
+// the points of the chunks that cannot be copied are left for the usual loop
+
+static I64 copy_compressed_chunks(LASreaderLAS* lasreader, LASwriterLAS* laswriter, const LAStransform* transform, U32 recompress_selective)
+{
+  I64 count = 0;
+  const U8* bytes;
+  U32 num_bytes;
+  U32 num_points;
+  U32 i;
+  while (lasreader->peek_chunk(&bytes, &num_bytes, &num_points))
+  {
+    if (transform == 0)
+    {
+      if (!laswriter->write_chunk(bytes, num_bytes, num_points) || !lasreader->skip_chunk())
+      {
+        laserror("copying compressed chunk with %u points", num_points);
+      }
+    }
+    else
+    {
+      if (!laswriter->copy_layers(bytes, num_bytes, recompress_selective))
+      {
+        laserror("copying layers of compressed chunk with %u points", num_points);
+      }
+      for (i = 0; i < num_points; i++)
+      {
+        if (!lasreader->read_point())
+        {
+          laserror("reading point %u of compressed chunk with %u points", i, num_points);
+        }
+        laswriter->write_point(&lasreader->point);
+        laswriter->update_inventory(&lasreader->point);
+      }
+    }
+    count += num_points;
+  }
+  return count;
+}
+
 // for point type conversions
 const U8 convert_point_type_from_to[11][11] =
 {
@@ -666,6 +720,10 @@ int main(int argc, char* argv[])
   bool remove_tiling_vlr = false;
   bool remove_original_vlr = false;
   bool remove_empty_files = true;
+  // decode, process and encode on separate threads
+  bool pipeline = false;
+  // copy compressed chunks (or their unchanged layers) of LAZ files with new LAS 1.4 points
+  bool chunk_copy = true;
   // extract a subsequence
   I64 subsequence_start = 0;
   I64 subsequence_stop = I64_MAX;
@@ -1131,6 +1189,14 @@ int main(int argc, char* argv[])
     {
       remove_empty_files = false;
     }
+    else if (strcmp(argv[i], "-pipeline") == 0)
+    {
+      pipeline = true;
+    }
+    else if (strcmp(argv[i], "-no_chunk_copy") == 0)
+    {
+      chunk_copy = false;
+    }
     // lasfilter abort on -clip_... due obsolete in general. we change -clip_ to -crop
     else if (strcmp(argv[i], "-crop_to_bounding_box") == 0 || strcmp(argv[i], "-crop_to_bb") == 0)
     {
@@ -1190,6 +1256,37 @@ int main(int argc, char* argv[])
     laserror("no input specified");
   }
 
+  // only decompress the layers that the output needs (for new LAS 1.4 point types only). the
+  // filter and the transform add their layers and z is needed for bounding box and reprojection
+
+  U32 decompress_selective = laswriteopener.get_decompress_selective() | LASZIP_DECOMPRESS_SELECTIVE_Z;
+  lasreadopener.set_decompress_selective(decompress_selective);
+
+  // the compressed chunks of LAZ files with new LAS 1.4 points can be copied as long as no point
+  // is dropped, moved or reformatted. a transform that only changes layers which are compressed
+  // independently lets all other layers be copied and needs to decode only what it changes and
+  // reads. the Z and the intensity layers are compressed depending on a change in GPS time
+
+  U32 recompress_selective = LASZIP_DECOMPRESS_SELECTIVE_ALL;
+  U32 chunk_copy_decompress_selective = LASZIP_DECOMPRESS_SELECTIVE_ALL;
+  if (chunk_copy && (subsequence_start == 0) && (subsequence_stop == I64_MAX) && !clip_to_bounding_box && (lasreadopener.get_filter() == 0) && !lasreadopener.is_offset_adjust() && !lasreadopener.is_piped() && !laswriteopener.is_piped() && !laswriteopener.get_statistics_sidecar() && !laswriteopener.get_chunk_summaries() && !laswriteopener.get_adaptive_chunking())
+  {
+    LAStransform* transform = lasreadopener.get_transform();
+    recompress_selective = (transform ? transform->get_recompress_selective() : 0);
+    if (recompress_selective & ~LAS2LAS_RECOMPRESS_SELECTIVE)
+    {
+      recompress_selective = LASZIP_DECOMPRESS_SELECTIVE_ALL;
+    }
+    else if (transform && !transform->filtered())
+    {
+      chunk_copy_decompress_selective = LASZIP_DECOMPRESS_SELECTIVE_Z | recompress_selective | transform->get_decompress_selective();
+      if (recompress_selective & (LASZIP_DECOMPRESS_SELECTIVE_Z | LASZIP_DECOMPRESS_SELECTIVE_INTENSITY))
+      {
+        chunk_copy_decompress_selective |= LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME;
+      }
+    }
+  }
+
   BOOL extra_pass = laswriteopener.is_piped();
 
   // we only really need an extra pass if the coordinates are altered or if points are filtered
@@ -2248,6 +2345,19 @@ int main(int argc, char* argv[])
         memset(lasreader->header.generating_software, 0, LAS_HEADER_CHAR_LEN);
         strncpy_las(lasreader->header.generating_software, LAS_HEADER_CHAR_LEN, temp);
         
+        // maybe copy compressed chunks. then the output keeps the chunking of the input
+        LASreaderLAS* chunk_reader = 0;
+        U32 chunk_size = laswriteopener.get_chunk_size();
+        if ((recompress_selective != LASZIP_DECOMPRESS_SELECTIVE_ALL) && (point == 0) && (reproject_quantizer == 0) && !extra_pass && lasreader->header.laszip && (lasreader->header.laszip->compressor == LASZIP_COMPRESSOR_LAYERED_CHUNKED))
+        {
+          U32 input_chunk_size = ((lasreader->header.laszip->chunk_size == U32_MAX) ? 0 : lasreader->header.laszip->chunk_size);
+          if ((chunk_size == LASZIP_CHUNK_SIZE_DEFAULT) || (chunk_size == input_chunk_size))
+          {
+            chunk_reader = dynamic_cast<LASreaderLAS*>(lasreader);
+            if (chunk_reader) laswriteopener.set_chunk_size(input_chunk_size);
+          }
+        }
+
         // open laswriter
         if (reproject_quantizer) {
           *header_writer = *reproject_quantizer;
@@ -2257,6 +2367,12 @@ int main(int argc, char* argv[])
         {
           laserror("could not open laswriter");
         }
+        laswriteopener.set_chunk_size(chunk_size);
+        LASwriterLAS* chunk_writer = (chunk_reader ? dynamic_cast<LASwriterLAS*>(laswriter) : 0);
+        if (chunk_writer && !chunk_writer->can_copy_chunks(lasreader->header.laszip))
+        {
+          chunk_writer = 0;
+        }
 
         // for piped output we need to re-open the input file
         if (extra_pass)
@@ -2270,65 +2386,141 @@ int main(int argc, char* argv[])
         // maybe seek to start position
         if (subsequence_start) lasreader->seek(subsequence_start);
 
+        // maybe copy compressed chunks (or all but the transformed layers)
+        I64 copied_points = 0;
+        if (chunk_writer)
+        {
+          const LAStransform* transform = lasreadopener.get_transform();
+          if (transform && (chunk_copy_decompress_selective != decompress_selective))
+          {
+            // only decode the layers that are transformed or needed for transforming
+            lasreadopener.set_decompress_selective(chunk_copy_decompress_selective);
+            if (!lasreadopener.reopen(lasreader))
+            {
+              laserror("could not re-open lasreader");
+            }
+            lasreadopener.set_decompress_selective(decompress_selective);
+          }
+          copied_points = copy_compressed_chunks(chunk_reader, chunk_writer, transform, recompress_selective);
+          if (copied_points) LASMessage(LAS_VERBOSE, "copied %s of %lld points as compressed chunks", (transform ? "the unchanged layers" : "all"), copied_points);
+        }
+
+        // without extra pass we need inventory of surviving points
+        LASpipeline laspipeline;
+        laspipeline.open(lasreader, laswriter, !extra_pass, pipeline, (point ? point : &lasreader->point));
+        LASpoint* read;
+
         // loop over points
-        if (point) // full rewrite: point copy
+        if (reproject_quantizer) // reprojection: points are buffered and reprojected in blocks
+        {
+          const LASpoint* layout = (point ? point : &lasreader->point);
+          LASpoint* block = new LASpoint[LAS2LAS_REPROJECTION_BLOCK];
+          F64* block_coordinates = new F64[3 * LAS2LAS_REPROJECTION_BLOCK];
+          U32 b, count = 0;
+          I64 failed = 0;
+          for (b = 0; b < LAS2LAS_REPROJECTION_BLOCK; b++)
+          {
+            block[b].init(&lasreader->header, layout->num_items, layout->items, layout->attributer);
+          }
+          BOOL more = TRUE;
+          while (more)
+          {
+            more = ((read = laspipeline.read_point()) != 0) && (laspipeline.p_cnt <= subsequence_stop);
+            if (more)
+            {
+              if (clip_to_bounding_box)
+              {
+                if (!read->inside_box(lasreader->header.min_x, lasreader->header.min_y, lasreader->header.min_z, lasreader->header.max_x, lasreader->header.max_y, lasreader->header.max_z))
+                {
+                  continue;
+                }
+              }
+              block[count] = *read;
+              block_coordinates[3 * count + 0] = read->get_x();
+              block_coordinates[3 * count + 1] = read->get_y();
+              block_coordinates[3 * count + 2] = read->get_z();
+              count++;
+              if (count < LAS2LAS_REPROJECTION_BLOCK) continue;
+            }
+            if (count)
+            {
+              // points that PROJ failed to transform have HUGE_VAL coordinates and are skipped
+              BOOL transformed = geoprojectionconverter.to_target(block_coordinates, count);
+              for (b = 0; b < count; b++)
+              {
+                if (!transformed && ((block_coordinates[3 * b + 0] == HUGE_VAL) || (block_coordinates[3 * b + 1] == HUGE_VAL)))
+                {
+                  failed++;
+                  continue;
+                }
+                block[b].coordinates[0] = block_coordinates[3 * b + 0];
+                block[b].coordinates[1] = block_coordinates[3 * b + 1];
+                block[b].coordinates[2] = block_coordinates[3 * b + 2];
+                block[b].compute_XYZ(reproject_quantizer);
+                laspipeline.write_point(&block[b]);
+              }
+              count = 0;
+            }
+          }
+          if (failed)
+          {
+            LASMessage(LAS_WARNING, "skipped %lld points that could not be reprojected", failed);
+          }
+          delete[] block;
+          delete[] block_coordinates;
+          if (point)
+          {
+            delete point;
+            point = 0;
+          }
+        }
+        else if (point) // full rewrite: point copy
         {
-          while (lasreader->read_point())
+          while ((read = laspipeline.read_point()))
           {
-            if (lasreader->p_cnt > subsequence_stop) break;
+            if (laspipeline.p_cnt > subsequence_stop) break;
 
             if (clip_to_bounding_box)
             {
-              if (!lasreader->point.inside_box(lasreader->header.min_x, lasreader->header.min_y, lasreader->header.min_z, lasreader->header.max_x, lasreader->header.max_y, lasreader->header.max_z))
+              if (!read->inside_box(lasreader->header.min_x, lasreader->header.min_y, lasreader->header.min_z, lasreader->header.max_x, lasreader->header.max_y, lasreader->header.max_z))
               {
                 continue;
               }
             }
 
-            if (reproject_quantizer)
-            {
-              lasreader->point.compute_coordinates();
-              geoprojectionconverter.to_target(lasreader->point.coordinates);
-              lasreader->point.compute_XYZ(reproject_quantizer);
-            }
-            *point = lasreader->point;
-            laswriter->write_point(point);
-            // without extra pass we need inventory of surviving points
-            if (!extra_pass) laswriter->update_inventory(point);
+            *point = *read;
+            laspipeline.write_point(point);
           }
           delete point;
           point = 0;
         }
         else // direct copy from source point to target point
         {
-          while (lasreader->read_point())
+          while ((read = laspipeline.read_point()))
           {
-            if (lasreader->p_cnt > subsequence_stop) break;
+            if (laspipeline.p_cnt > subsequence_stop) break;
 
             if (clip_to_bounding_box)
             {
-              if (!lasreader->point.inside_box(lasreader->header.min_x, lasreader->header.min_y, lasreader->header.min_z, lasreader->header.max_x, lasreader->header.max_y, lasreader->header.max_z))
+              if (!read->inside_box(lasreader->header.min_x, lasreader->header.min_y, lasreader->header.min_z, lasreader->header.max_x, lasreader->header.max_y, lasreader->header.max_z))
               {
                 continue;
               }
             }
 
-            if (reproject_quantizer)
-            {
-              lasreader->point.compute_coordinates();
-              geoprojectionconverter.to_target(lasreader->point.coordinates);
-              lasreader->point.compute_XYZ(reproject_quantizer);
-            }
-            laswriter->write_point(&lasreader->point);
-            // without extra pass we need inventory of surviving points
-            if (!extra_pass) laswriter->update_inventory(&lasreader->point);
+            laspipeline.write_point(read);
           }
         }
+        if (!laspipeline.close())
+        {
+          laserror("writing points failed");
+        }
 
         // without the extra pass we need to fix the header now
         if (!extra_pass)
         {
-          laswriter->update_header(&lasreader->header, TRUE);
+          // points of copied chunks are not in the inventory but they are all in the header already
+          if ((copied_points == 0) || lasreadopener.get_transform()) laswriter->update_header(&lasreader->header, TRUE);
           LASMessage(LAS_VERBOSE, "total time: %g sec. written %u surviving points to '%s'.", taketime() - start_time, (U32)laswriter->p_count, laswriteopener.get_file_name());
         }
         else
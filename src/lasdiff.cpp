@@ -26,6 +26,7 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- option '-cores' compares chunk-aligned segments in parallel
     4 November 2019 -- new option '-idir' takes two input directories and compares
     7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
     13 July 2017 -- added missing checks for LAS 1.4 EVLR size and payloads
@@ -48,6 +49,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include "lastool.hpp"
 
 class LasTool_lasdiff : public LasTool
@@ -63,6 +69,7 @@ public:
     fprintf(stderr, "lasdiff lidar1.txt lidar2.txt -iparse xyzti\n");
     fprintf(stderr, "lasdiff lidar1.las lidar1.laz\n");
     fprintf(stderr, "lasdiff lidar1.las lidar1.laz -random_seeks\n");
+    fprintf(stderr, "lasdiff lidar1.laz lidar2.laz -cores 8\n");
     fprintf(stderr, "lasdiff -i lidar1.las -i lidar2.las -o diff.las\n");
     fprintf(stderr, "lasdiff -wildcards folder1 folder2\n");
     fprintf(stderr, "lasdiff -h\n");
@@ -444,15 +451,482 @@ static int check_header(LASreader* lasreader1, LASreader* lasreader2)
 static int shutup = 5;
 static int different_scaled_offset_coordinates;
 
-static int check_points(const CHAR* file_name1, LASreader* lasreader1, const CHAR* file_name2, LASreader* lasreader2, LASwriter* laswriter, I32 random_seeks)
+// raw comparison of everything that check_point() looks at. only points that
+// fail this need to be compared (and reported) field by field.
+
+static inline bool points_identical(const LASpoint* point1, const LASpoint* point2)
+{
+  // X, Y, Z, intensity, flags, classification, scan angle, user data, point source ID and LAS 1.4 fields
+  if (memcmp((const void*)point1, (const void*)point2, 26)) return false;
+  if (point1->have_gps_time || point2->have_gps_time)
+  {
+    if (memcmp((const void*)&(point1->gps_time), (const void*)&(point2->gps_time), sizeof(F64))) return false;
+  }
+  if (point1->have_rgb || point2->have_rgb)
+  {
+    if (memcmp((const void*)point1->rgb, (const void*)point2->rgb, sizeof(U16[4]))) return false;
+  }
+  if (point1->have_wavepacket || point2->have_wavepacket)
+  {
+    if (memcmp((const void*)&(point1->wavepacket), (const void*)&(point2->wavepacket), sizeof(LASwavepacket))) return false;
+  }
+  if (point1->extra_bytes_number != point2->extra_bytes_number) return false;
+  if (point1->extra_bytes_number)
+  {
+    if (memcmp((const void*)point1->extra_bytes, (const void*)point2->extra_bytes, point1->extra_bytes_number)) return false;
+  }
+  return true;
+}
+
+// compares the current points of both readers field by field and reports the
+// differences if 'report' is set. returns true if the points are different.
+
+static bool check_point(LASreader* lasreader1, LASreader* lasreader2, bool report, double* max_diff)
+{
+  bool difference = false;
+  double diff;
+
+  if (memcmp((const void*)&(lasreader1->point), (const void*)&(lasreader2->point), 20))
+  {
+    if (scaled_offset_difference)
+    {
+      if (lasreader1->get_x() != lasreader2->get_x())
+      {
+        diff = lasreader1->get_x() - lasreader2->get_x();
+        if (diff < 0) diff = -diff;
+        if (diff > max_diff[0]) max_diff[0] = diff;
+        if (different_scaled_offset_coordinates < 9) fprintf(stderr, "  x: %d %d scaled offset x %g %g\n", lasreader1->point.get_X(), lasreader2->point.get_X(), lasreader1->get_x(), lasreader2->get_x());
+        different_scaled_offset_coordinates++;
+      }
+      if (lasreader1->get_y() != lasreader2->get_y())
+      {
+        diff = lasreader1->get_y() - lasreader2->get_y();
+        if (diff < 0) diff = -diff;
+        if (diff > max_diff[1]) max_diff[1] = diff;
+        if (different_scaled_offset_coordinates < 9) fprintf(stderr, "  y: %d %d scaled offset y %g %g\n", lasreader1->point.get_Y(), lasreader2->point.get_Y(), lasreader1->get_y(), lasreader2->get_y());
+        different_scaled_offset_coordinates++;
+      }
+      if (lasreader1->get_z() != lasreader2->get_z())
+      {
+        diff = lasreader1->get_z() - lasreader2->get_z();
+        if (diff < 0) diff = -diff;
+        if (diff > max_diff[2])
+        {
+          max_diff[2] = diff;
+          if (max_diff[2] > 0.001)
+          {
+            max_diff[2] = diff;
+          }
+        }
+        if (different_scaled_offset_coordinates < 9) fprintf(stderr, "  z: %d %d scaled offset z %g %g\n", lasreader1->point.get_Z(), lasreader2->point.get_Z(), lasreader1->get_z(), lasreader2->get_z());
+        different_scaled_offset_coordinates++;
+      }
+    }
+    else
+    {
+      if (lasreader1->point.get_X() != lasreader2->point.get_X())
+      {
+        if (report) fprintf(stderr, "  x: %d %d\n", lasreader1->point.get_X(), lasreader2->point.get_X());
+        difference = true;
+      }
+      if (lasreader1->point.get_Y() != lasreader2->point.get_Y())
+      {
+        if (report) fprintf(stderr, "  y: %d %d\n", lasreader1->point.get_Y(), lasreader2->point.get_Y());
+        difference = true;
+      }
+      if (lasreader1->point.get_Z() != lasreader2->point.get_Z())
+      {
+        if (report) fprintf(stderr, "  z: %d %d\n", lasreader1->point.get_Z(), lasreader2->point.get_Z());
+        difference = true;
+      }
+    }
+    if (lasreader1->point.intensity != lasreader2->point.intensity)
+    {
+      if (report) fprintf(stderr, "  intensity: %d %d\n", lasreader1->point.intensity, lasreader2->point.intensity);
+      difference = true;
+    }
+    if (lasreader1->point.return_number != lasreader2->point.return_number)
+    {
+      if (report) fprintf(stderr, "  return_number: %d %d\n", lasreader1->point.return_number, lasreader2->point.return_number);
+      difference = true;
+    }
+    if (lasreader1->point.number_of_returns != lasreader2->point.number_of_returns)
+    {
+      if (report) fprintf(stderr, "  number_of_returns: %d %d\n", lasreader1->point.number_of_returns, lasreader2->point.number_of_returns);
+      difference = true;
+    }
+    if (lasreader1->point.scan_direction_flag != lasreader2->point.scan_direction_flag)
+    {
+      if (report) fprintf(stderr, "  scan_direction_flag: %d %d\n", lasreader1->point.scan_direction_flag, lasreader2->point.scan_direction_flag);
+      difference = true;
+    }
+    if (lasreader1->point.edge_of_flight_line != lasreader2->point.edge_of_flight_line)
+    {
+      if (report) fprintf(stderr, "  edge_of_flight_line: %d %d\n", lasreader1->point.edge_of_flight_line, lasreader2->point.edge_of_flight_line);
+      difference = true;
+    }
+    if (lasreader1->point.get_classification() != lasreader2->point.get_classification())
+    {
+      if (report) fprintf(stderr, "  classification: %d %d\n", lasreader1->point.get_classification(), lasreader2->point.get_classification());
+      difference = true;
+    }
+    if (lasreader1->point.get_synthetic_flag() != lasreader2->point.get_synthetic_flag())
+    {
+      if (report) fprintf(stderr, "  synthetic_flag: %d %d\n", lasreader1->point.get_synthetic_flag(), lasreader2->point.get_synthetic_flag());
+      difference = true;
+    }
+    if (lasreader1->point.get_keypoint_flag() != lasreader2->point.get_keypoint_flag())
+    {
+      if (report) fprintf(stderr, "  keypoint_flag: %d %d\n", lasreader1->point.get_keypoint_flag(), lasreader2->point.get_keypoint_flag());
+      difference = true;
+    }
+    if (lasreader1->point.get_withheld_flag() != lasreader2->point.get_withheld_flag())
+    {
+      if (report) fprintf(stderr, "  withheld_flag: %d %d\n", lasreader1->point.get_withheld_flag(), lasreader2->point.get_withheld_flag());
+      difference = true;
+    }
+    if (lasreader1->point.get_scan_angle() != lasreader2->point.get_scan_angle())
+    {
+      if (report)
+        fprintf(stderr, "  scan_angle_rank: %s %s\n", lasreader1->point.get_scan_angle_string().c_str(), lasreader2->point.get_scan_angle_string().c_str());
+      difference = true;
+    }
+    if (lasreader1->point.user_data != lasreader2->point.user_data)
+    {
+      if (report) fprintf(stderr, "  user_data: %d %d\n", lasreader1->point.user_data, lasreader2->point.user_data);
+      difference = true;
+    }
+    if (lasreader1->point.point_source_ID != lasreader2->point.point_source_ID)
+    {
+      if (report) fprintf(stderr, "  point_source_ID: %d %d\n", lasreader1->point.point_source_ID, lasreader2->point.point_source_ID);
+      difference = true;
+    }
+    if (difference) if (report) fprintf(stderr, "point %u of %u is different\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints);
+  }
+  if (lasreader1->point.have_gps_time || lasreader2->point.have_gps_time)
+  {
+    if (lasreader1->point.gps_time != lasreader2->point.gps_time)
+    {
+      if (report) fprintf(stderr, "gps time of point %u of %u is different: %f != %f\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.gps_time, lasreader2->point.gps_time);
+      difference = true;
+    }
+  }
+  if (lasreader1->point.have_rgb || lasreader2->point.have_rgb)
+  {
+    if (lasreader1->point.have_nir || lasreader2->point.have_nir)
+    {
+      if (memcmp((const void*)&(lasreader1->point.rgb), (const void*)&(lasreader2->point.rgb), sizeof(short[4])))
+      {
+        if (report) fprintf(stderr, "RGBI of point %u of %u is different: (%d %d %d %d) != (%d %d %d %d)\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.rgb[0], lasreader1->point.rgb[1], lasreader1->point.rgb[2], lasreader1->point.rgb[3], lasreader2->point.rgb[0], lasreader2->point.rgb[1], lasreader2->point.rgb[2], lasreader2->point.rgb[3]);
+        difference = true;
+      }
+    }
+    else
+    {
+      if (memcmp((const void*)&(lasreader1->point.rgb), (const void*)&(lasreader2->point.rgb), sizeof(short[3])))
+      {
+        if (report) fprintf(stderr, "RGB of point %u of %u is different: (%d %d %d) != (%d %d %d)\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.rgb[0], lasreader1->point.rgb[1], lasreader1->point.rgb[2], lasreader2->point.rgb[0], lasreader2->point.rgb[1], lasreader2->point.rgb[2]);
+        difference = true;
+      }
+    }
+  }
+  if (lasreader1->point.have_wavepacket || lasreader2->point.have_wavepacket)
+  {
+    if (memcmp((const void*)&(lasreader1->point.wavepacket), (const void*)&(lasreader2->point.wavepacket), sizeof(LASwavepacket)))
+    {
+      if (report) fprintf(stderr, "wavepacket of point %u of %u is different: (%d %d %d %g %g %g %g) != (%d %d %d %g %g %g %g)\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.wavepacket.getIndex(), (I32)lasreader1->point.wavepacket.getOffset(), lasreader1->point.wavepacket.getSize(), lasreader1->point.wavepacket.getLocation(), lasreader1->point.wavepacket.getXt(), lasreader1->point.wavepacket.getYt(), lasreader1->point.wavepacket.getZt(), lasreader2->point.wavepacket.getIndex(), (I32)lasreader2->point.wavepacket.getOffset(), lasreader2->point.wavepacket.getSize(), lasreader2->point.wavepacket.getLocation(), lasreader2->point.wavepacket.getXt(), lasreader2->point.wavepacket.getYt(), lasreader2->point.wavepacket.getZt());
+      difference = true;
+    }
+  }
+  if (lasreader1->point.extra_bytes_number)
+  {
+    if (memcmp((const void*)lasreader1->point.extra_bytes, (const void*)lasreader2->point.extra_bytes, lasreader1->point.extra_bytes_number))
+    {
+      if (report)
+      {
+        if (lasreader1->point.extra_bytes_number == 1)
+        {
+          fprintf(stderr, "%d extra_byte of point %u of %u are different: %d != %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader2->point.extra_bytes[0]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 2)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d != %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 3)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d != %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 4)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d != %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 5)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d != %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 6)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d != %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 7)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d != %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 8)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 9)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 10)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 11)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 12)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 13)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 14)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 15)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 16)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader1->point.extra_bytes[15], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14], lasreader2->point.extra_bytes[15]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 17)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader1->point.extra_bytes[15], lasreader1->point.extra_bytes[16], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14], lasreader2->point.extra_bytes[15], lasreader2->point.extra_bytes[16]);
+        }
+        else
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d ... != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d ...\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader1->point.extra_bytes[15], lasreader1->point.extra_bytes[16], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14], lasreader2->point.extra_bytes[15], lasreader2->point.extra_bytes[16]);
+        }
+      }
+      difference = true;
+    }
+  }
+  else if (lasreader2->point.extra_bytes_number)
+  {
+    if (memcmp((const void*)lasreader1->point.extra_bytes, (const void*)lasreader2->point.extra_bytes, lasreader2->point.extra_bytes_number))
+    {
+      if (report)
+      {
+        if (lasreader1->point.extra_bytes_number == 1)
+        {
+          fprintf(stderr, "%d extra_byte of point %u of %u are different: %d != %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader2->point.extra_bytes[0]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 2)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d != %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 3)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d != %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 4)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d != %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 5)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d != %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 6)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d != %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 7)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d != %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6]);
+        }
+        else
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7]);
+        }
+      }
+      difference = true;
+    }
+  }
+  if (lasreader1->point.extended_point_type || lasreader2->point.extended_point_type )
+  {
+    if (lasreader1->point.extended_scan_angle != lasreader2->point.extended_scan_angle)
+    {
+      if (report) fprintf(stderr, "  extended_scan_angle: %s %s (point index %u)\n", lasreader1->point.get_scan_angle_string().c_str(), lasreader2->point.get_scan_angle_string().c_str(), (U32)(lasreader1->p_idx-1));
+      difference = true;
+    }
+    if (lasreader1->point.extended_scanner_channel != lasreader2->point.extended_scanner_channel)
+    {
+      if (report) fprintf(stderr, "  extended_scanner_channel: %d %d\n", lasreader1->point.extended_scanner_channel, lasreader2->point.extended_scanner_channel);
+      difference = true;
+    }
+    if (lasreader1->point.extended_classification_flags != lasreader2->point.extended_classification_flags)
+    {
+      if (report) fprintf(stderr, "  extended_classification_flags: %d %d\n", lasreader1->point.extended_classification_flags, lasreader2->point.extended_classification_flags);
+      difference = true;
+    }
+    if (lasreader1->point.extended_classification != lasreader2->point.extended_classification)
+    {
+      if (report) fprintf(stderr, "  extended_classification: %d %d\n", lasreader1->point.extended_classification, lasreader2->point.extended_classification);
+      difference = true;
+    }
+    if (lasreader1->point.extended_return_number != lasreader2->point.extended_return_number)
+    {
+      if (report) fprintf(stderr, "  extended_return_number: %d %d\n", lasreader1->point.extended_return_number, lasreader2->point.extended_return_number);
+      difference = true;
+    }
+    if (lasreader1->point.extended_number_of_returns != lasreader2->point.extended_number_of_returns)
+    {
+      if (report) fprintf(stderr, "  extended_number_of_returns: %d %d\n", lasreader1->point.extended_number_of_returns, lasreader2->point.extended_number_of_returns);
+      difference = true;
+    }
+  }
+  return difference;
+}
+
+// compares both files in segments of whole chunks on several threads. each
+// thread opens its own readers and only counts differences and remembers the
+// first few of them. those are then reported with check_point() in order.
+
+static bool check_points_parallel(const CHAR* file_name1, LASreader* lasreader1, const CHAR* file_name2, LASreader* lasreader2, I32 threads, int* different)
+{
+  I64 npoints = lasreader1->npoints;
+  I64 chunk_size = 50000;
+  if (lasreader1->header.laszip && (lasreader1->header.laszip->chunk_size != U32_MAX))
+  {
+    chunk_size = lasreader1->header.laszip->chunk_size;
+  }
+  I64 segment_size = ((npoints / ((I64)threads * 8)) / chunk_size + 1) * chunk_size;
+
+  std::atomic<I64> next_start(0);
+  std::mutex mutex;
+  std::vector<I64> indices;
+  int different_points = 0;
+  bool failed = false;
+
+  auto worker = [&]()
+  {
+    LASreadOpener lasreadopener1;
+    LASreadOpener lasreadopener2;
+    lasreadopener1.set_file_name(file_name1);
+    lasreadopener2.set_file_name(file_name2);
+    LASreader* reader1 = lasreadopener1.open();
+    LASreader* reader2 = lasreadopener2.open();
+    std::vector<I64> local_indices;
+    int local_different_points = 0;
+    bool local_failed = (reader1 == 0) || (reader2 == 0);
+    double max_diff[3] = { 0.0, 0.0, 0.0 };
+
+    while (!local_failed)
+    {
+      I64 start = next_start.fetch_add(segment_size);
+      if (start >= npoints) break;
+      I64 end = std::min(start + segment_size, npoints);
+      if (!reader1->seek(start) || !reader2->seek(start))
+      {
+        local_failed = true;
+        break;
+      }
+      for (I64 p = start; p < end; p++)
+      {
+        if (!reader1->read_point() || !reader2->read_point())
+        {
+          local_failed = true;
+          break;
+        }
+        if (!points_identical(&reader1->point, &reader2->point) && check_point(reader1, reader2, false, max_diff))
+        {
+          if (local_different_points < shutup) local_indices.push_back(p);
+          local_different_points++;
+        }
+      }
+    }
+
+    if (reader1) { reader1->close(); delete reader1; }
+    if (reader2) { reader2->close(); delete reader2; }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    different_points += local_different_points;
+    indices.insert(indices.end(), local_indices.begin(), local_indices.end());
+    if (local_failed) failed = true;
+  };
+
+  std::vector<std::thread> workers;
+  for (I32 t = 0; t < threads; t++) workers.push_back(std::thread(worker));
+  for (I32 t = 0; t < threads; t++) workers[t].join();
+
+  if (failed)
+  {
+    return false;
+  }
+
+  // report the first differences in point order as the sequential check does
+
+  std::sort(indices.begin(), indices.end());
+  double max_diff[3] = { 0.0, 0.0, 0.0 };
+  for (size_t j = 0; (j < indices.size()) && ((int)j < shutup); j++)
+  {
+    lasreader1->seek(indices[j]);
+    lasreader2->seek(indices[j]);
+    lasreader1->read_point();
+    lasreader2->read_point();
+    check_point(lasreader1, lasreader2, true, max_diff);
+  }
+  if (different_points >= shutup) fprintf(stderr, "already %d points are different ... shutting up.\n", shutup);
+
+  if (different_points)
+  {
+    fprintf(stderr, "%u points are different.\n", different_points);
+  }
+  else
+  {
+    fprintf(stderr, "raw points are identical.\n");
+  }
+
+  lasreader1->p_idx = npoints;
+  lasreader2->p_idx = npoints;
+  *different = different_points;
+  return true;
+}
+
+static int check_points(const CHAR* file_name1, LASreader* lasreader1, const CHAR* file_name2, LASreader* lasreader2, LASwriter* laswriter, I32 random_seeks, I32 threads)
 {
   int seeking = random_seeks;
 
+  // the parallel check needs two seekable LAS/LAZ files with the same number of points
+
+  if ((threads > 1) && (laswriter == 0) && (random_seeks == 0) && !scaled_offset_difference && (lasreader1->npoints == lasreader2->npoints))
+  {
+    if (IsLasLazFile(file_name1) && IsLasLazFile(file_name2) && !lasreader1->get_filter() && !lasreader1->get_transform())
+    {
+      int different_points = 0;
+      if (check_points_parallel(file_name1, lasreader1, file_name2, lasreader2, threads, &different_points))
+      {
+        different_scaled_offset_coordinates = 0;
+        return different_points;
+      }
+      LASMessage(LAS_WARNING, "parallel check failed. checking sequentially ...");
+      lasreader1->seek(0);
+      lasreader2->seek(0);
+    }
+  }
+
   int different_points = 0;
-  double diff;
-  double max_diff_x = 0.0;
-  double max_diff_y = 0.0;
-  double max_diff_z = 0.0;
+  double max_diff[3] = { 0.0, 0.0, 0.0 };
 
   different_scaled_offset_coordinates = 0;
 
@@ -463,7 +937,7 @@ static int check_points(const CHAR* file_name1, LASreader* lasreader1, const CHA
     {
       if (lasreader1->p_idx%100000 == 25000)
       {
-        I64 s = (rand()*rand())%lasreader1->npoints;
+        I64 s = (((I64)rand())*((I64)rand()))%lasreader1->npoints;
         fprintf(stderr, "at p_idx %u seeking to %u\n", (U32)lasreader1->p_idx, (U32)s);
         lasreader1->seek(s);
         lasreader2->seek(s);
@@ -474,314 +948,9 @@ static int check_points(const CHAR* file_name1, LASreader* lasreader1, const CHA
     {
       if (lasreader2->read_point())
       {
-        if (memcmp((const void*)&(lasreader1->point), (const void*)&(lasreader2->point), 20))
+        if (!points_identical(&lasreader1->point, &lasreader2->point))
         {
-          if (scaled_offset_difference)
-          {
-            if (lasreader1->get_x() != lasreader2->get_x())
-            {
-              diff = lasreader1->get_x() - lasreader2->get_x();
-              if (diff < 0) diff = -diff;
-              if (diff > max_diff_x) max_diff_x = diff;
-              if (different_scaled_offset_coordinates < 9) fprintf(stderr, "  x: %d %d scaled offset x %g %g\n", lasreader1->point.get_X(), lasreader2->point.get_X(), lasreader1->get_x(), lasreader2->get_x());
-              different_scaled_offset_coordinates++;
-            }
-            if (lasreader1->get_y() != lasreader2->get_y())
-            {
-              diff = lasreader1->get_y() - lasreader2->get_y();
-              if (diff < 0) diff = -diff;
-              if (diff > max_diff_y) max_diff_y = diff;
-              if (different_scaled_offset_coordinates < 9) fprintf(stderr, "  y: %d %d scaled offset y %g %g\n", lasreader1->point.get_Y(), lasreader2->point.get_Y(), lasreader1->get_y(), lasreader2->get_y());
-              different_scaled_offset_coordinates++;
-            }
-            if (lasreader1->get_z() != lasreader2->get_z())
-            {
-              diff = lasreader1->get_z() - lasreader2->get_z();
-              if (diff < 0) diff = -diff;
-              if (diff > max_diff_z)
-              {
-                max_diff_z = diff;
-                if (max_diff_z > 0.001)
-                {
-                  max_diff_z = diff;
-                }
-              }
-              if (different_scaled_offset_coordinates < 9) fprintf(stderr, "  z: %d %d scaled offset z %g %g\n", lasreader1->point.get_Z(), lasreader2->point.get_Z(), lasreader1->get_z(), lasreader2->get_z());
-              different_scaled_offset_coordinates++;
-            }
-          }
-          else
-          {
-            if (lasreader1->point.get_X() != lasreader2->point.get_X())
-            {
-              if (different_points < shutup) fprintf(stderr, "  x: %d %d\n", lasreader1->point.get_X(), lasreader2->point.get_X());
-              difference = true;
-            }
-            if (lasreader1->point.get_Y() != lasreader2->point.get_Y())
-            {
-              if (different_points < shutup) fprintf(stderr, "  y: %d %d\n", lasreader1->point.get_Y(), lasreader2->point.get_Y());
-              difference = true;
-            }
-            if (lasreader1->point.get_Z() != lasreader2->point.get_Z())
-            {
-              if (different_points < shutup) fprintf(stderr, "  z: %d %d\n", lasreader1->point.get_Z(), lasreader2->point.get_Z());
-              difference = true;
-            }
-          }
-          if (lasreader1->point.intensity != lasreader2->point.intensity)
-          {
-            if (different_points < shutup) fprintf(stderr, "  intensity: %d %d\n", lasreader1->point.intensity, lasreader2->point.intensity);
-            difference = true;
-          }
-          if (lasreader1->point.return_number != lasreader2->point.return_number)
-          {
-            if (different_points < shutup) fprintf(stderr, "  return_number: %d %d\n", lasreader1->point.return_number, lasreader2->point.return_number);
-            difference = true;
-          }
-          if (lasreader1->point.number_of_returns != lasreader2->point.number_of_returns)
-          {
-            if (different_points < shutup) fprintf(stderr, "  number_of_returns: %d %d\n", lasreader1->point.number_of_returns, lasreader2->point.number_of_returns);
-            difference = true;
-          }
-          if (lasreader1->point.scan_direction_flag != lasreader2->point.scan_direction_flag)
-          {
-            if (different_points < shutup) fprintf(stderr, "  scan_direction_flag: %d %d\n", lasreader1->point.scan_direction_flag, lasreader2->point.scan_direction_flag);
-            difference = true;
-          }
-          if (lasreader1->point.edge_of_flight_line != lasreader2->point.edge_of_flight_line)
-          {
-            if (different_points < shutup) fprintf(stderr, "  edge_of_flight_line: %d %d\n", lasreader1->point.edge_of_flight_line, lasreader2->point.edge_of_flight_line);
-            difference = true;
-          }
-          if (lasreader1->point.get_classification() != lasreader2->point.get_classification())
-          {
-            if (different_points < shutup) fprintf(stderr, "  classification: %d %d\n", lasreader1->point.get_classification(), lasreader2->point.get_classification());
-            difference = true;
-          }
-          if (lasreader1->point.get_synthetic_flag() != lasreader2->point.get_synthetic_flag())
-          {
-            if (different_points < shutup) fprintf(stderr, "  synthetic_flag: %d %d\n", lasreader1->point.get_synthetic_flag(), lasreader2->point.get_synthetic_flag());
-            difference = true;
-          }
-          if (lasreader1->point.get_keypoint_flag() != lasreader2->point.get_keypoint_flag())
-          {
-            if (different_points < shutup) fprintf(stderr, "  keypoint_flag: %d %d\n", lasreader1->point.get_keypoint_flag(), lasreader2->point.get_keypoint_flag());
-            difference = true;
-          }
-          if (lasreader1->point.get_withheld_flag() != lasreader2->point.get_withheld_flag())
-          {
-            if (different_points < shutup) fprintf(stderr, "  withheld_flag: %d %d\n", lasreader1->point.get_withheld_flag(), lasreader2->point.get_withheld_flag());
-            difference = true;
-          }
-          if (lasreader1->point.get_scan_angle() != lasreader2->point.get_scan_angle())
-          {
-            if (different_points < shutup)
-              fprintf(stderr, "  scan_angle_rank: %s %s\n", lasreader1->point.get_scan_angle_string().c_str(), lasreader2->point.get_scan_angle_string().c_str());
-            difference = true;
-          }
-          if (lasreader1->point.user_data != lasreader2->point.user_data)
-          {
-            if (different_points < shutup) fprintf(stderr, "  user_data: %d %d\n", lasreader1->point.user_data, lasreader2->point.user_data);
-            difference = true;
-          }
-          if (lasreader1->point.point_source_ID != lasreader2->point.point_source_ID)
-          {
-            if (different_points < shutup) fprintf(stderr, "  point_source_ID: %d %d\n", lasreader1->point.point_source_ID, lasreader2->point.point_source_ID);
-            difference = true;
-          }
-          if (difference) if (different_points < shutup) fprintf(stderr, "point %u of %u is different\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints);
-        }
-        if (lasreader1->point.have_gps_time || lasreader2->point.have_gps_time)
-        {
-          if (lasreader1->point.gps_time != lasreader2->point.gps_time)
-          {
-            if (different_points < shutup) fprintf(stderr, "gps time of point %u of %u is different: %f != %f\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.gps_time, lasreader2->point.gps_time);
-            difference = true;
-          }
-        }
-        if (lasreader1->point.have_rgb || lasreader2->point.have_rgb)
-        {
-          if (lasreader1->point.have_nir || lasreader2->point.have_nir)
-          {
-            if (memcmp((const void*)&(lasreader1->point.rgb), (const void*)&(lasreader2->point.rgb), sizeof(short[4])))
-            {
-              if (different_points < shutup) fprintf(stderr, "RGBI of point %u of %u is different: (%d %d %d %d) != (%d %d %d %d)\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.rgb[0], lasreader1->point.rgb[1], lasreader1->point.rgb[2], lasreader1->point.rgb[3], lasreader2->point.rgb[0], lasreader2->point.rgb[1], lasreader2->point.rgb[2], lasreader2->point.rgb[3]);
-              difference = true;
-            }
-          }
-          else
-          {
-            if (memcmp((const void*)&(lasreader1->point.rgb), (const void*)&(lasreader2->point.rgb), sizeof(short[3])))
-            {
-              if (different_points < shutup) fprintf(stderr, "RGB of point %u of %u is different: (%d %d %d) != (%d %d %d)\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.rgb[0], lasreader1->point.rgb[1], lasreader1->point.rgb[2], lasreader2->point.rgb[0], lasreader2->point.rgb[1], lasreader2->point.rgb[2]);
-              difference = true;
-            }
-          }
-        }
-        if (lasreader1->point.have_wavepacket || lasreader2->point.have_wavepacket)
-        {
-          if (memcmp((const void*)&(lasreader1->point.wavepacket), (const void*)&(lasreader2->point.wavepacket), sizeof(LASwavepacket)))
-          {
-            if (different_points < shutup) fprintf(stderr, "wavepacket of point %u of %u is different: (%d %d %d %g %g %g %g) != (%d %d %d %g %g %g %g)\n", (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.wavepacket.getIndex(), (I32)lasreader1->point.wavepacket.getOffset(), lasreader1->point.wavepacket.getSize(), lasreader1->point.wavepacket.getLocation(), lasreader1->point.wavepacket.getXt(), lasreader1->point.wavepacket.getYt(), lasreader1->point.wavepacket.getZt(), lasreader2->point.wavepacket.getIndex(), (I32)lasreader2->point.wavepacket.getOffset(), lasreader2->point.wavepacket.getSize(), lasreader2->point.wavepacket.getLocation(), lasreader2->point.wavepacket.getXt(), lasreader2->point.wavepacket.getYt(), lasreader2->point.wavepacket.getZt());
-            difference = true;
-          }
-        }
-        if (lasreader1->point.extra_bytes_number)
-        {
-          if (memcmp((const void*)lasreader1->point.extra_bytes, (const void*)lasreader2->point.extra_bytes, lasreader1->point.extra_bytes_number))
-          {
-            if (different_points < shutup)
-            {
-              if (lasreader1->point.extra_bytes_number == 1)
-              {
-                fprintf(stderr, "%d extra_byte of point %u of %u are different: %d != %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader2->point.extra_bytes[0]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 2)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d != %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 3)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d != %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 4)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d != %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 5)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d != %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 6)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d != %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 7)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d != %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 8)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 9)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 10)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 11)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 12)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 13)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 14)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 15)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 16)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader1->point.extra_bytes[15], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14], lasreader2->point.extra_bytes[15]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 17)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader1->point.extra_bytes[15], lasreader1->point.extra_bytes[16], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14], lasreader2->point.extra_bytes[15], lasreader2->point.extra_bytes[16]);
-              }
-              else
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d ... != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d ...\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader1->point.extra_bytes[15], lasreader1->point.extra_bytes[16], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14], lasreader2->point.extra_bytes[15], lasreader2->point.extra_bytes[16]);
-              }
-            }
-            difference = true;
-          }
-        }
-        else if (lasreader2->point.extra_bytes_number)
-        {
-          if (memcmp((const void*)lasreader1->point.extra_bytes, (const void*)lasreader2->point.extra_bytes, lasreader2->point.extra_bytes_number))
-          {
-            if (different_points < shutup)
-            {
-              if (lasreader1->point.extra_bytes_number == 1)
-              {
-                fprintf(stderr, "%d extra_byte of point %u of %u are different: %d != %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader2->point.extra_bytes[0]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 2)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d != %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 3)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d != %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 4)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d != %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 5)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d != %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 6)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d != %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 7)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d != %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6]);
-              }
-              else
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_idx, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7]);
-              }
-            }
-            difference = true;
-          }
-        }
-        if (lasreader1->point.extended_point_type || lasreader2->point.extended_point_type )
-        {
-          if (lasreader1->point.extended_scan_angle != lasreader2->point.extended_scan_angle)
-          {
-            if (different_points < shutup) fprintf(stderr, "  extended_scan_angle: %s %s (point index %u)\n", lasreader1->point.get_scan_angle_string().c_str(), lasreader2->point.get_scan_angle_string().c_str(), (U32)(lasreader1->p_idx-1));
-            difference = true;
-          }
-          if (lasreader1->point.extended_scanner_channel != lasreader2->point.extended_scanner_channel)
-          {
-            if (different_points < shutup) fprintf(stderr, "  extended_scanner_channel: %d %d\n", lasreader1->point.extended_scanner_channel, lasreader2->point.extended_scanner_channel);
-            difference = true;
-          }
-          if (lasreader1->point.extended_classification_flags != lasreader2->point.extended_classification_flags)
-          {
-            if (different_points < shutup) fprintf(stderr, "  extended_classification_flags: %d %d\n", lasreader1->point.extended_classification_flags, lasreader2->point.extended_classification_flags);
-            difference = true;
-          }
-          if (lasreader1->point.extended_classification != lasreader2->point.extended_classification)
-          {
-            if (different_points < shutup) fprintf(stderr, "  extended_classification: %d %d\n", lasreader1->point.extended_classification, lasreader2->point.extended_classification);
-            difference = true;
-          }
-          if (lasreader1->point.extended_return_number != lasreader2->point.extended_return_number)
-          {
-            if (different_points < shutup) fprintf(stderr, "  extended_return_number: %d %d\n", lasreader1->point.extended_return_number, lasreader2->point.extended_return_number);
-            difference = true;
-          }
-          if (lasreader1->point.extended_number_of_returns != lasreader2->point.extended_number_of_returns)
-          {
-            if (different_points < shutup) fprintf(stderr, "  extended_number_of_returns: %d %d\n", lasreader1->point.extended_number_of_returns, lasreader2->point.extended_number_of_returns);
-            difference = true;
-          }
+          difference = check_point(lasreader1, lasreader2, (different_points < shutup), max_diff);
         }
       }
       else
@@ -829,7 +998,7 @@ static int check_points(const CHAR* file_name1, LASreader* lasreader1, const CHA
   {
     if (different_scaled_offset_coordinates)
     {
-      fprintf(stderr, "scaled offset points are different (max diff: %g %g %g).\n", max_diff_x, max_diff_y, max_diff_z);
+      fprintf(stderr, "scaled offset points are different (max diff: %g %g %g).\n", max_diff[0], max_diff[1], max_diff[2]);
     }
     else
     {
@@ -859,6 +1028,7 @@ int main(int argc, char *argv[])
 {
   LasTool_lasdiff lastool;
   lastool.init(argc, argv, "lasdiff");
+  lastool.cores_threads = true;
   int i;
   int random_seeks = 0;
   const CHAR* wildcard1 = 0;
@@ -928,6 +1098,9 @@ int main(int argc, char *argv[])
 
   lastool.parse(arg_local);
 
+  // the points of two files are compared on '-cores' threads
+  I32 threads = (lastool.cores > 1 ? lastool.cores : 1);
+
 #ifdef COMPILE_WITH_GUI
   if (lastool.gui)
   {
@@ -994,7 +1167,7 @@ int main(int argc, char *argv[])
 
       // check points
 
-      int different_points = check_points(file_name1, lasreader1, file_name2, lasreader2, laswriter, random_seeks);
+      int different_points = check_points(file_name1, lasreader1, file_name2, lasreader2, laswriter, random_seeks, threads);
 
       // output final verdicts
 
@@ -1113,7 +1286,7 @@ int main(int argc, char *argv[])
 
       // check points
 
-      int different_points = check_points(file_name1, lasreader1, file_name2, lasreader2, laswriter, random_seeks);
+      int different_points = check_points(file_name1, lasreader1, file_name2, lasreader2, laswriter, random_seeks, threads);
 
       // output final verdicts
 
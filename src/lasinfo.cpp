@@ -30,6 +30,7 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- new option '-stats_sidecar' to answer from (or write) cached statistics
     10 June 2021 -- new option '-delete_empty' for deleting LAS files with zero points
     11 November 2020 -- new option '-set_vlr_record_id 2 4711'
     11 November 2020 -- new option '-set_vlr_user_id 1 "hello martin"'
@@ -2213,7 +2214,42 @@ class LasTool_lasinfo : public LasTool {
       F64 enlarged_max_y = lasreader->header.max_y + 0.25 * lasreader->header.y_scale_factor;
       F64 enlarged_min_z = lasreader->header.min_z - 0.25 * lasreader->header.z_scale_factor;
       F64 enlarged_max_z = lasreader->header.max_z + 0.25 * lasreader->header.z_scale_factor;
-      LASsummary lassummary;
+      LASstatistics lasstatistics;
+      LASstatistics lasstatistics_sidecar;
+      bool from_sidecar = false;
+      bool to_sidecar = false;
+
+      // maybe use (or create) a sidecar with the statistics of an earlier full read pass
+      if (laswriteopener.get_statistics_sidecar() && check_points && lasreadopener.get_file_name() && IsLasLazFile(lasreadopener.get_file_name()) &&
+          !lasreadopener.is_merged() && !lasreadopener.is_buffered() && !lasreadopener.is_inside() && !lasreader->get_filter() &&
+          !lasreader->get_transform() && (subsequence_start == 0) && (subsequence_stop == I64_MAX)) {
+        if (!compute_density && !report_outside && !lashistogram.active() && lasstatistics_sidecar.read(lasreadopener.get_file_name()) &&
+            lasstatistics_sidecar.is_compatible(&lasreader->header)) {
+          from_sidecar = true;
+          // the sidecar has no per-point information so the number of points outside must be zero
+          if (check_outside && lasstatistics_sidecar.summary.active()) {
+            const LASsummary& cached = lasstatistics_sidecar.summary;
+            if ((lasreader->header.get_x(cached.min.get_X()) < enlarged_min_x) || (lasreader->header.get_x(cached.max.get_X()) > enlarged_max_x) ||
+                (lasreader->header.get_y(cached.min.get_Y()) < enlarged_min_y) || (lasreader->header.get_y(cached.max.get_Y()) > enlarged_max_y) ||
+                (lasreader->header.get_z(cached.min.get_Z()) < enlarged_min_z) || (lasreader->header.get_z(cached.max.get_Z()) > enlarged_max_z)) {
+              from_sidecar = false;
+            }
+          }
+        }
+        if (from_sidecar) {
+          LASMessage(LAS_VERBOSE, "using statistics sidecar of '%s'", lasreadopener.get_file_name());
+        } else {
+          to_sidecar = true;
+          // chunk summaries that match the LAZ chunks unless chunks are variable
+          const LASzip* laszip = lasreader->header.laszip;
+          if (laszip && (laszip->compressor >= LASZIP_COMPRESSOR_POINTWISE_CHUNKED) && (laszip->chunk_size != U32_MAX)) {
+            lasstatistics.init(&lasreader->header, laszip->chunk_size);
+          } else {
+            lasstatistics.init(&lasreader->header);
+          }
+        }
+      }
+      LASsummary& lassummary = (from_sidecar ? lasstatistics_sidecar.summary : lasstatistics.summary);
 
       if (check_points) {
         I64 num_first_returns = 0;
@@ -2233,7 +2269,7 @@ class LasTool_lasinfo : public LasTool {
         // maybe seek to start position
         if (subsequence_start) lasreader->seek(subsequence_start);
 
-        while (lasreader->read_point()) {
+        while (!from_sidecar && lasreader->read_point()) {
           if (lasreader->p_cnt > subsequence_stop) break;
 
           if (check_outside) {
@@ -2281,26 +2317,12 @@ class LasTool_lasinfo : public LasTool {
             }
           }
 
-          lassummary.add(&lasreader->point);
+          lasstatistics.add(&lasreader->point);
 
           if (lasoccupancygrid) {
             lasoccupancygrid->add(&lasreader->point);
           }
 
-          if (lasreader->point.is_first()) {
-            num_first_returns++;
-          }
-          if (lasreader->point.is_intermediate()) {
-            num_intermediate_returns++;
-          }
-          if (lasreader->point.is_last()) {
-            num_last_returns++;
-          }
-          if (lasreader->point.is_single()) {
-            num_single_returns++;
-          }
-          num_all_returns++;
-
           if (lashistogram.active()) {
             lashistogram.add(&lasreader->point);
           }
@@ -2313,6 +2335,15 @@ class LasTool_lasinfo : public LasTool {
             }
           }
         }
+        if (to_sidecar) {
+          lasstatistics.write(lasreadopener.get_file_name());
+        }
+        const LASstatistics& statistics = (from_sidecar ? lasstatistics_sidecar : lasstatistics);
+        num_first_returns = statistics.number_of_first_returns;
+        num_intermediate_returns = statistics.number_of_intermediate_returns;
+        num_last_returns = statistics.number_of_last_returns;
+        num_single_returns = statistics.number_of_single_returns;
+        num_all_returns = statistics.number_of_all_returns;
         if (file_out && !no_min_max) {
           JsonObject json_las_point_report;
           if (json_out) {
@@ -26,6 +26,9 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- '-split' copies the compressed chunks that fit into a file as they are
+    18 October 2026 -- copies the chunks of identically compressed LAZ files as they are
+    18 October 2026 -- option '-pipeline' reads and writes on separate threads
     20 August 2014 -- new option '-keep_lastiling' to preserve the LAStiling VLR
     20 August 2014 -- copy VLRs from empty (zero points) LAS/LAZ files to others
      5 August 2011 -- possible to add/change projection info in command line
@@ -44,6 +47,8 @@
 
 #include "lasreader.hpp"
 #include "laswriter.hpp"
+#include "laswriter_las.hpp"
+#include "laspipeline.hpp"
 #include "geoprojectionconverter.hpp"
 #include "lastool.hpp"
 
@@ -57,6 +62,7 @@ public:
     fprintf(stderr, "lasmerge -i *.las -o out.las\n");
     fprintf(stderr, "lasmerge -lof lasfiles.txt -o out.las\n");
     fprintf(stderr, "lasmerge -i *.las -o out0000.laz -split 1000000000\n");
+    fprintf(stderr, "lasmerge -i *.laz -pipeline -o out.laz\n");
     fprintf(stderr, "lasmerge -i file1.las file2.las file3.las -o out.las\n");
     fprintf(stderr, "lasmerge -i file1.las file2.las -reoffset 600000 4000000 0 -olas > out.las\n");
     fprintf(stderr, "lasmerge -lof lasfiles.txt -rescale 0.01 0.01 0.01 -verbose -o out.las\n");
@@ -69,6 +75,42 @@ static double taketime()
   return (double)(clock())/CLOCKS_PER_SEC;
 }
 
+// copies the compressed chunks of the merged LAZ files into an output with
+// variable chunks. the points of chunks that cannot be copied are written one
+// by one (and added to the inventory) and chunked like they usually would be
+
+static I64 merge_compressed_chunks(LASreader* lasreader, LASwriterLAS* laswriter)
+{
+  I64 count = 0;
+  U32 written = 0;
+  const U8* bytes;
+  U32 num_bytes;
+  U32 num_points;
+  while (true)
+  {
+    if (lasreader->peek_chunk(&bytes, &num_bytes, &num_points))
+    {
+      if (!laswriter->write_chunk(bytes, num_bytes, num_points) || !lasreader->skip_chunk())
+      {
+        laserror("copying compressed chunk with %u points", num_points);
+      }
+      count += num_points;
+      written = 0;
+      continue;
+    }
+    if (!lasreader->read_point()) break;
+    laswriter->write_point(&lasreader->point);
+    laswriter->update_inventory(&lasreader->point);
+    written++;
+    if (written == LASZIP_CHUNK_SIZE_DEFAULT)
+    {
+      laswriter->chunk();
+      written = 0;
+    }
+  }
+  return count;
+}
+
 #ifdef COMPILE_WITH_GUI
 extern int lasmerge_gui(int argc, char *argv[], LASreadOpener* lasreadopener);
 #endif
@@ -84,6 +126,8 @@ int main(int argc, char *argv[])
   int i;
   bool keep_lastiling = false;
   U32 chopchop = 0;
+  bool pipeline = false;
+  bool chunk_copy = true;
   bool projection_was_set = false;
   double start_time = 0;
 
@@ -135,6 +179,14 @@ int main(int argc, char *argv[])
     {
       keep_lastiling = true;
     }
+    else if (strcmp(argv[i],"-pipeline") == 0)
+    {
+      pipeline = true;
+    }
+    else if (strcmp(argv[i],"-no_chunk_copy") == 0)
+    {
+      chunk_copy = false;
+    }
     else if ((argv[i][0] != '-') && (lasreadopener.get_file_name_number() == 0))
     {
       lasreadopener.add_file_name(argv[i]);
@@ -249,42 +301,123 @@ int main(int argc, char *argv[])
   {
     I32 file_number = 0;
     LASwriter* laswriter = 0;
-    // loop over the points
-    while (lasreader->read_point())
-    {
+    auto open_writer = [&]() {
+      // open the next writer
+      laswriteopener.make_file_name(0, file_number);
+      file_number++;
+      laswriter = laswriteopener.open(&lasreader->header);
       if (laswriter == 0)
       {
-        // open the next writer
-        laswriteopener.make_file_name(0, file_number);
-        file_number++;
-        laswriter = laswriteopener.open(&lasreader->header);
-        if (laswriter == 0)
+        laserror("could not open laswriter");
+      }
+    };
+    auto close_writer = [&]() {
+      // close the current writer
+      laswriter->update_header(&lasreader->header, TRUE);
+      laswriter->close();
+      LASMessage(LAS_VERBOSE, "splitting file '%s' took %g sec.", laswriteopener.get_file_name(), taketime()-start_time);
+      start_time = taketime();
+      delete laswriter;
+      laswriter = 0;
+    };
+    // compressed chunks of LAZ files with new LAS 1.4 points that fit entirely into the current
+    // file can be copied when the files have variable chunks. a second reader that only decodes
+    // the coordinates and the returns gives the points of copied chunks for the inventory
+    LASreader* lasinventory = 0;
+    U32 chunk_size = laswriteopener.get_chunk_size();
+    BOOL chunked = chunk_copy && lasreader->header.laszip && (lasreader->header.laszip->compressor == LASZIP_COMPRESSOR_LAYERED_CHUNKED);
+    if (chunked && (chunk_size == LASZIP_CHUNK_SIZE_DEFAULT) && (lasreadopener.get_filter() == 0) && (lasreadopener.get_transform() == 0) && !lasreadopener.is_piped() && !laswriteopener.is_piped() && !laswriteopener.get_statistics_sidecar() && !laswriteopener.get_chunk_summaries() && !laswriteopener.get_adaptive_chunking())
+    {
+      laswriteopener.set_chunk_size(0);
+      open_writer();
+      LASwriterLAS* chunk_writer = dynamic_cast<LASwriterLAS*>(laswriter);
+      if (chunk_writer && chunk_writer->can_copy_chunks(lasreader->header.laszip))
+      {
+        lasreadopener.set_decompress_selective(LASZIP_DECOMPRESS_SELECTIVE_CHANNEL_RETURNS_XY | LASZIP_DECOMPRESS_SELECTIVE_Z);
+        lasreadopener.reset();
+        lasinventory = lasreadopener.open();
+        lasreadopener.set_decompress_selective(LASZIP_DECOMPRESS_SELECTIVE_ALL);
+        if (lasinventory == 0)
         {
-          laserror("could not open laswriter");
+          laserror("could not open lasreader");
         }
       }
-      laswriter->write_point(&lasreader->point);
-      laswriter->update_inventory(&lasreader->point);
-      if (laswriter->p_count == chopchop)
+      else
       {
-        // close the current writer
-        laswriter->update_header(&lasreader->header, TRUE);
+        // start over with the usual chunks
         laswriter->close();
-        LASMessage(LAS_VERBOSE, "splitting file '%s' took %g sec.",       laswriteopener.get_file_name(), taketime()-start_time);
-        start_time = taketime();
         delete laswriter;
         laswriter = 0;
+        file_number--;
+        laswriteopener.set_chunk_size(chunk_size);
+      }
+    }
+    if (lasinventory)
+    {
+      I64 copied_points = 0;
+      const U8* bytes;
+      U32 num_bytes;
+      U32 num_points;
+      U32 i;
+      while (true)
+      {
+        if (lasreader->peek_chunk(&bytes, &num_bytes, &num_points))
+        {
+          if (laswriter == 0) open_writer();
+          if ((laswriter->p_count + num_points) <= chopchop)
+          {
+            if (!((LASwriterLAS*)laswriter)->write_chunk(bytes, num_bytes, num_points) || !lasreader->skip_chunk())
+            {
+              laserror("copying compressed chunk with %u points", num_points);
+            }
+            for (i = 0; i < num_points; i++)
+            {
+              if (!lasinventory->read_point())
+              {
+                laserror("reading point %u of compressed chunk with %u points", i, num_points);
+              }
+              laswriter->update_inventory(&lasinventory->point);
+            }
+            copied_points += num_points;
+            if (laswriter->p_count == chopchop) close_writer();
+            continue;
+          }
+        }
+        // the points of chunks across a split are decoded and encoded
+        if (!lasreader->read_point()) break;
+        lasinventory->read_point();
+        if (laswriter == 0) open_writer();
+        laswriter->write_point(&lasreader->point);
+        laswriter->update_inventory(&lasreader->point);
+        if (laswriter->p_count == chopchop) close_writer();
+      }
+      if (copied_points) LASMessage(LAS_VERBOSE, "copied %lld of %lld points as compressed chunks", copied_points, lasreader->p_cnt);
+      lasinventory->close();
+      delete lasinventory;
+      laswriteopener.set_chunk_size(chunk_size);
+    }
+    else
+    {
+      // only the reading is threaded as the writers change
+      LASpipeline laspipeline;
+      laspipeline.open(lasreader, 0, FALSE, pipeline);
+      LASpoint* point;
+      // loop over the points
+      while ((point = laspipeline.read_point()))
+      {
+        if (laswriter == 0) open_writer();
+        laswriter->write_point(point);
+        laswriter->update_inventory(point);
+        if (laswriter->p_count == chopchop) close_writer();
+      }
+      if (!laspipeline.close())
+      {
+        laserror("writing points failed");
       }
     }
     if (laswriter && laswriter->p_count)
     {
-      // close the current writer
-      laswriter->update_header(&lasreader->header, TRUE);
-      laswriter->close();
-      LASMessage(LAS_VERBOSE, "splitting file '%s' took %g sec.", laswriteopener.get_file_name(), taketime()-start_time);
-      start_time = taketime(); 
-      delete laswriter;
-      laswriter = 0;
+      close_writer();
     }
   }
   else
@@ -296,20 +429,62 @@ int main(int argc, char *argv[])
         laserror("cannot merge %lld points into single LAS 1.%d file. maximum is %u", lasreader->npoints, lasreader->header.version_minor, U32_MAX);
       }
     }
+    // compressed chunks of LAZ files with new LAS 1.4 points that are merged without any change
+    // can be copied when the output has variable chunks. the merged reader checks the details
+    LASwriterLAS* chunk_writer = 0;
+    U32 chunk_size = laswriteopener.get_chunk_size();
+    BOOL chunked = chunk_copy && lasreader->header.laszip && (lasreader->header.laszip->compressor == LASZIP_COMPRESSOR_LAYERED_CHUNKED);
+    if (chunked && (chunk_size == LASZIP_CHUNK_SIZE_DEFAULT) && (lasreadopener.get_filter() == 0) && (lasreadopener.get_transform() == 0) && !lasreadopener.is_piped() && !laswriteopener.is_piped() && !laswriteopener.get_statistics_sidecar() && !laswriteopener.get_chunk_summaries() && !laswriteopener.get_adaptive_chunking())
+    {
+      laswriteopener.set_chunk_size(0);
+    }
     // open the writer
     LASwriter* laswriter = laswriteopener.open(&lasreader->header);
     if (laswriter == 0)
     {
       laserror("could not open laswriter");
     }
-    // loop over the points
-    while (lasreader->read_point())
+    if (laswriteopener.get_chunk_size() != chunk_size)
+    {
+      chunk_writer = dynamic_cast<LASwriterLAS*>(laswriter);
+      if ((chunk_writer == 0) || !chunk_writer->can_copy_chunks(lasreader->header.laszip))
+      {
+        // start over with the usual chunks
+        chunk_writer = 0;
+        laswriter->close();
+        delete laswriter;
+        laswriteopener.set_chunk_size(chunk_size);
+        laswriter = laswriteopener.open(&lasreader->header);
+        if (laswriter == 0)
+        {
+          laserror("could not open laswriter");
+        }
+      }
+      laswriteopener.set_chunk_size(chunk_size);
+    }
+    I64 copied_points = 0;
+    if (chunk_writer)
+    {
+      copied_points = merge_compressed_chunks(lasreader, chunk_writer);
+      if (copied_points) LASMessage(LAS_VERBOSE, "copied %lld of %lld points as compressed chunks", copied_points, lasreader->p_cnt);
+    }
+    else
     {
-      laswriter->write_point(&lasreader->point);
-      laswriter->update_inventory(&lasreader->point);
+      // loop over the points
+      LASpipeline laspipeline;
+      laspipeline.open(lasreader, laswriter, TRUE, pipeline);
+      LASpoint* point;
+      while ((point = laspipeline.read_point()))
+      {
+        laspipeline.write_point(point);
+      }
+      if (!laspipeline.close())
+      {
+        laserror("writing points failed");
+      }
     }
-    // close the writer
-    laswriter->update_header(&lasreader->header, TRUE);
+    // close the writer. points of copied chunks are not in the inventory but in the merged header
+    if (copied_points == 0) laswriter->update_header(&lasreader->header, TRUE);
     laswriter->close();
     LASMessage(LAS_VERBOSE, "merging files took %g sec.", taketime()-start_time); 
     delete laswriter;
@@ -44,6 +44,8 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- values outside of the bitmaps and gps times go to sparse tiles
+    18 October 2026 -- streams whole files through value bitmaps instead of sorting 5M points
      1 May 2017 -- 3rd example for selective decompression for new LAS 1.4 points
     30 November 2010 -- created spotting few paper cups at Starbuck's Offenbach
 
@@ -61,82 +63,268 @@
 #include "geoprojectionconverter.hpp"
 #include "lastool.hpp"
 
-static void quicksort_for_shorts(short* a, int i, int j)
+#include <algorithm>
+#include <map>
+#include <vector>
+
+// one bit for every integer value between 'min' and 'max' that occurs in the
+// data. visiting the set bits in order visits the distinct values sorted so
+// that the differences between neighbours are histogrammed in a single pass
+// without storing or sorting any points. values outside of the range (e.g. a
+// wrong bounding box in the header or a range too large for the bitmap) go to
+// sparse tiles that hold a sorted list of the values they contain. tiles of
+// 65536 values switch to a bitmap of their own once they contain many. no
+// value is ever discarded and a value costs at most four bytes.
+
+#define LAS_PRECISION_MAX_RANGE ((I64)1 << 28)
+#define LAS_PRECISION_TILE_BITS 16
+#define LAS_PRECISION_TILE_WORDS (1 << (LAS_PRECISION_TILE_BITS - 6))
+
+class LASprecisionTile
 {
-  int in_i = i;
-  int in_j = j;
-  short key = a[(i+j)/2];
-  short w;
-  do
+public:
+  inline void add(const U32 offset, const BOOL bitmap)
   {
-    while ( a[i] < key ) i++;
-    while ( a[j] > key ) j--;
-    if (i<j)
+    if (bits.size())
     {
-      w = a[i];
-      a[i] = a[j];
-      a[j] = w;
+      bits[offset >> 6] |= (((U64)1) << (offset & 63));
+      return;
     }
-  } while (++i<=--j);
-  if (i == j+3)
+    offsets.push_back(offset);
+    if (offsets.size() >= compact_at)
+    {
+      compact();
+      if (bitmap && (offsets.size() >= 2 * LAS_PRECISION_TILE_WORDS))
+      {
+        // the bitmap is not larger than the list of offsets
+        bits.assign(LAS_PRECISION_TILE_WORDS, 0);
+        for (size_t i = 0; i < offsets.size(); i++) bits[offsets[i] >> 6] |= (((U64)1) << (offsets[i] & 63));
+        std::vector<U32>().swap(offsets);
+      }
+      else
+      {
+        compact_at = 2 * offsets.size();
+      }
+    }
+  };
+  void compact()
   {
-    i--;
-    j++;
-  }
-  if (j>in_i) quicksort_for_shorts(a, in_i, j);
-  if (i<in_j) quicksort_for_shorts(a, i, in_j);
+    std::sort(offsets.begin(), offsets.end());
+    offsets.erase(std::unique(offsets.begin(), offsets.end()), offsets.end());
+  };
+  std::vector<U32> offsets;
+  std::vector<U64> bits;
+private:
+  size_t compact_at = 16;
+};
+
+class LASprecisionValues
+{
+public:
+  // values spread too thinly for tiles of 65536 (e.g. gps times) use wider tiles
+  void init(const CHAR* name, I64 min, I64 max, I32 tile_bits = LAS_PRECISION_TILE_BITS)
+  {
+    this->name = name;
+    if ((max < min) || ((max - min) >= LAS_PRECISION_MAX_RANGE))
+    {
+      if (max >= min) LASMessage(LAS_VERBOSE, "range of %s values from %lld to %lld too large for bitmap. using sparse tiles", name, min, max);
+      // without a usable range all values go to the sparse tiles
+      min = 0;
+      max = -1;
+    }
+    this->min = min;
+    this->max = max;
+    this->tile_bits = tile_bits;
+    bits.assign((max < min ? 0 : (size_t)(((max - min) >> 6) + 1)), 0);
+    tiles.clear();
+    tile = 0;
+    count = 0;
+  };
+  inline void add(const I64 value)
+  {
+    if ((value < min) || (value > max))
+    {
+      I64 index = (value >> tile_bits);
+      if ((tile == 0) || (index != tile_index))
+      {
+        tile = &tiles[index];
+        tile_index = index;
+      }
+      tile->add((U32)(value & ((((I64)1) << tile_bits) - 1)), (tile_bits == LAS_PRECISION_TILE_BITS));
+    }
+    else
+    {
+      U64 bit = (U64)(value - min);
+      bits[(size_t)(bit >> 6)] |= (((U64)1) << (bit & 63));
+    }
+    count++;
+  };
+  // visits the distinct values in increasing order and returns how many there are
+  template <typename F>
+  U64 visit(F visitor)
+  {
+    U64 distinct = 0;
+    bool dense_done = false;
+    auto visit_dense = [&]()
+    {
+      for (size_t w = 0; w < bits.size(); w++)
+      {
+        U64 word = bits[w];
+        while (word)
+        {
+          visitor(min + (((I64)w) << 6) + lowest_bit(word));
+          distinct++;
+          word &= (word - 1);
+        }
+      }
+      dense_done = true;
+    };
+    auto visit_sparse = [&](I64 value)
+    {
+      if (!dense_done && (value > max)) visit_dense();
+      visitor(value);
+      distinct++;
+    };
+    std::map<I64, LASprecisionTile>::iterator it;
+    for (it = tiles.begin(); it != tiles.end(); it++)
+    {
+      I64 base = (it->first << tile_bits);
+      LASprecisionTile& t = it->second;
+      if (t.bits.size())
+      {
+        for (I32 w = 0; w < LAS_PRECISION_TILE_WORDS; w++)
+        {
+          U64 word = t.bits[w];
+          while (word)
+          {
+            visit_sparse(base + (w << 6) + lowest_bit(word));
+            word &= (word - 1);
+          }
+        }
+      }
+      else
+      {
+        t.compact();
+        for (size_t i = 0; i < t.offsets.size(); i++) visit_sparse(base + t.offsets[i]);
+      }
+    }
+    if (!dense_done) visit_dense();
+    return distinct;
+  };
+  // histogram of the differences between the sorted values (zero for repeated values)
+  void get_differences(std::map<I64, U64>& differences)
+  {
+    bool first = true;
+    I64 last = 0;
+    U64 distinct = visit([&](I64 value)
+    {
+      if (first) first = false;
+      else differences[value - last]++;
+      last = value;
+    });
+    if (count > distinct) differences[0] += (count - distinct);
+  };
+  U64 get_count() const { return count; };
+private:
+  const CHAR* name = 0;
+  I64 min = 0;
+  I64 max = -1;
+  I32 tile_bits = LAS_PRECISION_TILE_BITS;
+  U64 count = 0;
+  std::vector<U64> bits;
+  std::map<I64, LASprecisionTile> tiles;
+  LASprecisionTile* tile = 0;
+  I64 tile_index = 0;
+  static inline I32 lowest_bit(U64 word)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    I32 bit = 0;
+    while ((word & 1) == 0) { word >>= 1; bit++; }
+    return bit;
+#endif
+  };
+};
+
+// gps times are mapped to integers with the same order so that they go through
+// the same sparse tiles as the coordinates
+
+static inline I64 gps_time_to_key(const F64 gps_time)
+{
+  I64 key;
+  memcpy(&key, &gps_time, sizeof(I64));
+  return (key < 0 ? key ^ I64_MAX : key);
+}
+
+static inline F64 key_to_gps_time(I64 key)
+{
+  if (key < 0) key ^= I64_MAX;
+  F64 gps_time;
+  memcpy(&gps_time, &key, sizeof(F64));
+  return gps_time;
 }
 
-static void quicksort_for_ints(int* a, int i, int j)
+template <typename T>
+static void report_differences(const char* name, const std::map<T, U64>& differences, F64 scale, U32 report_lines, bool report_diff, bool report_diff_diff)
 {
-  int in_i = i;
-  int in_j = j;
-  int key = a[(i+j)/2];
-  int w;
-  do
+  typename std::map<T, U64>::const_iterator it;
+  if (report_diff)
   {
-    while ( a[i] < key ) i++;
-    while ( a[j] > key ) j--;
-    if (i<j)
+    fprintf(stdout, "%s differences \n", name);
+    U32 count_lines = 0;
+    for (it = differences.begin(); (it != differences.end()) && (count_lines < report_lines); it++, count_lines++)
     {
-      w = a[i];
-      a[i] = a[j];
-      a[j] = w;
+      if (scale != 0.0)
+        fprintf(stdout, " %10lld : %10llu   %g\n", (long long)it->first, (unsigned long long)it->second, scale*it->first);
+      else
+        fprintf(stdout, "  %10lld : %10llu\n", (long long)it->first, (unsigned long long)it->second);
     }
-  } while (++i<=--j);
-  if (i == j+3)
+  }
+  if (report_diff_diff)
   {
-    i--;
-    j++;
+    fprintf(stdout, "%s differences of differences\n", name);
+    std::map<T, U64> diff_diffs;
+    for (it = differences.begin(); it != differences.end(); it++)
+    {
+      typename std::map<T, U64>::const_iterator next = it;
+      if (++next == differences.end()) break;
+      diff_diffs[next->first - it->first]++;
+    }
+    for (it = diff_diffs.begin(); it != diff_diffs.end(); it++)
+    {
+      fprintf(stdout, "  %10lld : %10llu\n", (long long)it->first, (unsigned long long)it->second);
+    }
   }
-  if (j>in_i) quicksort_for_ints(a, in_i, j);
-  if (i<in_j) quicksort_for_ints(a, i, in_j);
 }
 
-static void quicksort_for_doubles(double* a, int i, int j)
+template <>
+void report_differences<F64>(const char* name, const std::map<F64, U64>& differences, F64 scale, U32 report_lines, bool report_diff, bool report_diff_diff)
 {
-  int in_i = i;
-  int in_j = j;
-  double key = a[(i+j)/2];
-  double w;
-  do
+  std::map<F64, U64>::const_iterator it;
+  if (report_diff)
   {
-    while ( a[i] < key ) i++;
-    while ( a[j] > key ) j--;
-    if (i<j)
+    fprintf(stdout, "%s differences \n", name);
+    for (it = differences.begin(); it != differences.end(); it++)
     {
-      w = a[i];
-      a[i] = a[j];
-      a[j] = w;
+      fprintf(stdout, "  %.10g : %10llu\n", it->first, (unsigned long long)it->second);
     }
-  } while (++i<=--j);
-  if (i == j+3)
+  }
+  if (report_diff_diff)
   {
-    i--;
-    j++;
+    fprintf(stdout, "%s  differences of differences\n", name);
+    std::map<F64, U64> diff_diffs;
+    for (it = differences.begin(); it != differences.end(); it++)
+    {
+      std::map<F64, U64>::const_iterator next = it;
+      if (++next == differences.end()) break;
+      diff_diffs[next->first - it->first]++;
+    }
+    for (it = diff_diffs.begin(); it != diff_diffs.end(); it++)
+    {
+      fprintf(stdout, "  %.10g : %10llu\n", it->first, (unsigned long long)it->second);
+    }
   }
-  if (j>in_i) quicksort_for_doubles(a, in_i, j);
-  if (i<in_j) quicksort_for_doubles(a, i, in_j);
 }
 
 class LasTool_lasprecision : public LasTool
@@ -184,7 +372,7 @@ int main(int argc, char *argv[])
   bool report_rgb = false;
   bool output = false;
   U32 report_lines = 20;
-  U32 array_max = 5000000;
+  I64 array_max = I64_MAX;
   bool projection_was_set = false;
   double start_time = 0;
   double full_start_time = 0;
@@ -258,7 +446,7 @@ int main(int argc, char *argv[])
         laserror("'%s' needs 1 argument: max", argv[i]);
       }
       i++;
-      array_max = atoi(argv[i]);
+      array_max = atoll(argv[i]);
     }
     else if (strcmp(argv[i],"-lines") == 0)
     {
@@ -271,7 +459,7 @@ int main(int argc, char *argv[])
     }
     else if (strcmp(argv[i],"-all") == 0)
     {
-      array_max = U32_MAX;
+      array_max = I64_MAX;
     }
     else if ((argv[i][0] != '-') && (lasreadopener.get_file_name_number() == 0))
     {
@@ -369,395 +557,150 @@ int main(int argc, char *argv[])
       laserror("could not open lasreader");
     }
 
-    // run presicion statistics across the first array_max points
+    // run presicion statistics across all (or the first array_max) points
 
     if (!output)
     {
       fprintf(stdout, "original scale factors: %g %g %g\n", lasreader->header.x_scale_factor, lasreader->header.y_scale_factor, lasreader->header.z_scale_factor);
 
-      // create the arrays
-      int* array_x = 0;
-      int* array_y = 0;
-      int* array_z = 0;
+      // values are marked in bitmaps spanning the bounding box of the header
+
+      LASprecisionValues values_x;
+      LASprecisionValues values_y;
+      LASprecisionValues values_z;
       if (report_x)
       {
-        array_x = new int[array_max];
+        values_x.init("X", lasreader->header.get_X(lasreader->header.min_x), lasreader->header.get_X(lasreader->header.max_x));
       }
       if (report_y)
       {
-        array_y = new int[array_max];
+        values_y.init("Y", lasreader->header.get_Y(lasreader->header.min_y), lasreader->header.get_Y(lasreader->header.max_y));
       }
       if (report_z)
       {
-        array_z = new int[array_max];
+        values_z.init("Z", lasreader->header.get_Z(lasreader->header.min_z), lasreader->header.get_Z(lasreader->header.max_z));
       }
 
-      double* array_gps = 0;
-      if (report_gps && lasreader->point.have_gps_time)
+      // gps times have no useful range for a bitmap and all go to wide sparse tiles
+
+      LASprecisionValues values_gps;
+      bool do_gps = report_gps && lasreader->point.have_gps_time;
+      if (do_gps)
       {
-        array_gps = new double[array_max];
+        values_gps.init("GPS time", 0, -1, 32);
       }
 
-      short* array_r = 0;
-      short* array_g = 0;
-      short* array_b = 0;
-      if (report_rgb && lasreader->point.have_rgb)
+      LASprecisionValues values_r;
+      LASprecisionValues values_g;
+      LASprecisionValues values_b;
+      bool do_rgb = report_rgb && lasreader->point.have_rgb;
+      if (do_rgb)
       {
-        array_r = new short[array_max];
-        array_g = new short[array_max];
-        array_b = new short[array_max];
+        values_r.init("R", 0, U16_MAX);
+        values_g.init("G", 0, U16_MAX);
+        values_b.init("B", 0, U16_MAX);
       }
 
-      // do the first pass
+      // a single pass over the points
 
-      LASMessage(LAS_INFO, "loading first %u of %u points", array_max, (U32)lasreader->npoints);
+      if (array_max < lasreader->npoints)
+        LASMessage(LAS_INFO, "loading first %lld of %lld points", array_max, lasreader->npoints);
+      else
+        LASMessage(LAS_INFO, "loading all %lld points", lasreader->npoints);
 
       // loop over points
 
-      unsigned int array_count = 0;
+      I64 array_count = 0;
 
-      while ((lasreader->read_point()) && (array_count < array_max))
+      while ((array_count < array_max) && (lasreader->read_point()))
       {
         if (report_x)
         {
-          array_x[array_count] = lasreader->point.get_X();
+          values_x.add(lasreader->point.get_X());
         }
 
         if (report_y)
         {
-          array_y[array_count] = lasreader->point.get_Y();
+          values_y.add(lasreader->point.get_Y());
         }
 
         if (report_z)
         {
-          array_z[array_count] = lasreader->point.get_Z();
+          values_z.add(lasreader->point.get_Z());
         }
 
-        if (report_gps && lasreader->point.have_gps_time)
+        if (do_gps)
         {
-          array_gps[array_count] = lasreader->point.gps_time;
+          values_gps.add(gps_time_to_key(lasreader->point.gps_time));
         }
 
-        if (report_rgb && lasreader->point.have_rgb)
+        if (do_rgb)
         {
-          array_r[array_count] = lasreader->point.rgb[0];
-          array_g[array_count] = lasreader->point.rgb[1];
-          array_b[array_count] = lasreader->point.rgb[2];
+          values_r.add(lasreader->point.rgb[0]);
+          values_g.add(lasreader->point.rgb[1]);
+          values_b.add(lasreader->point.rgb[2]);
         }
 
         array_count++;
       }
 
-      array_max = array_count;
-
-      // sort values
-
-      if (report_x)
-      {
-        quicksort_for_ints(array_x, 0, array_max-1);
-      }
-
-      if (report_y)
-      {
-        quicksort_for_ints(array_y, 0, array_max-1);
-      }
-
-      if (report_z)
-      {
-        quicksort_for_ints(array_z, 0, array_max-1);
-      }
-
-      if (report_gps && lasreader->point.have_gps_time)
-      {
-        quicksort_for_doubles(array_gps, 0, array_max-1);
-      }
-
-      if (report_rgb && lasreader->point.have_rgb)
-      {
-        quicksort_for_shorts(array_r, 0, array_max-1);
-        quicksort_for_shorts(array_g, 0, array_max-1);
-        quicksort_for_shorts(array_b, 0, array_max-1);
-      }
-
-      // create differences
-
-      if (report_x)
-      {
-        for (array_count = 1; array_count < array_max; array_count++)
-        {
-          array_x[array_count-1] = array_x[array_count] - array_x[array_count-1];
-        }
-      }
-
-      if (report_y)
-      {
-        for (array_count = 1; array_count < array_max; array_count++)
-        {
-          array_y[array_count-1] = array_y[array_count] - array_y[array_count-1];
-        }
-      }
-
-      if (report_z)
-      {
-        for (array_count = 1; array_count < array_max; array_count++)
-        {
-          array_z[array_count-1] = array_z[array_count] - array_z[array_count-1];
-        }
-      }
-
-      if (report_gps && lasreader->point.have_gps_time)
-      {
-        for (array_count = 1; array_count < array_max; array_count++)
-        {
-          array_gps[array_count-1] = array_gps[array_count] - array_gps[array_count-1];
-        }
-      }
-
-      if (report_rgb && lasreader->point.have_rgb)
-      {
-        for (array_count = 1; array_count < array_max; array_count++)
-        {
-          array_r[array_count-1] = array_r[array_count] - array_r[array_count-1];
-          array_g[array_count-1] = array_g[array_count] - array_g[array_count-1];
-          array_b[array_count-1] = array_b[array_count] - array_b[array_count-1];
-        }
-      }
-
-      // sort differences
-
-      if (report_x)
-      {
-        quicksort_for_ints(array_x, 0, array_max-2);
-      }
-
-      if (report_y)
-      {
-        quicksort_for_ints(array_y, 0, array_max-2);
-      }
-
-      if (report_z)
-      {
-        quicksort_for_ints(array_z, 0, array_max-2);
-      }
-
-      if (report_gps && lasreader->point.have_gps_time)
-      {
-        quicksort_for_doubles(array_gps, 0, array_max-2);
-      }
-
-      if (report_rgb && lasreader->point.have_rgb)
-      {
-        quicksort_for_shorts(array_r, 0, array_max-2);
-        quicksort_for_shorts(array_g, 0, array_max-2);
-        quicksort_for_shorts(array_b, 0, array_max-2);
-      }
-
-      // compute difference of differences, sort them, output histogram
+      // histogram differences between sorted values and output them
 
       // first for X & Y & Z
 
-      unsigned int count_lines, array_last, array_first;
-
       if (report_x)
       {
-        if (report_diff) fprintf(stdout, "X differences \n");
-        for (count_lines = 0, array_first = 0, array_last = 0, array_count = 1; array_count < array_max; array_count++)
-        {
-          if (array_x[array_last] != array_x[array_count])
-          {
-            if (report_diff && (count_lines < report_lines)) {  count_lines++; fprintf(stdout, " %10d : %10d   %g\n", array_x[array_last], array_count - array_last, lasreader->header.x_scale_factor*array_x[array_last]); }
-            array_x[array_first] = array_x[array_count] - array_x[array_last];
-            array_last = array_count;
-            array_first++;
-          }
-        }
-        if (report_diff_diff)
-        {
-          fprintf(stdout, "X differences of differences\n");
-          quicksort_for_ints(array_x, 0, array_first-1);
-          for (array_last = 0, array_count = 1; array_count < array_first; array_count++)
-          {
-            if (array_x[array_last] != array_x[array_count])
-            {
-              fprintf(stdout, "  %10d : %10d\n", array_x[array_last], array_count - array_last);
-              array_last = array_count;
-            }
-          }
-        }
+        std::map<I64, U64> differences;
+        values_x.get_differences(differences);
+        report_differences("X", differences, lasreader->header.x_scale_factor, report_lines, report_diff, report_diff_diff);
       }
 
       if (report_y)
       {
-        if (report_diff) fprintf(stdout, "Y differences \n");
-        for (count_lines = 0, array_first = 0, array_last = 0, array_count = 1; array_count < array_max; array_count++)
-        {
-          if (array_y[array_last] != array_y[array_count])
-          {
-            if (report_diff && (count_lines < report_lines)) { count_lines++; fprintf(stdout, " %10d : %10d   %g\n", array_y[array_last], array_count - array_last, lasreader->header.y_scale_factor*array_y[array_last]); }
-            array_y[array_first] = array_y[array_count] - array_y[array_last];
-            array_last = array_count;
-            array_first++;
-          }
-        }
-        if (report_diff_diff)
-        {
-          fprintf(stdout, "Y differences of differences\n");
-          quicksort_for_ints(array_y, 0, array_first-1);
-          for (array_last = 0, array_count = 1; array_count < array_first; array_count++)
-          {
-            if (array_y[array_last] != array_y[array_count])
-            {
-              fprintf(stdout, "  %10d : %10d\n", array_y[array_last], array_count - array_last);
-              array_last = array_count;
-            }
-          }
-        }
+        std::map<I64, U64> differences;
+        values_y.get_differences(differences);
+        report_differences("Y", differences, lasreader->header.y_scale_factor, report_lines, report_diff, report_diff_diff);
       }
 
       if (report_z)
       {
-        if (report_diff) fprintf(stdout, "Z differences \n");
-        for (count_lines = 0, array_first = 0, array_last = 0, array_count = 1; array_count < array_max; array_count++)
-        {
-          if (array_z[array_last] != array_z[array_count])
-          {
-            if (report_diff && (count_lines < report_lines)) { count_lines++; fprintf(stdout, " %10d : %10d   %g\n", array_z[array_last], array_count - array_last, lasreader->header.z_scale_factor*array_z[array_last]); }
-            array_z[array_first] = array_z[array_count] - array_z[array_last];
-            array_last = array_count;
-            array_first++;
-          }
-        }
-        if (report_diff_diff)
-        {
-          fprintf(stdout, "Z differences of differences\n");
-          quicksort_for_ints(array_z, 0, array_first-1);
-          for (array_last = 0, array_count = 1; array_count < array_first; array_count++)
-          {
-            if (array_z[array_last] != array_z[array_count])
-            {
-              fprintf(stdout, "  %10d : %10d\n", array_z[array_last], array_count - array_last);
-              array_last = array_count;
-            }
-          }
-        }
+        std::map<I64, U64> differences;
+        values_z.get_differences(differences);
+        report_differences("Z", differences, lasreader->header.z_scale_factor, report_lines, report_diff, report_diff_diff);
       }
 
       // then for GPS
 
-      if (report_gps && lasreader->point.have_gps_time)
+      if (do_gps && values_gps.get_count())
       {
-        if (report_diff) fprintf(stdout, "GPS time differences \n");
-        for (array_first = 0, array_last = 0, array_count = 1; array_count < array_max; array_count++)
-        {
-          if (array_gps[array_last] != array_gps[array_count])
-          {
-            if (report_diff) fprintf(stdout, "  %.10g : %10d\n", array_gps[array_last], array_count - array_last);
-            array_gps[array_first] = array_gps[array_count] - array_gps[array_last];
-            array_last = array_count;
-            array_first++;
-          }
-        }
-        if (report_diff_diff)
+        std::map<F64, U64> differences;
+        bool first = true;
+        F64 last = 0.0;
+        U64 distinct = values_gps.visit([&](I64 key)
         {
-          fprintf(stdout, "GPS time  differences of differences\n");
-          quicksort_for_doubles(array_gps, 0, array_first-1);
-          for (array_last = 0, array_count = 1; array_count < array_first; array_count++)
-          {
-            if (array_gps[array_last] != array_gps[array_count])
-            {
-              fprintf(stdout, "  %.10g : %10d\n", array_gps[array_last], array_count - array_last);
-              array_last = array_count;
-            }
-          }
-        }
+          F64 gps_time = key_to_gps_time(key);
+          if (first) first = false;
+          else differences[gps_time - last]++;
+          last = gps_time;
+        });
+        if (values_gps.get_count() > distinct) differences[0.0] += (values_gps.get_count() - distinct);
+        report_differences("GPS time", differences, 0.0, U32_MAX, report_diff, report_diff_diff);
       }
 
       // then for R & G & B
 
-      if (report_rgb && lasreader->point.have_rgb)
+      if (do_rgb)
       {
-        if (report_diff) fprintf(stdout, "R differences \n");
-        for (array_first = 0, array_last = 0, array_count = 1; array_count < array_max; array_count++)
-        {
-          if (array_r[array_last] != array_r[array_count])
-          {
-            if (report_diff) fprintf(stdout, "  %10d : %10d\n", array_r[array_last], array_count - array_last);
-            array_r[array_first] = array_r[array_count] - array_r[array_last];
-            array_last = array_count;
-            array_first++;
-          }
-        }
-        if (report_diff_diff)
-        {
-          fprintf(stdout, "R differences of differences\n");
-          quicksort_for_shorts(array_r, 0, array_first-1);
-          for (array_last = 0, array_count = 1; array_count < array_first; array_count++)
-          {
-            if (array_r[array_last] != array_r[array_count])
-            {
-              fprintf(stdout, "  %10d : %10d\n", array_r[array_last], array_count - array_last);
-              array_last = array_count;
-            }
-          }
-        }
-
-        if (report_diff) fprintf(stdout, "G differences \n");
-        for (array_first = 0, array_last = 0, array_count = 1; array_count < array_max; array_count++)
-        {
-          if (array_g[array_last] != array_g[array_count])
-          {
-            if (report_diff) fprintf(stdout, "  %10d : %10d\n", array_g[array_last], array_count - array_last);
-            array_g[array_first] = array_g[array_count] - array_g[array_last];
-            array_last = array_count;
-            array_first++;
-          }
-        }
-        if (report_diff_diff)
-        {
-          fprintf(stdout, "G differences of differences\n");
-          quicksort_for_shorts(array_g, 0, array_first-1);
-          for (array_last = 0, array_count = 1; array_count < array_first; array_count++)
-          {
-            if (array_g[array_last] != array_g[array_count])
-            {
-              fprintf(stdout, "  %10d : %10d\n", array_g[array_last], array_count - array_last);
-              array_last = array_count;
-            }
-          }
-        }
-
-        if (report_diff) fprintf(stdout, "B differences \n");
-        for (array_first = 0, array_last = 0, array_count = 1; array_count < array_max; array_count++)
-        {
-          if (array_b[array_last] != array_b[array_count])
-          {
-            if (report_diff) fprintf(stdout, "  %10d : %10d\n", array_b[array_last], array_count - array_last);
-            array_b[array_first] = array_b[array_count] - array_b[array_last];
-            array_last = array_count;
-            array_first++;
-          }
-        }
-        if (report_diff_diff)
-        {
-          fprintf(stdout, "B differences of differences\n");
-          quicksort_for_shorts(array_b, 0, array_first-1);
-          for (array_last = 0, array_count = 1; array_count < array_first; array_count++)
-          {
-            if (array_b[array_last] != array_b[array_count])
-            {
-              fprintf(stdout, "  %10d : %10d\n", array_b[array_last], array_count - array_last);
-              array_last = array_count;
-            }
-          }
-        }
+        std::map<I64, U64> differences;
+        values_r.get_differences(differences);
+        report_differences("R", differences, 0.0, U32_MAX, report_diff, report_diff_diff);
+        differences.clear();
+        values_g.get_differences(differences);
+        report_differences("G", differences, 0.0, U32_MAX, report_diff, report_diff_diff);
+        differences.clear();
+        values_b.get_differences(differences);
+        report_differences("B", differences, 0.0, U32_MAX, report_diff, report_diff_diff);
       }
-      if (array_x) delete [] array_x;
-      if (array_y) delete [] array_y;
-      if (array_z) delete [] array_z;
-      if (array_gps) delete [] array_gps;
-      if (array_r) delete [] array_r;
-      if (array_g) delete [] array_g;
-      if (array_b) delete [] array_b;
     }
     else
     {
@@ -20,6 +20,7 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 - '-cores' also sets the threads of tools that use them on a single input
     01 Mai 2024 - initial
 
 ===============================================================================
@@ -49,8 +50,9 @@ class LasTool
 #ifdef COMPILE_WITH_GUI
     bool gui = false;
 #endif
-#ifdef COMPILE_WITH_MULTI_CORE
     I32 cores = 1;
+    bool cores_threads = false;  // the tool also runs '-cores' threads on a single input
+#ifdef COMPILE_WITH_MULTI_CORE
     BOOL cpu64 = FALSE;
 #endif
     std::string name;
@@ -187,7 +189,14 @@ class LasTool
         }
         else if (strcmp(argv[i], "-cores") == 0)
         {
-#ifdef COMPILE_WITH_MULTI_CORE
+#ifndef COMPILE_WITH_MULTI_CORE
+            if (!cores_threads)
+            {
+                LASMessage(LAS_WARNING, "not compiled with multi-core batching. ignoring '-cores' ...");
+                i++;
+                return true;
+            }
+#endif
             if ((i + 1) >= argc)
             {
                 laserrorusage("'%s' needs 1 argument: number", argv[i]);
@@ -201,10 +210,6 @@ class LasTool
             argv[i][0] = '\0';
             i++;
             argv[i][0] = '\0';
-#else
-            LASMessage(LAS_WARNING, "not compiled with multi-core batching. ignoring '-cores' ...");
-            i++;
-#endif
         }
         else if (strcmp(argv[i], "-cpu64") == 0)
         {
@@ -25,6 +25,7 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- option '-pipeline' decompresses and compresses on separate threads
     21 Juni 2019 -- allows compressing Trimble waveforms where first WDP offset is 0
     7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
     29 March 2015 -- using LASwriterCompatible for LAS 1.4 compatibility mode
@@ -58,6 +59,7 @@
 #include "geoprojectionconverter.hpp"
 #include "lasindex.hpp"
 #include "lasquadtree.hpp"
+#include "laspipeline.hpp"
 #include "lastool.hpp"
 
 class OffsetSize
@@ -91,6 +93,7 @@ public:
     fprintf(stderr, "laszip -i *.laz -odir uncompressed -cores 4\n");
 #endif
     fprintf(stderr, "laszip -i lidar.las -o lidar_zipped.laz\n");
+    fprintf(stderr, "laszip -i lidar.laz -pipeline -o lidar_rezipped.laz\n");
     fprintf(stderr, "laszip -i lidar.laz -o lidar_unzipped.las\n");
     fprintf(stderr, "laszip -i lidar.las -stdout -olaz > lidar.laz\n");
     fprintf(stderr, "laszip -stdin -o lidar.laz < lidar.las\n");
@@ -130,6 +133,7 @@ int main(int argc, char *argv[])
   bool format_not_specified = false;
   BOOL lax = FALSE;
   BOOL append = FALSE;
+  BOOL pipeline = FALSE;
   BOOL remain_compatible = FALSE;
   BOOL move_CRS = FALSE;
   BOOL move_all = FALSE;
@@ -184,6 +188,10 @@ int main(int argc, char *argv[])
     {
       append = TRUE;
     }
+    else if (strcmp(argv[i],"-pipeline") == 0)
+    {
+      pipeline = TRUE;
+    }
     else if (strcmp(argv[i],"-remain_compatible") == 0)
     {
       remain_compatible = TRUE;
@@ -696,6 +704,10 @@ int main(int argc, char *argv[])
       {
         // loop over points
 
+        LASpipeline laspipeline;
+        laspipeline.open(lasreader, laswriter, !lasreadopener.is_header_populated() || (end_of_points > -1), pipeline);
+        LASpoint* point;
+
         if (lasreadopener.is_header_populated())
         {
           if (lax) // should we also create a spatial indexing file
@@ -709,10 +721,14 @@ int main(int argc, char *argv[])
             lasindex.prepare(lasquadtree, threshold);
 
             // compress points and add to index
-            while (lasreader->read_point())
+            while ((point = laspipeline.read_point()))
             {
-              lasindex.add(lasreader->point.get_x(), lasreader->point.get_y(), (U32)(laswriter->p_count));
-              laswriter->write_point(&lasreader->point);
+              lasindex.add(point->get_x(), point->get_y(), (U32)(laspipeline.p_count));
+              laspipeline.write_point(point);
+            }
+            if (!laspipeline.close())
+            {
+              laserror("writing points failed");
             }
 
             // flush the writer
@@ -741,22 +757,29 @@ int main(int argc, char *argv[])
 
               LASMessage(LAS_VERBOSE, "writing with end_of_points value %d", end_of_points);
 
-              while (lasreader->read_point())
+              while ((point = laspipeline.read_point()))
               {
-                if (memcmp(point10, &lasreader->point, 20) == 0)
+                if (memcmp(point10, point, 20) == 0)
                 {
                   break;
                 }
-                laswriter->write_point(&lasreader->point);
-                laswriter->update_inventory(&lasreader->point);
+                laspipeline.write_point(point);
+              }
+              if (!laspipeline.close())
+              {
+                laserror("writing points failed");
               }
               laswriter->update_header(&lasreader->header, TRUE);
             }
             else
             {
-              while (lasreader->read_point())
+              while ((point = laspipeline.read_point()))
               {
-                laswriter->write_point(&lasreader->point);
+                laspipeline.write_point(point);
+              }
+              if (!laspipeline.close())
+              {
+                laserror("writing points failed");
               }
             }
             // flush the writer
@@ -776,11 +799,14 @@ int main(int argc, char *argv[])
             lasindex.prepare(lasquadtree, threshold);
 
             // compress points and add to index
-            while (lasreader->read_point())
+            while ((point = laspipeline.read_point()))
+            {
+              lasindex.add(point->get_x(), point->get_y(), (U32)(laspipeline.p_count));
+              laspipeline.write_point(point);
+            }
+            if (!laspipeline.close())
             {
-              lasindex.add(lasreader->point.get_x(), lasreader->point.get_y(), (U32)(laswriter->p_count));
-              laswriter->write_point(&lasreader->point);
-              laswriter->update_inventory(&lasreader->point);
+              laserror("writing points failed");
             }
 
             // flush the writer
@@ -809,25 +835,27 @@ int main(int argc, char *argv[])
 
               LASMessage(LAS_VERBOSE, "writing with end_of_points value %d", end_of_points);
 
-              while (lasreader->read_point())
+              while ((point = laspipeline.read_point()))
               {
-                if (memcmp(point10, &lasreader->point, 20) == 0)
+                if (memcmp(point10, point, 20) == 0)
                 {
                   break;
                 }
-                laswriter->write_point(&lasreader->point);
-                laswriter->update_inventory(&lasreader->point);
+                laspipeline.write_point(point);
               }
             }
             else
             {
-              while (lasreader->read_point())
+              while ((point = laspipeline.read_point()))
               {
-                laswriter->write_point(&lasreader->point);
-                laswriter->update_inventory(&lasreader->point);
+                laspipeline.write_point(point);
               }
             }
           }
+          if (!laspipeline.close())
+          {
+            laserror("writing points failed");
+          }
 
           // update the header
           laswriter->update_header(&lasreader->header, TRUE);
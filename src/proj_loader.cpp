@@ -76,6 +76,7 @@ proj_context_errno_t proj_context_errno_ptr = nullptr;
 proj_context_errno_string_t proj_context_errno_string_ptr = nullptr;
 proj_coord_t proj_coord_ptr = nullptr;
 proj_trans_t proj_trans_ptr = nullptr;
+proj_trans_generic_t proj_trans_generic_ptr = nullptr;
 proj_get_type_t proj_get_type_ptr = nullptr;
 proj_is_crs_t proj_is_crs_ptr = nullptr;
 
@@ -451,6 +452,8 @@ bool load_proj_library(const char* path, bool isNecessary/*=true*/) {
   proj_context_errno_string_ptr = (proj_context_errno_string_t)GET_PROC_ADDRESS(proj_lib_handle, "proj_context_errno_string");
   proj_coord_ptr = (proj_coord_t)GET_PROC_ADDRESS(proj_lib_handle, "proj_coord");
   proj_trans_ptr = (proj_trans_t)GET_PROC_ADDRESS(proj_lib_handle, "proj_trans");
+  // optional: batched transformation of coordinate arrays (falls back to proj_trans per point)
+  proj_trans_generic_ptr = (proj_trans_generic_t)GET_PROC_ADDRESS(proj_lib_handle, "proj_trans_generic");
   proj_get_type_ptr = (proj_get_type_t)GET_PROC_ADDRESS(proj_lib_handle, "proj_get_type");
   proj_is_crs_ptr = (proj_is_crs_t)GET_PROC_ADDRESS(proj_lib_handle, "proj_is_crs");
 
@@ -507,6 +510,7 @@ void unload_proj_library() {
   proj_context_errno_string_ptr = nullptr;
   proj_coord_ptr = nullptr;
   proj_trans_ptr = nullptr;
+  proj_trans_generic_ptr = nullptr;
   proj_get_type_ptr = nullptr;
   proj_is_crs_ptr = nullptr;
 }
@@ -46,6 +46,7 @@
 #define FREE_LIBRARY(lib) dlclose(lib)
 #define PROJ_LIB_HANDLE void*
 #endif
+#include <stddef.h>
 
 // Placeholder for compiling without proj.h
 typedef void* PJ;
@@ -136,6 +137,7 @@ typedef int (*proj_context_errno_t)(PJ_CONTEXT*);
 typedef const char* (*proj_context_errno_string_t)(PJ_CONTEXT*, int);
 typedef PJ_COORD (*proj_coord_t)(double, double, double, double);
 typedef PJ_COORD (*proj_trans_t)(PJ*, PJ_DIRECTION, PJ_COORD);
+typedef size_t (*proj_trans_generic_t)(PJ*, PJ_DIRECTION, double*, size_t, size_t, double*, size_t, size_t, double*, size_t, size_t, double*, size_t, size_t);
 typedef PJ_TYPE (*proj_get_type_t)(const PJ*);
 typedef int (*proj_is_crs_t)(const PJ*);
 
@@ -170,6 +172,7 @@ extern proj_context_errno_t proj_context_errno_ptr;
 extern proj_context_errno_string_t proj_context_errno_string_ptr;
 extern proj_coord_t proj_coord_ptr;
 extern proj_trans_t proj_trans_ptr;
+extern proj_trans_generic_t proj_trans_generic_ptr;
 extern proj_get_type_t proj_get_type_ptr;
 extern proj_is_crs_t proj_is_crs_ptr;
 
@@ -256,6 +259,9 @@ void unload_proj_library();
 
 #define proj_trans(P, direction, coord) (proj_trans_ptr ? proj_trans_ptr(P, direction, coord) : PJ_COORD{})
 
+#define proj_trans_generic(P, direction, x, sx, nx, y, sy, ny, z, sz, nz, t, st, nt)                                                                 \
+  (proj_trans_generic_ptr ? proj_trans_generic_ptr(P, direction, x, sx, nx, y, sy, ny, z, sz, nz, t, st, nt) : 0)
+
 #define proj_get_type(P) (proj_get_type_ptr ? proj_get_type_ptr(P) : PJ_TYPE{})
 
 #define proj_is_crs(P) (proj_is_crs_ptr ? proj_is_crs_ptr(P) : 0)
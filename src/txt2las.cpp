@@ -31,6 +31,8 @@
 
   CHANGE HISTORY:
 
+    18 October 2026 -- piped input is copied to a temporary file so that it can be quantized again
+    18 October 2026 -- option '-cores 8' parses a single input on several threads in one pass
     21 November 2017 -- allow adding up to 32 (from 10) additional attributes
      7 April 2017 -- new option to '-set_point_type 6' for new LAS 1.4 point types
     17 January 2016 -- pre-scaling and pre-offsetting of "extra bytes" attributes
@@ -60,6 +62,7 @@
 #endif
 
 #include "lasreader.hpp"
+#include "lasreader_txt.hpp"
 #include "laswriter.hpp"
 #include "geoprojectionconverter.hpp"
 #include "lastool.hpp"
@@ -86,6 +89,7 @@ public:
     fprintf(stderr, "txt2las -i lidar.zip -parse txyzar -scale_scan_angle 57.3 -o lidar.laz\n");
     fprintf(stderr, "txt2las -skip 5 -parse xyz -i lidar.rar -set_file_creation 28 2011 -o lidar.las\n");
     fprintf(stderr, "txt2las -parse xyzsst -verbose -set_scale 0.001 0.001 0.001 -i lidar.txt\n");
+    fprintf(stderr, "txt2las -parse xyzi -i huge.txt -cores 8 -o huge.laz\n");
     fprintf(stderr, "txt2las -parse xsysz -set_scale 0.1 0.1 0.01 -i lidar.txt.gz -sp83 OH_N -feet\n");
     fprintf(stderr, "las2las -parse tsxyzRGB -i lidar.txt -set_version 1.2 -scale_intensity 65535 -o lidar.las\n");
     fprintf(stderr, "txt2las -h\n");
@@ -131,6 +135,40 @@ static double taketime()
 
 extern "C" FILE * fopen_compressed(const char* filename, const char* mode, bool* piped = 0);
 
+// copies the piped input into a file that can be read a second time
+
+static bool spool_stdin(const char* file_name)
+{
+  FILE* file = fopen(file_name, "wb");
+  if (file == 0)
+  {
+    LASMessage(LAS_ERROR, "cannot create temporary file '%s' for the piped input", file_name);
+    return false;
+  }
+  char* buffer = (char*)malloc(LAS_TOOLS_IO_IBUFFER_SIZE);
+  size_t bytes;
+  bool ok = (buffer != 0);
+  while (ok && ((bytes = fread(buffer, 1, LAS_TOOLS_IO_IBUFFER_SIZE, stdin)) > 0))
+  {
+    ok = (fwrite(buffer, 1, bytes, file) == bytes);
+  }
+  if (ok && ferror(stdin))
+  {
+    ok = false;
+  }
+  if (fclose(file) != 0)
+  {
+    ok = false;
+  }
+  free(buffer);
+  if (!ok)
+  {
+    LASMessage(LAS_ERROR, "copying the piped input to temporary file '%s' failed", file_name);
+    remove(file_name);
+  }
+  return ok;
+}
+
 #ifdef COMPILE_WITH_GUI
 extern int txt2las_gui(int argc, char* argv[], LASreadOpener* lasreadopener);
 #endif
@@ -143,6 +181,7 @@ int main(int argc, char* argv[])
 {
   LasTool_txt2las lastool;
   lastool.init(argc, argv, "txt2las");
+  lastool.cores_threads = true;
   int i;
   bool projection_was_set = false;
   int file_creation_day = -1;
@@ -156,6 +195,7 @@ int main(int argc, char* argv[])
   U32 progress = 0;
   double full_start_time = 0.0;
   double start_time = 0.0;
+  std::string stdin_spool;
 
   LASreadOpener lasreadopener;
   GeoProjectionConverter geoprojectionconverter;
@@ -469,24 +509,9 @@ int main(int argc, char* argv[])
 #endif
 
 #ifdef COMPILE_WITH_MULTI_CORE
-  if (lastool.cores > 1)
+  if ((lastool.cores > 1) && !lasreadopener.get_use_stdin() && (lasreadopener.get_file_name_number() > 1) && !lasreadopener.is_merged())
   {
-    if (lasreadopener.get_use_stdin())
-    {
-      LASMessage(LAS_WARNING, "using stdin. ignoring '-cores %d' ...", lastool.cores);
-    }
-    else if (lasreadopener.get_file_name_number() < 2)
-    {
-      LASMessage(LAS_WARNING, "only %u input files. ignoring '-cores %d' ...", lasreadopener.get_file_name_number(), lastool.cores);
-    }
-    else if (lasreadopener.is_merged())
-    {
-      LASMessage(LAS_WARNING, "input files merged on-the-fly. ignoring '-cores %d' ...", lastool.cores);
-    }
-    else
-    {
-      txt2las_multi_core(argc, argv, &geoprojectionconverter, &lasreadopener, &laswriteopener, lastool.cores, lastool.cpu64);
-    }
+    txt2las_multi_core(argc, argv, &geoprojectionconverter, &lasreadopener, &laswriteopener, lastool.cores, lastool.cpu64);
   }
   if (lastool.cpu64)
   {
@@ -494,6 +519,13 @@ int main(int argc, char* argv[])
   }
 #endif
 
+  // a single input, stdin or merged inputs are parsed on '-cores' threads
+
+  if (lastool.cores > 1)
+  {
+    lasreadopener.set_parse_threads(lastool.cores);
+  }
+
   // make sure we have input
 
   if (!lasreadopener.active())
@@ -522,6 +554,20 @@ int main(int argc, char* argv[])
     lasreadopener.set_populate_header(TRUE);
   }
 
+  // piped input cannot be read twice. when the scale or the offset come from
+  // the first points an overflow needs a second pass, so the input is copied
+  // to a temporary file before the first pass
+
+  if (lasreadopener.is_piped() && ((lasreadopener.get_scale_factor() == 0) || (lasreadopener.get_offset() == 0)))
+  {
+    stdin_spool = lasreadopener.get_temp_file_base() + "_txt2las_stdin.txt";
+    if (!spool_stdin(stdin_spool.c_str()))
+    {
+      laserror("cannot read piped input twice. use '-set_scale' and '-set_offset' or a file instead of '-stdin'");
+    }
+    lasreadopener.add_file_name(stdin_spool.c_str());
+  }
+
   // check if projection info was set in the command line
 
   int number_of_keys;
@@ -557,10 +603,10 @@ int main(int argc, char* argv[])
     if (!laswriteopener.active())
     {
       // create name from input name
-      laswriteopener.make_file_name(lasreadopener.get_file_name(), -2);
+      laswriteopener.make_file_name((stdin_spool.empty() ? lasreadopener.get_file_name() : 0), -2);
     }
 
-    LASMessage(LAS_VERBOSE, "reading from '%s' and writing to '%s'", (lasreadopener.is_piped() ? "stdin" : lasreadopener.get_file_name()), (laswriteopener.is_piped() ? "stdout" : laswriteopener.get_file_name()));
+    LASMessage(LAS_VERBOSE, "reading from '%s' and writing to '%s'", ((lasreadopener.is_piped() || !stdin_spool.empty()) ? "stdin" : lasreadopener.get_file_name()), (laswriteopener.is_piped() ? "stdout" : laswriteopener.get_file_name()));
 
     // populate header
 
@@ -601,7 +647,7 @@ int main(int argc, char* argv[])
     // maybe set creation date
 
 #ifdef _WIN32
-    if (lasreadopener.get_file_name() && file_creation_day == -1 && file_creation_year == -1)
+    if (lasreadopener.get_file_name() && stdin_spool.empty() && file_creation_day == -1 && file_creation_year == -1)
     {
       WIN32_FILE_ATTRIBUTE_DATA attr;
       SYSTEMTIME creation;
@@ -732,6 +778,34 @@ int main(int argc, char* argv[])
     }
     lasreader->close();
 
+    // the scale and offset from the first lines did not fit all points. quantize once more
+
+    LASreaderTXT* lasreadertxt = dynamic_cast<LASreaderTXT*>(lasreader);
+    if (lasreadertxt && lasreadertxt->has_quantization_overflow())
+    {
+      LASMessage(LAS_INFO, "quantizing again with the scale and offset of the entire bounding box ...");
+      laswriter->close();
+      delete laswriter;
+      if (!lasreadopener.reopen(lasreader))
+      {
+        laserror("could not reopen lasreader");
+      }
+      laswriter = laswriteopener.open(&lasreader->header);
+      if (laswriter == 0)
+      {
+        laserror("could not open laswriter");
+      }
+      while (lasreader->read_point())
+      {
+        laswriter->write_point(&lasreader->point);
+        if (progress && ((lasreader->p_cnt % progress) == 0))
+        {
+          fprintf(stderr, " ... processed %lld points ...\012", lasreader->p_cnt);
+        }
+      }
+      lasreader->close();
+    }
+
     LASMessage(LAS_VERBOSE, "main pass took %g sec.", taketime() - start_time);
 
     if (!laswriteopener.is_piped())
@@ -754,6 +828,7 @@ int main(int argc, char* argv[])
     start_time = taketime();
     laswriteopener.set_file_name(0);
   }
+  if (!stdin_spool.empty()) remove(stdin_spool.c_str());
   if (lasreadopener.get_file_name_number() > 1) LASMessage(LAS_INFO, "done with %u files. total time %g sec.", lasreadopener.get_file_name_number(), taketime() - full_start_time);
   byebye();
   return 0;